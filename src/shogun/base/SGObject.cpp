@@ -31,7 +31,10 @@
 #include <rxcpp/rx-subscription.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <unordered_map>
 #include <vector>
 
@@ -70,7 +73,20 @@ namespace shogun
 
 	typedef std::unordered_map<std::string_view, std::string_view> ObsParamsList;
 
-	class SGObject::Self: public detail::ParameterInterface<ParameterBackend> {};
+	class SGObject::Self: public detail::ParameterInterface<ParameterBackend>
+	{
+	public:
+		/** parameters whose values are loaded on first access */
+		std::set<std::string, std::less<>> lazy_parameters;
+		/** lazy parameters whose loader is running */
+		std::set<std::string, std::less<>> loading_parameters;
+		/** loads the value of a lazy parameter */
+		std::function<void(SGObject*, std::string_view)> lazy_loader;
+		/** whether there are lazy parameters, checked without locking */
+		std::atomic<bool> has_lazy_parameters{false};
+		/** serializes loading, recursive as the loader accesses the object */
+		std::recursive_mutex lazy_mutex;
+	};
 
 	class Parallel;
 
@@ -323,6 +339,7 @@ std::shared_ptr<SGObject> SGObject::clone(ParameterProperties pp) const
 	          "SGObject::create_empty() overridden.\n",
 	    get_name());
 
+	load_lazy_parameters();
 	for (const auto& it : self->filter(pp))
 	{
 		const BaseTag& tag = it.first;
@@ -361,7 +378,8 @@ const AnyParameter& SGObject::get_parameter(const BaseTag& _tag) const
 			"Parameter {}::{} does not exist.", get_name(),
 			_tag.name().c_str());
 	}
-	
+
+	load_lazy_parameter(_tag.name());
 	const auto& parameter = self->at(_tag);
 	
 	if (parameter.get_properties().has_property(
@@ -384,6 +402,7 @@ AnyParameter& SGObject::get_parameter(const BaseTag& _tag)
 			_tag.name().c_str());
 	}
 
+	load_lazy_parameter(_tag.name());
 	auto& parameter = self->at(_tag);
 
 	if (parameter.get_properties().has_property(
@@ -516,6 +535,7 @@ std::string SGObject::to_string() const
 	std::unique_ptr<AnyVisitor> visitor(new ToStringVisitor(&ss));
 	ss << get_name();
 	ss << "(";
+	load_lazy_parameters();
 	for (auto it = self->begin(); it != self->end(); ++it)
 	{
 		ss << it->first.name() << "=";
@@ -543,6 +563,7 @@ std::string SGObject::to_string() const
 
 std::map<std::string, std::shared_ptr<const AnyParameter>> SGObject::get_params() const
 {
+	load_lazy_parameters();
 	std::map<std::string, std::shared_ptr<const AnyParameter>> result;
 	for (auto const& each: *self) {
 		result.emplace(std::string(each.first.name()), 
@@ -572,6 +593,7 @@ bool SGObject::equals(const SGObject* other) const
 	}
 
 	/* Assumption: objects of same type have same set of tags. */
+	load_lazy_parameters();
 	for (const auto& it : *self)
 	{
 		const BaseTag& tag = it.first;
@@ -623,6 +645,7 @@ void SGObject::for_each_param_of_type(
 {
 	auto visitor = std::make_unique<FilterVisitor<T>>(operation);
 
+	load_lazy_parameters();
 	std::for_each(self->begin(), self->end(), [&](auto& pair) {
 		Any any_param = pair.second.get_value();
 		if (any_param.safe_visitable())
@@ -705,6 +728,75 @@ std::string SGObject::string_enum_reverse_lookup(
 	return std::string(enum_map_it->first);
 }
 
+void SGObject::set_lazy_parameters(
+    const std::vector<std::string>& names,
+    std::function<void(SGObject*, std::string_view)> loader)
+{
+	require(loader, "Function object is not callable");
+	for (const auto& name : names)
+	{
+		require(
+		    has_parameter(BaseTag(name)),
+		    "Parameter {}::{} does not exist.", get_name(), name);
+	}
+
+	std::lock_guard<std::recursive_mutex> lock(self->lazy_mutex);
+	self->lazy_parameters.insert(names.begin(), names.end());
+	self->lazy_loader = std::move(loader);
+	self->has_lazy_parameters = !self->lazy_parameters.empty();
+}
+
+void SGObject::load_lazy_parameter(std::string_view name) const
+{
+	if (!self->has_lazy_parameters)
+		return;
+
+	std::lock_guard<std::recursive_mutex> lock(self->lazy_mutex);
+	auto it = self->lazy_parameters.find(name);
+	if (it == self->lazy_parameters.end())
+		return;
+
+	/* the loader accesses the parameter itself */
+	if (self->loading_parameters.find(name) !=
+	    self->loading_parameters.end())
+		return;
+
+	/* the parameter stays pending if loading fails */
+	std::string lazy_name = *it;
+	self->loading_parameters.insert(lazy_name);
+	SG_DEBUG("Loading parameter {}::{}.", get_name(), lazy_name);
+	try
+	{
+		self->lazy_loader(const_cast<SGObject*>(this), lazy_name);
+	}
+	catch (...)
+	{
+		self->loading_parameters.erase(lazy_name);
+		throw;
+	}
+	self->loading_parameters.erase(lazy_name);
+
+	self->lazy_parameters.erase(lazy_name);
+	if (self->lazy_parameters.empty())
+	{
+		self->has_lazy_parameters = false;
+		self->lazy_loader = nullptr;
+	}
+}
+
+void SGObject::load_lazy_parameters() const
+{
+	if (!self->has_lazy_parameters)
+		return;
+
+	std::lock_guard<std::recursive_mutex> lock(self->lazy_mutex);
+	/* parameters that are being loaded are skipped, see above */
+	std::vector<std::string> pending(
+	    self->lazy_parameters.begin(), self->lazy_parameters.end());
+	for (const auto& name : pending)
+		load_lazy_parameter(name);
+}
+
 void SGObject::visit_parameter(const BaseTag& _tag, AnyVisitor* v) const
 {
 	auto p = get_parameter(_tag);
@@ -1081,6 +1081,28 @@ public:
 			std::string_view param, machine_int_t value) const;
 
 	void visit_parameter(const BaseTag& _tag, AnyVisitor* v) const;
+
+#ifndef SWIG
+	/** Registers parameters whose values are loaded on first access, see
+	 * io::BitseryDeserializer::read_object_lazy(). The loader is called
+	 * when the parameter is first accessed through get(), visit_parameter(),
+	 * or any method that iterates over all parameters. A parameter remains
+	 * pending until its loader returns without throwing.
+	 *
+	 * @param names names of the parameters
+	 * @param loader function that loads the value of a parameter
+	 */
+	void set_lazy_parameters(
+	    const std::vector<std::string>& names,
+	    std::function<void(SGObject*, std::string_view)> loader);
+#endif
+
+	/** Loads all parameters registered with set_lazy_parameters(). Members
+	 * that are used directly are only valid after their parameters have been
+	 * loaded, Machine::train() and the apply methods of machines hence call
+	 * this first.
+	 */
+	void load_lazy_parameters() const;
 protected:
 	/** Returns an empty instance of own type.
 	 *
@@ -1205,6 +1227,13 @@ private:
 	 */
 	const AnyParameter& get_function(const BaseTag& _tag) const;
 
+	/** Loads a parameter registered with set_lazy_parameters(), if it has
+	 * not been loaded yet.
+	 *
+	 * @param name name of the parameter
+	 */
+	void load_lazy_parameter(std::string_view name) const;
+
 	class Self;
 	std::unique_ptr<Self> self;
 
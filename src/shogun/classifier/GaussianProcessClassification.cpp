@@ -64,6 +64,7 @@ GaussianProcessClassification::~GaussianProcessClassification()
 
 std::shared_ptr<MulticlassLabels> GaussianProcessClassification::apply_multiclass(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	// check whether given combination of inference method and likelihood
 	// function supports classification
 	require(m_method, "Inference method should not be NULL");
@@ -103,6 +104,7 @@ std::shared_ptr<MulticlassLabels> GaussianProcessClassification::apply_multiclas
 std::shared_ptr<BinaryLabels> GaussianProcessClassification::apply_binary(
 		std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	// check whether given combination of inference method and likelihood
 	// function supports classification
 	require(m_method, "Inference method should not be NULL");
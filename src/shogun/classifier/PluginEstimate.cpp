@@ -89,6 +89,7 @@ bool PluginEstimate::train_machine(std::shared_ptr<Features> data)
 
 std::shared_ptr<BinaryLabels> PluginEstimate::apply_binary(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	if (data)
 	{
 		if (data->get_feature_class() != C_STRING ||
@@ -111,6 +112,7 @@ std::shared_ptr<BinaryLabels> PluginEstimate::apply_binary(std::shared_ptr<Featu
 
 float64_t PluginEstimate::apply_one(int32_t vec_idx)
 {
+	load_lazy_parameters();
 	ASSERT(features)
 
 	int32_t len;
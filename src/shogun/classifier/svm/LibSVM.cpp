@@ -42,6 +42,10 @@ void LibSVM::register_params()
 	    (machine_int_t*)&solver_type, "libsvm_solver_type",
 	    "LibSVM Solver type", ParameterProperties::SETTING,
 	    SG_OPTIONS(LIBSVM_C_SVC, LIBSVM_NU_SVC));
+	SG_ADD(
+	    &m_prefetch_size, "prefetch_size",
+	    "Number of kernel columns prefetched per iteration",
+	    ParameterProperties::SETTING);
 }
 
 bool LibSVM::train_machine(std::shared_ptr<Features> data)
@@ -130,6 +134,8 @@ bool LibSVM::train_machine(std::shared_ptr<Features> data)
 	param.nu = get_nu();
 	param.kernel=kernel.get();
 	param.cache_size = kernel->get_cache_size();
+	param.cache_precision = kernel->get_cache_precision();
+	param.prefetch_size = m_prefetch_size;
 	param.max_train_time = m_max_train_time;
 	param.C = get_C1();
 	param.eps = epsilon;
@@ -57,6 +57,18 @@ class LibSVM : public SVM
 		/** @return object name */
 		const char* get_name() const override { return "LibSVM"; }
 
+		/** set the number of kernel columns the solver prefetches on
+		 * background threads in each iteration. The columns are chosen
+		 * among the variables that violate the optimality conditions
+		 * the most, i.e. the likely next working sets.
+		 *
+		 * @param size number of columns, 0 disables prefetching
+		 */
+		void set_prefetch_size(int32_t size) { m_prefetch_size = size; }
+
+		/** @return number of prefetched kernel columns per iteration */
+		int32_t get_prefetch_size() const { return m_prefetch_size; }
+
 	private:
 		void register_params();
 
@@ -74,6 +86,9 @@ class LibSVM : public SVM
 	protected:
 		/** solver type */
 		LIBSVM_SOLVER_TYPE solver_type;
+
+		/** number of prefetched kernel columns per iteration */
+		int32_t m_prefetch_size = 0;
 };
 }
 #endif
@@ -98,12 +98,14 @@ WDSVMOcas::~WDSVMOcas()
 
 std::shared_ptr<BinaryLabels> WDSVMOcas::apply_binary(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	SGVector<float64_t> outputs = apply_get_outputs(data);
 	return std::make_shared<BinaryLabels>(outputs);
 }
 
 std::shared_ptr<RegressionLabels> WDSVMOcas::apply_regression(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	SGVector<float64_t> outputs = apply_get_outputs(data);
 	return std::make_shared<RegressionLabels>(outputs);
 }
@@ -113,9 +113,13 @@ bool Hierarchical::train_machine(std::shared_ptr<Features> data)
 	int32_t offs=0;
 	for (auto i : SG_PROGRESS(range(0, num)))
 	{
+		// the distances of vector i to all later vectors are stored
+		// consecutively, so they form a 1 x (num-i-1) block
+		SGMatrix<float64_t> block(distances+offs, 1, num-i-1, false);
+		distance->distance_block(i, 1, i+1, num-i-1, block);
+
 		for (int32_t j=i+1; j<num; j++)
 		{
-			distances[offs] = distance->distance(i, j);
 			index[offs].idx1 = i;
 			index[offs].idx2 = j;
 			offs++; // offs=i*(i+1)/2+j
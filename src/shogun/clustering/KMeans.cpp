@@ -12,28 +12,48 @@
 #include <shogun/distance/EuclideanDistance.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/lib/observers/ObservedValueTemplated.h>
+#include <shogun/mathematics/Math.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <algorithm>
+#include <limits>
 #include <utility>
 
 using namespace Eigen;
 using namespace shogun;
 
+namespace
+{
+	/** euclidean distance between column i of a and column j of b */
+	float64_t column_distance(
+	    const SGMatrix<float64_t>& a, index_t i, const SGMatrix<float64_t>& b,
+	    index_t j)
+	{
+		float64_t dist = 0;
+		for (index_t l = 0; l < a.num_rows; l++)
+			dist += Math::sq(a(l, i) - b(l, j));
+		return std::sqrt(dist);
+	}
+}
+
 
 namespace shogun
 {
 
 KMeans::KMeans():KMeansBase()
 {
+	init_kmeans_params();
 }
 
 KMeans::KMeans(int32_t k_i, std::shared_ptr<Distance> d_i, bool use_kmpp_i):KMeansBase(k_i, std::move(d_i), use_kmpp_i)
 {
+	init_kmeans_params();
 }
 
 KMeans::KMeans(int32_t k_i, std::shared_ptr<Distance> d_i, SGMatrix<float64_t> centers_i):KMeansBase(k_i, std::move(d_i), centers_i)
 {
+	init_kmeans_params();
 }
 
 KMeans::~KMeans()
@@ -179,10 +199,187 @@ void KMeans::Lloyd_KMeans(SGMatrix<float64_t> centers, int32_t num_centers)
 
 }
 
+void KMeans::Hamerly_KMeans(SGMatrix<float64_t> centers, int32_t num_centers)
+{
+	auto euclidean = std::dynamic_pointer_cast<EuclideanDistance>(distance);
+	require(
+	    euclidean && !euclidean->get_disable_sqrt(),
+	    "Hamerly's KMeans requires a euclidean distance, got {}.",
+	    distance->get_name());
+	require(
+	    !fixed_centers, "Hamerly's KMeans does not support fixed centers.");
+
+	auto lhs =
+		std::dynamic_pointer_cast<DenseFeatures<float64_t>>(distance->get_lhs());
+
+	int32_t lhs_size=lhs->get_num_vectors();
+
+	auto rhs_cache = distance->get_rhs();
+
+	SGVector<int32_t> cluster_assignments=SGVector<int32_t>(lhs_size);
+	cluster_assignments.zero();
+
+	/* Upper bound on the distance of each point to its center */
+	SGVector<float64_t> upper_bounds(lhs_size);
+	/* Lower bound on the distance of each point to all other centers */
+	SGVector<float64_t> lower_bounds(lhs_size);
+	/* Half the distance of each center to its closest other center */
+	SGVector<float64_t> half_center_dists(num_centers);
+	/* Distance each center moved in the last update step */
+	SGVector<float64_t> center_shifts(num_centers);
+	/* Weights : Number of points in each cluster */
+	SGVector<int64_t> weights_set(num_centers);
+
+	distance->precompute_lhs();
+	distance->replace_rhs(
+	    std::make_shared<DenseFeatures<float64_t>>(centers.clone()));
+
+	/* Computes the distances of point i to all centers, sets its bounds
+	 * and returns its closest center */
+	auto assign_point = [&](int32_t i) {
+		int32_t min_cluster=0;
+		float64_t min_dist=distance->distance(i, 0);
+		float64_t second_dist=std::numeric_limits<float64_t>::infinity();
+		for (int32_t j=1; j<num_centers; j++)
+		{
+			float64_t dist=distance->distance(i, j);
+			if (dist<min_dist)
+			{
+				second_dist=min_dist;
+				min_dist=dist;
+				min_cluster=j;
+			}
+			else if (dist<second_dist)
+				second_dist=dist;
+		}
+		upper_bounds[i]=min_dist;
+		lower_bounds[i]=second_dist;
+		return min_cluster;
+	};
+
+	int32_t changed=1;
+
+	for (auto iter : SG_PROGRESS(range(max_iter)))
+	{
+		if (iter==max_iter-1)
+			io::warn("KMeans clustering has reached maximum number of ( {} ) iterations without having converged. \
+				   	Terminating. ", iter);
+
+		changed=0;
+
+		if (iter>0)
+		{
+#pragma omp parallel for
+			for (int32_t j=0; j<num_centers; j++)
+			{
+				float64_t min_dist=std::numeric_limits<float64_t>::infinity();
+				for (int32_t l=0; l<num_centers; l++)
+				{
+					if (l!=j)
+						min_dist=std::min(
+						    min_dist, column_distance(centers, j, centers, l));
+				}
+				half_center_dists[j]=min_dist/2;
+			}
+		}
+
+#pragma omp parallel for reduction(+:changed)
+		/* Assigment step : Assign each point to nearest cluster, only
+		 * looking at the centers if the bounds do not rule out a change */
+		for (int32_t i=0; i<lhs_size; i++)
+		{
+			const int32_t cluster_assignments_i=cluster_assignments[i];
+			if (iter>0)
+			{
+				const float64_t bound=std::max(
+				    half_center_dists[cluster_assignments_i], lower_bounds[i]);
+				if (upper_bounds[i]<=bound)
+					continue;
+
+				upper_bounds[i]=distance->distance(i, cluster_assignments_i);
+				if (upper_bounds[i]<=bound)
+					continue;
+			}
+
+			const int32_t min_cluster=assign_point(i);
+			if (min_cluster!=cluster_assignments_i)
+			{
+				changed++;
+				cluster_assignments[i]=min_cluster;
+			}
+		}
+		if(changed==0)
+			break;
+
+		/* Update Step : Calculate new means */
+		auto old_centers=centers.clone();
+		centers.zero();
+		weights_set.zero();
+
+		for (int32_t i=0; i<lhs_size; i++)
+		{
+			int32_t cluster_i=cluster_assignments[i];
+
+			auto vec = lhs->get_feature_vector(i);
+			linalg::add_col_vec(centers, cluster_i, vec, centers);
+			lhs->free_feature_vector(vec, i);
+			++weights_set[cluster_i];
+		}
+
+		for (int32_t i=0; i<num_centers; i++)
+		{
+			if (weights_set[i]!=0)
+			{
+				auto col = centers.get_column(i);
+				linalg::scale(col, col, 1.0 / weights_set[i]);
+			}
+		}
+
+		distance->replace_rhs(
+		    std::make_shared<DenseFeatures<float64_t>>(centers.clone()));
+
+		/* Move the bounds by the distance the centers moved */
+		int32_t max_shift_cluster=0;
+		float64_t max_shift=0;
+		float64_t second_shift=0;
+		for (int32_t j=0; j<num_centers; j++)
+		{
+			center_shifts[j]=column_distance(old_centers, j, centers, j);
+			if (center_shifts[j]>max_shift)
+			{
+				second_shift=max_shift;
+				max_shift=center_shifts[j];
+				max_shift_cluster=j;
+			}
+			else if (center_shifts[j]>second_shift)
+				second_shift=center_shifts[j];
+		}
+
+#pragma omp parallel for
+		for (int32_t i=0; i<lhs_size; i++)
+		{
+			const int32_t cluster_i=cluster_assignments[i];
+			upper_bounds[i]+=center_shifts[cluster_i];
+			lower_bounds[i]-=
+			    cluster_i==max_shift_cluster ? second_shift : max_shift;
+		}
+
+		observe<SGMatrix<float64_t>>(iter, "cluster_centers");
+
+		if (iter%std::max(1, max_iter/10) == 0)
+			io::info("Iteration[{}/{}]: Assignment of {} patterns changed.", iter, max_iter, changed);
+	}
+	distance->reset_precompute();
+	distance->replace_rhs(rhs_cache);
+}
+
 bool KMeans::train_machine(std::shared_ptr<Features> data)
 {
 	initialize_training(data);
-	Lloyd_KMeans(cluster_centers, k);
+	if (m_method==KMM_HAMERLY)
+		Hamerly_KMeans(cluster_centers, k);
+	else
+		Lloyd_KMeans(cluster_centers, k);
 	compute_cluster_variances();
 	auto cluster_centres =
 		std::make_shared<DenseFeatures<float64_t>>(cluster_centers);
@@ -190,5 +387,14 @@ bool KMeans::train_machine(std::shared_ptr<Features> data)
 	return true;
 }
 
+void KMeans::init_kmeans_params()
+{
+	m_method=KMM_LLOYD;
+
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_method, "kmeans_method",
+	    "Method used for training", ParameterProperties::HYPER,
+	    SG_OPTIONS(KMM_LLOYD, KMM_HAMERLY));
 }
 
+}
@@ -21,6 +21,18 @@ namespace shogun
 {
 class KMeansBase;
 
+/** method used by KMeans to assign points to clusters */
+enum EKMeansMethod
+{
+	/** Lloyd's algorithm, computes all point to center distances in each
+	 * iteration */
+	KMM_LLOYD,
+	/** Hamerly's algorithm, skips distance computations that cannot change
+	 * the assignment using triangle inequality bounds. Requires euclidean
+	 * distance */
+	KMM_HAMERLY
+};
+
 /** @brief KMeans clustering,  partitions the data into k (a-priori specified) clusters.
  *
  * It minimizes
@@ -35,6 +47,11 @@ class KMeansBase;
  *
  * To use mini-batch based training was see KMeansMiniBatch 
  *
+ * Setting the method to KMM_HAMERLY maintains an upper bound on the distance
+ * of each point to its center and a lower bound on the distance to all other
+ * centers, so that most distance computations are skipped once the clusters
+ * stabilize. It finds the same clustering as Lloyd's algorithm.
+ *
  * cf. http://en.wikipedia.org/wiki/K-means_algorithm
  * cf. http://en.wikipedia.org/wiki/Lloyd's_algorithm
  *
@@ -67,7 +84,14 @@ class KMeans : public KMeansBase
 		/** @return object name */
 		const char* get_name() const override { return "KMeans"; }		
 
+		/** @return method used for training */
+		EKMeansMethod get_kmeans_method() const { return m_method; }
+
+		/** @param method method used for training */
+		void set_kmeans_method(EKMeansMethod method) { m_method = method; }
+
 	private:
+		void init_kmeans_params();
 
 		/** train k-means
 		 *
@@ -82,6 +106,16 @@ class KMeans : public KMeansBase
 		/** Lloyd's KMeans training method
 		 */
 		void Lloyd_KMeans(SGMatrix<float64_t> centers, int32_t num_centers);
+
+		/** Hamerly's accelerated KMeans training method
+		 *
+		 * G. Hamerly. Making k-means even faster. SDM 2010.
+		 */
+		void Hamerly_KMeans(SGMatrix<float64_t> centers, int32_t num_centers);
+
+	protected:
+		/** Method used for training */
+		EKMeansMethod m_method;
 };
 }
 #endif
@@ -15,7 +15,9 @@
 #include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
+#include <limits>
 #include <utility>
+#include <vector>
 
 using namespace shogun;
 using namespace Eigen;
@@ -158,9 +160,16 @@ void KMeansBase::initialize_training(const std::shared_ptr<Features>& data)
 	require(lhs_size>0, "Lhs features should not be empty");
 	require(dimensions>0, "Lhs features should have more than zero dimensions");
 
+	require(
+	    !(use_kmeanspp && use_kmeans_parallel),
+	    "Only one of kmeans++ and k-means|| can be used to initialize the "
+	    "centers");
+
 	/* if kmeans++ to be used */
 	if (use_kmeanspp)
 		initial_centers = kmeanspp();
+	else if (use_kmeans_parallel)
+		initial_centers = kmeans_parallel();
 
 	R=SGVector<float64_t>(k);
 
@@ -292,6 +301,155 @@ SGMatrix<float64_t> KMeansBase::kmeanspp()
 	return centers;
 }
 
+SGMatrix<float64_t> KMeansBase::kmeans_parallel()
+{
+	require(
+	    oversampling_factor > 0,
+	    "Oversampling factor ({}) must be greater than 0",
+	    oversampling_factor);
+	require(
+	    kmeans_parallel_rounds >= 0,
+	    "Number of k-means|| rounds ({}) must not be negative",
+	    kmeans_parallel_rounds);
+
+	auto lhs=distance->get_lhs()->as<DenseFeatures<float64_t>>();
+	int32_t lhs_size=lhs->get_num_vectors();
+	require(
+	    lhs_size >= k, "Number of vectors ({}) must be at least k ({})",
+	    lhs_size, k);
+	const float64_t oversampling=oversampling_factor*k;
+
+	/* Indices of the candidate centers */
+	std::vector<int32_t> candidates;
+	/* Whether a point is a candidate */
+	std::vector<bool> is_candidate(lhs_size, false);
+	/* Squared distance of each point to its closest candidate */
+	SGVector<float64_t> min_dist(lhs_size);
+	min_dist.set_const(std::numeric_limits<float64_t>::infinity());
+	/* Position in candidates of the closest candidate of each point */
+	SGVector<int32_t> closest(lhs_size);
+	closest.zero();
+
+	UniformIntDistribution<int32_t> uniform_int_dist(0, lhs_size-1);
+	UniformRealDistribution<float64_t> uniform_real_dist(0.0, 1.0);
+
+	/* First candidate is chosen at random */
+	int32_t mu=uniform_int_dist(m_prng);
+	candidates.push_back(mu);
+	is_candidate[mu]=true;
+
+	distance->precompute_lhs();
+	distance->precompute_rhs();
+
+	int32_t num_seen=0;
+	for (int32_t round=0; round<=kmeans_parallel_rounds; round++)
+	{
+		/* Account for the candidates added in the previous round */
+		const int32_t num_candidates=candidates.size();
+#pragma omp parallel for
+		for (int32_t i=0; i<lhs_size; i++)
+		{
+			for (int32_t c=num_seen; c<num_candidates; c++)
+			{
+				float64_t dist=Math::sq(distance->distance(i, candidates[c]));
+				if (dist<min_dist[i])
+				{
+					min_dist[i]=dist;
+					closest[i]=c;
+				}
+			}
+		}
+		num_seen=num_candidates;
+
+		if (round==kmeans_parallel_rounds)
+			break;
+
+		float64_t cost=linalg::sum(min_dist);
+		if (cost==0)
+			break;
+
+		/* Sample every point independently with probability proportional to
+		 * its squared distance */
+		for (int32_t i=0; i<lhs_size; i++)
+		{
+			if (uniform_real_dist(m_prng)*cost < oversampling*min_dist[i])
+			{
+				candidates.push_back(i);
+				is_candidate[i]=true;
+			}
+		}
+	}
+
+	SGMatrix<float64_t> centers=SGMatrix<float64_t>(dimensions, k);
+
+	/* Not enough distinct candidates, fill up with random points */
+	if (int32_t(candidates.size())<=k)
+	{
+		for (int32_t i=candidates.size(); i<k; i++)
+		{
+			do
+				mu=uniform_int_dist(m_prng);
+			while (is_candidate[mu]);
+			candidates.push_back(mu);
+			is_candidate[mu]=true;
+		}
+
+		for (int32_t i=0; i<k; i++)
+		{
+			SGVector<float64_t> vec=lhs->get_feature_vector(candidates[i]);
+			centers.set_column(i, vec);
+			lhs->free_feature_vector(vec, candidates[i]);
+		}
+		distance->reset_precompute();
+		return centers;
+	}
+
+	/* Weight candidates by the number of points closest to them */
+	const int32_t num_candidates=candidates.size();
+	SGVector<float64_t> weights(num_candidates);
+	weights.zero();
+	for (int32_t i=0; i<lhs_size; i++)
+		weights[closest[i]]++;
+
+	/* Recluster the weighted candidates with K-Means++ */
+	SGVector<float64_t> cand_min_dist(num_candidates);
+	cand_min_dist.set_const(std::numeric_limits<float64_t>::infinity());
+	SGVector<float64_t> cand_probs=weights.clone();
+
+	for (int32_t i=0; i<k; i++)
+	{
+		float64_t prob=uniform_real_dist(m_prng)*linalg::sum(cand_probs);
+		float64_t temp_sum=0.0;
+		int32_t center=0;
+		for (int32_t c=0; c<num_candidates; c++)
+		{
+			temp_sum+=cand_probs[c];
+			if (prob<=temp_sum)
+			{
+				center=c;
+				break;
+			}
+		}
+
+		SGVector<float64_t> vec=lhs->get_feature_vector(candidates[center]);
+		centers.set_column(i, vec);
+		lhs->free_feature_vector(vec, candidates[center]);
+
+#pragma omp parallel for
+		for (int32_t c=0; c<num_candidates; c++)
+		{
+			float64_t dist=Math::sq(
+			    distance->distance(candidates[c], candidates[center]));
+			cand_min_dist[c]=Math::min(dist, cand_min_dist[c]);
+			cand_probs[c]=weights[c]*cand_min_dist[c];
+		}
+	}
+
+	distance->reset_precompute();
+
+	return centers;
+}
+
 void KMeansBase::init()
 {
 	max_iter = 300;
@@ -299,6 +457,9 @@ void KMeansBase::init()
 	dimensions = 0;
 	fixed_centers = false;
 	use_kmeanspp = false;
+	use_kmeans_parallel = false;
+	oversampling_factor = 2.0;
+	kmeans_parallel_rounds = 5;
 	initial_centers = SGMatrix<float64_t>();
 	SG_ADD(
 	    &max_iter, "max_iter", "Maximum number of iterations",
@@ -317,6 +478,18 @@ void KMeansBase::init()
 	SG_ADD(
 	    &use_kmeanspp, "kmeanspp", "Whether to use kmeans++",
 	    ParameterProperties::HYPER | ParameterProperties::SETTING);
+	SG_ADD(
+	    &use_kmeans_parallel, "kmeans_parallel",
+	    "Whether to use k-means|| (scalable kmeans++)",
+	    ParameterProperties::HYPER | ParameterProperties::SETTING);
+	SG_ADD(
+	    &oversampling_factor, "oversampling_factor",
+	    "Candidates sampled per k-means|| round, relative to k",
+	    ParameterProperties::HYPER | ParameterProperties::SETTING);
+	SG_ADD(
+	    &kmeans_parallel_rounds, "kmeans_parallel_rounds",
+	    "Number of k-means|| sampling rounds",
+	    ParameterProperties::HYPER | ParameterProperties::SETTING);
 	watch_method("cluster_centers", &KMeansBase::get_cluster_centers);
 	SG_ADD(
 	    &initial_centers, "initial_centers", "Initial centers",
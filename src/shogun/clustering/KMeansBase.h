@@ -100,6 +100,19 @@ class KMeansBase : public RandomMixin<DistanceMachine>
 		*/
 		SGMatrix<float64_t> kmeanspp();
 
+		/** Scalable K-Means++ (k-means||) algorithm to initialize cluster
+		 * centers. Oversamples candidate centers in a few rounds, each
+		 * picking every point independently with probability proportional
+		 * to its squared distance to the candidates so far, and reduces
+		 * the candidates to k centers with K-Means++ weighted by the number
+		 * of points closest to each candidate.
+		 *
+		 * B. Bahmani et al. Scalable K-Means++. VLDB 2012.
+		 *
+		 * @return initial cluster centers: matrix (k columns, dim rows)
+		 */
+		SGMatrix<float64_t> kmeans_parallel();
+
 		/**
 		 * Init the model (register params)
 		 */
@@ -135,6 +148,16 @@ class KMeansBase : public RandomMixin<DistanceMachine>
 		/** Flag to check if kmeans++ has to be used */
 		bool use_kmeanspp;
 
+		/** Flag to check if k-means|| has to be used, excludes kmeans++ */
+		bool use_kmeans_parallel;
+
+		/** Expected number of candidates sampled per k-means|| round,
+		 * relative to k */
+		float64_t oversampling_factor;
+
+		/** Number of k-means|| sampling rounds */
+		int32_t kmeans_parallel_rounds;
+
 		/** Cluster centers */
 		SGMatrix<float64_t> cluster_centers;
 };
@@ -58,3 +58,13 @@ float64_t ChebyshewMetric::compute(int32_t idx_a, int32_t idx_b)
 
 	return result;
 }
+
+void ChebyshewMetric::distance_block(index_t lhs_begin, index_t lhs_size,
+		index_t rhs_begin, index_t rhs_size, SGMatrix<float64_t>& result)
+{
+	compute_block(lhs_begin, lhs_size, rhs_begin, rhs_size, result,
+		[](const auto& a, const auto& b)
+		{
+			return a.size() ? Math::max(DBL_MIN, (a-b).abs().maxCoeff()) : DBL_MIN;
+		});
+}
@@ -67,3 +67,14 @@ float64_t ChiSquareDistance::compute(int32_t idx_a, int32_t idx_b)
 
 	return result;
 }
+
+void ChiSquareDistance::distance_block(index_t lhs_begin, index_t lhs_size,
+		index_t rhs_begin, index_t rhs_size, SGMatrix<float64_t>& result)
+{
+	compute_block(lhs_begin, lhs_size, rhs_begin, rhs_size, result,
+		[](const auto& a, const auto& b)
+		{
+			auto abs_sum=a.abs()+b.abs();
+			return (abs_sum!=0).select((a-b).square()/abs_sum, 0.0).sum();
+		});
+}
@@ -65,6 +65,20 @@ class ChiSquareDistance: public DenseDistance<float64_t>
 		 */
 		const char* get_name() const override { return "ChiSquareDistance"; }
 
+		/** get distances between a block of lhs and a block of rhs
+		 * feature vectors. For every pair, (x_i-y_i)^2/(|x_i|+|y_i|) is
+		 * summed over the coordinates with a nonzero denominator, masked
+		 * instead of branching per coordinate.
+		 *
+		 * @param lhs_begin index of the first lhs feature vector
+		 * @param lhs_size number of lhs feature vectors
+		 * @param rhs_begin index of the first rhs feature vector
+		 * @param rhs_size number of rhs feature vectors
+		 * @param result lhs_size x rhs_size matrix receiving the distances
+		 */
+		void distance_block(index_t lhs_begin, index_t lhs_size,
+				index_t rhs_begin, index_t rhs_size, SGMatrix<float64_t>& result) override;
+
 	protected:
 		/// compute distance for features a and b
 		/// idx_{a,b} denote the index of the feature vectors
@@ -9,6 +9,8 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/distance/CosineDistance.h>
 #include <shogun/features/Features.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 using namespace shogun;
 
@@ -76,3 +78,37 @@ float64_t CosineDistance::compute(int32_t idx_a, int32_t idx_b)
 	else
 		return s ;
 }
+
+void CosineDistance::distance_block(index_t lhs_begin, index_t lhs_size,
+		index_t rhs_begin, index_t rhs_size, SGMatrix<float64_t>& result)
+{
+	if (precompute_matrix)
+	{
+		Distance::distance_block(lhs_begin, lhs_size, rhs_begin, rhs_size, result);
+		return;
+	}
+	check_block(lhs_begin, lhs_size, rhs_begin, rhs_size, result);
+
+	auto l=lhs->as<DenseFeatures<float64_t>>()->get_feature_matrix_block(lhs_begin, lhs_size);
+	auto r=rhs->as<DenseFeatures<float64_t>>()->get_feature_matrix_block(rhs_begin, rhs_size);
+	require(l.num_rows==r.num_rows,
+			"Dimension of lhs ({}) and rhs ({}) vectors differ", l.num_rows, r.num_rows);
+
+	linalg::matrix_prod(l, r, result, true, false);
+
+	SGVector<float64_t> lhs_norms(lhs_size);
+	for (index_t i=0; i<lhs_size; i++)
+		lhs_norms[i]=linalg::norm(SGVector<float64_t>(l.get_column_vector(i), l.num_rows, false));
+
+	for (index_t j=0; j<rhs_size; j++)
+	{
+		const float64_t rhs_norm=linalg::norm(
+				SGVector<float64_t>(r.get_column_vector(j), r.num_rows, false));
+		for (index_t i=0; i<lhs_size; i++)
+		{
+			// same as compute()
+			float64_t s=lhs_norms[i]*rhs_norm;
+			result(i, j)=s==0 ? 0 : Math::max(1-result(i, j)/s, 0.0);
+		}
+	}
+}
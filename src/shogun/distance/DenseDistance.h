@@ -13,6 +13,7 @@
 #include <shogun/features/FeatureTypes.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/mathematics/eigen3.h>
 
 #define IGNORE_IN_CLASSLIST
 
@@ -60,6 +61,52 @@ IGNORE_IN_CLASSLIST template <class ST> class DenseDistance : public Distance
 		 * @return distance type
 		 */
 		EDistanceType get_distance_type() override =0;
+
+	protected:
+		/** evaluates a distance function of two feature vectors on all
+		 * pairs of a block of lhs and rhs vectors, see distance_block().
+		 * The vectors are passed as Eigen arrays, so that element-wise
+		 * expressions in the function are vectorized by Eigen for the
+		 * instruction set (SSE2, AVX2, AVX-512) enabled at compile time.
+		 *
+		 * @param lhs_begin index of the first lhs feature vector
+		 * @param lhs_size number of lhs feature vectors
+		 * @param rhs_begin index of the first rhs feature vector
+		 * @param rhs_size number of rhs feature vectors
+		 * @param result lhs_size x rhs_size matrix receiving the distances
+		 * @param dist distance function of two Eigen arrays
+		 */
+		template <class F>
+		void compute_block(index_t lhs_begin, index_t lhs_size,
+				index_t rhs_begin, index_t rhs_size,
+				SGMatrix<float64_t>& result, F dist)
+		{
+			if (this->precompute_matrix)
+			{
+				Distance::distance_block(lhs_begin, lhs_size, rhs_begin, rhs_size, result);
+				return;
+			}
+			this->check_block(lhs_begin, lhs_size, rhs_begin, rhs_size, result);
+
+			using Array = Eigen::Array<ST, Eigen::Dynamic, 1>;
+			auto l=this->lhs->template as<DenseFeatures<ST>>()
+					->get_feature_matrix_block(lhs_begin, lhs_size);
+			auto r=this->rhs->template as<DenseFeatures<ST>>()
+					->get_feature_matrix_block(rhs_begin, rhs_size);
+			require(l.num_rows==r.num_rows,
+					"Dimension of lhs ({}) and rhs ({}) vectors differ",
+					l.num_rows, r.num_rows);
+
+			for (index_t j=0; j<rhs_size; j++)
+			{
+				Eigen::Map<const Array> b(r.get_column_vector(j), r.num_rows);
+				for (index_t i=0; i<lhs_size; i++)
+				{
+					Eigen::Map<const Array> a(l.get_column_vector(i), l.num_rows);
+					result(i, j)=dist(a, b);
+				}
+			}
+		}
 };
 } // namespace shogun
 #endif
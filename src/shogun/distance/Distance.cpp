@@ -35,6 +35,13 @@
 
 using namespace shogun;
 
+namespace
+{
+	/** number of lhs and rhs vectors in a tile of the distance matrix that
+	 * is computed by a single call of distance_block */
+	const index_t DISTANCE_TILE_SIZE = 256;
+}
+
 Distance::Distance() : SGObject()
 {
 	init();
@@ -219,6 +226,33 @@ float64_t Distance::distance(int32_t idx_a, int32_t idx_b)
 	return compute(idx_a, idx_b);
 }
 
+void Distance::distance_block(index_t lhs_begin, index_t lhs_size,
+		index_t rhs_begin, index_t rhs_size, SGMatrix<float64_t>& result)
+{
+	check_block(lhs_begin, lhs_size, rhs_begin, rhs_size, result);
+
+	for (index_t j=0; j<rhs_size; j++)
+	{
+		for (index_t i=0; i<lhs_size; i++)
+			result(i, j)=distance(lhs_begin+i, rhs_begin+j);
+	}
+}
+
+void Distance::check_block(index_t lhs_begin, index_t lhs_size,
+		index_t rhs_begin, index_t rhs_size, const SGMatrix<float64_t>& result)
+{
+	require(has_features(), "No features assigned to distance");
+	require(lhs_begin>=0 && lhs_size>=0 && lhs_begin+lhs_size<=lhs->get_num_vectors(),
+			"lhs block [{}, {}) exceeds the {} lhs vectors",
+			lhs_begin, lhs_begin+lhs_size, lhs->get_num_vectors());
+	require(rhs_begin>=0 && rhs_size>=0 && rhs_begin+rhs_size<=rhs->get_num_vectors(),
+			"rhs block [{}, {}) exceeds the {} rhs vectors",
+			rhs_begin, rhs_begin+rhs_size, rhs->get_num_vectors());
+	require(result.num_rows==lhs_size && result.num_cols==rhs_size,
+			"Result matrix ({}x{}) must be of size {}x{}",
+			result.num_rows, result.num_cols, lhs_size, rhs_size);
+}
+
 void Distance::run_distance_rhs(SGVector<float64_t>& result, const index_t idx_r_start, index_t idx_start, const index_t idx_stop, const index_t idx_a)
 {
 	for(index_t i=idx_r_start; idx_start < idx_stop; ++i,++idx_start)
@@ -267,82 +301,63 @@ void Distance::init()
 template <class T>
 SGMatrix<T> Distance::get_distance_matrix()
 {
-	T* result = NULL;
-
 	require(has_features(), "no features assigned to distance");
 	init(lhs, rhs);
 
-	int32_t m=get_num_vec_lhs();
-	int32_t n=get_num_vec_rhs();
-
-	int64_t total_num = int64_t(m)*n;
-	int64_t total=0;
+	const index_t m=get_num_vec_lhs();
+	const index_t n=get_num_vec_rhs();
 
 	// if lhs == rhs and sizes match assume k(i,j)=k(j,i)
-	bool symmetric= (lhs && lhs==rhs && m==n);
+	const bool symmetric= (lhs && lhs==rhs && m==n);
 
 	SG_DEBUG("returning distance matrix of size {}x{}", m, n)
 
-	result=SG_MALLOC(T, total_num);
+	SGMatrix<T> result(m, n);
+
+	const index_t num_row_tiles=(m+DISTANCE_TILE_SIZE-1)/DISTANCE_TILE_SIZE;
+	const index_t num_col_tiles=(n+DISTANCE_TILE_SIZE-1)/DISTANCE_TILE_SIZE;
+	const int64_t num_tiles=int64_t(num_row_tiles)*num_col_tiles;
 
 	PRange<int64_t> pb = PRange<int64_t>(
-	    range(total_num), "PROGRESS: ", UTF8, []() { return true; });
-	int32_t num_threads;
-	int64_t step;
-	#pragma omp parallel shared(num_threads, step)
+	    range(num_tiles), "PROGRESS: ", UTF8, []() { return true; });
+#pragma omp parallel
 	{
-#ifdef HAVE_OPENMP
-		#pragma omp single
-		{
-			num_threads=omp_get_num_threads();
-			step=total_num/num_threads;
-			num_threads--;
-		}
-		int32_t thread_num=omp_get_thread_num();
-#else
-		num_threads=0;
-		step=total_num;
-		int32_t thread_num=0;
-#endif
-		bool verbose=(thread_num == 0);
+		SGMatrix<float64_t> buffer(
+			std::min(DISTANCE_TILE_SIZE, m), std::min(DISTANCE_TILE_SIZE, n));
 
-		int32_t start=compute_row_start(thread_num*step, n, symmetric);
-		int32_t end=(thread_num==num_threads) ? m : compute_row_start((thread_num+1)*step, n, symmetric);
-
-		for (int32_t i=start; i<end; i++)
+#pragma omp for schedule(dynamic)
+		for (int64_t tile=0; tile<num_tiles; tile++)
 		{
-			int32_t j_start=0;
+			const index_t row_start=(tile/num_col_tiles)*DISTANCE_TILE_SIZE;
+			const index_t col_start=(tile%num_col_tiles)*DISTANCE_TILE_SIZE;
+			if (symmetric && col_start<row_start)
+				continue;
 
-			if (symmetric)
-				j_start=i;
+			const index_t row_len=std::min(DISTANCE_TILE_SIZE, m-row_start);
+			const index_t col_len=std::min(DISTANCE_TILE_SIZE, n-col_start);
+			SGMatrix<float64_t> block(buffer.matrix, row_len, col_len, false);
+			distance_block(row_start, row_len, col_start, col_len, block);
 
-			for (int32_t j=j_start; j<n; j++)
+			for (index_t j=0; j<col_len; j++)
 			{
-				float64_t v=this->distance(i,j);
-				result[i+j*m]=v;
-
-				if (symmetric && i!=j)
-					result[j+i*m]=v;
-
-				if (verbose)
+				for (index_t i=0; i<row_len; i++)
 				{
-					total++;
-
-					if (symmetric && i!=j)
-						total++;
-
-					pb.print_progress();
-
-					// TODO: replace with new signal
-					// if (Signal::cancel_computations())
-					//	break;
+					const index_t row=row_start+i;
+					const index_t col=col_start+j;
+					if (symmetric && col<row)
+						continue;
+
+					result(row, col)=block(i, j);
+					if (symmetric)
+						result(col, row)=block(i, j);
 				}
 			}
+			pb.print_progress();
 		}
 	}
 	pb.complete();
 
-	return SGMatrix<T>(result,m,n,true);
+	return result;
 }
 
 template SGMatrix<float64_t> Distance::get_distance_matrix<float64_t>();
@@ -124,6 +124,21 @@ class Distance : public SGObject
 			return distance(idx_a, idx_b);
 		}
 
+		/** get distances between a block of consecutive lhs feature
+		 * vectors and a block of consecutive rhs feature vectors, i.e.
+		 * result(i,j)=distance(lhs_begin+i, rhs_begin+j).
+		 * Distances that can evaluate a whole block at once override
+		 * this, the default calls distance() for every pair.
+		 *
+		 * @param lhs_begin index of the first lhs feature vector
+		 * @param lhs_size number of lhs feature vectors
+		 * @param rhs_begin index of the first rhs feature vector
+		 * @param rhs_size number of rhs feature vectors
+		 * @param result lhs_size x rhs_size matrix receiving the distances
+		 */
+		virtual void distance_block(index_t lhs_begin, index_t lhs_size,
+				index_t rhs_begin, index_t rhs_size, SGMatrix<float64_t>& result);
+
 		/**
 		 * Precomputation related to features of right hand side
 		 * WARNING : Make sure to reset computations using reset_precompute()
@@ -369,6 +384,18 @@ class Distance : public SGObject
 		/// matrix precomputation
 		void do_precompute_matrix();
 
+		/** checks the arguments of distance_block()
+		 *
+		 * @param lhs_begin index of the first lhs feature vector
+		 * @param lhs_size number of lhs feature vectors
+		 * @param rhs_begin index of the first rhs feature vector
+		 * @param rhs_size number of rhs feature vectors
+		 * @param result matrix receiving the distances
+		 */
+		void check_block(index_t lhs_begin, index_t lhs_size,
+				index_t rhs_begin, index_t rhs_size,
+				const SGMatrix<float64_t>& result);
+
 		/**
 		 * Checks the compatibility between two supplied features
 		 *
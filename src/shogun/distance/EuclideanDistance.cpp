@@ -11,6 +11,7 @@
 #include <shogun/features/DotFeatures.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 using namespace shogun;
 
@@ -76,6 +77,43 @@ float64_t EuclideanDistance::compute(int32_t idx_a, int32_t idx_b)
 	return std::sqrt(result);
 }
 
+void EuclideanDistance::distance_block(index_t lhs_begin, index_t lhs_size,
+		index_t rhs_begin, index_t rhs_size, SGMatrix<float64_t>& result)
+{
+	const bool dense=lhs && rhs &&
+		lhs->get_feature_class()==C_DENSE && lhs->get_feature_type()==F_DREAL &&
+		rhs->get_feature_class()==C_DENSE && rhs->get_feature_type()==F_DREAL;
+	if (precompute_matrix || !dense)
+	{
+		Distance::distance_block(lhs_begin, lhs_size, rhs_begin, rhs_size, result);
+		return;
+	}
+	check_block(lhs_begin, lhs_size, rhs_begin, rhs_size, result);
+
+	auto l=lhs->as<DenseFeatures<float64_t>>()->get_feature_matrix_block(lhs_begin, lhs_size);
+	auto r=rhs->as<DenseFeatures<float64_t>>()->get_feature_matrix_block(rhs_begin, rhs_size);
+	linalg::matrix_prod(l, r, result, true, false);
+
+	for (index_t j=0; j<rhs_size; j++)
+	{
+		for (index_t i=0; i<lhs_size; i++)
+		{
+			// the product may differ from the squared norm in the last
+			// bits, which sqrt would turn into a visible self distance
+			if (lhs==rhs && lhs_begin+i==rhs_begin+j)
+			{
+				result(i, j)=0;
+				continue;
+			}
+
+			float64_t d=m_lhs_squared_norms[lhs_begin+i]+
+				m_rhs_squared_norms[rhs_begin+j]-2*result(i, j);
+			d=Math::max(d, 0.0);
+			result(i, j)=disable_sqrt ? d : std::sqrt(d);
+		}
+	}
+}
+
 void EuclideanDistance::precompute_lhs()
 {
 	require(lhs, "Left hand side feature cannot be NULL!");
@@ -130,6 +130,21 @@ public:
 	 */
 	float64_t distance_upper_bounded(int32_t idx_a, int32_t idx_b, float64_t upper_bound) override;
 
+	/** get distances between a block of lhs and a block of rhs
+	 * feature vectors. For dense real valued features,
+	 * ||x-y||^2=||x||^2+||y||^2-2<x,y> is expanded with the precomputed
+	 * squared norms, and the inner products are taken from a matrix
+	 * product. The self distances of lhs==rhs are set to zero.
+	 *
+	 * @param lhs_begin index of the first lhs feature vector
+	 * @param lhs_size number of lhs feature vectors
+	 * @param rhs_begin index of the first rhs feature vector
+	 * @param rhs_size number of rhs feature vectors
+	 * @param result lhs_size x rhs_size matrix receiving the distances
+	 */
+	void distance_block(index_t lhs_begin, index_t lhs_size,
+			index_t rhs_begin, index_t rhs_size, SGMatrix<float64_t>& result) override;
+
 	/**
 	 * Precomputation of squared norms for features of right hand side
 	 * WARNING : Make sure to reset computations using reset_precompute()
@@ -66,3 +66,10 @@ float64_t ManhattanMetric::compute(int32_t idx_a, int32_t idx_b)
 
 	return result;
 }
+
+void ManhattanMetric::distance_block(index_t lhs_begin, index_t lhs_size,
+		index_t rhs_begin, index_t rhs_size, SGMatrix<float64_t>& result)
+{
+	compute_block(lhs_begin, lhs_size, rhs_begin, rhs_size, result,
+		[](const auto& a, const auto& b) { return (a-b).abs().sum(); });
+}
@@ -79,6 +79,16 @@ float64_t MinkowskiMetric::compute(int32_t idx_a, int32_t idx_b)
 	return pow(result,1/k);
 }
 
+void MinkowskiMetric::distance_block(index_t lhs_begin, index_t lhs_size,
+		index_t rhs_begin, index_t rhs_size, SGMatrix<float64_t>& result)
+{
+	compute_block(lhs_begin, lhs_size, rhs_begin, rhs_size, result,
+		[this](const auto& a, const auto& b)
+		{
+			return std::pow((a-b).abs().pow(k).sum(), 1/k);
+		});
+}
+
 void MinkowskiMetric::init()
 {
 	k = 2.0;
@@ -78,6 +78,20 @@ class MinkowskiMetric: public DenseDistance<float64_t>
 		 */
 		const char* get_name() const override { return "MinkowskiMetric"; }
 
+		/** get distances between a block of lhs and a block of rhs
+		 * feature vectors. The k-th powers of the absolute coordinate
+		 * differences of a pair are summed as one array expression, then
+		 * the k-th root is taken once per pair.
+		 *
+		 * @param lhs_begin index of the first lhs feature vector
+		 * @param lhs_size number of lhs feature vectors
+		 * @param rhs_begin index of the first rhs feature vector
+		 * @param rhs_size number of rhs feature vectors
+		 * @param result lhs_size x rhs_size matrix receiving the distances
+		 */
+		void distance_block(index_t lhs_begin, index_t lhs_size,
+				index_t rhs_begin, index_t rhs_size, SGMatrix<float64_t>& result) override;
+
 	protected:
 		/// compute distance for features a and b
 		/// idx_{a,b} denote the index of the feature vectors
@@ -7,6 +7,7 @@
  */
 #include <shogun/distributions/HMM.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/config.h>
@@ -20,7 +21,11 @@
 #include <stdio.h>
 #include <time.h>
 #include <ctype.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <thread>
+#include <vector>
 
 #include <utility>
 
@@ -719,21 +724,10 @@ float64_t HMM::forward_comp(int32_t time, int32_t state, int32_t dimension)
 			alpha[i] = get_p(i) + get_b(i, p_observations->get_feature(dimension,0)) ;
 
 		//induction		alpha_t+1(j) = (sum_i=1^N alpha_t(i)a_ij) b_j(O_t+1)
+		std::vector<float64_t> scaled(N);
 		for (int32_t t=1; t<time && t < p_observations->get_vector_length(dimension); t++)
 		{
-
-			for (int32_t j=0; j<N; j++)
-			{
-				int32_t i, num = trans_list_forward_cnt[j] ;
-				float64_t sum=-Math::INFTY;
-				for (i=0; i < num; i++)
-				{
-					int32_t ii = trans_list_forward[j][i] ;
-					sum = Math::logarithmic_sum(sum, alpha[ii] + get_a(ii,j));
-				} ;
-
-				alpha_new[j]= sum + get_b(j, p_observations->get_feature(dimension,t));
-			}
+			forward_step(alpha, alpha_new, p_observations->get_feature(dimension,t), scaled.data());
 
 			if (!ALPHA_CACHE(dimension).table)
 			{
@@ -956,19 +950,10 @@ float64_t HMM::backward_comp(int32_t time, int32_t state, int32_t dimension)
 	beta[i]=get_q(i);
 
       //induction		beta_t(i) = (sum_j=1^N a_ij*b_j(O_t+1)*beta_t+1(j)
+      std::vector<float64_t> scaled(N);
       for (int32_t t=p_observations->get_vector_length(dimension)-1; t>time+1 && t>0; t--)
 	{
-	  for (int32_t i=0; i<N; i++)
-	    {
-	      int32_t j, num=trans_list_backward_cnt[i] ;
-	      float64_t sum=-Math::INFTY;
-	      for (j=0; j<num; j++)
-		{
-		  int32_t jj = trans_list_backward[i][j] ;
-		  sum= Math::logarithmic_sum(sum, get_a(i, jj) + get_b(jj, p_observations->get_feature(dimension,t)) + beta[jj]);
-		} ;
-	      beta_new[i]=sum;
-	    }
+	  backward_step(beta, beta_new, p_observations->get_feature(dimension,t), scaled.data());
 
 	  if (!BETA_CACHE(dimension).table)
 	    {
@@ -1188,10 +1173,14 @@ float64_t HMM::best_path(int32_t dimension)
 		float64_t* delta= ARRAYN2(dimension);
 		float64_t* delta_new= ARRAYN1(dimension);
 
+		int32_t len;
+		bool free_vec;
+		uint16_t* obs=p_observations->get_feature_vector(dimension, len, free_vec);
+
 		{ //initialization
 			for (int32_t i=0; i<N; i++)
 			{
-				delta[i]=get_p(i)+get_b(i, p_observations->get_feature(dimension,0));
+				delta[i]=get_p(i)+get_b(i, obs[0]);
 				set_psi(0, i, 0, dimension);
 			}
 		}
@@ -1200,7 +1189,7 @@ float64_t HMM::best_path(int32_t dimension)
 		float64_t worst=-Math::INFTY/4 ;
 #endif
 		//recursion
-		for (int32_t t=1; t<p_observations->get_vector_length(dimension); t++)
+		for (int32_t t=1; t<len; t++)
 		{
 			float64_t* dummy;
 			int32_t NN=N ;
@@ -1223,10 +1212,10 @@ float64_t HMM::best_path(int32_t dimension)
 #ifdef FIX_POS
 				if ((!model) || (model->get_fix_pos_state(t,j,NN)!=Model::FIX_DISALLOWED))
 #endif
-					delta_new[j]=maxj + get_b(j,p_observations->get_feature(dimension,t));
+					delta_new[j]=maxj + get_b(j,obs[t]);
 #ifdef FIX_POS
 				else
-					delta_new[j]=maxj + get_b(j,p_observations->get_feature(dimension,t)) + Model::DISALLOWED_PENALTY;
+					delta_new[j]=maxj + get_b(j,obs[t]) + Model::DISALLOWED_PENALTY;
 #endif
 				set_psi(t, j, argmax, dimension);
 			}
@@ -1265,22 +1254,210 @@ float64_t HMM::best_path(int32_t dimension)
 				}
 			}
 			pat_prob=maxj;
-			PATH(dimension)[p_observations->get_vector_length(dimension)-1]=argmax;
+			PATH(dimension)[len-1]=argmax;
 		} ;
 
 
 		{ //state sequence backtracking
-			for (int32_t t=p_observations->get_vector_length(dimension)-1; t>0; t--)
+			for (int32_t t=len-1; t>0; t--)
 			{
 				PATH(dimension)[t-1]=get_psi(t, PATH(dimension)[t], dimension);
 			}
 		}
+		p_observations->free_feature_vector(obs, dimension, free_vec);
+
 		PATH_PROB_UPDATED(dimension)=true;
 		PATH_PROB_DIMENSION(dimension)=dimension;
 		return pat_prob ;
 	}
 }
 
+void HMM::forward_step(
+	const float64_t* alpha, float64_t* alpha_new, uint16_t o,
+	float64_t* scaled) const
+{
+	float64_t max_alpha=-Math::INFTY;
+	for (int32_t i=0; i<N; i++)
+		max_alpha=std::max(max_alpha, alpha[i]);
+
+	if (max_alpha==-Math::INFTY)
+	{
+		for (int32_t j=0; j<N; j++)
+			alpha_new[j]=-Math::INFTY;
+		return;
+	}
+
+	//sum_i exp(alpha(i)-max) a_ij for all j at once
+	for (int32_t i=0; i<N; i++)
+		scaled[i]=std::exp(alpha[i]-max_alpha);
+
+	Eigen::Map<const Eigen::MatrixXd> a(transition_matrix_exp.matrix, N, N);
+	Eigen::Map<Eigen::VectorXd> sums(alpha_new, N);
+	sums.noalias()=a.transpose()*Eigen::Map<const Eigen::VectorXd>(scaled, N);
+
+	for (int32_t j=0; j<N; j++)
+	{
+		float64_t sum;
+		if (alpha_new[j]>=std::numeric_limits<float64_t>::min())
+			sum=max_alpha+std::log(alpha_new[j]);
+		else
+		{
+			//underflow, sum in log space
+			int32_t num=trans_list_forward_cnt[j];
+			sum=-Math::INFTY;
+			for (int32_t i=0; i<num; i++)
+			{
+				int32_t ii=trans_list_forward[j][i];
+				sum=Math::logarithmic_sum(sum, alpha[ii]+get_a(ii,j));
+			}
+		}
+
+		alpha_new[j]=sum+get_b(j, o);
+	}
+}
+
+void HMM::backward_step(
+	const float64_t* beta, float64_t* beta_new, uint16_t o,
+	float64_t* scaled) const
+{
+	float64_t max_beta=-Math::INFTY;
+	for (int32_t j=0; j<N; j++)
+	{
+		scaled[j]=get_b(j, o)+beta[j];
+		max_beta=std::max(max_beta, scaled[j]);
+	}
+
+	if (max_beta==-Math::INFTY)
+	{
+		for (int32_t i=0; i<N; i++)
+			beta_new[i]=-Math::INFTY;
+		return;
+	}
+
+	//sum_j a_ij exp(b_j(o)+beta(j)-max) for all i at once
+	for (int32_t j=0; j<N; j++)
+		scaled[j]=std::exp(scaled[j]-max_beta);
+
+	Eigen::Map<const Eigen::MatrixXd> a(transition_matrix_exp.matrix, N, N);
+	Eigen::Map<Eigen::VectorXd> sums(beta_new, N);
+	sums.noalias()=a*Eigen::Map<const Eigen::VectorXd>(scaled, N);
+
+	for (int32_t i=0; i<N; i++)
+	{
+		if (beta_new[i]>=std::numeric_limits<float64_t>::min())
+			beta_new[i]=max_beta+std::log(beta_new[i]);
+		else
+		{
+			//underflow, sum in log space
+			int32_t num=trans_list_backward_cnt[i];
+			float64_t sum=-Math::INFTY;
+			for (int32_t j=0; j<num; j++)
+			{
+				int32_t jj=trans_list_backward[i][j];
+				sum=Math::logarithmic_sum(sum, get_a(i,jj)+get_b(jj, o)+beta[jj]);
+			}
+			beta_new[i]=sum;
+		}
+	}
+}
+
+//forward and backward variables of a whole sequence
+//unlike forward_comp/backward_comp the alpha/beta caches are not touched,
+//so several sequences can be processed concurrently
+float64_t HMM::forward_backward_trellis(
+	const uint16_t* obs, int32_t len, float64_t* alpha, float64_t* beta,
+	float64_t* scaled) const
+{
+	//initialization	alpha_1(i)=p_i*b_i(O_1)
+	for (int32_t i=0; i<N; i++)
+		alpha[i]=get_p(i)+get_b(i, obs[0]);
+
+	//induction		alpha_t+1(j) = (sum_i=1^N alpha_t(i)a_ij) b_j(O_t+1)
+	for (int32_t t=1; t<len; t++)
+		forward_step(&alpha[(t-1)*N], &alpha[t*N], obs[t], scaled);
+
+	//initialization	beta_T(i)=q(i)
+	for (int32_t i=0; i<N; i++)
+		beta[(len-1)*N+i]=get_q(i);
+
+	//induction		beta_t(i) = (sum_j=1^N a_ij*b_j(O_t+1)*beta_t+1(j)
+	for (int32_t t=len-2; t>=0; t--)
+		backward_step(&beta[(t+1)*N], &beta[t*N], obs[t+1], scaled);
+
+	//termination
+	float64_t sum=-Math::INFTY;
+	for (int32_t i=0; i<N; i++)
+		sum=Math::logarithmic_sum(sum, alpha[(len-1)*N+i]+get_q(i));
+
+	return sum;
+}
+
+//best path through the model for a whole sequence
+//unlike best_path the path caches are not touched, so several sequences
+//can be processed concurrently
+float64_t HMM::viterbi_trellis(
+	const uint16_t* obs, int32_t len, float64_t* delta, T_STATES* psi,
+	T_STATES* states) const
+{
+	float64_t* delta_new=delta+N;
+
+	//initialization
+	for (int32_t i=0; i<N; i++)
+	{
+		delta[i]=get_p(i)+get_b(i, obs[0]);
+		psi[i]=0;
+	}
+
+	//recursion
+	for (int32_t t=1; t<len; t++)
+	{
+		for (int32_t j=0; j<N; j++)
+		{
+			const float64_t* matrix_a=&transition_matrix_a[j*N]; // a(i,j) for all i
+			float64_t maxj=delta[0]+matrix_a[0];
+			int32_t argmax=0;
+
+			for (int32_t i=1; i<N; i++)
+			{
+				float64_t temp=delta[i]+matrix_a[i];
+
+				if (temp>maxj)
+				{
+					maxj=temp;
+					argmax=i;
+				}
+			}
+
+			delta_new[j]=maxj+get_b(j, obs[t]);
+			psi[t*N+j]=argmax;
+		}
+
+		std::swap(delta, delta_new);
+	}
+
+	//termination
+	float64_t maxj=delta[0]+get_q(0);
+	int32_t argmax=0;
+
+	for (int32_t i=1; i<N; i++)
+	{
+		float64_t temp=delta[i]+get_q(i);
+
+		if (temp>maxj)
+		{
+			maxj=temp;
+			argmax=i;
+		}
+	}
+	states[len-1]=argmax;
+
+	//state sequence backtracking
+	for (int32_t t=len-1; t>0; t--)
+		states[t-1]=psi[t*N+states[t]];
+
+	return maxj;
+}
+
 #ifndef USE_HMMPARALLEL
 float64_t HMM::model_probability_comp()
 {
@@ -1420,116 +1597,15 @@ void HMM::ab_buf_comp(
 	}
 }
 
-//estimates new model lambda out of lambda_train using baum welch algorithm
-void HMM::estimate_model_baum_welch(const std::shared_ptr<HMM>&	hmm)
-{
-	int32_t i,j,cpu;
-	float64_t fullmodprob=0;	//for all dims
-
-	//clear actual model a,b,p,q are used as numerator
-	for (i=0; i<N; i++)
-	{
-	  if (hmm->get_p(i)>Math::ALMOST_NEG_INFTY)
-	    set_p(i,log(PSEUDO));
-	  else
-	    set_p(i,hmm->get_p(i));
-	  if (hmm->get_q(i)>Math::ALMOST_NEG_INFTY)
-	    set_q(i,log(PSEUDO));
-	  else
-	    set_q(i,hmm->get_q(i));
-
-	  for (j=0; j<N; j++)
-	    if (hmm->get_a(i,j)>Math::ALMOST_NEG_INFTY)
-	      set_a(i,j, log(PSEUDO));
-	    else
-	      set_a(i,j,hmm->get_a(i,j));
-	  for (j=0; j<M; j++)
-	    if (hmm->get_b(i,j)>Math::ALMOST_NEG_INFTY)
-	      set_b(i,j, log(PSEUDO));
-	    else
-	      set_b(i,j,hmm->get_b(i,j));
-	}
-	invalidate_model();
-
-	int32_t num_threads = env()->get_num_threads();
-
-	std::vector<S_BW_THREAD_PARAM> params(num_threads);
-
-	if (p_observations->get_num_vectors()<num_threads)
-		num_threads=p_observations->get_num_vectors();
-
-	std::vector<std::thread> threads;
-	threads.reserve(num_threads);
-
-	for (cpu=0; cpu<num_threads; cpu++)
-	{
-		params[cpu].p_buf=SG_MALLOC(float64_t, N);
-		params[cpu].q_buf=SG_MALLOC(float64_t, N);
-		params[cpu].a_buf=SG_MALLOC(float64_t, N*N);
-		params[cpu].b_buf=SG_MALLOC(float64_t, N*M);
-
-		params[cpu].hmm=hmm;
-		int32_t start = p_observations->get_num_vectors()*cpu / num_threads;
-		int32_t stop=p_observations->get_num_vectors()*(cpu+1) / num_threads;
-
-		if (cpu == env()->get_num_threads()-1)
-			stop=p_observations->get_num_vectors();
-
-		ASSERT(start<stop)
-		params[cpu].dim_start=start;
-		params[cpu].dim_stop=stop;
-
-		threads.emplace_back([&p=params[cpu], this](){bw_dim_prefetch(&p);});
-	}
-
-	for (cpu=0; cpu<num_threads; cpu++)
-	{
-		threads[cpu].join();
-
-		for (i=0; i<N; i++)
-		{
-			//estimate initial+end state distribution numerator
-			set_p(i, Math::logarithmic_sum(get_p(i), params[cpu].p_buf[i]));
-			set_q(i, Math::logarithmic_sum(get_q(i), params[cpu].q_buf[i]));
-
-			//estimate numerator for a
-			for (j=0; j<N; j++)
-				set_a(i,j, Math::logarithmic_sum(get_a(i,j), params[cpu].a_buf[N*i+j]));
-
-			//estimate numerator for b
-			for (j=0; j<M; j++)
-				set_b(i,j, Math::logarithmic_sum(get_b(i,j), params[cpu].b_buf[M*i+j]));
-		}
-
-		fullmodprob+=params[cpu].ret;
-
-	}
-
-	for (cpu=0; cpu<num_threads; cpu++)
-	{
-		SG_FREE(params[cpu].p_buf);
-		SG_FREE(params[cpu].q_buf);
-		SG_FREE(params[cpu].a_buf);
-		SG_FREE(params[cpu].b_buf);
-	}
-
-	//cache hmm model probability
-	hmm->mod_prob=fullmodprob;
-	hmm->mod_prob_updated=true ;
-
-	//new model probability is unknown
-	normalize();
-	invalidate_model();
-}
-
-#else // USE_HMMPARALLEL
+#endif // USE_HMMPARALLEL
 
 //estimates new model lambda out of lambda_estimate using baum welch algorithm
+//the observation sequences are distributed over the threads, every thread
+//computes the trellis of its sequences in its own buffers and accumulates
+//their contribution to the numerators before they are added to the model
 void HMM::estimate_model_baum_welch(const std::shared_ptr<HMM>& estimate)
 {
-	int32_t i,j,t,dim;
-	float64_t a_sum, b_sum;	//numerator
-	float64_t dimmodprob=0;	//model probability for dim
+	int32_t i,j;
 	float64_t fullmodprob=0;	//for all dims
 
 	//clear actual model a,b,p,q are used as numerator
@@ -1557,47 +1633,83 @@ void HMM::estimate_model_baum_welch(const std::shared_ptr<HMM>& estimate)
 	}
 	invalidate_model();
 
-	//change summation order to make use of alpha/beta caches
-	for (dim=0; dim<p_observations->get_num_vectors(); dim++)
+	const int32_t num_vectors=p_observations->get_num_vectors();
+	const int64_t max_len=p_observations->get_max_vector_length();
+
+	#pragma omp parallel
 	{
-		dimmodprob=estimate->model_probability(dim);
-		fullmodprob+=dimmodprob ;
+		//trellis of the longest sequence, reused for all sequences of the thread
+		std::vector<float64_t> alpha(max_len*N);
+		std::vector<float64_t> beta(max_len*N);
+		std::vector<float64_t> scaled(N);
 
-		for (i=0; i<N; i++)
-		{
-			//estimate initial+end state distribution numerator
-			set_p(i, Math::logarithmic_sum(get_p(i), estimate->get_p(i)+estimate->get_b(i,p_observations->get_feature(dim,0))+estimate->backward(0,i,dim) - dimmodprob));
-			set_q(i, Math::logarithmic_sum(get_q(i), estimate->forward(p_observations->get_vector_length(dim)-1, i, dim)+estimate->get_q(i) - dimmodprob ));
+		//numerators of the sequences of the thread
+		std::vector<float64_t> p_num(N, -Math::INFTY);
+		std::vector<float64_t> q_num(N, -Math::INFTY);
+		std::vector<float64_t> a_num(int64_t(N)*N, -Math::INFTY);
+		std::vector<float64_t> b_num(int64_t(N)*M, -Math::INFTY);
+		float64_t modprob=0;
 
-			int32_t num = trans_list_backward_cnt[i] ;
+		#pragma omp for schedule(dynamic)
+		for (int32_t dim=0; dim<num_vectors; dim++)
+		{
+			int32_t len;
+			bool free_vec;
+			uint16_t* obs=p_observations->get_feature_vector(dim, len, free_vec);
 
-			//estimate a
-			for (j=0; j<num; j++)
+			if (len>0)
 			{
-				int32_t jj = trans_list_backward[i][j] ;
-				a_sum=-Math::INFTY;
+				float64_t dimmodprob=estimate->forward_backward_trellis(
+					obs, len, alpha.data(), beta.data(), scaled.data());
+				modprob+=dimmodprob;
 
-				for (t=0; t<p_observations->get_vector_length(dim)-1; t++)
+				for (int32_t s=0; s<N; s++)
 				{
-					a_sum= Math::logarithmic_sum(a_sum, estimate->forward(t,i,dim)+
-							estimate->get_a(i,jj)+estimate->get_b(jj,p_observations->get_feature(dim,t+1))+estimate->backward(t+1,jj,dim));
+					//estimate initial+end state distribution numerator
+					p_num[s]=Math::logarithmic_sum(p_num[s], alpha[s]+beta[s]-dimmodprob);
+					q_num[s]=Math::logarithmic_sum(q_num[s], alpha[(len-1)*N+s]+estimate->get_q(s)-dimmodprob);
+
+					//estimate numerator for a
+					int32_t num=estimate->trans_list_backward_cnt[s];
+					for (int32_t k=0; k<num; k++)
+					{
+						int32_t jj=estimate->trans_list_backward[s][k];
+						float64_t a_sum=-Math::INFTY;
+
+						for (int32_t t=0; t<len-1; t++)
+						{
+							a_sum=Math::logarithmic_sum(a_sum, alpha[t*N+s]+
+									estimate->get_a(s,jj)+estimate->get_b(jj,obs[t+1])+beta[(t+1)*N+jj]);
+						}
+						a_num[s*N+jj]=Math::logarithmic_sum(a_num[s*N+jj], a_sum-dimmodprob);
+					}
+
+					//estimate numerator for b
+					for (int32_t t=0; t<len; t++)
+					{
+						float64_t& b_sum=b_num[s*M+obs[t]];
+						b_sum=Math::logarithmic_sum(b_sum, alpha[t*N+s]+beta[t*N+s]-dimmodprob);
+					}
 				}
-				set_a(i,jj, Math::logarithmic_sum(get_a(i,jj), a_sum-dimmodprob));
 			}
 
-			//estimate b
-			for (j=0; j<M; j++)
+			p_observations->free_feature_vector(obs, dim, free_vec);
+		}
+
+		#pragma omp critical
+		{
+			for (int32_t s=0; s<N; s++)
 			{
-				b_sum=-Math::INFTY;
+				set_p(s, Math::logarithmic_sum(get_p(s), p_num[s]));
+				set_q(s, Math::logarithmic_sum(get_q(s), q_num[s]));
 
-				for (t=0; t<p_observations->get_vector_length(dim); t++)
-				{
-					if (p_observations->get_feature(dim,t)==j)
-						b_sum=Math::logarithmic_sum(b_sum, estimate->forward(t,i,dim)+estimate->backward(t, i, dim));
-				}
+				for (int32_t k=0; k<N; k++)
+					set_a(s,k, Math::logarithmic_sum(get_a(s,k), a_num[s*N+k]));
 
-				set_b(i,j, Math::logarithmic_sum(get_b(i,j), b_sum-dimmodprob));
+				for (int32_t k=0; k<M; k++)
+					set_b(s,k, Math::logarithmic_sum(get_b(s,k), b_num[s*M+k]));
 			}
+			fullmodprob+=modprob;
 		}
 	}
 
@@ -1610,6 +1722,8 @@ void HMM::estimate_model_baum_welch(const std::shared_ptr<HMM>& estimate)
 	invalidate_model();
 }
 
+#ifndef USE_HMMPARALLEL
+
 //estimates new model lambda out of lambda_estimate using baum welch algorithm
 void HMM::estimate_model_baum_welch_old(const std::shared_ptr<HMM>& estimate)
 {
@@ -1940,7 +2054,7 @@ void HMM::estimate_model_baum_welch_defined(const std::shared_ptr<HMM>& estimate
 //estimates new model lambda out of lambda_estimate using viterbi algorithm
 void HMM::estimate_model_viterbi(const std::shared_ptr<HMM>& estimate)
 {
-	int32_t i,j,t;
+	int32_t i,j;
 	float64_t sum;
 	float64_t* P=ARRAYN1(0);
 	float64_t* Q=ARRAYN2(0);
@@ -1962,56 +2076,67 @@ void HMM::estimate_model_viterbi(const std::shared_ptr<HMM>& estimate)
 
 	float64_t allpatprob=0 ;
 
-#ifdef USE_HMMPARALLEL
-	int32_t num_threads = env()->get_num_threads();
-	std::vector<std::thread> threads;
-	threads.reserve(num_threads);
-	std::vector<S_DIM_THREAD_PARAM> params(num_threads);
-
-	if (p_observations->get_num_vectors()<num_threads)
-		num_threads=p_observations->get_num_vectors();
-#endif
+	const int32_t num_vectors=p_observations->get_num_vectors();
+	const int64_t max_len=p_observations->get_max_vector_length();
 
-	for (int32_t dim=0; dim<p_observations->get_num_vectors(); dim++)
+	//the observation sequences are distributed over the threads, every
+	//thread counts the occurences on the best paths of its sequences
+	#pragma omp parallel
 	{
+		//trellis of the longest sequence, reused for all sequences of the thread
+		std::vector<float64_t> delta(2*N);
+		std::vector<T_STATES> psi(max_len*N);
+		std::vector<T_STATES> states(max_len);
 
-#ifdef USE_HMMPARALLEL
-		if (dim%num_threads==0)
+		std::vector<float64_t> A_cnt(int64_t(N)*N, 0);
+		std::vector<float64_t> B_cnt(int64_t(N)*M, 0);
+		std::vector<float64_t> P_cnt(N, 0);
+		std::vector<float64_t> Q_cnt(N, 0);
+		float64_t patprob=0;
+
+		#pragma omp for schedule(dynamic)
+		for (int32_t dim=0; dim<num_vectors; dim++)
 		{
-			for (i=0; i<num_threads; i++)
-			{
-				if (dim+i<p_observations->get_num_vectors())
-				{
-					params[i].hmm=estimate ;
-					params[i].dim=dim+i ;
-					threads.emplace_back([this, &p=params[i]](){vit_dim_prefetch(&p);});
-				}
-			}
-			for (i=0; i<num_threads; i++)
+			int32_t len;
+			bool free_vec;
+			uint16_t* obs=p_observations->get_feature_vector(dim, len, free_vec);
+
+			if (len>0)
 			{
-				if (dim+i<p_observations->get_num_vectors())
+				//using viterbi to find best path
+				patprob+=estimate->viterbi_trellis(
+					obs, len, delta.data(), psi.data(), states.data());
+
+				//counting occurences for A and B
+				for (int32_t t=0; t<len-1; t++)
 				{
-					threads[i].join();
-					allpatprob += params[i].prob_sum;
+					A_cnt[states[t]*N+states[t+1]]++;
+					B_cnt[states[t]*M+obs[t]]++;
 				}
+				B_cnt[states[len-1]*M+obs[len-1]]++;
+
+				P_cnt[states[0]]++;
+				Q_cnt[states[len-1]]++;
 			}
+
+			p_observations->free_feature_vector(obs, dim, free_vec);
 		}
-#else
-		//using viterbi to find best path
-		allpatprob += estimate->best_path(dim);
-#endif // USE_HMMPARALLEL
 
-		//counting occurences for A and B
-		for (t=0; t<p_observations->get_vector_length(dim)-1; t++)
+		#pragma omp critical
 		{
-			set_A(estimate->PATH(dim)[t], estimate->PATH(dim)[t+1], get_A(estimate->PATH(dim)[t], estimate->PATH(dim)[t+1])+1);
-			set_B(estimate->PATH(dim)[t], p_observations->get_feature(dim,t),  get_B(estimate->PATH(dim)[t], p_observations->get_feature(dim,t))+1);
-		}
+			for (int32_t s=0; s<N; s++)
+			{
+				for (int32_t k=0; k<N; k++)
+					set_A(s,k, get_A(s,k)+A_cnt[s*N+k]);
 
-		set_B(estimate->PATH(dim)[p_observations->get_vector_length(dim)-1], p_observations->get_feature(dim,p_observations->get_vector_length(dim)-1),  get_B(estimate->PATH(dim)[p_observations->get_vector_length(dim)-1], p_observations->get_feature(dim,p_observations->get_vector_length(dim)-1)) + 1 );
+				for (int32_t k=0; k<M; k++)
+					set_B(s,k, get_B(s,k)+B_cnt[s*M+k]);
 
-		P[estimate->PATH(dim)[0]]++;
-		Q[estimate->PATH(dim)[p_observations->get_vector_length(dim)-1]]++;
+				P[s]+=P_cnt[s];
+				Q[s]+=Q_cnt[s];
+			}
+			allpatprob+=patprob;
+		}
 	}
 
 	allpatprob/=p_observations->get_num_vectors() ;
@@ -2763,6 +2888,11 @@ void HMM::invalidate_model()
 		    trans_list_backward_cnt[i]++ ;
 		  }
 	    } ;
+
+	  if (transition_matrix_exp.num_rows!=N)
+	    transition_matrix_exp=SGMatrix<float64_t>(N, N);
+	  for (int32_t i=0; i<N*N; i++)
+	    transition_matrix_exp[i]=std::exp(transition_matrix_a[i]);
 	} ;
 	this->all_pat_prob=0.0;
 	this->pat_prob=0.0;
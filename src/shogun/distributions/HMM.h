@@ -12,6 +12,7 @@
 #include <shogun/lib/common.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/config.h>
+#include <shogun/lib/SGMatrix.h>
 #include <shogun/features/Features.h>
 #include <shogun/features/StringFeatures.h>
 #include <shogun/distributions/Distribution.h>
@@ -453,6 +454,66 @@ class HMM : public RandomMixin<Distribution>
 		 */
 		bool converged(float64_t x, float64_t y);
 
+		/** computes forward and backward variables of a whole sequence
+		 * into the given buffers, without using the alpha/beta caches.
+		 * Used by the parallel baum welch estimation.
+		 *
+		 * @param obs observation sequence
+		 * @param len length of the sequence, at least 1
+		 * @param alpha buffer of size len*N for the forward variables
+		 * @param beta buffer of size len*N for the backward variables
+		 * @param scaled buffer of size N for temporary calculations
+		 * @return log probability of the sequence
+		 */
+		float64_t forward_backward_trellis(
+			const uint16_t* obs, int32_t len, float64_t* alpha,
+			float64_t* beta, float64_t* scaled) const;
+
+		/** one step of the forward algorithm,
+		 * alpha_new(j) = log(sum_i exp(alpha(i)) a_ij) + b_j(o).
+		 *
+		 * The sums over all states are computed at once as a dense
+		 * matrix-vector product of the transition probabilities and
+		 * exp(alpha(i) - max_i alpha(i)). Sums that are too small for
+		 * this are computed in log space.
+		 *
+		 * @param alpha forward variables of the previous time step
+		 * @param alpha_new forward variables of the current time step
+		 * @param o observation at the current time step
+		 * @param scaled buffer of size N for temporary calculations
+		 */
+		void forward_step(
+			const float64_t* alpha, float64_t* alpha_new, uint16_t o,
+			float64_t* scaled) const;
+
+		/** one step of the backward algorithm,
+		 * beta_new(i) = log(sum_j a_ij exp(b_j(o) + beta(j))),
+		 * computed like forward_step().
+		 *
+		 * @param beta backward variables of the next time step
+		 * @param beta_new backward variables of the current time step
+		 * @param o observation at the next time step
+		 * @param scaled buffer of size N for temporary calculations
+		 */
+		void backward_step(
+			const float64_t* beta, float64_t* beta_new, uint16_t o,
+			float64_t* scaled) const;
+
+		/** computes the best path of a whole sequence into the given
+		 * buffers, without using the path caches.
+		 * Used by the parallel viterbi estimation.
+		 *
+		 * @param obs observation sequence
+		 * @param len length of the sequence, at least 1
+		 * @param delta buffer of size 2*N
+		 * @param psi buffer of size len*N for the backtracking table
+		 * @param states buffer of size len for the best path
+		 * @return log probability of the best path
+		 */
+		float64_t viterbi_trellis(
+			const uint16_t* obs, int32_t len, float64_t* delta,
+			T_STATES* psi, T_STATES* states) const;
+
 #ifdef USE_HMMPARALLEL_STRUCTURES
 		static void bw_dim_prefetch(S_BW_THREAD_PARAM* params);
 		static void bw_single_dim_prefetch(S_DIM_THREAD_PARAM* params);
@@ -1213,6 +1274,10 @@ class HMM : public RandomMixin<Distribution>
 		/// transition matrix
 		float64_t* transition_matrix_a;
 
+		/// transition probabilities exp(a), laid out like transition_matrix_a
+		/// and updated by invalidate_model()
+		SGMatrix<float64_t> transition_matrix_exp;
+
 		/// initial distribution of states
 		float64_t* initial_state_distribution_p;
 
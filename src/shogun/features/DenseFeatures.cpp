@@ -10,6 +10,7 @@
 
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
+#include <shogun/io/MappedFeaturesFormat.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
@@ -42,6 +43,7 @@ template<class ST> DenseFeatures<ST>::DenseFeatures(const DenseFeatures & orig)
 {
 	init();
 	set_feature_matrix(orig.feature_matrix);
+	m_mapped_file = orig.m_mapped_file;
 	initialize_cache();
 
 	if (orig.m_subset_stack != NULL)
@@ -72,6 +74,13 @@ template<class ST> DenseFeatures<ST>::DenseFeatures(const std::shared_ptr<File>&
 	load(loader);
 }
 
+template<class ST> DenseFeatures<ST>::DenseFeatures(const std::shared_ptr<MemoryMappedFile<char>>& file) :
+		DotFeatures()
+{
+	init();
+	load_mapped(file);
+}
+
 template<class ST> DenseFeatures<ST>::DenseFeatures(const std::shared_ptr<DotFeatures>& features) :
 		DotFeatures()
 {
@@ -277,6 +286,32 @@ SGMatrix<ST> DenseFeatures<ST>::get_feature_matrix() const
 	return target;
 }
 
+template <class ST>
+SGMatrix<ST> DenseFeatures<ST>::get_feature_matrix_block(index_t begin, index_t size) const
+{
+	require(begin>=0 && size>=0 && begin+size<=get_num_vectors(),
+			"Block [{}, {}) exceeds the {} feature vectors",
+			begin, begin+size, get_num_vectors());
+
+	if (feature_matrix.matrix && !m_subset_stack->has_subsets() &&
+	    !get_num_preprocessors())
+	{
+		return SGMatrix<ST>(feature_matrix.matrix + begin * int64_t(num_features),
+				num_features, size, false);
+	}
+
+	SGMatrix<ST> block(num_features, size);
+	for (index_t i=0; i<size; i++)
+	{
+		SGVector<ST> vec=get_feature_vector(begin+i);
+		require(vec.vlen==num_features,
+				"Feature vector {} has {} instead of {} features",
+				begin+i, vec.vlen, num_features);
+		sg_memcpy(block.get_column_vector(i), vec.vector, num_features*sizeof(ST));
+	}
+	return block;
+}
+
 template <class ST>
 void DenseFeatures<ST>::copy_feature_matrix(SGMatrix<ST>& target, index_t column_offset) const
 {
@@ -724,6 +759,43 @@ void DenseFeatures<ST>::save(std::shared_ptr<File> writer)
 	feature_matrix.save(writer);
 }
 
+template<class ST>
+void DenseFeatures<ST>::load_mapped(const std::shared_ptr<MemoryMappedFile<char>>& file)
+{
+	const auto& header = MappedFeaturesHeader::read(
+		file.get(), MFL_DENSE, get_generic(), sizeof(ST));
+	require(header.num_entries == header.num_features * header.num_vectors,
+		"Mapped features contain {} values instead of {}x{}",
+		header.num_entries, header.num_features, header.num_vectors);
+
+	ST* data = (ST*) (file->get_map() + sizeof(MappedFeaturesHeader));
+	set_feature_matrix(SGMatrix<ST>(
+		data, header.num_features, header.num_vectors, false));
+	m_mapped_file = file;
+}
+
+template<class ST>
+void DenseFeatures<ST>::save_mapped(const char* fname) const
+{
+	// only the vectors of the active subset are written
+	auto matrix = get_feature_matrix();
+	const int64_t num_entries = int64_t(num_features) * matrix.num_cols;
+	auto header = MappedFeaturesHeader::create(MFL_DENSE, get_generic(),
+		sizeof(ST), num_features, matrix.num_cols, num_entries);
+
+	FILE* f = fopen(fname, "wb");
+	if (!f)
+		error("Error opening file '{}'", fname);
+
+	bool written = fwrite(&header, sizeof(header), 1, f) == 1;
+	if (num_entries)
+		written = written && fwrite(matrix.matrix, sizeof(ST), num_entries, f) == (size_t)num_entries;
+	fclose(f);
+
+	if (!written)
+		error("Error writing file '{}'", fname);
+}
+
 template< class ST > std::shared_ptr<DenseFeatures< ST >> DenseFeatures< ST >::obtain_from_generic(std::shared_ptr<Features> base_features)
 {
 	require(base_features->get_feature_class() == C_DENSE,
@@ -24,6 +24,7 @@ namespace shogun {
 template<class ST> class StringFeatures;
 template<class ST> class DenseFeatures;
 template<class ST> class SGMatrix;
+template<class T> class MemoryMappedFile;
 class DotFeatures;
 
 /** @brief The class DenseFeatures implements dense feature matrices.
@@ -99,6 +100,14 @@ public:
 	 */
 	DenseFeatures(const std::shared_ptr<File>& loader);
 
+#ifndef SWIG
+	/** constructor over a memory mapped file, see load_mapped()
+	 *
+	 * @param file file in the MappedFeaturesHeader format
+	 */
+	DenseFeatures(const std::shared_ptr<MemoryMappedFile<char>>& file);
+#endif
+
 	/** duplicate feature object
 	 *
 	 * @return feature object
@@ -193,6 +202,17 @@ public:
 	 */
 	SGMatrix<ST> get_feature_matrix() const;
 
+	/** Getter for a block of consecutive feature vectors
+	 *
+	 * in-place if the features are a plain matrix without subset
+	 * and preprocessors, a copy otherwise
+	 *
+	 * @param begin index of the first feature vector
+	 * @param size number of feature vectors
+	 * @return matrix with the feature vectors as columns
+	 */
+	SGMatrix<ST> get_feature_matrix_block(index_t begin, index_t size) const;
+
 	/** get the pointer to the feature matrix
 	 * num_feat,num_vectors are returned by reference
 	 *
@@ -379,6 +399,28 @@ public:
 	 */
 	void save(std::shared_ptr<File> saver) override;
 
+#ifndef SWIG
+	/** use the feature matrix stored in a memory mapped file,
+	 * without copying it into memory
+	 *
+	 * The file has to be in the MFL_DENSE layout described in
+	 * MappedFeaturesHeader, as written by save_mapped(). The feature
+	 * matrix is read-only and only valid as long as these features
+	 * exist; matrices obtained with get_feature_matrix() do not keep
+	 * the mapping alive.
+	 *
+	 * @param file mapped file
+	 */
+	void load_mapped(const std::shared_ptr<MemoryMappedFile<char>>& file);
+#endif
+
+	/** save features in the binary format read by load_mapped(), only
+	 * the vectors of the active subset are saved
+	 *
+	 * @param fname name of the file to write
+	 */
+	void save_mapped(const char* fname) const;
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 	/** iterator for dense features */
 	struct dense_feature_iterator
@@ -557,6 +599,9 @@ protected:
 
 	/** feature cache */
 	std::shared_ptr<Cache<ST>> feature_cache;
+
+	/** file mapping feature_matrix points into, if any */
+	std::shared_ptr<MemoryMappedFile<char>> m_mapped_file;
 };
 }
 #endif // _DENSEFEATURES__H__
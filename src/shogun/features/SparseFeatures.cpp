@@ -3,6 +3,7 @@
 #include <shogun/features/SparseFeatures.h>
 #include <shogun/preprocessor/SparsePreprocessor.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/io/MappedFeaturesFormat.h>
 #include <shogun/io/SGIO.h>
 
 #include <string.h>
@@ -33,7 +34,7 @@ template<class ST> SparseFeatures<ST>::SparseFeatures(SGMatrix<ST> dense)
 
 template<class ST> SparseFeatures<ST>::SparseFeatures(const SparseFeatures & orig)
 : DotFeatures(orig), sparse_feature_matrix(orig.sparse_feature_matrix),
-	feature_cache(orig.feature_cache)
+	feature_cache(orig.feature_cache), m_mapped_file(orig.m_mapped_file)
 {
 	init();
 
@@ -63,6 +64,14 @@ template<class ST> SparseFeatures<ST>::SparseFeatures(const std::shared_ptr<File
 	load(loader);
 }
 
+template<class ST> SparseFeatures<ST>::SparseFeatures(const std::shared_ptr<MemoryMappedFile<char>>& file)
+: DotFeatures(), feature_cache(NULL)
+{
+	init();
+
+	load_mapped(file);
+}
+
 template<class ST> SparseFeatures<ST>::~SparseFeatures()
 {
 
@@ -645,6 +654,75 @@ template<class ST> void SparseFeatures<ST>::save_with_labels(const std::shared_p
 	sparse_feature_matrix.save_with_labels(writer, labels);
 }
 
+template<class ST> void SparseFeatures<ST>::load_mapped(const std::shared_ptr<MemoryMappedFile<char>>& file)
+{
+	const auto& header = MappedFeaturesHeader::read(file.get(), MFL_SPARSE,
+		get_generic(), sizeof(SGSparseVectorEntry<ST>));
+
+	char* map = file->get_map();
+	const int64_t* offsets = (const int64_t*) (map + sizeof(MappedFeaturesHeader));
+	auto entries = (SGSparseVectorEntry<ST>*) (map +
+		MappedFeaturesHeader::sparse_entries_offset(header.num_vectors));
+
+	remove_all_subsets();
+	free_sparse_feature_matrix();
+
+	SGSparseMatrix<ST> matrix(header.num_features, header.num_vectors);
+	for (index_t i=0; i<matrix.num_vectors; i++)
+	{
+		require(offsets[i] >= 0 && offsets[i] <= offsets[i+1] && offsets[i+1] <= header.num_entries,
+			"Invalid offsets [{}, {}) of vector {} in mapped features",
+			offsets[i], offsets[i+1], i);
+
+		matrix.sparse_matrix[i] = SGSparseVector<ST>(entries + offsets[i],
+			offsets[i+1] - offsets[i], false);
+	}
+
+	sparse_feature_matrix = matrix;
+	m_mapped_file = file;
+}
+
+template<class ST> void SparseFeatures<ST>::save_mapped(const char* fname) const
+{
+	if (m_subset_stack->has_subsets())
+		error("Not allowed with subset");
+
+	const index_t num_vectors = sparse_feature_matrix.num_vectors;
+	SGVector<int64_t> offsets(num_vectors + 1);
+	offsets[0] = 0;
+	for (index_t i=0; i<num_vectors; i++)
+		offsets[i+1] = offsets[i] + sparse_feature_matrix[i].num_feat_entries;
+
+	auto header = MappedFeaturesHeader::create(MFL_SPARSE, get_generic(),
+		sizeof(SGSparseVectorEntry<ST>), sparse_feature_matrix.num_features,
+		num_vectors, offsets[num_vectors]);
+
+	FILE* f = fopen(fname, "wb");
+	if (!f)
+		error("Error opening file '{}'", fname);
+
+	bool written = fwrite(&header, sizeof(header), 1, f) == 1;
+	written = written && fwrite(offsets.vector, sizeof(int64_t), offsets.vlen, f) == (size_t)offsets.vlen;
+
+	const char padding[16] = {0};
+	const size_t num_padding = MappedFeaturesHeader::sparse_entries_offset(num_vectors)
+		- sizeof(header) - offsets.vlen * sizeof(int64_t);
+	if (num_padding)
+		written = written && fwrite(padding, 1, num_padding, f) == num_padding;
+
+	for (index_t i=0; i<num_vectors && written; i++)
+	{
+		const SGSparseVector<ST>& vec = sparse_feature_matrix[i];
+		if (vec.num_feat_entries)
+			written = fwrite(vec.features, sizeof(SGSparseVectorEntry<ST>),
+				vec.num_feat_entries, f) == (size_t)vec.num_feat_entries;
+	}
+	fclose(f);
+
+	if (!written)
+		error("Error writing file '{}'", fname);
+}
+
 template class SparseFeatures<bool>;
 template class SparseFeatures<char>;
 template class SparseFeatures<int8_t>;
@@ -27,6 +27,7 @@ class LibSVMFile;
 class Features;
 template <class ST> class DenseFeatures;
 template <class T> class Cache;
+template <class T> class MemoryMappedFile;
 
 /** @brief Template class SparseFeatures implements sparse matrices.
  *
@@ -81,6 +82,14 @@ template <class ST> class SparseFeatures : public DotFeatures
 		 */
 		SparseFeatures(const std::shared_ptr<File>& loader);
 
+#ifndef SWIG
+		/** constructor over a memory mapped file, see load_mapped()
+		 *
+		 * @param file file in the MappedFeaturesHeader format
+		 */
+		SparseFeatures(const std::shared_ptr<MemoryMappedFile<char>>& file);
+#endif
+
 		/** default destructor */
 		~SparseFeatures() override;
 
@@ -356,6 +365,30 @@ template <class ST> class SparseFeatures : public DotFeatures
 		 */
 		void save_with_labels(const std::shared_ptr<File>& writer, SGVector<float64_t> labels);
 
+#ifndef SWIG
+		/** use the sparse vectors stored in a memory mapped file,
+		 * without copying their entries into memory
+		 *
+		 * any subset is removed before
+		 *
+		 * The file has to be in the MFL_SPARSE layout described in
+		 * MappedFeaturesHeader, as written by save_mapped(). Only the
+		 * vector headers are allocated; the entries are read-only and only
+		 * valid as long as these features exist.
+		 *
+		 * @param file mapped file
+		 */
+		void load_mapped(const std::shared_ptr<MemoryMappedFile<char>>& file);
+#endif
+
+		/** save features in the binary format read by load_mapped()
+		 *
+		 * not possible with subset
+		 *
+		 * @param fname name of the file to write
+		 */
+		void save_mapped(const char* fname) const;
+
 		/** ensure that features occur in ascending order, only call when no
 		 * preprocessors are attached
 		 *
@@ -482,6 +515,9 @@ template <class ST> class SparseFeatures : public DotFeatures
 
 		/** feature cache */
 		std::shared_ptr<Cache< SGSparseVectorEntry<ST> >> feature_cache;
+
+		/** file mapping the sparse entries point into, if any */
+		std::shared_ptr<MemoryMappedFile<char>> m_mapped_file;
 };
 }
 #endif /* _SPARSEFEATURES__H__ */
@@ -0,0 +1,157 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+#ifndef __MAPPEDFEATURESFORMAT_H__
+#define __MAPPEDFEATURESFORMAT_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/io/MemoryMappedFile.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/lib/DataType.h>
+#include <shogun/lib/common.h>
+
+#include <limits>
+#include <string.h>
+
+#define MAPPED_FEATURES_MAGIC "SGMAPFT"
+#define MAPPED_FEATURES_VERSION 1
+
+namespace shogun
+{
+/// Layout of the data following the header of a mapped features file
+enum EMappedFeaturesLayout
+{
+	MFL_DENSE = 0,
+	MFL_SPARSE = 1
+};
+
+/** @brief Header of binary feature files that can be memory mapped by
+ * DenseFeatures::load_mapped() and SparseFeatures::load_mapped().
+ *
+ * All values are stored in native byte order. A file consists of this
+ * 64 byte header followed by the data, depending on the layout:
+ *
+ * \li MFL_DENSE: num_features x num_vectors values of the primitive type
+ * in column major order, i.e. one feature vector after the other.
+ * \li MFL_SPARSE: num_vectors + 1 int64_t offsets into the entries, where
+ * vector i consists of the entries offsets[i] to offsets[i+1] (exclusive),
+ * followed, at the next multiple of 16 bytes, by num_entries
+ * SGSparseVectorEntry structs sorted by vector (compressed sparse columns,
+ * one column per feature vector).
+ *
+ * entry_size is the size of one value or sparse entry on the machine that
+ * wrote the file, so that files are rejected where the layout of the
+ * entries differs.
+ */
+struct MappedFeaturesHeader
+{
+	/** MAPPED_FEATURES_MAGIC */
+	char magic[8];
+	/** MAPPED_FEATURES_VERSION */
+	uint32_t version;
+	/** EMappedFeaturesLayout */
+	uint32_t layout;
+	/** EPrimitiveType of the values */
+	uint32_t ptype;
+	/** size of one value or sparse entry in bytes */
+	uint32_t entry_size;
+	/** dimension of the feature vectors */
+	int64_t num_features;
+	/** number of feature vectors */
+	int64_t num_vectors;
+	/** number of stored values or sparse entries */
+	int64_t num_entries;
+	/** reserved, zero */
+	uint8_t reserved[16];
+
+	/** create a header
+	 *
+	 * @param layout layout of the data
+	 * @param ptype primitive type of the values
+	 * @param entry_size size of one value or sparse entry
+	 * @param num_features dimension of the feature vectors
+	 * @param num_vectors number of feature vectors
+	 * @param num_entries number of values or sparse entries
+	 * @return header
+	 */
+	static MappedFeaturesHeader create(
+		EMappedFeaturesLayout layout, EPrimitiveType ptype, size_t entry_size,
+		int64_t num_features, int64_t num_vectors, int64_t num_entries)
+	{
+		MappedFeaturesHeader header;
+		memset(&header, 0, sizeof(header));
+		strncpy(header.magic, MAPPED_FEATURES_MAGIC, sizeof(header.magic));
+		header.version = MAPPED_FEATURES_VERSION;
+		header.layout = layout;
+		header.ptype = ptype;
+		header.entry_size = entry_size;
+		header.num_features = num_features;
+		header.num_vectors = num_vectors;
+		header.num_entries = num_entries;
+		return header;
+	}
+
+	/** read and check the header of a mapped file
+	 *
+	 * @param file mapped file
+	 * @param layout expected layout of the data
+	 * @param ptype expected primitive type of the values
+	 * @param entry_size expected size of one value or sparse entry
+	 * @return header, pointing into the mapping
+	 */
+	static const MappedFeaturesHeader& read(
+		MemoryMappedFile<char>* file, EMappedFeaturesLayout layout,
+		EPrimitiveType ptype, size_t entry_size)
+	{
+		require(file, "No file given");
+		require(file->get_size() >= sizeof(MappedFeaturesHeader),
+			"File too small to contain a mapped features header");
+
+		const auto& header = *(const MappedFeaturesHeader*)file->get_map();
+		require(!strncmp(header.magic, MAPPED_FEATURES_MAGIC, sizeof(header.magic)),
+			"File is not a mapped features file");
+		require(header.version == MAPPED_FEATURES_VERSION,
+			"Unsupported mapped features version {} (expected {})",
+			header.version, MAPPED_FEATURES_VERSION);
+		require(header.layout == (uint32_t)layout,
+			"Mapped features layout {} does not match expected layout {}",
+			header.layout, (uint32_t)layout);
+		require(header.ptype == (uint32_t)ptype,
+			"Mapped features of type {} cannot be read as {}",
+			ptype_name((EPrimitiveType)header.ptype), ptype_name(ptype));
+		require(header.entry_size == entry_size,
+			"Mapped features entry size {} does not match {} of this machine",
+			header.entry_size, entry_size);
+		require(header.num_features >= 0 && header.num_features <= std::numeric_limits<index_t>::max()
+			&& header.num_vectors >= 0 && header.num_vectors <= std::numeric_limits<index_t>::max(),
+			"Mapped features of size {}x{} exceed the supported range",
+			header.num_features, header.num_vectors);
+
+		uint64_t data_offset = layout == MFL_DENSE
+			? sizeof(MappedFeaturesHeader)
+			: sparse_entries_offset(header.num_vectors);
+		require(file->get_size() >= data_offset + header.num_entries * entry_size,
+			"Mapped features file is truncated");
+
+		return header;
+	}
+
+	/** offset of the sparse entries from the start of the file
+	 *
+	 * @param num_vectors number of feature vectors
+	 * @return offset in bytes
+	 */
+	static uint64_t sparse_entries_offset(int64_t num_vectors)
+	{
+		uint64_t end_of_offsets = sizeof(MappedFeaturesHeader) + (num_vectors + 1) * sizeof(int64_t);
+		return (end_of_offsets + 15) / 16 * 16;
+	}
+};
+
+static_assert(sizeof(MappedFeaturesHeader) == 64,
+	"MappedFeaturesHeader must be 64 bytes");
+}
+#endif // __MAPPEDFEATURESFORMAT_H__
@@ -8,6 +8,7 @@
 #include <shogun/io/ShogunErrc.h>
 #include <shogun/util/converters.h>
 #include <shogun/base/class_list.h>
+#include <shogun/machine/Machine.h>
 #include <shogun/util/system.h>
 
 #include <bitsery/bitsery.h>
@@ -22,8 +23,31 @@ template<class S>
 class BitseryReaderVisitor: public detail::BitseryVisitor<S, BitseryReaderVisitor<S>>
 {
 public:
-	BitseryReaderVisitor(S& s):
-		detail::BitseryVisitor<S,BitseryReaderVisitor<S>>(s) {}
+	BitseryReaderVisitor(S& s, std::shared_ptr<InputStream> stream):
+		detail::BitseryVisitor<S,BitseryReaderVisitor<S>>(s),
+		m_stream(std::move(stream)) {}
+
+	// the storage of dense containers is read in chunks straight from the
+	// stream, see BitseryWriterVisitor::on_bulk
+	bool on_bulk(S& s, void* data, uint64_t num_bytes)
+	{
+		uint64_t stored_bytes;
+		s.value8b(stored_bytes);
+		require(stored_bytes == num_bytes,
+			"Stored container of {} bytes does not match the expected {} bytes",
+			stored_bytes, num_bytes);
+
+		auto dst = static_cast<char*>(data);
+		for (uint64_t offset = 0; offset < num_bytes; offset += detail::kBulkChunkSize)
+		{
+			auto chunk = std::min(detail::kBulkChunkSize, num_bytes - offset);
+			auto ec = m_stream->read(&m_buffer, chunk);
+			if (ec || m_buffer.size() != chunk)
+				throw io::to_system_error(ec ? ec : make_error_condition(ShogunErrc::OutOfRange));
+			copy_n(m_buffer.data(), chunk, dst + offset);
+		}
+		return true;
+	}
 
 	void on_complex(S& s, complex128_t* v)
 	{
@@ -75,6 +99,9 @@ public:
 	std::optional<float64_t> m_auto_value;
 
 private:
+	std::shared_ptr<InputStream> m_stream;
+	string m_buffer;
+
 	SG_DELETE_COPY_AND_ASSIGN(BitseryReaderVisitor);
 };
 
@@ -114,6 +141,39 @@ struct InputStreamAdapter
 	error_condition m_status;
 };
 
+// names and sizes of the parameters of an object written by
+// write_indexed_object, in the order in which they are stored
+template<typename Reader>
+std::vector<std::pair<string, uint64_t>> read_table_of_contents(Reader& reader)
+{
+	size_t num_params;
+	reader.value8b(num_params);
+	std::vector<std::pair<string, uint64_t>> toc(num_params);
+	for (auto& entry: toc)
+	{
+		reader.text1b(entry.first, 64);
+		reader.value8b(entry.second);
+	}
+	return toc;
+}
+
+// format version of an object, which follows its magic
+template<typename Reader>
+uint16_t read_format_version(Reader& reader, size_t obj_magic)
+{
+	// objects of older files are not versioned
+	uint16_t version = 0;
+	if (obj_magic == detail::kObjectMagic || obj_magic == detail::kIndexedObjectMagic)
+		reader.value2b(version);
+	require(version <= detail::kFormatVersion,
+		"Unknown format version {}, the latest supported version is {}",
+		version, detail::kFormatVersion);
+	require(version < detail::kBlobFormatVersion || !utils::is_big_endian(),
+		"Objects of format version {} can only be read on little endian hosts",
+		version);
+	return version;
+}
+
 template<typename Reader>
 std::shared_ptr<SGObject> object_reader(Reader& reader, BitseryReaderVisitor<Reader>* visitor, const std::shared_ptr<SGObject>& _this = nullptr)
 {
@@ -121,6 +181,7 @@ std::shared_ptr<SGObject> object_reader(Reader& reader, BitseryReaderVisitor<Rea
 	reader.value8b(obj_magic);
 	if (obj_magic == detail::kNullObjectMagic)
 		return nullptr;
+	auto format_version = read_format_version(reader, obj_magic);
 
 	string obj_name;
 	reader.text1b(obj_name, 64);
@@ -140,27 +201,40 @@ std::shared_ptr<SGObject> object_reader(Reader& reader, BitseryReaderVisitor<Rea
 	if (obj == nullptr)
 		throw runtime_error("Trying to deserializer and unknown object!");
 
+	// nested objects may have been written in another format
+	auto parent_format_version = visitor->get_format_version();
+	visitor->set_format_version(format_version);
 	try
 	{
 		pre_deserialize(obj);
 
-		size_t num_params;
-		reader.value8b(num_params);
-		for (size_t i = 0; i < num_params; ++i)
+		if (obj_magic == detail::kIndexedObjectMagic)
+		{
+			for (const auto& entry: read_table_of_contents(reader))
+				obj->visit_parameter(BaseTag(entry.first), visitor);
+		}
+		else
 		{
-			string param_name;
-			reader.text1b(param_name, 64);
-			obj->visit_parameter(BaseTag(param_name), visitor);
+			size_t num_params;
+			reader.value8b(num_params);
+			for (size_t i = 0; i < num_params; ++i)
+			{
+				string param_name;
+				reader.text1b(param_name, 64);
+				obj->visit_parameter(BaseTag(param_name), visitor);
+			}
 		}
 
 		post_deserialize(obj);
 	}
 	catch(ShogunException& e)
 	{
+		visitor->set_format_version(parent_format_version);
 		io::warn("Error while deserializeing {}: ShogunException: "
 			"{}", obj_name.c_str(), e.what());
 		return nullptr;
 	}
+	visitor->set_format_version(parent_format_version);
 
 	return obj;
 }
@@ -180,7 +254,7 @@ std::shared_ptr<SGObject> BitseryDeserializer::read_object()
 {
 	InputStreamAdapter adapter { stream() };
 	BitseryDeser deser {std::move(adapter)};
-	BitseryReaderVisitor<BitseryDeser> reader_visitor(deser);
+	BitseryReaderVisitor<BitseryDeser> reader_visitor(deser, stream());
 	return object_reader(deser, addressof(reader_visitor));
 }
 
@@ -188,6 +262,71 @@ void BitseryDeserializer::read(std::shared_ptr<SGObject> _this)
 {
 	InputStreamAdapter adapter { stream() };
 	BitseryDeser deser {std::move(adapter)};
-	BitseryReaderVisitor<BitseryDeser> reader_visitor(deser);
+	BitseryReaderVisitor<BitseryDeser> reader_visitor(deser, stream());
 	object_reader(deser, addressof(reader_visitor), _this);
 }
+
+std::shared_ptr<SGObject> BitseryDeserializer::read_object_lazy()
+{
+	auto input = stream();
+	InputStreamAdapter adapter { input };
+	BitseryDeser deser {std::move(adapter)};
+
+	size_t obj_magic;
+	deser.value8b(obj_magic);
+	require(obj_magic == detail::kIndexedObjectMagic,
+		"The stream does not contain an object with a table of contents");
+	auto format_version = read_format_version(deser, obj_magic);
+
+	string obj_name;
+	deser.text1b(obj_name, 64);
+	uint16_t primitive_type;
+	deser.value2b(primitive_type);
+	auto obj = create(obj_name.c_str(), static_cast<EPrimitiveType>(primitive_type));
+	require(obj, "Trying to deserialize an unknown object {}", obj_name);
+	// members that are used directly hold their default values until the
+	// parameters are loaded, only the entry points of machines load them
+	require(std::dynamic_pointer_cast<Machine>(obj),
+		"Only machines can be read lazily, {} has to be read with read_object()",
+		obj_name);
+
+	pre_deserialize(obj);
+	auto toc = read_table_of_contents(deser);
+	if (toc.empty())
+	{
+		post_deserialize(obj);
+		return obj;
+	}
+
+	// the parameters are stored right after the table of contents
+	std::map<string, int64_t, std::less<>> offsets;
+	std::vector<string> names;
+	auto offset = input->tell();
+	for (const auto& entry: toc)
+	{
+		offsets.emplace(entry.first, offset);
+		names.push_back(entry.first);
+		offset += entry.second;
+	}
+
+	// the object serializes the calls, each parameter is loaded once
+	auto loader = [input, format_version, offsets = std::move(offsets), remaining = names.size()](
+		SGObject* o, std::string_view name) mutable
+	{
+		const auto& [param_name, param_offset] = *offsets.find(name);
+		input->reset();
+		if (auto ec = input->skip(param_offset))
+			throw io::to_system_error(ec);
+
+		InputStreamAdapter adapter { input };
+		BitseryDeser deser {std::move(adapter)};
+		BitseryReaderVisitor<BitseryDeser> reader_visitor(deser, input);
+		reader_visitor.set_format_version(format_version);
+		o->visit_parameter(BaseTag(param_name), addressof(reader_visitor));
+
+		if (--remaining == 0)
+			post_deserialize(o->shared_from_this());
+	};
+	obj->set_lazy_parameters(names, std::move(loader));
+	return obj;
+}
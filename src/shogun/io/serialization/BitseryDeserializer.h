@@ -19,6 +19,19 @@ namespace shogun
 			std::shared_ptr<SGObject> read_object() override;
 			void read(std::shared_ptr<SGObject> _this) override;
 
+			/** Reads a machine written by BitserySerializer with a table of
+			 * contents, see BitserySerializer::set_table_of_contents(),
+			 * without reading its parameters. Each parameter is read from the stream when it
+			 * is first accessed, see SGObject::set_lazy_parameters(), so the
+			 * stream has to remain valid and seekable until then. Training
+			 * and the apply methods of the machine load all parameters that
+			 * are still pending. Other objects are not supported, as their
+			 * members are used directly.
+			 *
+			 * @return the object with lazily loaded parameters
+			 */
+			std::shared_ptr<SGObject> read_object_lazy();
+
 			const char* get_name() const override
 			{
 				return "BitseryDeserializer";
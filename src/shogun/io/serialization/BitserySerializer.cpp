@@ -21,8 +21,23 @@ template<class Writer>
 class BitseryWriterVisitor : public detail::BitseryVisitor<Writer, BitseryWriterVisitor<Writer>>
 {
 public:
-	BitseryWriterVisitor(Writer& w):
-		detail::BitseryVisitor<Writer,BitseryWriterVisitor<Writer>>(w) {}
+	BitseryWriterVisitor(Writer& w, shared_ptr<OutputStream> stream):
+		detail::BitseryVisitor<Writer,BitseryWriterVisitor<Writer>>(w),
+		m_stream(std::move(stream)) {}
+
+	// the storage of dense containers is written with a single call after
+	// its size, instead of element by element
+	bool on_bulk(Writer& writer, void* data, uint64_t num_bytes)
+	{
+		writer.value8b(num_bytes);
+		if (num_bytes)
+		{
+			auto ec = m_stream->write(data, num_bytes);
+			if (ec)
+				throw io::to_system_error(ec);
+		}
+		return true;
+	}
 
 	void on_complex(Writer& writer, complex128_t* v)
 	{
@@ -74,6 +89,9 @@ public:
 	}
 
 	std::optional<float64_t> m_auto_value;
+
+private:
+	shared_ptr<OutputStream> m_stream;
 };
 
 struct OutputStreamAdapter
@@ -102,15 +120,33 @@ struct OutputStreamAdapter
 	size_t written_bytes = 0;
 };
 
-// cannot use context because of circular dependency :(
-template<typename Writer>
-void write_object(Writer& writer, BitseryWriterVisitor<Writer>* visitor, const shared_ptr<SGObject>& o) noexcept(false)
+// keeps the bytes written to it in memory
+class MemoryOutputStream : public OutputStream
+{
+public:
+	MemoryOutputStream() : OutputStream() {}
+	~MemoryOutputStream() override {}
+
+	error_condition close() override { return {}; }
+	error_condition flush() override { return {}; }
+	error_condition write(const void* buffer, int64_t size) override
+	{
+		auto bytes = static_cast<const char*>(buffer);
+		m_bytes.insert(m_bytes.end(), bytes, bytes + size);
+		return {};
+	}
+
+	const char* data() const { return m_bytes.data(); }
+	int64_t size() const { return m_bytes.size(); }
+
+	const char* get_name() const override { return "MemoryOutputStream"; }
+
+private:
+	vector<char> m_bytes;
+};
+
+map<string, shared_ptr<const AnyParameter>> serializable_params(const shared_ptr<SGObject>& o)
 {
-	pre_serialize(o);
-	writer.value8b(sizeof(o.get()));
-	string name(o->get_name());
-	writer.text1b(name, 64);
-	writer.value2b(static_cast<uint16_t>(o->get_generic()));
 	auto params = o->get_params();
 	for (auto it = params.begin(); it != params.end();)
 	{
@@ -119,6 +155,20 @@ void write_object(Writer& writer, BitseryWriterVisitor<Writer>* visitor, const s
 		else
 			++it;
 	}
+	return params;
+}
+
+// cannot use context because of circular dependency :(
+template<typename Writer>
+void write_object(Writer& writer, BitseryWriterVisitor<Writer>* visitor, const shared_ptr<SGObject>& o) noexcept(false)
+{
+	pre_serialize(o);
+	writer.value8b(detail::kObjectMagic);
+	writer.value2b(visitor->get_format_version());
+	string name(o->get_name());
+	writer.text1b(name, 64);
+	writer.value2b(static_cast<uint16_t>(o->get_generic()));
+	auto params = serializable_params(o);
 	writer.value8b(params.size());
 	for (const auto& p: params)
 	{
@@ -131,7 +181,44 @@ void write_object(Writer& writer, BitseryWriterVisitor<Writer>* visitor, const s
 using OutputAdapter = AdapterWriter<OutputStreamAdapter, bitsery::DefaultConfig>;
 using BitserySer = BasicSerializer<OutputAdapter>;
 
-BitserySerializer::BitserySerializer() : Serializer()
+// writes the parameters after a table of contents with the size of each,
+// so that BitseryDeserializer::read_object_lazy can skip to any of them.
+// As the sizes have to precede the parameters, these are written to memory
+// first. Nested objects are written in the plain format.
+void write_indexed_object(BitserySer& writer, const shared_ptr<OutputStream>& stream, const shared_ptr<SGObject>& o) noexcept(false)
+{
+	pre_serialize(o);
+	auto buffer = make_shared<MemoryOutputStream>();
+	OutputStreamAdapter adapter { buffer };
+	BitserySer buffer_serializer {std::move(adapter)};
+	BitseryWriterVisitor<BitserySer> buffer_visitor(buffer_serializer, buffer);
+
+	writer.value8b(detail::kIndexedObjectMagic);
+	writer.value2b(buffer_visitor.get_format_version());
+	string name(o->get_name());
+	writer.text1b(name, 64);
+	writer.value2b(static_cast<uint16_t>(o->get_generic()));
+	auto params = serializable_params(o);
+	writer.value8b(params.size());
+
+	for (const auto& p: params)
+	{
+		auto offset = buffer->size();
+		p.second->get_value().visit(addressof(buffer_visitor));
+		writer.text1b(p.first, 64);
+		writer.value8b(static_cast<uint64_t>(buffer->size() - offset));
+	}
+
+	if (buffer->size())
+	{
+		auto ec = stream->write(buffer->data(), buffer->size());
+		if (ec)
+			throw io::to_system_error(ec);
+	}
+	post_serialize(o);
+}
+
+BitserySerializer::BitserySerializer() : Serializer(), m_table_of_contents(false)
 {
 }
 
@@ -139,10 +226,25 @@ BitserySerializer::~BitserySerializer()
 {
 }
 
+void BitserySerializer::set_table_of_contents(bool table_of_contents)
+{
+	m_table_of_contents = table_of_contents;
+}
+
+bool BitserySerializer::get_table_of_contents() const
+{
+	return m_table_of_contents;
+}
+
 void BitserySerializer::write(const shared_ptr<SGObject>& object) noexcept(false)
 {
 	OutputStreamAdapter adapter { stream() };
  	BitserySer serializer {std::move(adapter)};
- 	BitseryWriterVisitor<BitserySer> writer_visitor(serializer);
+	if (m_table_of_contents)
+	{
+		write_indexed_object(serializer, stream(), object);
+		return;
+	}
+ 	BitseryWriterVisitor<BitserySer> writer_visitor(serializer, stream());
  	write_object(serializer, addressof(writer_visitor), object);
 }
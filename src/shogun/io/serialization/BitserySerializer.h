@@ -18,10 +18,25 @@ namespace shogun
 			~BitserySerializer() override;
 			void write(const std::shared_ptr<SGObject>& object) override;
 
+			/** Write a table of contents with the size of each parameter
+			 * in front of the parameters of the top level object, which is
+			 * required by BitseryDeserializer::read_object_lazy(). The
+			 * parameters are then kept in memory until they are written.
+			 *
+			 * @param table_of_contents whether to write the table
+			 */
+			void set_table_of_contents(bool table_of_contents);
+
+			/** @return whether a table of contents is written */
+			bool get_table_of_contents() const;
+
 			const char* get_name() const override
 			{
 				return "BitserySerializer";
 			}
+
+		private:
+			bool m_table_of_contents;
 		};
 	}
 }
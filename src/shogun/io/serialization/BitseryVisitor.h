@@ -7,6 +7,7 @@
 
 #include <shogun/lib/any.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/util/system.h>
 
 namespace shogun
 {
@@ -15,13 +16,42 @@ namespace shogun
 		namespace detail
 		{
 			static const size_t kNullObjectMagic = std::numeric_limits<size_t>::max();
+			/** marks an object followed by a table of contents of its
+			 * parameters, which can be loaded individually */
+			static const size_t kIndexedObjectMagic = kNullObjectMagic - 1;
+			/** marks an object, both this and kIndexedObjectMagic are
+			 * followed by the format version of the object. Objects of
+			 * older files start with another value and have version 0. */
+			static const size_t kObjectMagic = kNullObjectMagic - 2;
+			/** format version from which the storage of dense numeric
+			 * containers is written at once, see AnyVisitor::on_blob() */
+			static const uint16_t kBlobFormatVersion = 1;
+			/** latest format version */
+			static const uint16_t kFormatVersion = kBlobFormatVersion;
+			/** bytes of dense containers copied at once from or to a stream */
+			static const uint64_t kBulkChunkSize = 1 << 24;
 
 			template <class S, class T>
 			class BitseryVisitor : public AnyVisitor
 			{
 			public:
 				BitseryVisitor(S& s):
-					AnyVisitor(), m_s(s) {}
+					AnyVisitor(), m_s(s),
+					// the raw storage is only portable in bitsery's little
+					// endian byte order, big endian hosts write the elements
+					m_format_version(utils::is_big_endian() ? 0 : kFormatVersion) {}
+
+				/** @param version format version of the visited data */
+				void set_format_version(uint16_t version)
+				{
+					m_format_version = version;
+				}
+
+				/** @return format version of the visited data */
+				uint16_t get_format_version() const
+				{
+					return m_format_version;
+				}
 
 				void on(bool* v) override
 				{
@@ -131,8 +161,16 @@ namespace shogun
 				void exit_std_vector(size_t* size) override {}
 				void exit_map(size_t* size) override {}
 
+				bool on_blob(void* data, size_t element_size, int64_t num_elements) override
+				{
+					if (m_format_version < kBlobFormatVersion)
+						return false;
+					return static_cast<T*>(this)->on_bulk(m_s, data, element_size * num_elements);
+				}
+
 			private:
 				S& m_s;
+				uint16_t m_format_version;
 				SG_DELETE_COPY_AND_ASSIGN(BitseryVisitor);
 			};
 		} // namespace detail
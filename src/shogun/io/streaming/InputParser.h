@@ -14,12 +14,13 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/io/streaming/StreamingFile.h>
 #include <shogun/io/streaming/ParseBuffer.h>
-#include <condition_variable>
+#include <algorithm>
+#include <atomic>
 #include <memory>
-#include <mutex>
 #include <thread>
 
 #define PARSER_DEFAULT_BUFFSIZE 100
+#define PARSER_DEFAULT_BATCHSIZE 32
 
 namespace shogun
 {
@@ -58,9 +59,12 @@ namespace shogun
  * function which starts a new thread for continuous parsing of examples.
  *
  * Parsing is done through the ParseBuffer object, which in its
- * current implementation is a ring of a specified number of examples.
- * It is the task of the InputParser object to ensure that this ring
- * is being updated with new parsed examples.
+ * current implementation is a lock-free single-producer/single-consumer
+ * ring of a specified number of examples. It is the task of the
+ * InputParser object to ensure that this ring is being updated with
+ * new parsed examples. Examples are parsed in place into the slots of
+ * the ring and handed over to the consumer in batches, see
+ * set_batch_size().
  *
  * InputParser provides mainly the get_next_example function which
  * returns the next example from the ParseBuffer object to the caller
@@ -211,24 +215,16 @@ public:
 
 
     /**
-     * Copy example into the buffer.
+     * Retrieves the next example from the buffer, without waiting.
      *
-     * @param ex Example to be copied.
-     */
-    void copy_example_into_buffer(Example<T>* ex);
-
-    /**
-     * Retrieves the next example from the buffer.
-     *
-     *
-     * @return The example pointer.
+     * @return The example pointer, or NULL if none has been parsed yet.
      */
     Example<T>* retrieve_example();
 
     /**
      * Gets the next example, assuming it to be labelled.
      *
-     * Waits till retrieve_example returns a valid example, or
+     * Spins till retrieve_example returns a valid example, or
      * returns if reading is done already.
      *
      * @param feature_vector Feature vector pointer
@@ -278,6 +274,25 @@ public:
      */
     int32_t get_ring_size() { return ring_size; }
 
+    /**
+     * Sets the maximum number of examples the parse thread
+     * claims and publishes to the ring at once. Larger batches
+     * reduce the synchronisation between the parse thread and the
+     * learner, at the cost of latency for the first examples.
+     *
+     * Must be called before start_parser().
+     *
+     * @param size number of examples per batch
+     */
+    void set_batch_size(int32_t size);
+
+    /**
+     * Returns the number of examples handed over at once
+     *
+     * @return batch size in terms of number of examples
+     */
+    int32_t get_batch_size() { return batch_size; }
+
 private:
     /**
      * Entry point for the parse thread.
@@ -289,8 +304,8 @@ private:
     static void* parse_loop_entry_point(void* params);
 
 public:
-    bool parsing_done;	/**< true if all input is parsed */
-    bool reading_done;	/**< true if all examples are fetched */
+    std::atomic_bool parsing_done;	/**< true if all input is parsed */
+    std::atomic_bool reading_done;	/**< true if all examples are fetched */
 
     E_EXAMPLE_TYPE example_type; /**< LABELLED or UNLABELLED */
 
@@ -329,29 +344,17 @@ protected:
     /// Number of vectors used by external algorithm
     int32_t number_of_vectors_read;
 
-    /// Example currently being used
+    /// Example currently being parsed
     Example<T>* current_example;
 
-    /// Feature vector of current example
-    T* current_feature_vector;
-
-    /// Label of current example
-    float64_t current_label;
-
-    /// Number of features in current example
-    int32_t current_len;
-
     /// Whether to SG_FREE() vector after it is used
     bool free_after_release;
 
     /// Size of the ring of examples
     int32_t ring_size;
 
-    /// Mutex which is used when getting/setting state of examples (whether a new example is ready)
-	std::mutex examples_state_lock;
-
-    /// Condition variable to indicate change of state of examples
-	std::condition_variable examples_state_changed;
+    /// Number of examples claimed and published at once by the parse thread
+    int32_t batch_size;
 
 	/// Flag that indicate that the parsing thread should continue reading
 	alignas(CPU_CACHE_LINE_SIZE) std::atomic_bool keep_running;
@@ -398,12 +401,20 @@ template <class T>
     number_of_vectors_parsed = 0;
     number_of_vectors_read = 0;
 
-    current_len = -1;
-    current_label = -1;
-    current_feature_vector = NULL;
+    current_example = NULL;
 
     free_after_release=true;
     ring_size=size;
+    batch_size=std::min(PARSER_DEFAULT_BATCHSIZE, size);
+    examples_ring->set_release_batch_size(batch_size);
+}
+
+template <class T>
+    void InputParser<T>::set_batch_size(int32_t size)
+{
+    require(size > 0, "Batch size ({}) must be positive", size);
+    batch_size=std::min(size, ring_size);
+    examples_ring->set_release_batch_size(batch_size);
 }
 
 template <class T>
@@ -449,10 +460,9 @@ template <class T>
 {
 	SG_TRACE("entering InputParser::is_running()");
     bool ret;
-	std::lock_guard<std::mutex> lock(examples_state_lock);
 
-    if (parsing_done)
-        if (reading_done)
+    if (parsing_done.load(std::memory_order_acquire))
+        if (reading_done.load(std::memory_order_acquire))
             ret = false;
         else
             ret = true;
@@ -494,87 +504,56 @@ template <class T>
     return 1;
 }
 
-template <class T>
-    void InputParser<T>::copy_example_into_buffer(Example<T>* ex)
-{
-    examples_ring->copy_example(ex);
-}
-
 template <class T> void* InputParser<T>::main_parse_loop(void* params)
 {
-    // Read the examples into current_* objects
-    // Instead of allocating mem for new objects each time
+    // Parse the examples directly into the slots of the ring,
+    // claiming and publishing them batch_size at a time
     InputParser* this_obj = (InputParser *) params;
     this->input_source = this_obj->input_source;
 
     while (keep_running.load(std::memory_order_acquire))
 	{
-		std::unique_lock<std::mutex> lock(examples_state_lock);
-
-		if (parsing_done)
-		{
+		if (parsing_done.load(std::memory_order_acquire))
 			return NULL;
-		}
-		lock.unlock();
-
-		current_example = examples_ring->get_free_example();
-		current_feature_vector = current_example->fv;
-		current_len = current_example->length;
-		current_label = current_example->label;
 
-		if (example_type == E_LABELLED)
-			get_vector_and_label(current_feature_vector, current_len, current_label);
-		else
-			get_vector_only(current_feature_vector,	current_len);
+		int32_t num_claimed = 0;
+		examples_ring->wait_until([&]() {
+			num_claimed = examples_ring->acquire_free_examples(batch_size);
+			return num_claimed > 0
+				|| !keep_running.load(std::memory_order_acquire);
+		});
+		if (num_claimed == 0)
+			continue;
 
-		if (current_len < 0)
+		for (int32_t i = 0; i < num_claimed; i++)
 		{
-			lock.lock();
-			parsing_done = true;
-			examples_state_changed.notify_one();
-			return NULL;
+			current_example = examples_ring->get_free_example(i);
+
+			if (example_type == E_LABELLED)
+				get_vector_and_label(current_example->fv,
+					current_example->length, current_example->label);
+			else
+				get_vector_only(current_example->fv, current_example->length);
+
+			if (current_example->length < 0)
+			{
+				examples_ring->publish_examples(i);
+				number_of_vectors_parsed += i;
+				parsing_done.store(true, std::memory_order_release);
+				examples_ring->notify();
+				return NULL;
+			}
 		}
 
-		current_example->label = current_label;
-		current_example->fv = current_feature_vector;
-		current_example->length = current_len;
-
-		examples_ring->copy_example(current_example);
-		lock.lock();
-		number_of_vectors_parsed++;
-		examples_state_changed.notify_one();
+		examples_ring->publish_examples(num_claimed);
+		number_of_vectors_parsed += num_claimed;
 	}
     return NULL;
 }
 
 template <class T> Example<T>* InputParser<T>::retrieve_example()
 {
-    /* This function should be guarded by mutexes while calling  */
-    Example<T> *ex;
-
-    if (parsing_done)
-    {
-        if (number_of_vectors_read == number_of_vectors_parsed)
-        {
-            reading_done = true;
-            /* Signal to waiting threads that no more examples are left */
-			examples_state_changed.notify_one();
-            return NULL;
-        }
-    }
-
-    if (number_of_vectors_parsed <= 0)
-        return NULL;
-
-    if (number_of_vectors_read == number_of_vectors_parsed)
-    {
-        return NULL;
-    }
-
-    ex = examples_ring->get_unused_example();
-    number_of_vectors_read++;
-
-    return ex;
+    return examples_ring->get_unused_example();
 }
 
 template <class T> int32_t InputParser<T>::get_next_example(T* &fv,
@@ -582,40 +561,44 @@ template <class T> int32_t InputParser<T>::get_next_example(T* &fv,
 {
     /* if reading is done, no more examples can be fetched. return 0
        else, if example can be read, get the example and return 1.
-       otherwise, wait for further parsing, get the example and
-       return 1 */
+       otherwise, wait until the parser publishes further examples,
+       get the example and return 1 */
 
-    Example<T> *ex;
+    Example<T> *ex = NULL;
 
-    while (keep_running.load(std::memory_order_acquire))
+    while (ex == NULL)
     {
-        if (reading_done)
+        if (reading_done.load(std::memory_order_relaxed)
+            || !keep_running.load(std::memory_order_acquire))
             return 0;
 
-		std::unique_lock<std::mutex> lock(examples_state_lock);
+        /* parsing_done has to be read before looking into the ring,
+           otherwise examples published right before it was set
+           could be missed */
+        bool parsed_all = parsing_done.load(std::memory_order_acquire);
         ex = retrieve_example();
 
         if (ex == NULL)
         {
-            if (reading_done)
+            if (parsed_all)
             {
                 /* No more examples left, return */
+                reading_done.store(true, std::memory_order_release);
                 return 0;
             }
-            else
-            {
-                /* Examples left, wait for one to become ready */
-				examples_state_changed.wait(lock);
-                continue;
-            }
-        }
-        else
-        {
-            /* Example ready, return the example */
-            break;
+
+            /* Examples left, hand the used ones back to the parser
+               and wait for one to become ready */
+            examples_ring->release_examples();
+            examples_ring->wait_until([this]() {
+                return examples_ring->get_unused_example() != NULL
+                    || parsing_done.load(std::memory_order_acquire)
+                    || !keep_running.load(std::memory_order_acquire);
+            });
         }
     }
 
+    number_of_vectors_read++;
     fv = ex->fv;
     length = ex->length;
     label = ex->label;
@@ -650,7 +633,8 @@ template <class T> void InputParser<T>::exit_parser()
 {
 	SG_TRACE("cancelling parse thread");
 	keep_running.store(false, std::memory_order_release);
-	examples_state_changed.notify_one();
+	if (examples_ring)
+		examples_ring->notify();
 	if (parse_thread.joinable())
 		parse_thread.join();
 }
@@ -12,23 +12,17 @@
 #include <shogun/lib/common.h>
 #include <shogun/base/SGObject.h>
 #include <shogun/lib/DataType.h>
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
-#include <memory>
 #include <mutex>
-#include <vector>
+#include <thread>
+
+#define PARSEBUFFER_SPIN_COUNT 64
 
 namespace shogun
 {
 
-/// Specifies whether location is empty,
-/// contains an unused example or a used example.
-enum E_IS_EXAMPLE_USED
-{
-	E_EMPTY = 1,
-	E_NOT_USED = 2,
-	E_USED = 3
-};
-
 /** @brief Class Example is the container type for
  * the vector+label combination.
  *
@@ -53,17 +47,25 @@ public:
  * examples of a defined size. The ring stores
  * objects of the Example type.
  *
- * The feature vector and label are provided to this
- * class from an external source. ParseBuffer is
- * only responsible for managing how these examples
- * are represented and stored in the memory. It is
- * also responsible for returning stored examples to be
- * used by an external caller, and freeing up the space
- * when the example is used to make room for another
- * example to take its place.
+ * The ring is a single-producer/single-consumer
+ * lock-free queue: one thread (the parser) claims
+ * free slots and parses examples directly into them,
+ * another thread (the learner) reads the published
+ * examples and releases them once it is done.
+ * Both sides only synchronise through two monotonic
+ * counters, so no locks are taken and examples are
+ * never copied.
+ *
+ * Handoff is batched: the producer claims and publishes
+ * several slots at once, and the consumer releases them
+ * in batches too (see set_release_batch_size()) and
+ * caches the number of published examples, so that the
+ * shared counters are only touched once per batch.
  *
- * Writing of examples is done into whichever position
- * in the ring is free to be overwritten, or empty.
+ * None of the methods above block. A side that has to
+ * wait for free slots or published examples calls
+ * wait_until(), which spins shortly and then sleeps until
+ * the other side publishes or releases examples.
  */
 template <class T> class ParseBuffer: public SGObject
 {
@@ -82,64 +84,92 @@ public:
 	~ParseBuffer() override;
 
 	/**
-	 * Return the next position to write the example
-	 * into the ring.
+	 * Claims up to n free slots of the ring for writing.
+	 * Must only be called by the producer.
 	 *
-	 * @return pointer to example
+	 * The claimed slots are accessed with get_free_example()
+	 * and handed to the consumer with publish_examples().
+	 *
+	 * @param n maximum number of slots to claim
+	 *
+	 * @return number of slots claimed, 0 if the ring is full
 	 */
-	Example<T>* get_free_example()
-	{
-		std::unique_lock<std::mutex> write_lk(*write_mutex, std::defer_lock);
-		std::unique_lock<std::mutex> current_ex_lock(*ex_in_use_mutex[ex_write_index], std::defer_lock);
-		std::lock(write_lk, current_ex_lock);
-		while (ex_used[ex_write_index] == E_NOT_USED)
-			ex_in_use_cond[ex_write_index]->wait(current_ex_lock);
-		Example<T>* ex=&ex_ring[ex_write_index];
-		return ex;
-	}
+	int32_t acquire_free_examples(int32_t n);
 
 	/**
-	 * Writes the given example into the appropriate buffer space.
-	 * Feature vector is copied into a separate block.
+	 * Returns a claimed slot, so that an example can be
+	 * parsed directly into it.
 	 *
-	 * @param ex Example to copy into buffer
+	 * @param i offset of the slot among the claimed ones
 	 *
-	 * @return 1 if successful, 0 on failure (if no space available)
+	 * @return pointer to example
 	 */
-	int32_t write_example(Example<T>* ex);
+	Example<T>* get_free_example(int32_t i = 0)
+	{
+		return &ex_ring[(ex_write_index + i) % ring_size];
+	}
 
 	/**
-	 * Returns the example that should be read next from the buffer.
+	 * Makes the first n claimed slots visible to the consumer.
 	 *
-	 * @return example object at next 'read' position
+	 * @param n number of examples to publish
 	 */
-	Example<T>* return_example_to_read();
+	void publish_examples(int32_t n);
 
 	/**
-	 * Returns the next example from the buffer if unused, or NULL.
+	 * Returns the next example from the buffer if it has
+	 * been published, or NULL. Must only be called by the
+	 * consumer.
 	 *
 	 * @return unused example object at next 'read' position or NULL.
 	 */
 	Example<T>* get_unused_example();
 
 	/**
-	 * Copies an example into the buffer, waiting for the
-	 * destination example to be used if necessary.
+	 * Mark the example in 'read' position as 'used'.
 	 *
-	 * @param ex Example to copy into buffer
+	 * It will be free to be overwritten once it is released,
+	 * which happens every release batch size examples or
+	 * on release_examples().
 	 *
-	 * @return 1 on success, 0 on memory errors
+	 * @param free_after_release whether to SG_FREE() the vector or not
 	 */
-	int32_t copy_example(Example<T>* ex);
+	void finalize_example(bool free_after_release);
 
 	/**
-	 * Mark the example in 'read' position as 'used'.
+	 * Hands all used examples back to the producer.
+	 * Must only be called by the consumer, before it waits
+	 * for further examples.
+	 */
+	void release_examples();
+
+	/**
+	 * Sets the number of used examples that the consumer
+	 * releases at once.
 	 *
-	 * It will then be free to be overwritten.
+	 * @param n release batch size, at most half the ring size so
+	 * that the producer can refill while the consumer works
+	 */
+	void set_release_batch_size(int32_t n)
+	{
+		release_batch_size = std::max(1, std::min(n, ring_size / 2));
+	}
+
+	/**
+	 * Blocks until ready() returns true. Spins for a few
+	 * rounds first, then sleeps until the other side
+	 * publishes or releases examples or notify() is called.
 	 *
-	 * @param free_after_release whether to SG_FREE() the vector or not
+	 * @param ready condition to wait for
 	 */
-	void finalize_example(bool free_after_release);
+	template <class Predicate>
+	void wait_until(Predicate ready);
+
+	/**
+	 * Wakes up the threads sleeping in wait_until(), so that
+	 * they check their condition again.
+	 */
+	void notify();
 
 	/**
 	 * Set whether all vectors are to be freed
@@ -176,25 +206,6 @@ public:
 	 */
 	void init_vector();
 
-protected:
-	/**
-	 * Increments the 'read' position in the buffer.
-	 *
-	 */
-	virtual void inc_read_index()
-	{
-		ex_read_index=(ex_read_index + 1) % ring_size;
-	}
-
-	/**
-	 * Increments the 'write' position in the buffer.
-	 *
-	 */
-	virtual void inc_write_index()
-	{
-		ex_write_index=(ex_write_index + 1) % ring_size;
-	}
-
 protected:
 
 	/// Size of ring as number of examples
@@ -202,24 +213,33 @@ protected:
 	/// Ring of examples
 	Example<T>* ex_ring;
 
-	/// Enum used for representing used/unused/empty state of example
-	E_IS_EXAMPLE_USED* ex_used;
-	/// Lock on state of example - used or unused
-	std::vector<std::shared_ptr<std::mutex> > ex_in_use_mutex;
-	/// Condition variable triggered when example is being/not being used
-	std::vector<std::shared_ptr<std::condition_variable> > ex_in_use_cond;
-	/// Lock for reading examples from the ring
-	std::shared_ptr<std::mutex> read_mutex;
-	/// Lock for writing new examples
-	std::shared_ptr<std::mutex> write_mutex;
-
-	/// Write position for next example
-	int32_t ex_write_index;
-	/// Position of next example to be read
-	int32_t ex_read_index;
+	/// Number of examples published by the producer
+	alignas(CPU_CACHE_LINE_SIZE) std::atomic<int64_t> num_written;
+	/// Producer: position of the next slot to write
+	int64_t ex_write_index;
+	/// Producer: last seen value of num_read
+	int64_t cached_num_read;
+	/// Producer: number of slots claimed but not yet published
+	int32_t num_claimed;
+
+	/// Number of examples released by the consumer
+	alignas(CPU_CACHE_LINE_SIZE) std::atomic<int64_t> num_read;
+	/// Consumer: position of the next example to read
+	int64_t ex_read_index;
+	/// Consumer: last seen value of num_written
+	int64_t cached_num_written;
+	/// Consumer: number of used examples released at once
+	int32_t release_batch_size;
+
+	/// Number of threads sleeping in wait_until()
+	alignas(CPU_CACHE_LINE_SIZE) std::atomic<int32_t> num_waiting;
+	/// Guards the sleep in wait_until()
+	std::mutex wait_mutex;
+	/// Signalled when examples are published or released
+	std::condition_variable wait_cond;
 
 	/// Whether examples on the ring will be freed on destruction
-	bool free_vectors_on_destruct;
+	alignas(CPU_CACHE_LINE_SIZE) bool free_vectors_on_destruct;
 };
 
 
@@ -238,24 +258,23 @@ template <class T> ParseBuffer<T>::ParseBuffer(int32_t size)
 {
 	ring_size = size;
 	ex_ring = SG_CALLOC(Example<T>, ring_size);
-	ex_used = SG_MALLOC(E_IS_EXAMPLE_USED, ring_size);
-	read_mutex = std::make_shared<std::mutex>();
-	write_mutex = std::make_shared<std::mutex>();
 	io::info("Initialized with ring size: {}.", ring_size);
 
+	num_written.store(0, std::memory_order_relaxed);
+	num_read.store(0, std::memory_order_relaxed);
 	ex_write_index = 0;
 	ex_read_index = 0;
+	cached_num_read = 0;
+	cached_num_written = 0;
+	num_claimed = 0;
+	release_batch_size = 1;
+	num_waiting.store(0, std::memory_order_relaxed);
 
 	for (int32_t i=0; i<ring_size; i++)
 	{
-		ex_used[i] = E_EMPTY;
-
 		ex_ring[i].fv = NULL;
 		ex_ring[i].length = 1;
 		ex_ring[i].label = FLT_MAX;
-
-		ex_in_use_mutex.push_back(std::make_shared<std::mutex>());
-		ex_in_use_cond.push_back(std::make_shared<std::condition_variable>());
 	}
 	free_vectors_on_destruct = true;
 }
@@ -272,91 +291,106 @@ template <class T> ParseBuffer<T>::~ParseBuffer()
 		}
 	}
 	SG_FREE(ex_ring);
-	SG_FREE(ex_used);
-
-	ex_in_use_mutex.clear();
-	ex_in_use_cond.clear();
-	read_mutex.reset();
-	write_mutex.reset();
 }
 
 template <class T>
-int32_t ParseBuffer<T>::write_example(Example<T> *ex)
+int32_t ParseBuffer<T>::acquire_free_examples(int32_t n)
 {
-	ex_ring[ex_write_index].label = ex->label;
-	ex_ring[ex_write_index].fv = ex->fv;
-	ex_ring[ex_write_index].length = ex->length;
-	ex_used[ex_write_index] = E_NOT_USED;
-	inc_write_index();
+	int64_t num_free = ring_size - (ex_write_index - cached_num_read);
+	if (num_free < n)
+	{
+		cached_num_read = num_read.load(std::memory_order_acquire);
+		num_free = ring_size - (ex_write_index - cached_num_read);
+	}
 
-	return 1;
+	num_claimed = (int32_t)std::min((int64_t)n, num_free);
+	return num_claimed;
 }
 
 template <class T>
-Example<T>* ParseBuffer<T>::return_example_to_read()
+void ParseBuffer<T>::publish_examples(int32_t n)
 {
-	if (ex_read_index >= 0)
-		return &ex_ring[ex_read_index];
-	else
-		return NULL;
+	ASSERT(n <= num_claimed)
+
+	ex_write_index += n;
+	num_claimed = 0;
+	num_written.store(ex_write_index, std::memory_order_release);
+	notify();
 }
 
 template <class T>
 Example<T>* ParseBuffer<T>::get_unused_example()
 {
-	std::lock_guard<std::mutex> read_lk(*read_mutex);
-
-	Example<T> *ex;
-	int32_t current_index = ex_read_index;
-	// Because read index will change after return_example_to_read
-
-	std::lock_guard<std::mutex> current_ex_lk(*ex_in_use_mutex[current_index]);
-
-	if (ex_used[current_index] == E_NOT_USED)
-		ex = return_example_to_read();
-	else
-		ex = NULL;
+	if (ex_read_index == cached_num_written)
+	{
+		cached_num_written = num_written.load(std::memory_order_acquire);
+		if (ex_read_index == cached_num_written)
+			return NULL;
+	}
 
-	return ex;
+	return &ex_ring[ex_read_index % ring_size];
 }
 
 template <class T>
-int32_t ParseBuffer<T>::copy_example(Example<T> *ex)
+void ParseBuffer<T>::finalize_example(bool free_after_release)
 {
-	std::lock_guard<std::mutex> write_lk(*write_mutex);
-	int32_t ret;
-	int32_t current_index = ex_write_index;
+	Example<T>* ex = &ex_ring[ex_read_index % ring_size];
 
-	std::unique_lock<std::mutex> current_ex_lock(*ex_in_use_mutex[current_index]);
-	while (ex_used[ex_write_index] == E_NOT_USED)
+	if (free_after_release)
 	{
-		ex_in_use_cond[ex_write_index]->wait(current_ex_lock);
-	}
+		SG_DEBUG("Freeing object in ring at index {} and address: {}.",
+			 ex_read_index % ring_size, fmt::ptr(ex->fv));
 
-	ret = write_example(ex);
+		SG_FREE(ex->fv);
+		ex->fv=NULL;
+	}
 
-	return ret;
+	ex_read_index++;
+	if (ex_read_index - num_read.load(std::memory_order_relaxed) >= release_batch_size)
+		release_examples();
 }
 
 template <class T>
-void ParseBuffer<T>::finalize_example(bool free_after_release)
+void ParseBuffer<T>::release_examples()
 {
-	std::lock_guard<std::mutex> read_lk(*read_mutex);
-	std::unique_lock<std::mutex> current_ex_lock(*ex_in_use_mutex[ex_read_index]);
-	ex_used[ex_read_index] = E_USED;
+	if (ex_read_index == num_read.load(std::memory_order_relaxed))
+		return;
 
-	if (free_after_release)
+	num_read.store(ex_read_index, std::memory_order_release);
+	notify();
+}
+
+template <class T>
+template <class Predicate>
+void ParseBuffer<T>::wait_until(Predicate ready)
+{
+	for (int32_t i=0; i<PARSEBUFFER_SPIN_COUNT; i++)
 	{
-		SG_DEBUG("Freeing object in ring at index {} and address: {}.",
-			 ex_read_index, fmt::ptr(ex_ring[ex_read_index].fv));
+		if (ready())
+			return;
+		std::this_thread::yield();
+	}
 
-		SG_FREE(ex_ring[ex_read_index].fv);
-		ex_ring[ex_read_index].fv=NULL;
+	// either notify() sees the waiting thread, or ready() sees the
+	// counter that was stored before notify()
+	num_waiting.fetch_add(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	{
+		std::unique_lock<std::mutex> lock(wait_mutex);
+		wait_cond.wait(lock, ready);
 	}
+	num_waiting.fetch_sub(1, std::memory_order_relaxed);
+}
 
-	ex_in_use_cond[ex_read_index]->notify_one();
-	current_ex_lock.unlock();
-	inc_read_index();
+template <class T>
+void ParseBuffer<T>::notify()
+{
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (num_waiting.load(std::memory_order_relaxed) > 0)
+	{
+		std::lock_guard<std::mutex> lock(wait_mutex);
+		wait_cond.notify_all();
+	}
 }
 
 }
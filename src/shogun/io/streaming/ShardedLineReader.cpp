@@ -0,0 +1,156 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/io/SGIO.h>
+#include <shogun/io/streaming/ShardedLineReader.h>
+
+#include <algorithm>
+#include <fstream>
+
+using namespace shogun;
+
+ShardedLineReader::ShardedLineReader(
+    const char* fname, int32_t num_threads, bool preserve_order,
+    int64_t shard_size, ParseFunction parse)
+    : m_filename(fname), m_preserve_order(preserve_order),
+      m_shard_size(shard_size), m_parse(std::move(parse)), m_next_claim(0),
+      m_num_consumed(0), m_stop(false)
+{
+	require(num_threads > 0, "Number of threads ({}) must be positive", num_threads);
+	require(shard_size > 0, "Shard size ({}) must be positive", shard_size);
+
+	std::ifstream file(m_filename, std::ios::binary | std::ios::ate);
+	if (!file)
+		error("Error opening file '{}'", m_filename);
+	m_file_size = file.tellg();
+	m_num_shards = (m_file_size + m_shard_size - 1) / m_shard_size;
+	m_max_in_flight = 4 * num_threads;
+
+	for (int32_t i = 0; i < num_threads; ++i)
+		m_workers.emplace_back(&ShardedLineReader::worker_loop, this);
+}
+
+ShardedLineReader::~ShardedLineReader()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_shard_consumed.notify_all();
+
+	for (auto& worker : m_workers)
+		worker.join();
+}
+
+std::unique_ptr<ShardedLineReader::Shard> ShardedLineReader::next_shard()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+
+	while (true)
+	{
+		if (m_error)
+			std::rethrow_exception(m_error);
+
+		if (m_num_consumed == m_num_shards)
+			return nullptr;
+
+		// in order, the next shard is the one after all consumed ones
+		auto it = m_preserve_order ? m_parsed.find(m_num_consumed)
+		                           : m_parsed.begin();
+		if (it != m_parsed.end())
+		{
+			auto shard = std::move(it->second);
+			m_parsed.erase(it);
+			++m_num_consumed;
+			lock.unlock();
+			m_shard_consumed.notify_one();
+			return shard;
+		}
+
+		m_shard_parsed.wait(lock);
+	}
+}
+
+void ShardedLineReader::worker_loop()
+{
+	std::ifstream file(m_filename, std::ios::binary);
+	std::vector<char> data;
+
+	while (true)
+	{
+		int64_t index;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_shard_consumed.wait(lock, [this]() {
+				return m_stop || m_next_claim == m_num_shards ||
+				       m_next_claim - m_num_consumed < m_max_in_flight;
+			});
+
+			if (m_stop || m_next_claim == m_num_shards)
+				return;
+			index = m_next_claim++;
+		}
+
+		try
+		{
+			char* begin;
+			char* end;
+			read_shard(file, index, data, begin, end);
+			auto shard = m_parse(begin, end);
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_parsed.emplace(index, std::move(shard));
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_error)
+				m_error = std::current_exception();
+			m_stop = true;
+		}
+		m_shard_parsed.notify_one();
+		m_shard_consumed.notify_all();
+	}
+}
+
+void ShardedLineReader::read_shard(
+    std::ifstream& file, int64_t index, std::vector<char>& data, char*& begin,
+    char*& end) const
+{
+	const int64_t start = index * m_shard_size;
+	const int64_t stop = std::min(start + m_shard_size, m_file_size);
+	// one byte before the shard tells whether a line starts at its beginning
+	const int64_t offset = start > 0 ? start - 1 : 0;
+
+	data.resize(stop - offset);
+	file.clear();
+	file.seekg(offset);
+	file.read(data.data(), data.size());
+	if (file.gcount() != (std::streamsize)data.size())
+		error("Error reading shard {} of file '{}'", index, m_filename);
+
+	// complete the last line, which may reach into the next shard
+	if (stop < m_file_size && data.back() != '\n')
+	{
+		std::string tail;
+		std::getline(file, tail);
+		data.insert(data.end(), tail.begin(), tail.end());
+		data.push_back('\n');
+	}
+
+	size_t first = 0;
+	if (start > 0)
+	{
+		auto newline = std::find(data.begin(), data.end(), '\n');
+		first = newline == data.end() ? data.size()
+		                              : newline - data.begin() + 1;
+	}
+
+	const size_t last = data.size();
+	data.push_back('\0');
+	begin = data.data() + first;
+	end = data.data() + last;
+}
@@ -0,0 +1,136 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+#ifndef __SHARDED_LINE_READER_H__
+#define __SHARDED_LINE_READER_H__
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/common.h>
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define SHARDED_READER_DEFAULT_SHARD_SIZE (int64_t(4) << 20)
+
+namespace shogun
+{
+
+/** @brief Class ShardedLineReader parses a line based text file
+ * on several threads.
+ *
+ * The file is split into shards of a fixed number of bytes. A line
+ * belongs to the shard in which its first character lies, so every
+ * shard can be located independently by seeking to its start and
+ * skipping to the next newline. Worker threads claim shards in file
+ * order, read them with their own file handle and turn them into
+ * parsed shards with the supplied parse function.
+ *
+ * The consumer fetches parsed shards with next_shard(), either in
+ * file order or in the order in which the workers finish them. The
+ * number of shards being parsed or waiting to be consumed is bounded,
+ * so memory use does not depend on the size of the file.
+ */
+class ShardedLineReader
+{
+public:
+	/** Base class of the parsed content of one shard */
+	class Shard
+	{
+	public:
+		virtual ~Shard() = default;
+	};
+
+	/** Function turning the lines in [begin, end) into a parsed shard.
+	 * The range may be modified in place, the character at end is
+	 * always a terminating '\0'. It is called concurrently from the
+	 * worker threads.
+	 */
+	using ParseFunction =
+	    std::function<std::unique_ptr<Shard>(char* begin, char* end)>;
+
+	/** Constructor, starts the worker threads
+	 *
+	 * @param fname name of the file to parse
+	 * @param num_threads number of worker threads
+	 * @param preserve_order whether shards are returned in file order
+	 * @param shard_size size of a shard in bytes
+	 * @param parse function parsing the lines of a shard
+	 */
+	ShardedLineReader(
+	    const char* fname, int32_t num_threads, bool preserve_order,
+	    int64_t shard_size, ParseFunction parse);
+
+	/** Destructor, stops and joins the worker threads */
+	~ShardedLineReader();
+
+	/** Returns the next parsed shard, waiting for it if necessary.
+	 * Exceptions thrown while parsing are rethrown here.
+	 *
+	 * @return parsed shard, or nullptr once the whole file was returned
+	 */
+	std::unique_ptr<Shard> next_shard();
+
+private:
+	/** Main loop of the worker threads */
+	void worker_loop();
+
+	/** Reads the lines that start in the given shard into data.
+	 *
+	 * @param file file to read from
+	 * @param index index of the shard
+	 * @param data buffer receiving the shard, '\0' terminated
+	 * @param begin set to the start of the first line in data
+	 * @param end set to the end of the last line in data
+	 */
+	void read_shard(
+	    std::ifstream& file, int64_t index, std::vector<char>& data,
+	    char*& begin, char*& end) const;
+
+private:
+	/** name of the file */
+	std::string m_filename;
+	/** whether shards are returned in file order */
+	bool m_preserve_order;
+	/** size of a shard in bytes */
+	int64_t m_shard_size;
+	/** size of the file in bytes */
+	int64_t m_file_size;
+	/** number of shards in the file */
+	int64_t m_num_shards;
+	/** maximum number of shards claimed but not yet consumed */
+	int64_t m_max_in_flight;
+	/** parse function */
+	ParseFunction m_parse;
+
+	/** guards all members below */
+	std::mutex m_mutex;
+	/** signalled when a shard was parsed */
+	std::condition_variable m_shard_parsed;
+	/** signalled when a shard was consumed */
+	std::condition_variable m_shard_consumed;
+	/** parsed shards waiting to be consumed, by index */
+	std::map<int64_t, std::unique_ptr<Shard>> m_parsed;
+	/** index of the next shard to be claimed by a worker */
+	int64_t m_next_claim;
+	/** number of shards returned by next_shard() */
+	int64_t m_num_consumed;
+	/** whether the workers should stop */
+	bool m_stop;
+	/** first exception thrown by a worker */
+	std::exception_ptr m_error;
+
+	/** worker threads */
+	std::vector<std::thread> m_workers;
+};
+}
+#endif // __SHARDED_LINE_READER_H__
@@ -9,47 +9,151 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/SGSparseVector.h>
 
+#include <algorithm>
 #include <ctype.h>
+#include <string.h>
 
 using namespace shogun;
 
+namespace
+{
+/** Examples parsed from one shard, stored contiguously */
+template <class T>
+class ParsedShard : public ShardedLineReader::Shard
+{
+public:
+	ParsedShard() : offsets(1, 0), position(0)
+	{
+	}
+
+	void append(const T* vector, int32_t len, float64_t label)
+	{
+		values.insert(values.end(), vector, vector + len);
+		offsets.push_back(values.size());
+		labels.push_back(label);
+	}
+
+	int64_t num_examples() const
+	{
+		return labels.size();
+	}
+
+	/** values of all examples */
+	std::vector<T> values;
+	/** start of each example in values, and end of the last one */
+	std::vector<int64_t> offsets;
+	/** label of each example */
+	std::vector<float64_t> labels;
+	/** next example to be returned */
+	int64_t position;
+};
+}
+
 StreamingAsciiFile::StreamingAsciiFile()
 		: StreamingFile()
 {
 	unstable(SOURCE_LOCATION);
 	m_delimiter = ' ';
+	m_num_parse_threads = 1;
+	m_preserve_order = true;
+	m_shard_size = SHARDED_READER_DEFAULT_SHARD_SIZE;
 }
 
 StreamingAsciiFile::StreamingAsciiFile(const char* fname, char rw)
 		: StreamingFile(fname, rw)
 {
 	m_delimiter = ' ';
+	m_num_parse_threads = 1;
+	m_preserve_order = true;
+	m_shard_size = SHARDED_READER_DEFAULT_SHARD_SIZE;
 }
 
 StreamingAsciiFile::~StreamingAsciiFile()
 {
+	m_current_shard.reset();
+	m_sharded_reader.reset();
+}
+
+template <class T>
+void StreamingAsciiFile::get_sharded_vector(
+		T*& vector, int32_t& len, float64_t& label, bool labelled)
+{
+	if (!m_sharded_reader)
+	{
+		require(filename, "Parsing on several threads requires a file name");
+
+		auto parse = [this, labelled](char* begin, char* end)
+		{
+			auto shard = std::make_unique<ParsedShard<T>>();
+			v_array<substring> tokens;
+			T* parsed = NULL;
+			int32_t parsed_len = 0;
+			float64_t parsed_label = 0;
+
+			for (char* line = begin; line < end;)
+			{
+				char* eol = (char*) memchr(line, '\n', end - line);
+				if (!eol)
+					eol = end;
+
+				if (eol > line)
+				{
+					if (labelled)
+						parse_labelled_line(line, eol - line, parsed,
+								parsed_len, parsed_label, tokens);
+					else
+						parse_line(line, eol - line, parsed, parsed_len, tokens);
+
+					shard->append(parsed, parsed_len, parsed_label);
+				}
+				line = eol + 1;
+			}
+			SG_FREE(parsed);
+
+			return std::unique_ptr<ShardedLineReader::Shard>(std::move(shard));
+		};
+
+		/* strtod and friends are used concurrently by the workers */
+		SG_SET_LOCALE_C;
+		m_sharded_reader = std::make_unique<ShardedLineReader>(filename,
+				m_num_parse_threads, m_preserve_order, m_shard_size, parse);
+	}
+
+	auto shard = static_cast<ParsedShard<T>*>(m_current_shard.get());
+	while (!shard || shard->position == shard->num_examples())
+	{
+		m_current_shard = m_sharded_reader->next_shard();
+		if (!m_current_shard)
+		{
+			SG_RESET_LOCALE;
+			len = -1;
+			return;
+		}
+
+		shard = dynamic_cast<ParsedShard<T>*>(m_current_shard.get());
+		require(shard, "Vector type changed while parsing on several threads");
+	}
+
+	const int64_t begin = shard->offsets[shard->position];
+	const int32_t num_values = shard->offsets[shard->position + 1] - begin;
+	if (len < num_values)
+		vector = SG_REALLOC(T, vector, len, num_values);
+
+	std::copy(shard->values.begin() + begin,
+			shard->values.begin() + begin + num_values, vector);
+	len = num_values;
+	label = shard->labels[shard->position];
+	shard->position++;
 }
 
 /* Methods for reading dense vectors from an ascii file */
 
 #define GET_VECTOR(fname, conv, sg_type)									\
-void StreamingAsciiFile::get_vector(sg_type*& vector, int32_t& num_feat)	\
+void StreamingAsciiFile::parse_line(char* buffer, ssize_t bytes_read,		\
+		sg_type*& vector, int32_t& num_feat, v_array<substring>& tokens)	\
 {																			\
-		char* buffer = NULL;												\
-		ssize_t bytes_read;													\
 		int32_t old_len = num_feat;											\
 																			\
-		SG_SET_LOCALE_C;													\
-		bytes_read = buf->read_line(buffer);								\
-																			\
-		if (bytes_read<=0)													\
-		{																	\
-				vector=NULL;												\
-				num_feat=-1;												\
-				SG_RESET_LOCALE;											\
-				return;														\
-		}																	\
-																			\
 		/* determine num_feat, populate dynamic array */					\
 		int32_t nf=0;														\
 		num_feat=0;															\
@@ -99,6 +203,32 @@ void StreamingAsciiFile::get_vector(sg_type*& vector, int32_t& num_feat)	\
 				vector[i]=conv(item);										\
 				SG_FREE(item);												\
 		}																	\
+}																			\
+																			\
+void StreamingAsciiFile::get_vector(sg_type*& vector, int32_t& num_feat)	\
+{																			\
+		if (m_num_parse_threads > 1)										\
+		{																	\
+				float64_t label;											\
+				get_sharded_vector(vector, num_feat, label, false);			\
+				return;														\
+		}																	\
+																			\
+		char* buffer = NULL;												\
+		ssize_t bytes_read;													\
+																			\
+		SG_SET_LOCALE_C;													\
+		bytes_read = buf->read_line(buffer);								\
+																			\
+		if (bytes_read<=0)													\
+		{																	\
+				vector=NULL;												\
+				num_feat=-1;												\
+				SG_RESET_LOCALE;											\
+				return;														\
+		}																	\
+																			\
+		parse_line(buffer, bytes_read, vector, num_feat, words);			\
 		SG_RESET_LOCALE;													\
 }
 
@@ -116,35 +246,48 @@ GET_VECTOR(get_longreal_vector, atoi, floatmax_t)
 #undef GET_VECTOR
 
 #define GET_FLOAT_VECTOR(sg_type)											\
-		void StreamingAsciiFile::get_vector(sg_type*& vector, int32_t& len)\
+		void StreamingAsciiFile::parse_line(char* line, ssize_t num_chars,	\
+				sg_type*& vector, int32_t& len, v_array<substring>& tokens)	\
 		{																	\
-				char *line=NULL;											\
-				SG_SET_LOCALE_C;											\
-				int32_t num_chars = buf->read_line(line);					\
 				int32_t old_len = len;										\
-																			\
-				if (num_chars == 0)											\
-				{															\
-						len = -1;											\
-						SG_RESET_LOCALE;									\
-						return;												\
-				}															\
-																			\
 				substring example_string = {line, line + num_chars};		\
 																			\
-				tokenize(m_delimiter, example_string, words);				\
+				tokenize(m_delimiter, example_string, tokens);				\
 																			\
-				len = words.index();										\
-				substring* feature_start = &words[0];						\
+				len = tokens.index();										\
+				substring* feature_start = &tokens[0];						\
 																			\
 				if (len > old_len)											\
 						vector = SG_REALLOC(sg_type, vector, old_len, len);	\
 																			\
 				int32_t j=0;												\
-				for (substring* i = feature_start; i != words.end; i++)		\
+				for (substring* i = feature_start; i != tokens.end; i++)	\
 				{															\
 						vector[j++] = io::SGIO::float_of_substring(*i);		\
 				}															\
+		}																	\
+																			\
+		void StreamingAsciiFile::get_vector(sg_type*& vector, int32_t& len)	\
+		{																	\
+				if (m_num_parse_threads > 1)								\
+				{															\
+						float64_t label;									\
+						get_sharded_vector(vector, len, label, false);		\
+						return;												\
+				}															\
+																			\
+				char *line=NULL;											\
+				SG_SET_LOCALE_C;											\
+				int32_t num_chars = buf->read_line(line);					\
+																			\
+				if (num_chars == 0)											\
+				{															\
+						len = -1;											\
+						SG_RESET_LOCALE;									\
+						return;												\
+				}															\
+																			\
+				parse_line(line, num_chars, vector, len, words);			\
 				SG_RESET_LOCALE;											\
 		}
 
@@ -154,76 +297,90 @@ GET_FLOAT_VECTOR(float64_t)
 
 /* Methods for reading a dense vector and a label from an ascii file */
 
-#define GET_VECTOR_AND_LABEL(fname, conv, sg_type)						\
-		void StreamingAsciiFile::get_vector_and_label(sg_type*& vector, int32_t& num_feat, float64_t& label) \
-		{																\
-				char* buffer = NULL;									\
-				ssize_t bytes_read;										\
-				int32_t old_len = num_feat;								\
-				SG_SET_LOCALE_C;										\
-																		\
-				bytes_read = buf->read_line(buffer);					\
-																		\
-				if (bytes_read<=0)										\
-				{														\
-						vector=NULL;									\
-						num_feat=-1;									\
-						SG_RESET_LOCALE;								\
-						return;											\
-				}														\
-																		\
-				/* determine num_feat, populate dynamic array */		\
-				int32_t nf=0;											\
-				num_feat=0;												\
-																		\
-				char* ptr_item=NULL;									\
-				char* ptr_data=buffer;									\
-				std::vector<char*> items;								\
-																		\
-				while (*ptr_data)										\
-				{														\
-						if ((*ptr_data=='\n') ||						\
-						    (ptr_data - buffer >= bytes_read))			\
-						{												\
-								if (ptr_item)							\
-										nf++;							\
-																		\
-								append_item(items, ptr_data, ptr_item);	\
-								num_feat=nf;							\
-																		\
-								nf=0;									\
-								ptr_item=NULL;							\
-								break;									\
-						}												\
-						else if (!isblank(*ptr_data) && !ptr_item)		\
-						{												\
-								ptr_item=ptr_data;						\
-						}												\
-						else if (isblank(*ptr_data) && ptr_item)		\
-						{												\
-								append_item(items, ptr_data, ptr_item);	\
-								ptr_item=NULL;							\
-								nf++;									\
-						}												\
-																		\
-						ptr_data++;										\
-				}														\
-																		\
-				SG_DEBUG("num_feat {}", num_feat)					\
-				/* The first element is the label */					\
-				label=atof(items[0]);									\
-				/* now copy rest of the data into vector */				\
-				if (old_len < num_feat - 1)								\
+#define GET_VECTOR_AND_LABEL(fname, conv, sg_type)							\
+		void StreamingAsciiFile::parse_labelled_line(char* buffer,			\
+				ssize_t bytes_read, sg_type*& vector, int32_t& num_feat,	\
+				float64_t& label, v_array<substring>& tokens)				\
+		{																	\
+				int32_t old_len = num_feat;									\
+																			\
+				/* determine num_feat, populate dynamic array */			\
+				int32_t nf=0;												\
+				num_feat=0;													\
+																			\
+				char* ptr_item=NULL;										\
+				char* ptr_data=buffer;										\
+				std::vector<char*> items;									\
+																			\
+				while (*ptr_data)											\
+				{															\
+						if ((*ptr_data=='\n') ||							\
+						    (ptr_data - buffer >= bytes_read))				\
+						{													\
+								if (ptr_item)								\
+										nf++;								\
+																			\
+								append_item(items, ptr_data, ptr_item);		\
+								num_feat=nf;								\
+																			\
+								nf=0;										\
+								ptr_item=NULL;								\
+								break;										\
+						}													\
+						else if (!isblank(*ptr_data) && !ptr_item)			\
+						{													\
+								ptr_item=ptr_data;							\
+						}													\
+						else if (isblank(*ptr_data) && ptr_item)			\
+						{													\
+								append_item(items, ptr_data, ptr_item);		\
+								ptr_item=NULL;								\
+								nf++;										\
+						}													\
+																			\
+						ptr_data++;											\
+				}															\
+																			\
+				SG_DEBUG("num_feat {}", num_feat)							\
+				/* The first element is the label */						\
+				label=atof(items[0]);										\
+				/* now copy rest of the data into vector */					\
+				if (old_len < num_feat - 1)									\
 						vector=SG_REALLOC(sg_type, vector, old_len, num_feat-1);	\
-																		\
-				for (int32_t i=1; i<num_feat; i++)						\
-				{														\
-						char* item=items[i];							\
-						vector[i-1]=conv(item);							\
-						SG_FREE(item);									\
-				}														\
-				num_feat--;												\
-				SG_RESET_LOCALE;										\
+																			\
+				for (int32_t i=1; i<num_feat; i++)							\
+				{															\
+						char* item=items[i];								\
+						vector[i-1]=conv(item);								\
+						SG_FREE(item);										\
+				}															\
+				num_feat--;													\
+		}																	\
+																			\
+		void StreamingAsciiFile::get_vector_and_label(sg_type*& vector, int32_t& num_feat, float64_t& label)	\
+		{																	\
+				if (m_num_parse_threads > 1)								\
+				{															\
+						get_sharded_vector(vector, num_feat, label, true);	\
+						return;												\
+				}															\
+																			\
+				char* buffer = NULL;										\
+				ssize_t bytes_read;											\
+				SG_SET_LOCALE_C;											\
+																			\
+				bytes_read = buf->read_line(buffer);						\
+																			\
+				if (bytes_read<=0)											\
+				{															\
+						vector=NULL;										\
+						num_feat=-1;										\
+						SG_RESET_LOCALE;									\
+						return;												\
+				}															\
+																			\
+				parse_labelled_line(buffer, bytes_read, vector, num_feat, label, words);	\
+				SG_RESET_LOCALE;											\
 		}
 
 GET_VECTOR_AND_LABEL(get_bool_vector_and_label, str_to_bool, bool)
@@ -239,39 +396,52 @@ GET_VECTOR_AND_LABEL(get_ulong_vector_and_label, atoi, uint64_t)
 GET_VECTOR_AND_LABEL(get_longreal_vector_and_label, atoi, floatmax_t)
 #undef GET_VECTOR_AND_LABEL
 
-#define GET_FLOAT_VECTOR_AND_LABEL(sg_type)								\
-		void StreamingAsciiFile::get_vector_and_label(sg_type*& vector, int32_t& len, float64_t& label) \
-		{																\
-				char *line=NULL;										\
-				SG_SET_LOCALE_C;										\
-				int32_t num_chars = buf->read_line(line);				\
-				int32_t old_len = len;									\
-																		\
-				if (num_chars == 0)										\
-				{														\
-						len = -1;										\
-						SG_RESET_LOCALE;								\
-						return;											\
-				}														\
-																		\
-				substring example_string = {line, line + num_chars};	\
-																		\
-				tokenize(m_delimiter, example_string, words);			\
-																		\
-				label = io::SGIO::float_of_substring(words[0]);				\
-																		\
-				len = words.index() - 1;								\
-				substring* feature_start = &words[1];					\
-																		\
-				if (len > old_len)										\
+#define GET_FLOAT_VECTOR_AND_LABEL(sg_type)									\
+		void StreamingAsciiFile::parse_labelled_line(char* line,			\
+				ssize_t num_chars, sg_type*& vector, int32_t& len,			\
+				float64_t& label, v_array<substring>& tokens)				\
+		{																	\
+				int32_t old_len = len;										\
+				substring example_string = {line, line + num_chars};		\
+																			\
+				tokenize(m_delimiter, example_string, tokens);				\
+																			\
+				label = io::SGIO::float_of_substring(tokens[0]);			\
+																			\
+				len = tokens.index() - 1;									\
+				substring* feature_start = &tokens[1];						\
+																			\
+				if (len > old_len)											\
 						vector = SG_REALLOC(sg_type, vector, old_len, len);	\
-																		\
-				int32_t j=0;											\
-				for (substring* i = feature_start; i != words.end; i++)	\
-				{														\
+																			\
+				int32_t j=0;												\
+				for (substring* i = feature_start; i != tokens.end; i++)	\
+				{															\
 						vector[j++] = io::SGIO::float_of_substring(*i);		\
-				}														\
-				SG_RESET_LOCALE;										\
+				}															\
+		}																	\
+																			\
+		void StreamingAsciiFile::get_vector_and_label(sg_type*& vector, int32_t& len, float64_t& label)	\
+		{																	\
+				if (m_num_parse_threads > 1)								\
+				{															\
+						get_sharded_vector(vector, len, label, true);		\
+						return;												\
+				}															\
+																			\
+				char *line=NULL;											\
+				SG_SET_LOCALE_C;											\
+				int32_t num_chars = buf->read_line(line);					\
+																			\
+				if (num_chars == 0)											\
+				{															\
+						len = -1;											\
+						SG_RESET_LOCALE;									\
+						return;												\
+				}															\
+																			\
+				parse_labelled_line(line, num_chars, vector, len, label, words);	\
+				SG_RESET_LOCALE;											\
 		}
 
 GET_FLOAT_VECTOR_AND_LABEL(float32_t)
@@ -394,81 +564,95 @@ GET_STRING_AND_LABEL(get_longreal_string_and_label, atoi, floatmax_t)
 
 /* Methods for reading a sparse vector from an ascii file */
 
-#define GET_SPARSE_VECTOR(fname, conv, sg_type)							\
-void StreamingAsciiFile::get_sparse_vector(SGSparseVectorEntry<sg_type>*& vector, int32_t& len) \
-{																		\
-		char* buffer = NULL;											\
-		ssize_t bytes_read;												\
-		SG_SET_LOCALE_C;												\
-																		\
-		bytes_read = buf->read_line(buffer);							\
-																		\
-		if (bytes_read<=1)												\
-		{																\
-				vector=NULL;											\
-				len=-1;													\
-				SG_RESET_LOCALE;										\
-				return;													\
-		}																\
-																		\
-		/* Remove terminating \n */										\
-		int32_t num_chars;												\
-		if (buffer[bytes_read-1]=='\n')									\
-		  {																\
-		    num_chars=bytes_read-1;										\
-		    buffer[num_chars]='\0';										\
-		  }																\
-		else															\
-		  num_chars=bytes_read;											\
-																		\
-		int32_t num_dims=0;												\
-		for (int32_t i=0; i<num_chars; i++)								\
-		{																\
-				if (buffer[i]==':')										\
-				{														\
-						num_dims++;										\
-				}														\
-		}																\
-																		\
-		int32_t index_start_pos=-1;										\
-		int32_t feature_start_pos;										\
-		int32_t current_feat=0;											\
-		if (len < num_dims)												\
+#define GET_SPARSE_VECTOR(fname, conv, sg_type)								\
+void StreamingAsciiFile::parse_line(char* buffer, ssize_t bytes_read,		\
+		SGSparseVectorEntry<sg_type>*& vector, int32_t& len,				\
+		v_array<substring>& tokens)											\
+{																			\
+		/* Remove terminating \n */											\
+		int32_t num_chars;													\
+		if (buffer[bytes_read-1]=='\n')										\
+		  {																	\
+		    num_chars=bytes_read-1;											\
+		    buffer[num_chars]='\0';											\
+		  }																	\
+		else																\
+		  num_chars=bytes_read;												\
+																			\
+		int32_t num_dims=0;													\
+		for (int32_t i=0; i<num_chars; i++)									\
+		{																	\
+				if (buffer[i]==':')											\
+				{															\
+						num_dims++;											\
+				}															\
+		}																	\
+																			\
+		int32_t index_start_pos=-1;											\
+		int32_t feature_start_pos;											\
+		int32_t current_feat=0;												\
+		if (len < num_dims)													\
 			vector=SG_REALLOC(SGSparseVectorEntry<sg_type>, vector, len, num_dims);	\
-		for (int32_t i=0; i<num_chars; i++)								\
-		{																\
-				if (buffer[i]==':')										\
-				{														\
-						buffer[i]='\0';									\
-						vector[current_feat].feat_index=(int32_t) atoi(buffer+index_start_pos)-1; \
-						/* Unset index_start_pos */						\
-						index_start_pos=-1;								\
-																		\
-						feature_start_pos=i+1;							\
-						while ((buffer[i]!=' ') && (i<num_chars))		\
-						{												\
-								i++;									\
-						}												\
-																		\
-						buffer[i]='\0';									\
-						vector[current_feat].entry=(sg_type) conv(buffer+feature_start_pos); \
-																		\
-						current_feat++;									\
-				}														\
-				else if (buffer[i]==' ')								\
-				  i++;													\
-				else													\
-				  {														\
-				    /* Set index_start_pos if not set already */		\
-				    /* if already set, it means the index is  */		\
-				    /* more than one digit long.              */		\
-				    if (index_start_pos == -1)							\
-						index_start_pos=i;								\
-				  }														\
-		}																\
-																		\
-		len=current_feat;												\
-		SG_RESET_LOCALE;												\
+		for (int32_t i=0; i<num_chars; i++)									\
+		{																	\
+				if (buffer[i]==':')											\
+				{															\
+						buffer[i]='\0';										\
+						vector[current_feat].feat_index=(int32_t) atoi(buffer+index_start_pos)-1;	\
+						/* Unset index_start_pos */							\
+						index_start_pos=-1;									\
+																			\
+						feature_start_pos=i+1;								\
+						while ((buffer[i]!=' ') && (i<num_chars))			\
+						{													\
+								i++;										\
+						}													\
+																			\
+						buffer[i]='\0';										\
+						vector[current_feat].entry=(sg_type) conv(buffer+feature_start_pos);	\
+																			\
+						current_feat++;										\
+				}															\
+				else if (buffer[i]==' ')									\
+				  i++;														\
+				else														\
+				  {															\
+				    /* Set index_start_pos if not set already */			\
+				    /* if already set, it means the index is  */			\
+				    /* more than one digit long.              */			\
+				    if (index_start_pos == -1)								\
+						index_start_pos=i;									\
+				  }															\
+		}																	\
+																			\
+		len=current_feat;													\
+}																			\
+																			\
+void StreamingAsciiFile::get_sparse_vector(SGSparseVectorEntry<sg_type>*& vector, int32_t& len)	\
+{																			\
+		if (m_num_parse_threads > 1)										\
+		{																	\
+				float64_t label;											\
+				get_sharded_vector(vector, len, label, false);				\
+				return;														\
+		}																	\
+																			\
+		char* buffer = NULL;												\
+		ssize_t bytes_read;													\
+		SG_SET_LOCALE_C;													\
+																			\
+		bytes_read = buf->read_line(buffer);								\
+																			\
+		if (bytes_read<=1)													\
+		{																	\
+				vector=NULL;												\
+				len=-1;														\
+				SG_RESET_LOCALE;											\
+				return;														\
+		}																	\
+																			\
+		parse_line(buffer, bytes_read, vector, len, words);					\
+		SG_RESET_LOCALE;													\
 }
 
 GET_SPARSE_VECTOR(get_bool_sparse_vector, str_to_bool, bool)
@@ -488,103 +672,116 @@ GET_SPARSE_VECTOR(get_longreal_sparse_vector, atoi, floatmax_t)
 
 /* Methods for reading a sparse vector and a label from an ascii file */
 
-#define GET_SPARSE_VECTOR_AND_LABEL(fname, conv, sg_type)				\
-void StreamingAsciiFile::get_sparse_vector_and_label(SGSparseVectorEntry<sg_type>*& vector, int32_t& len, float64_t& label) \
-{																		\
-		char* buffer = NULL;											\
-		ssize_t bytes_read;												\
-		SG_SET_LOCALE_C;												\
-																		\
-		bytes_read = buf->read_line(buffer);							\
-																		\
-		if (bytes_read<=1)												\
-		{																\
-				vector=NULL;											\
-				len=-1;													\
-				SG_RESET_LOCALE;										\
-				return;													\
-		}																\
-																		\
-		/* Remove terminating \n */										\
-		int32_t num_chars;												\
-		if (buffer[bytes_read-1]=='\n')									\
-		{																\
-				num_chars=bytes_read-1;									\
-				buffer[num_chars]='\0';									\
-		}																\
-		else															\
-				num_chars=bytes_read;									\
-																		\
-		int32_t num_dims=0;												\
-		for (int32_t i=0; i<num_chars; i++)								\
-		{																\
-				if (buffer[i]==':')										\
-				{														\
-						num_dims++;										\
-				}														\
-		}																\
-																		\
-		int32_t index_start_pos=-1;										\
-		int32_t feature_start_pos;										\
-		int32_t current_feat=0;											\
-		int32_t label_pos=-1;											\
-		if (len < num_dims)												\
-			vector=SG_REALLOC(SGSparseVectorEntry<sg_type>, vector, len, num_dims); \
-																		\
-		for (int32_t i=1; i<num_chars; i++)								\
-		{																\
-				if (buffer[i]==':')										\
-				{														\
-						break;											\
-				}														\
-				if ( (buffer[i]==' ') && (buffer[i-1]!=' ') )			\
-				{														\
-						buffer[i]='\0';									\
-						label_pos=i;									\
-						label=atof(buffer);								\
-						break;											\
-				}														\
-		}																\
-																		\
-		if (label_pos==-1)												\
-				error("No label found!");							\
-																		\
-		buffer+=label_pos+1;											\
-		num_chars-=label_pos+1;											\
-		for (int32_t i=0; i<num_chars; i++)								\
-		{																\
-				if (buffer[i]==':')										\
-				{														\
-						buffer[i]='\0';									\
-						vector[current_feat].feat_index=(int32_t) atoi(buffer+index_start_pos)-1; \
-						/* Unset index_start_pos */						\
-						index_start_pos=-1;								\
-																		\
-						feature_start_pos=i+1;							\
-						while ((buffer[i]!=' ') && (i<num_chars))		\
-						{												\
-								i++;									\
-						}												\
-																		\
-						buffer[i]='\0';									\
-						vector[current_feat].entry=(sg_type) conv(buffer+feature_start_pos); \
-																		\
-						current_feat++;									\
-				}														\
-				else if (buffer[i]==' ')								\
-						i++;											\
-				else													\
-				{														\
-						/* Set index_start_pos if not set already */	\
-						/* if already set, it means the index is  */	\
-						/* more than one digit long.              */	\
-						if (index_start_pos == -1)						\
-								index_start_pos=i;						\
-				}														\
-		}																\
-																		\
-		len=current_feat;												\
-		SG_RESET_LOCALE;												\
+#define GET_SPARSE_VECTOR_AND_LABEL(fname, conv, sg_type)					\
+void StreamingAsciiFile::parse_labelled_line(char* buffer, ssize_t bytes_read,	\
+		SGSparseVectorEntry<sg_type>*& vector, int32_t& len, float64_t& label,	\
+		v_array<substring>& tokens)											\
+{																			\
+		/* Remove terminating \n */											\
+		int32_t num_chars;													\
+		if (buffer[bytes_read-1]=='\n')										\
+		{																	\
+				num_chars=bytes_read-1;										\
+				buffer[num_chars]='\0';										\
+		}																	\
+		else																\
+				num_chars=bytes_read;										\
+																			\
+		int32_t num_dims=0;													\
+		for (int32_t i=0; i<num_chars; i++)									\
+		{																	\
+				if (buffer[i]==':')											\
+				{															\
+						num_dims++;											\
+				}															\
+		}																	\
+																			\
+		int32_t index_start_pos=-1;											\
+		int32_t feature_start_pos;											\
+		int32_t current_feat=0;												\
+		int32_t label_pos=-1;												\
+		if (len < num_dims)													\
+			vector=SG_REALLOC(SGSparseVectorEntry<sg_type>, vector, len, num_dims);	\
+																			\
+		for (int32_t i=1; i<num_chars; i++)									\
+		{																	\
+				if (buffer[i]==':')											\
+				{															\
+						break;												\
+				}															\
+				if ( (buffer[i]==' ') && (buffer[i-1]!=' ') )				\
+				{															\
+						buffer[i]='\0';										\
+						label_pos=i;										\
+						label=atof(buffer);									\
+						break;												\
+				}															\
+		}																	\
+																			\
+		if (label_pos==-1)													\
+				error("No label found!");									\
+																			\
+		buffer+=label_pos+1;												\
+		num_chars-=label_pos+1;												\
+		for (int32_t i=0; i<num_chars; i++)									\
+		{																	\
+				if (buffer[i]==':')											\
+				{															\
+						buffer[i]='\0';										\
+						vector[current_feat].feat_index=(int32_t) atoi(buffer+index_start_pos)-1;	\
+						/* Unset index_start_pos */							\
+						index_start_pos=-1;									\
+																			\
+						feature_start_pos=i+1;								\
+						while ((buffer[i]!=' ') && (i<num_chars))			\
+						{													\
+								i++;										\
+						}													\
+																			\
+						buffer[i]='\0';										\
+						vector[current_feat].entry=(sg_type) conv(buffer+feature_start_pos);	\
+																			\
+						current_feat++;										\
+				}															\
+				else if (buffer[i]==' ')									\
+						i++;												\
+				else														\
+				{															\
+						/* Set index_start_pos if not set already */		\
+						/* if already set, it means the index is  */		\
+						/* more than one digit long.              */		\
+						if (index_start_pos == -1)							\
+								index_start_pos=i;							\
+				}															\
+		}																	\
+																			\
+		len=current_feat;													\
+}																			\
+																			\
+void StreamingAsciiFile::get_sparse_vector_and_label(SGSparseVectorEntry<sg_type>*& vector, int32_t& len, float64_t& label)	\
+{																			\
+		if (m_num_parse_threads > 1)										\
+		{																	\
+				get_sharded_vector(vector, len, label, true);				\
+				return;														\
+		}																	\
+																			\
+		char* buffer = NULL;												\
+		ssize_t bytes_read;													\
+		SG_SET_LOCALE_C;													\
+																			\
+		bytes_read = buf->read_line(buffer);								\
+																			\
+		if (bytes_read<=1)													\
+		{																	\
+				vector=NULL;												\
+				len=-1;														\
+				SG_RESET_LOCALE;											\
+				return;														\
+		}																	\
+																			\
+		parse_labelled_line(buffer, bytes_read, vector, len, label, words);	\
+		SG_RESET_LOCALE;													\
 }
 
 GET_SPARSE_VECTOR_AND_LABEL(get_bool_sparse_vector_and_label, str_to_bool, bool)
@@ -643,3 +840,20 @@ void StreamingAsciiFile::tokenize(char delim, substring s, v_array<substring>& r
 		ret.push(final);
 	}
 }
+
+void StreamingAsciiFile::set_parse_threads(int32_t num_threads, bool preserve_order)
+{
+	require(num_threads > 0, "Number of threads ({}) must be positive", num_threads);
+	require(!m_sharded_reader, "Cannot change the number of threads while parsing");
+
+	m_num_parse_threads = num_threads;
+	m_preserve_order = preserve_order;
+}
+
+void StreamingAsciiFile::set_shard_size(int64_t shard_size)
+{
+	require(shard_size > 0, "Shard size ({}) must be positive", shard_size);
+	require(!m_sharded_reader, "Cannot change the shard size while parsing");
+
+	m_shard_size = shard_size;
+}
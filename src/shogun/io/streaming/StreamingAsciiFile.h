@@ -9,9 +9,12 @@
 
 #include <shogun/lib/config.h>
 
+#include <shogun/io/streaming/ShardedLineReader.h>
 #include <shogun/io/streaming/StreamingFile.h>
 #include <shogun/lib/v_array.h>
 
+#include <memory>
+
 namespace shogun
 {
 
@@ -21,6 +24,9 @@ template <class ST> struct SGSparseVectorEntry;
 /** @brief Class StreamingAsciiFile to read vector-by-vector from ASCII files.
  *
  * The object must be initialized like a CSVFile.
+ *
+ * Dense and sparse (LibSVM) vectors can optionally be parsed on several
+ * threads, see set_parse_threads().
  */
 class StreamingAsciiFile: public StreamingFile
 {
@@ -51,6 +57,33 @@ public:
 	 */
 	void set_delimiter(char delimiter);
 
+	/** Parse the file on several threads.
+	 *
+	 * The file is split into shards of shard_size bytes at line
+	 * boundaries, which are parsed concurrently by num_threads threads.
+	 * Applies to dense and sparse vectors, with or without labels;
+	 * strings are still read line by line. Empty lines are skipped.
+	 * Must be called before the first vector is read.
+	 *
+	 * @param num_threads number of parsing threads, 1 parses on the
+	 * calling thread
+	 * @param preserve_order whether vectors are returned in the order of
+	 * the file, otherwise shards are returned as soon as they are parsed
+	 */
+	void set_parse_threads(int32_t num_threads, bool preserve_order = true);
+
+	/** @return number of parsing threads */
+	int32_t get_parse_threads() const
+	{
+		return m_num_parse_threads;
+	}
+
+	/** set size of the shards parsed by each thread
+	 *
+	 * @param shard_size size of a shard in bytes
+	 */
+	void set_shard_size(int64_t shard_size);
+
 #ifndef SWIG // SWIG should skip this
 	/**
 	 * Utility function to convert a string to a boolean value
@@ -108,6 +141,52 @@ public:
 	}
 
 private:
+#ifndef SWIG // SWIG should skip this
+#define PARSE_LINE_DECL(sg_type)					\
+	void parse_line(char* line, ssize_t num_chars,			\
+		sg_type*& vector, int32_t& len,				\
+		v_array<substring>& tokens);					\
+									\
+	void parse_labelled_line(char* line, ssize_t num_chars,	\
+		sg_type*& vector, int32_t& len, float64_t& label,	\
+		v_array<substring>& tokens);					\
+									\
+	void parse_line(char* line, ssize_t num_chars,			\
+		SGSparseVectorEntry<sg_type>*& vector, int32_t& len,	\
+		v_array<substring>& tokens);					\
+									\
+	void parse_labelled_line(char* line, ssize_t num_chars,	\
+		SGSparseVectorEntry<sg_type>*& vector, int32_t& len,	\
+		float64_t& label, v_array<substring>& tokens);
+
+	PARSE_LINE_DECL(bool)
+	PARSE_LINE_DECL(uint8_t)
+	PARSE_LINE_DECL(char)
+	PARSE_LINE_DECL(int32_t)
+	PARSE_LINE_DECL(float32_t)
+	PARSE_LINE_DECL(float64_t)
+	PARSE_LINE_DECL(int16_t)
+	PARSE_LINE_DECL(uint16_t)
+	PARSE_LINE_DECL(int8_t)
+	PARSE_LINE_DECL(uint32_t)
+	PARSE_LINE_DECL(int64_t)
+	PARSE_LINE_DECL(uint64_t)
+	PARSE_LINE_DECL(floatmax_t)
+#undef PARSE_LINE_DECL
+
+	/** Returns the next vector parsed by the sharded reader,
+	 * starting the reader on the first call.
+	 *
+	 * @param vector vector, reallocated if too short
+	 * @param len length of the vector, -1 at the end of the file
+	 * @param label label of the vector
+	 * @param labelled whether lines start with a label
+	 */
+	template <class T>
+	void get_sharded_vector(
+		T*& vector, int32_t& len, float64_t& label, bool labelled);
+#endif // #ifndef SWIG // SWIG should skip this
+
 	/** helper function to read vectors / matrices
 	 *
 	 * @param items dynamic array of values
@@ -132,6 +211,21 @@ private:
 
 	/** delimiter */
 	char m_delimiter;
+
+	/** number of parsing threads */
+	int32_t m_num_parse_threads;
+
+	/** whether parsed vectors keep the order of the file */
+	bool m_preserve_order;
+
+	/** size of the shards in bytes */
+	int64_t m_shard_size;
+
+	/** reader parsing the shards, if parsing on several threads */
+	std::unique_ptr<ShardedLineReader> m_sharded_reader;
+
+	/** shard the vectors are currently returned from */
+	std::unique_ptr<ShardedLineReader::Shard> m_current_shard;
 };
 }
 #endif //__STREAMING_ASCIIFILE_H__
@@ -21,7 +21,9 @@
 #include <shogun/kernel/Kernel.h>
 #include <shogun/kernel/normalizer/KernelNormalizer.h>
 #include <shogun/kernel/normalizer/IdentityKernelNormalizer.h>
+#include <shogun/features/DenseFeatures.h>
 #include <shogun/features/Features.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 #include <shogun/classifier/svm/SVM.h>
 
@@ -35,6 +37,13 @@
 
 using namespace shogun;
 
+namespace
+{
+	/** number of lhs and rhs vectors in a tile of the kernel matrix that is
+	 * computed by a single matrix product */
+	const index_t KERNEL_TILE_SIZE = 256;
+}
+
 Kernel::Kernel() : SGObject()
 {
 	init();
@@ -85,6 +94,50 @@ float64_t Kernel::kernel(int32_t idx_a, int32_t idx_b)
 	return normalizer->normalize(compute(idx_a, idx_b), idx_a, idx_b);
 }
 
+void Kernel::kernel_block(index_t lhs_begin, index_t lhs_size,
+		index_t rhs_begin, index_t rhs_size, SGMatrix<float64_t>& result)
+{
+	require(has_features(), "No features assigned to kernel");
+	require(lhs_begin>=0 && lhs_size>=0 && lhs_begin+lhs_size<=num_lhs,
+			"lhs block [{}, {}) exceeds the {} lhs vectors",
+			lhs_begin, lhs_begin+lhs_size, num_lhs);
+	require(rhs_begin>=0 && rhs_size>=0 && rhs_begin+rhs_size<=num_rhs,
+			"rhs block [{}, {}) exceeds the {} rhs vectors",
+			rhs_begin, rhs_begin+rhs_size, num_rhs);
+	require(result.num_rows==lhs_size && result.num_cols==rhs_size,
+			"Result matrix ({}x{}) must be of size {}x{}",
+			result.num_rows, result.num_cols, lhs_size, rhs_size);
+
+	if (!use_blocked_kernel_matrix())
+	{
+		for (index_t j=0; j<rhs_size; j++)
+		{
+			for (index_t i=0; i<lhs_size; i++)
+				result(i, j)=kernel(lhs_begin+i, rhs_begin+j);
+		}
+		return;
+	}
+
+	auto lhs_block=lhs->as<DenseFeatures<float64_t>>()
+		->get_feature_matrix_block(lhs_begin, lhs_size);
+	auto rhs_block=rhs->as<DenseFeatures<float64_t>>()
+		->get_feature_matrix_block(rhs_begin, rhs_size);
+	require(lhs_block.num_rows==rhs_block.num_rows,
+			"Dimension of lhs ({}) and rhs ({}) vectors differ.",
+			lhs_block.num_rows, rhs_block.num_rows);
+
+	linalg::matrix_prod(lhs_block, rhs_block, result, true, false);
+	auto lhs_sq_norms=linalg::colwise_squared_norm(lhs_block);
+	auto rhs_sq_norms=linalg::colwise_squared_norm(rhs_block);
+	transform_dot_block(result, lhs_sq_norms.vector, rhs_sq_norms.vector);
+
+	for (index_t j=0; j<rhs_size; j++)
+	{
+		for (index_t i=0; i<lhs_size; i++)
+			result(i, j)=normalizer->normalize(result(i, j), lhs_begin+i, rhs_begin+j);
+	}
+}
+
 #ifdef USE_SVMLIGHT
 void Kernel::resize_kernel_cache(KERNELCACHE_IDX size, bool regression_hack)
 {
@@ -919,6 +972,10 @@ void Kernel::save_serializable_post() noexcept(false)
 void Kernel::register_params()
 {
 	SG_ADD(&cache_size, "cache_size", "Cache size in MB.");
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&cache_precision, "cache_precision",
+	    "Storage precision of cached kernel rows.", ParameterProperties::NONE,
+	    SG_OPTIONS(KCP_FLOAT64, KCP_FLOAT32));
 	SG_ADD(
 		&lhs, "lhs", "Feature vectors to occur on left hand side.",
 		ParameterProperties::READONLY);
@@ -951,6 +1008,11 @@ void Kernel::register_params()
 void Kernel::init()
 {
 	cache_size=10;
+#ifdef USE_SHORTREAL_KERNELCACHE
+	cache_precision=KCP_FLOAT32;
+#else
+	cache_precision=KCP_FLOAT64;
+#endif
 	kernel_matrix=NULL;
 	lhs=NULL;
 	rhs=NULL;
@@ -1328,6 +1390,9 @@ SGMatrix<T> Kernel::get_kernel_matrix()
 
 	SG_DEBUG("returning kernel matrix of size {}x{}", m, n)
 
+	if (use_blocked_kernel_matrix())
+		return get_kernel_matrix_blocked<T>();
+
 	result=SG_MALLOC(T, total_num);
 
 	int32_t num_threads=env()->get_num_threads();
@@ -1371,6 +1436,88 @@ SGMatrix<T> Kernel::get_kernel_matrix()
 	return SGMatrix<T>(result,m,n,true);
 }
 
+bool Kernel::use_blocked_kernel_matrix()
+{
+	if (!has_property(KP_DOTBLOCK))
+		return false;
+
+	for (const auto& feats : {lhs, rhs})
+	{
+		if (!feats || feats->get_feature_class() != C_DENSE ||
+		    feats->get_feature_type() != F_DREAL)
+			return false;
+	}
+	return true;
+}
+
+template <class T>
+SGMatrix<T> Kernel::get_kernel_matrix_blocked()
+{
+	auto lhs_feats = lhs->as<DenseFeatures<float64_t>>();
+	auto rhs_feats = rhs->as<DenseFeatures<float64_t>>();
+	require(
+	    lhs_feats->get_num_features() == rhs_feats->get_num_features(),
+	    "Dimension of lhs ({}) and rhs ({}) vectors differ.",
+	    lhs_feats->get_num_features(), rhs_feats->get_num_features());
+
+	const index_t m = num_lhs;
+	const index_t n = num_rhs;
+	// if lhs == rhs assume k(i,j)=k(j,i) and only compute the upper tiles
+	const bool symmetric = lhs == rhs;
+	const index_t num_row_tiles = (m + KERNEL_TILE_SIZE - 1) / KERNEL_TILE_SIZE;
+	const index_t num_col_tiles = (n + KERNEL_TILE_SIZE - 1) / KERNEL_TILE_SIZE;
+
+	SGMatrix<T> result(m, n);
+
+	auto pb = SG_PROGRESS(range(int64_t(num_row_tiles) * num_col_tiles));
+#pragma omp parallel
+	{
+		SGMatrix<float64_t> products(
+		    std::min(KERNEL_TILE_SIZE, m), std::min(KERNEL_TILE_SIZE, n));
+
+#pragma omp for schedule(dynamic)
+		for (int64_t tile = 0; tile < int64_t(num_row_tiles) * num_col_tiles;
+		     ++tile)
+		{
+			const index_t row_start = (tile / num_col_tiles) * KERNEL_TILE_SIZE;
+			const index_t col_start = (tile % num_col_tiles) * KERNEL_TILE_SIZE;
+			if (symmetric && col_start < row_start)
+				continue;
+
+			const index_t row_len = std::min(KERNEL_TILE_SIZE, m - row_start);
+			const index_t col_len = std::min(KERNEL_TILE_SIZE, n - col_start);
+			// in place unless there are subsets or preprocessors
+			auto lhs_block =
+			    lhs_feats->get_feature_matrix_block(row_start, row_len);
+			auto rhs_block =
+			    rhs_feats->get_feature_matrix_block(col_start, col_len);
+			SGMatrix<float64_t> block(
+			    products.matrix, row_len, col_len, false);
+
+			linalg::matrix_prod(lhs_block, rhs_block, block, true, false);
+			auto lhs_sq_norms = linalg::colwise_squared_norm(lhs_block);
+			auto rhs_sq_norms = linalg::colwise_squared_norm(rhs_block);
+			transform_dot_block(
+			    block, lhs_sq_norms.vector, rhs_sq_norms.vector);
+
+			for (index_t j = 0; j < col_len; ++j)
+			{
+				for (index_t i = 0; i < row_len; ++i)
+				{
+					const T v = normalizer->normalize(
+					    block(i, j), row_start + i, col_start + j);
+					result(row_start + i, col_start + j) = v;
+					if (symmetric)
+						result(col_start + j, row_start + i) = v;
+				}
+			}
+			pb.print_progress();
+		}
+	}
+	pb.complete();
+
+	return result;
+}
 
 template SGMatrix<float64_t> Kernel::get_kernel_matrix<float64_t>();
 template SGMatrix<float32_t> Kernel::get_kernel_matrix<float32_t>();
@@ -21,6 +21,7 @@
 #include <shogun/base/SGObject.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/features/Features.h>
+#include <shogun/kernel/KernelRowCache.h>
 
 namespace shogun
 {
@@ -121,7 +122,8 @@ enum EKernelProperty
 	KP_NONE = 0,
 	KP_LINADD = 1,	// Kernels that can be optimized via doing normal updates w + dw
 	KP_KERNCOMBINATION = 2,	// Kernels that are infact a linear combination of subkernels K=\sum_i b_i*K_i
-	KP_BATCHEVALUATION = 4  // Kernels that can on the fly generate normals in linadd and more quickly/memory efficient process batches instead of single examples
+	KP_BATCHEVALUATION = 4,  // Kernels that can on the fly generate normals in linadd and more quickly/memory efficient process batches instead of single examples
+	KP_DOTBLOCK = 8  // Kernels that are a function of the inner product and squared norms of the vectors, so that blocks of the kernel matrix can be computed via matrix products
 };
 
 class SVM;
@@ -199,6 +201,22 @@ class Kernel : public SGObject
 		 */
 		float64_t kernel(int32_t idx_a, int32_t idx_b);
 
+		/** get kernel values of a block of consecutive lhs feature vectors
+		 * and a block of consecutive rhs feature vectors, i.e.
+		 * result(i,j)=kernel(lhs_begin+i, rhs_begin+j). Kernels with
+		 * property KP_DOTBLOCK on dense real valued features compute the
+		 * block from a single matrix product, others call kernel() for
+		 * every pair.
+		 *
+		 * @param lhs_begin index of the first lhs feature vector
+		 * @param lhs_size number of lhs feature vectors
+		 * @param rhs_begin index of the first rhs feature vector
+		 * @param rhs_size number of rhs feature vectors
+		 * @param result lhs_size x rhs_size matrix receiving the values
+		 */
+		void kernel_block(index_t lhs_begin, index_t lhs_size,
+				index_t rhs_begin, index_t rhs_size, SGMatrix<float64_t>& result);
+
 		/** get kernel matrix
 		 *
 		 * @return computed kernel matrix (needs to be cleaned up)
@@ -584,6 +602,25 @@ class Kernel : public SGObject
 		 */
 		inline int32_t get_cache_size() { return cache_size; }
 
+		/** set the precision in which kernel rows are cached by solvers
+		 * using a KernelRowCache (e.g. LibSVM)
+		 *
+		 * @param precision storage precision of cached kernel values
+		 */
+		inline void set_cache_precision(EKernelCachePrecision precision)
+		{
+			cache_precision = precision;
+		}
+
+		/** return the precision in which kernel rows are cached
+		 *
+		 * @return storage precision of cached kernel values
+		 */
+		inline EKernelCachePrecision get_cache_precision()
+		{
+			return cache_precision;
+		}
+
 #ifdef USE_SVMLIGHT
 		/** cache reset */
 		inline void cache_reset() { resize_kernel_cache(cache_size); }
@@ -928,6 +965,34 @@ class Kernel : public SGObject
 		 */
 		template <class T> static void* get_kernel_matrix_helper(void* p);
 
+		/** compute kernel values from the inner products of a block of
+		 * vectors in place, for kernels with property KP_DOTBLOCK.
+		 * The unnormalized kernel value of lhs vector i and rhs vector j
+		 * of the block is a function of block(i,j)=<x_i,y_j>, ||x_i||^2
+		 * and ||y_j||^2. The default keeps the inner products.
+		 *
+		 * @param block inner products, overwritten by the kernel values
+		 * @param lhs_sq_norms squared norms of the lhs vectors of the block
+		 * @param rhs_sq_norms squared norms of the rhs vectors of the block
+		 */
+		virtual void transform_dot_block(SGMatrix<float64_t>& block,
+			const float64_t* lhs_sq_norms, const float64_t* rhs_sq_norms) const
+		{
+		}
+
+		/** whether the kernel matrix is computed blockwise via matrix
+		 * products, i.e. the kernel has property KP_DOTBLOCK and both
+		 * sides are dense real valued features
+		 */
+		bool use_blocked_kernel_matrix();
+
+		/** compute the kernel matrix in tiles, each with a single matrix
+		 * product of lhs and rhs vectors and transform_dot_block()
+		 *
+		 * @return the kernel matrix
+		 */
+		template <class T> SGMatrix<T> get_kernel_matrix_blocked();
+
 		/** Can (optionally) be overridden to post-initialize some member
 		 *  variables which are not PARAMETER::ADD'ed.  Make sure that at
 		 *  first the overridden method BASE_CLASS::LOAD_SERIALIZABLE_POST
@@ -1040,6 +1105,9 @@ class Kernel : public SGObject
 		/// cache_size in MB
 		int32_t cache_size;
 
+		/// storage precision of cached kernel rows
+		EKernelCachePrecision cache_precision;
+
 #ifdef USE_SVMLIGHT
 		/// kernel cache
 		KERNEL_CACHE kernel_cache;
@@ -0,0 +1,277 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/kernel/KernelRowCache.h>
+#include <shogun/lib/memory.h>
+#include <shogun/mathematics/Math.h>
+
+#include <string.h>
+
+using namespace shogun;
+
+KernelRowCache::RowBlock::RowBlock(int32_t n, size_t elem_size) : len(n)
+{
+	data = SG_MALLOC(char, int64_t(n) * elem_size);
+}
+
+KernelRowCache::RowBlock::~RowBlock()
+{
+	SG_FREE(data);
+}
+
+KernelRowCache::KernelRowCache(
+    int32_t num_rows, int64_t size_bytes, EKernelCachePrecision precision,
+    int32_t num_shards)
+    : m_num_rows(num_rows), m_precision(precision), m_entries(num_rows),
+      m_hits(0), m_misses(0), m_evictions(0), m_bytes_used(0)
+{
+	require(num_rows > 0, "Number of rows ({}) has to be positive", num_rows);
+
+	int64_t elems = size_bytes / element_size();
+	elems -= int64_t(num_rows) * sizeof(Entry) / element_size();
+	// cache must be large enough for two full rows
+	elems = Math::max(elems, int64_t(2) * num_rows);
+
+	if (num_shards <= 0)
+		num_shards = env()->get_num_threads();
+
+	// every shard has to be able to hold two full rows on its own
+	int64_t max_shards = Math::max(elems / (int64_t(2) * num_rows), int64_t(1));
+	num_shards = (int32_t)Math::clamp(
+	    int64_t(num_shards), int64_t(1), Math::min(max_shards, int64_t(num_rows)));
+
+	m_shards = std::vector<Shard>(num_shards);
+	for (auto& shard : m_shards)
+		shard.free_elems = elems / num_shards;
+
+	SG_DEBUG(
+	    "kernel row cache for {} rows: {} values of {} bytes in {} shards",
+	    num_rows, elems, element_size(), num_shards);
+}
+
+KernelRowCache::~KernelRowCache()
+{
+}
+
+KernelRowCache::Row KernelRowCache::get_row(
+    int32_t row, int32_t len, const RowComputer& compute)
+{
+	require(
+	    row >= 0 && row < m_num_rows, "Row index {} out of range [0, {})", row,
+	    m_num_rows);
+	require(
+	    len >= 0 && len <= m_num_rows, "Row length {} out of range [0, {}]",
+	    len, m_num_rows);
+
+	auto& shard = shard_of(row);
+	auto& entry = m_entries[row];
+
+	Row result;
+	result.m_precision = m_precision;
+
+	std::unique_lock<std::mutex> lock(shard.mutex);
+	shard.computed.wait(lock, [&entry]() { return !entry.computing; });
+
+	int32_t cached = entry.block ? entry.block->len : 0;
+	if (cached >= len)
+	{
+		m_hits++;
+		touch(shard, row);
+		result.m_block = entry.block;
+		result.m_len = cached;
+		return result;
+	}
+
+	m_misses++;
+	if (entry.in_lru)
+	{
+		shard.lru.erase(entry.lru_pos);
+		entry.in_lru = false;
+	}
+	make_room(shard, len - cached);
+	m_bytes_used += int64_t(len - cached) * element_size();
+
+	auto block = std::make_shared<RowBlock>(len, element_size());
+	if (cached)
+		sg_memcpy(block->data, entry.block->data, cached * element_size());
+	entry.computing = true;
+	lock.unlock();
+
+	try
+	{
+		if (m_precision == KCP_FLOAT64)
+			compute(row, (float64_t*)block->data, cached, len);
+		else
+		{
+			std::vector<float64_t> values(len);
+			compute(row, values.data(), cached, len);
+			auto dst = (float32_t*)block->data;
+			for (int32_t j = cached; j < len; ++j)
+				dst[j] = (float32_t)values[j];
+		}
+	}
+	catch (...)
+	{
+		lock.lock();
+		shard.free_elems += len - cached;
+		m_bytes_used -= int64_t(len - cached) * element_size();
+		entry.computing = false;
+		if (entry.block)
+			touch(shard, row);
+		shard.computed.notify_all();
+		throw;
+	}
+
+	lock.lock();
+	entry.block = block;
+	entry.computing = false;
+	touch(shard, row);
+	shard.computed.notify_all();
+
+	result.m_block = std::move(block);
+	result.m_len = len;
+	return result;
+}
+
+bool KernelRowCache::is_cached(int32_t row, int32_t len) const
+{
+	const auto& shard = shard_of(row);
+	const auto& entry = m_entries[row];
+
+	std::lock_guard<std::mutex> lock(shard.mutex);
+	return !entry.computing && entry.block && entry.block->len >= len;
+}
+
+void KernelRowCache::swap_index(int32_t i, int32_t j)
+{
+	if (i == j)
+		return;
+
+	std::vector<std::unique_lock<std::mutex>> locks;
+	for (auto& shard : m_shards)
+		locks.emplace_back(shard.mutex);
+
+	auto& shard_i = shard_of(i);
+	auto& shard_j = shard_of(j);
+	auto& entry_i = m_entries[i];
+	auto& entry_j = m_entries[j];
+
+	for (auto idx : {i, j})
+	{
+		auto& entry = m_entries[idx];
+		if (entry.in_lru)
+		{
+			shard_of(idx).lru.erase(entry.lru_pos);
+			entry.in_lru = false;
+		}
+	}
+
+	// rows may move between shards, so does their memory
+	int32_t len_i = entry_i.block ? entry_i.block->len : 0;
+	int32_t len_j = entry_j.block ? entry_j.block->len : 0;
+	shard_i.free_elems += len_i - len_j;
+	shard_j.free_elems += len_j - len_i;
+	std::swap(entry_i.block, entry_j.block);
+
+	if (entry_i.block)
+		touch(shard_i, i);
+	if (entry_j.block)
+		touch(shard_j, j);
+
+	if (i > j)
+		std::swap(i, j);
+
+	// only cached rows need fixing up, which are exactly those in the lru
+	// lists as no row is being computed
+	const auto elem_size = element_size();
+	std::vector<char> tmp(elem_size);
+	for (auto& shard : m_shards)
+	{
+		for (auto it = shard.lru.begin(); it != shard.lru.end();)
+		{
+			int32_t row = *it++;
+			auto& block = m_entries[row].block;
+			if (block->len <= i)
+				continue;
+
+			if (block->len > j)
+			{
+				auto data = (char*)block->data;
+				sg_memcpy(tmp.data(), data + i * elem_size, elem_size);
+				sg_memcpy(data + i * elem_size, data + j * elem_size, elem_size);
+				sg_memcpy(data + j * elem_size, tmp.data(), elem_size);
+			}
+			else
+			{
+				// give up on the row, like libsvm does
+				drop(shard, row);
+			}
+		}
+	}
+}
+
+void KernelRowCache::clear()
+{
+	std::vector<std::unique_lock<std::mutex>> locks;
+	for (auto& shard : m_shards)
+		locks.emplace_back(shard.mutex);
+
+	for (auto& shard : m_shards)
+	{
+		while (!shard.lru.empty())
+			drop(shard, shard.lru.front());
+	}
+}
+
+KernelRowCache::Statistics KernelRowCache::get_statistics() const
+{
+	Statistics stats;
+	stats.hits = m_hits;
+	stats.misses = m_misses;
+	stats.evictions = m_evictions;
+	stats.bytes_used = m_bytes_used;
+	return stats;
+}
+
+void KernelRowCache::make_room(Shard& shard, int64_t num_elems)
+{
+	// rows that are being computed are not in the lru list, so they are
+	// never dropped. If all memory is bound in such rows, we temporarily
+	// exceed the budget rather than blocking.
+	while (shard.free_elems < num_elems && !shard.lru.empty())
+	{
+		drop(shard, shard.lru.front());
+		m_evictions++;
+	}
+	shard.free_elems -= num_elems;
+}
+
+void KernelRowCache::drop(Shard& shard, int32_t row)
+{
+	auto& entry = m_entries[row];
+	if (entry.in_lru)
+	{
+		shard.lru.erase(entry.lru_pos);
+		entry.in_lru = false;
+	}
+	if (entry.block)
+	{
+		shard.free_elems += entry.block->len;
+		m_bytes_used -= int64_t(entry.block->len) * element_size();
+		entry.block.reset();
+	}
+}
+
+void KernelRowCache::touch(Shard& shard, int32_t row)
+{
+	auto& entry = m_entries[row];
+	if (entry.in_lru)
+		shard.lru.erase(entry.lru_pos);
+	entry.lru_pos = shard.lru.insert(shard.lru.end(), row);
+	entry.in_lru = true;
+}
@@ -0,0 +1,306 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#ifndef _KERNEL_ROW_CACHE_H__
+#define _KERNEL_ROW_CACHE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace shogun
+{
+	/** storage precision of cached kernel rows */
+	enum EKernelCachePrecision
+	{
+		KCP_FLOAT64 = 0,
+		KCP_FLOAT32 = 1
+	};
+
+	/** @brief Thread-safe LRU cache of kernel rows.
+	 *
+	 * Rows are identified by their index in [0, num_rows) and are cached as
+	 * prefixes, i.e. a row that was requested with length len holds the
+	 * values of columns [0, len). Requesting a longer prefix only computes
+	 * the missing part.
+	 *
+	 * The cache is split into shards (row index modulo the number of
+	 * shards), each protected by its own mutex and owning an equal part of
+	 * the memory budget, so that several threads (e.g. a solver and its
+	 * prefetching workers) can fetch and compute rows concurrently. Rows
+	 * that are being computed by one thread are waited for by others
+	 * instead of being computed twice.
+	 *
+	 * Rows are handed out as Row handles which keep the underlying buffer
+	 * alive, hence a row that gets evicted while a caller still holds its
+	 * handle stays valid for that caller.
+	 *
+	 * Values are stored either as float64_t or as float32_t, which is
+	 * selected at construction time and halves the memory footprint at the
+	 * price of precision.
+	 */
+	class KernelRowCache
+	{
+		/** reference counted buffer holding a row prefix */
+		struct RowBlock
+		{
+			RowBlock(int32_t len, size_t elem_size);
+			~RowBlock();
+
+			/** row values */
+			void* data;
+			/** number of values */
+			int32_t len;
+		};
+
+	public:
+		/** cache usage statistics */
+		struct Statistics
+		{
+			/** number of requests that were served from cache */
+			int64_t hits;
+			/** number of requests that required computation */
+			int64_t misses;
+			/** number of rows that were dropped to make room */
+			int64_t evictions;
+			/** number of bytes currently used by cached rows */
+			int64_t bytes_used;
+		};
+
+		/** @brief Handle to a cached row.
+		 *
+		 * Keeps the row values alive as long as the handle exists.
+		 */
+		class Row
+		{
+			friend class KernelRowCache;
+
+		public:
+			/** empty handle */
+			Row() = default;
+
+			/** @return whether the handle refers to a row */
+			bool valid() const
+			{
+				return m_block != nullptr;
+			}
+
+			/** @return number of values available in the row */
+			int32_t size() const
+			{
+				return m_len;
+			}
+
+			/** @return the j-th value of the row */
+			float64_t operator[](int32_t j) const
+			{
+				if (m_precision == KCP_FLOAT32)
+					return ((const float32_t*)m_block->data)[j];
+				return ((const float64_t*)m_block->data)[j];
+			}
+
+			/** direct access to the stored values
+			 *
+			 * @return pointer to the values if the cache stores T,
+			 * nullptr otherwise
+			 */
+			template <class T>
+			const T* data() const
+			{
+				if (sizeof(T) != element_size())
+					return nullptr;
+				return (const T*)m_block->data;
+			}
+
+			/** convert the values in [start, end) to T
+			 *
+			 * @param dst destination, indexed like the row
+			 * @param start first column
+			 * @param end one past the last column
+			 */
+			template <class T>
+			void copy_to(T* dst, int32_t start, int32_t end) const
+			{
+				if (m_precision == KCP_FLOAT32)
+				{
+					auto src = (const float32_t*)m_block->data;
+					for (int32_t j = start; j < end; ++j)
+						dst[j] = (T)src[j];
+				}
+				else
+				{
+					auto src = (const float64_t*)m_block->data;
+					for (int32_t j = start; j < end; ++j)
+						dst[j] = (T)src[j];
+				}
+			}
+
+			/** @return size of a stored value in bytes */
+			size_t element_size() const
+			{
+				return m_precision == KCP_FLOAT32 ? sizeof(float32_t)
+				                                  : sizeof(float64_t);
+			}
+
+		private:
+			std::shared_ptr<RowBlock> m_block;
+			int32_t m_len = 0;
+			EKernelCachePrecision m_precision = KCP_FLOAT64;
+		};
+
+		/** computes the values of a row on the columns [start, end) into
+		 * out[start, end)
+		 */
+		typedef std::function<void(
+		    int32_t row, float64_t* out, int32_t start, int32_t end)>
+		    RowComputer;
+
+		/** constructor
+		 *
+		 * @param num_rows number of distinct rows
+		 * @param size_bytes memory budget in bytes
+		 * @param precision storage precision of the values
+		 * @param num_shards number of independently locked shards, 0 picks
+		 * one per thread
+		 */
+		KernelRowCache(
+		    int32_t num_rows, int64_t size_bytes,
+		    EKernelCachePrecision precision = KCP_FLOAT64,
+		    int32_t num_shards = 0);
+
+		~KernelRowCache();
+
+		/** fetch the prefix [0, len) of a row, computing the missing part
+		 * with the given function
+		 *
+		 * @param row row index
+		 * @param len length of the requested prefix
+		 * @param compute function computing row values
+		 * @return handle to the row
+		 */
+		Row get_row(int32_t row, int32_t len, const RowComputer& compute);
+
+		/** check whether the prefix [0, len) of a row is cached
+		 *
+		 * @param row row index
+		 * @param len length of the prefix
+		 * @return whether the prefix is readily available
+		 */
+		bool is_cached(int32_t row, int32_t len) const;
+
+		/** exchange rows and columns i and j, used by shrinking solvers
+		 * that permute their working indices. Cached rows that cannot be
+		 * fixed up are dropped. Must not be called while other threads
+		 * are computing rows.
+		 *
+		 * @param i first index
+		 * @param j second index
+		 */
+		void swap_index(int32_t i, int32_t j);
+
+		/** drop all cached rows */
+		void clear();
+
+		/** @return usage statistics */
+		Statistics get_statistics() const;
+
+		/** @return storage precision */
+		EKernelCachePrecision get_precision() const
+		{
+			return m_precision;
+		}
+
+		/** @return number of shards */
+		int32_t get_num_shards() const
+		{
+			return (int32_t)m_shards.size();
+		}
+
+		/** @return number of distinct rows */
+		int32_t get_num_rows() const
+		{
+			return m_num_rows;
+		}
+
+	private:
+		/** cache line of a single row */
+		struct Entry
+		{
+			/** cached prefix, empty if the row is not cached */
+			std::shared_ptr<RowBlock> block;
+			/** position in the lru list of the shard */
+			std::list<int32_t>::iterator lru_pos;
+			/** whether the row is in the lru list */
+			bool in_lru = false;
+			/** whether a thread is currently computing the row */
+			bool computing = false;
+		};
+
+		/** independently locked part of the cache */
+		struct Shard
+		{
+			/** guards all entries of this shard */
+			mutable std::mutex mutex;
+			/** signalled when a row computation finished */
+			std::condition_variable computed;
+			/** least recently used rows first */
+			std::list<int32_t> lru;
+			/** number of values that may still be stored */
+			int64_t free_elems = 0;
+		};
+
+		Shard& shard_of(int32_t row)
+		{
+			return m_shards[row % m_shards.size()];
+		}
+
+		const Shard& shard_of(int32_t row) const
+		{
+			return m_shards[row % m_shards.size()];
+		}
+
+		size_t element_size() const
+		{
+			return m_precision == KCP_FLOAT32 ? sizeof(float32_t)
+			                                  : sizeof(float64_t);
+		}
+
+		/** free entries of the given shard until at least num_elems values
+		 * fit, has to be called with the shard lock held
+		 */
+		void make_room(Shard& shard, int64_t num_elems);
+
+		/** drop the cached prefix of a row, has to be called with the
+		 * shard lock held
+		 */
+		void drop(Shard& shard, int32_t row);
+
+		/** move row to the most recently used position, has to be called
+		 * with the shard lock held
+		 */
+		void touch(Shard& shard, int32_t row);
+
+	private:
+		int32_t m_num_rows;
+		EKernelCachePrecision m_precision;
+		std::vector<Entry> m_entries;
+		std::vector<Shard> m_shards;
+
+		std::atomic<int64_t> m_hits;
+		std::atomic<int64_t> m_misses;
+		std::atomic<int64_t> m_evictions;
+		std::atomic<int64_t> m_bytes_used;
+	};
+} // namespace shogun
+#endif // _KERNEL_ROW_CACHE_H__
@@ -16,13 +16,13 @@ using namespace shogun;
 LinearKernel::LinearKernel()
 : DotKernel(0)
 {
-	properties |= KP_LINADD;
+	properties |= KP_LINADD | KP_DOTBLOCK;
 }
 
 LinearKernel::LinearKernel(const std::shared_ptr<DotFeatures>& l, const std::shared_ptr<DotFeatures>& r)
 : DotKernel(0)
 {
-	properties |= KP_LINADD;
+	properties |= KP_LINADD | KP_DOTBLOCK;
 	init(l,r);
 }
 
@@ -66,8 +66,17 @@ float64_t PolyKernel::compute(int32_t idx_a, int32_t idx_b)
 	return Math::pow(result, degree);
 }
 
+void PolyKernel::transform_dot_block(SGMatrix<float64_t>& block,
+	const float64_t* lhs_sq_norms, const float64_t* rhs_sq_norms) const
+{
+	const float64_t gamma = std::get<float64_t>(m_gamma);
+	for (int64_t i=0; i<block.size(); i++)
+		block.matrix[i] = Math::pow(gamma * block.matrix[i] + m_c, degree);
+}
+
 void PolyKernel::init()
 {
+	set_property(KP_DOTBLOCK);
 	degree = 0;
 	m_c = 0.0;
 	set_normalizer(std::make_shared<SqrtDiagKernelNormalizer>());
@@ -100,6 +100,15 @@ class PolyKernel: public DotKernel
 		 */
 		float64_t compute(int32_t idx_a, int32_t idx_b) override;
 
+		/** compute (gamma*<x,y>+c)^degree from a block of inner products
+		 *
+		 * @param block inner products, overwritten by the kernel values
+		 * @param lhs_sq_norms squared norms of the lhs vectors of the block
+		 * @param rhs_sq_norms squared norms of the rhs vectors of the block
+		 */
+		void transform_dot_block(SGMatrix<float64_t>& block,
+			const float64_t* lhs_sq_norms, const float64_t* rhs_sq_norms) const override;
+
 	private:
 		void init();
 
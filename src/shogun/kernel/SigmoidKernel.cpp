@@ -13,6 +13,7 @@ using namespace shogun;
 
 SigmoidKernel::SigmoidKernel() : DotKernel()
 {
+	set_property(KP_DOTBLOCK);
 	SG_ADD(
 	    &m_gamma, "gamma", "Scaler for the dot product.",
 	    ParameterProperties::HYPER | ParameterProperties::AUTO,
@@ -49,3 +50,11 @@ bool SigmoidKernel::init(std::shared_ptr<Features> l, std::shared_ptr<Features>
 	DotKernel::init(l, r);
 	return init_normalizer();
 }
+
+void SigmoidKernel::transform_dot_block(SGMatrix<float64_t>& block,
+	const float64_t* lhs_sq_norms, const float64_t* rhs_sq_norms) const
+{
+	const float64_t gamma = std::get<float64_t>(m_gamma);
+	for (int64_t i=0; i<block.size(); i++)
+		block.matrix[i] = tanh(gamma * block.matrix[i] + coef0);
+}
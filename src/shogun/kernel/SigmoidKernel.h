@@ -93,6 +93,15 @@ class SigmoidKernel: public DotKernel
 			return tanh(std::get<float64_t>(m_gamma)*DotKernel::compute(idx_a,idx_b)+coef0);
 		}
 
+		/** compute tanh(gamma*<x,y>+coef0) from a block of inner products
+		 *
+		 * @param block inner products, overwritten by the kernel values
+		 * @param lhs_sq_norms squared norms of the lhs vectors of the block
+		 * @param rhs_sq_norms squared norms of the rhs vectors of the block
+		 */
+		void transform_dot_block(SGMatrix<float64_t>& block,
+			const float64_t* lhs_sq_norms, const float64_t* rhs_sq_norms) const override;
+
 	protected:
 		/** gamma */
 		AutoValue<float64_t> m_gamma = AutoValueEmpty{};
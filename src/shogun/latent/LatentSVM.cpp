@@ -29,6 +29,7 @@ LatentSVM::~LatentSVM()
 
 std::shared_ptr<LatentLabels> LatentSVM::apply_latent()
 {
+	load_lazy_parameters();
 	if (!m_model)
 		error("LatentModel is not set!");
 
@@ -200,6 +200,20 @@ namespace shogun
 		virtual void exit_std_vector(size_t* size) = 0;
 		virtual void exit_map(size_t* size) = 0;
 
+		/** called with the storage of a dense container of numeric values
+		 * before its elements are visited one by one
+		 *
+		 * @param data first element
+		 * @param element_size size of one element in bytes
+		 * @param num_elements number of elements
+		 * @return whether the whole storage was handled, so that the
+		 * elements are not visited
+		 */
+		virtual bool on_blob(void* data, size_t element_size, int64_t num_elements)
+		{
+			return false;
+		}
+
 		template <typename T>
 		void on(std::atomic<T>* val)
 		{
@@ -244,8 +258,11 @@ namespace shogun
 			enter_vector(std::addressof(size));
 			if (size != _v->vlen)
 				_v->resize_vector(size);
-			for (auto&& _value : *_v)
-				on(std::addressof(_value));
+			if (!visit_blob(_v->vector, size))
+			{
+				for (auto&& _value : *_v)
+					on(std::addressof(_value));
+			}
 			exit_vector(std::addressof(size));
 		}
 
@@ -289,8 +306,11 @@ namespace shogun
 					*_v->ptr() = SG_CALLOC(T, size);
 			}
 			auto ptr = *(_v->ptr());
-			for (S i = 0; i < size; ++i)
-				on(std::addressof(ptr[i]));
+			if (!visit_blob(ptr, size))
+			{
+				for (S i = 0; i < size; ++i)
+					on(std::addressof(ptr[i]));
+			}
 			exit_vector(std::addressof(size));
 		}
 
@@ -310,8 +330,11 @@ namespace shogun
 					*_v->ptr() = SG_MALLOC(T, length);
 			}
 			auto ptr = *(_v->ptr());
-			for (int64_t i = 0; i < length; ++i)
-				on(std::addressof(ptr[i]));
+			if (!visit_blob(ptr, length))
+			{
+				for (int64_t i = 0; i < length; ++i)
+					on(std::addressof(ptr[i]));
+			}
 			exit_matrix(shape.first, shape.second);
 		}
 
@@ -323,10 +346,13 @@ namespace shogun
 			enter_matrix(std::addressof(rows), std::addressof(cols));
 			if ((rows != _matrix->num_rows) || (cols != _matrix->num_cols))
 				*_matrix = SGMatrix<T>(rows, cols);
-			for (auto index = 0; index < cols; index++)
+			if (!visit_blob(_matrix->matrix, int64_t(rows) * cols))
 			{
-				on_matrix_row(
-				    std::addressof(rows), std::addressof(index), _matrix);
+				for (auto index = 0; index < cols; index++)
+				{
+					on_matrix_row(
+					    std::addressof(rows), std::addressof(index), _matrix);
+				}
 			}
 			exit_matrix(std::addressof(rows), std::addressof(cols));
 		}
@@ -396,6 +422,24 @@ namespace shogun
 		void on(...)
 		{
 		}
+
+	private:
+		/** offers the storage of a dense container to on_blob() if its
+		 * elements are plain numeric values
+		 *
+		 * @return whether the storage was handled
+		 */
+		template <typename T, typename S>
+		bool visit_blob(T* data, S num_elements)
+		{
+			if constexpr (
+			    (std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+			     !std::is_same_v<T, floatmax_t>) ||
+			    std::is_same_v<T, complex128_t>)
+				return on_blob(data, sizeof(T), num_elements);
+			else
+				return false;
+		}
 	};
 
 	namespace any_detail
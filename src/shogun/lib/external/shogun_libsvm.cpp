@@ -52,6 +52,13 @@
 #include <string.h>
 #include <stdarg.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <rxcpp/rx.hpp>
 
 namespace shogun
@@ -71,133 +78,6 @@ template <class S, class T> inline void clone(T*& dst, S* src, int32_t n)
 class QMatrix;
 class SVC_QMC;
 
-//
-// Kernel Cache
-//
-// l is the number of total data items
-// size is the cache size limit in bytes
-//
-class Cache
-{
-public:
-	Cache(int32_t l, int64_t size);
-	~Cache();
-
-	// request data [0,len)
-	// return some position p where [p,len) need to be filled
-	// (p >= len if nothing needs to be filled)
-	int32_t get_data(const int32_t index, Qfloat **data, int32_t len);
-	void swap_index(int32_t i, int32_t j);	// future_option
-
-private:
-	int32_t l;
-	int64_t size;
-	struct head_t
-	{
-		head_t *prev, *next;	// a circular list
-		Qfloat *data;
-		int32_t len;		// data[0,len) is cached in this entry
-	};
-
-	head_t *head;
-	head_t lru_head;
-	void lru_delete(head_t *h);
-	void lru_insert(head_t *h);
-};
-
-Cache::Cache(int32_t l_, int64_t size_):l(l_),size(size_)
-{
-	head = (head_t *)SG_CALLOC(head_t, l);	// initialized to 0
-	size /= sizeof(Qfloat);
-	size -= l * sizeof(head_t) / sizeof(Qfloat);
-	size = Math::max(size, (int64_t) 2*l);	// cache must be large enough for two columns
-	lru_head.next = lru_head.prev = &lru_head;
-}
-
-Cache::~Cache()
-{
-	for(head_t *h = lru_head.next; h != &lru_head; h=h->next)
-		SG_FREE(h->data);
-	SG_FREE(head);
-}
-
-void Cache::lru_delete(head_t *h)
-{
-	// delete from current location
-	h->prev->next = h->next;
-	h->next->prev = h->prev;
-}
-
-void Cache::lru_insert(head_t *h)
-{
-	// insert to last position
-	h->next = &lru_head;
-	h->prev = lru_head.prev;
-	h->prev->next = h;
-	h->next->prev = h;
-}
-
-int32_t Cache::get_data(const int32_t index, Qfloat **data, int32_t len)
-{
-	head_t *h = &head[index];
-	if(h->len) lru_delete(h);
-	int32_t more = len - h->len;
-
-	if(more > 0)
-	{
-		// free old space
-		while(size < more)
-		{
-			head_t *old = lru_head.next;
-			lru_delete(old);
-			SG_FREE(old->data);
-			size += old->len;
-			old->data = 0;
-			old->len = 0;
-		}
-
-		// allocate new space
-		h->data = SG_REALLOC(Qfloat, h->data, h->len, len);
-		size -= more;
-		Math::swap(h->len,len);
-	}
-
-	lru_insert(h);
-	*data = h->data;
-	return len;
-}
-
-void Cache::swap_index(int32_t i, int32_t j)
-{
-	if(i==j) return;
-
-	if(head[i].len) lru_delete(&head[i]);
-	if(head[j].len) lru_delete(&head[j]);
-	Math::swap(head[i].data,head[j].data);
-	Math::swap(head[i].len,head[j].len);
-	if(head[i].len) lru_insert(&head[i]);
-	if(head[j].len) lru_insert(&head[j]);
-
-	if(i>j) Math::swap(i,j);
-	for(head_t *h = lru_head.next; h!=&lru_head; h=h->next)
-	{
-		if(h->len > i)
-		{
-			if(h->len > j)
-				Math::swap(h->data[i],h->data[j]);
-			else
-			{
-				// give up
-				lru_delete(h);
-				SG_FREE(h->data);
-				size += h->len;
-				h->data = 0;
-				h->len = 0;
-			}
-		}
-	}
-}
-
 //
 // Kernel evaluation
 //
@@ -212,7 +92,14 @@ public:
 	virtual void swap_index(int32_t i, int32_t j) const = 0;
 	virtual ~QMatrix() {}
 
+	// hint that columns will be requested soon with the given length
+	virtual void prefetch_Q(const int32_t* columns, int32_t num, int32_t len) const {}
+	// block until no prefetching is in progress anymore
+	virtual void wait_prefetch() const {}
+
 	float64_t max_train_time;
+	// number of columns to prefetch per iteration, 0 disables prefetching
+	int32_t prefetch_size;
 };
 
 class LibSVMKernel;
@@ -230,19 +117,22 @@ public:
 		if(x_square) Math::swap(x_square[i],x_square[j]);
 	}
 
-	void compute_Q_parallel(Qfloat* data, float64_t* lab, int32_t i, int32_t start, int32_t len) const
+	void prefetch_Q(const int32_t* columns, int32_t num, int32_t len) const override;
+	void wait_prefetch() const override;
+
+	void compute_Q_parallel(float64_t* data, const float64_t* lab, int32_t i, int32_t start, int32_t len, bool parallel=true) const
 	{
 		if (lab) // two class
 		{
-			#pragma omp parallel for
+			#pragma omp parallel for if(parallel)
 			for(int32_t j=start;j<len;j++)
-				data[j] = (Qfloat) lab[i]*lab[j]*this->kernel_function(i,j);
+				data[j] = lab[i]*lab[j]*this->kernel_function(i,j);
 		}
 		else // one class, eps svr
 		{
-			#pragma omp parallel for
+			#pragma omp parallel for if(parallel)
 			for(int32_t j=start;j<len;j++)
-				data[j] = (Qfloat) this->kernel_function(i,j);
+				data[j] = this->kernel_function(i,j);
 		}
 	}
 
@@ -251,10 +141,57 @@ public:
 		return kernel->kernel(x[i]->index,x[j]->index);
 	}
 
+protected:
+	// compute the cached row with index row on [start,len)
+	virtual void compute_Q(int32_t row, float64_t* data, int32_t start, int32_t len, bool parallel) const = 0;
+
+	// cached row and its length that get_Q(column, len) is served from
+	virtual int32_t cache_index(int32_t column) const { return column; }
+	virtual int32_t cache_len(int32_t len) const { return len; }
+
+	// request column i on [0,len) from the row cache, computing
+	// missing entries with compute_Q. The returned column stays
+	// valid until get_cached_Q was called two more times (the solver only
+	// ever works with two columns at once)
+	Qfloat* get_cached_Q(int32_t i, int32_t len) const
+	{
+		KernelRowCache::Row& row = pinned[next_pinned];
+		Qfloat* buf = pinned_buffer[next_pinned];
+		next_pinned = 1 - next_pinned;
+
+		row = cache->get_row(i, len, [this](int32_t r, float64_t* data, int32_t start, int32_t end)
+		{
+			compute_Q(r, data, start, end, true);
+		});
+		if (const Qfloat* data = row.data<Qfloat>())
+			return const_cast<Qfloat*>(data);
+
+		// cache precision differs from Qfloat
+		row.copy_to(buf, 0, len);
+		return buf;
+	}
+
+	KernelRowCache* cache;
+
 private:
+	void prefetch_loop() const;
+
 	Kernel* kernel;
 	const svm_node **x;
 	float64_t *x_square;
+
+	mutable KernelRowCache::Row pinned[2];
+	Qfloat* pinned_buffer[2];
+	mutable int32_t next_pinned;
+
+	// background workers filling the cache with predicted columns
+	mutable std::vector<std::thread> prefetch_workers;
+	mutable std::mutex prefetch_mutex;
+	mutable std::condition_variable prefetch_queued;
+	mutable std::condition_variable prefetch_done;
+	mutable std::deque<std::pair<int32_t, int32_t>> prefetch_queue;
+	mutable int32_t prefetch_running;
+	mutable bool prefetch_stop;
 };
 
 LibSVMKernel::LibSVMKernel(int32_t l, svm_node * const * x_, const svm_parameter& param)
@@ -263,14 +200,118 @@ LibSVMKernel::LibSVMKernel(int32_t l, svm_node * const * x_, const svm_parameter
 	x_square = 0;
 	kernel=param.kernel;
 	max_train_time=param.max_train_time;
+	prefetch_size=param.prefetch_size;
+
+	cache = new KernelRowCache(l, (int64_t)(param.cache_size*(1l<<20)), param.cache_precision);
+	next_pinned = 0;
+	pinned_buffer[0] = pinned_buffer[1] = NULL;
+	if (cache->get_precision() != (sizeof(Qfloat) == sizeof(float32_t) ? KCP_FLOAT32 : KCP_FLOAT64))
+	{
+		pinned_buffer[0] = SG_MALLOC(Qfloat, l);
+		pinned_buffer[1] = SG_MALLOC(Qfloat, l);
+	}
+
+	prefetch_running = 0;
+	prefetch_stop = false;
+	if (prefetch_size > 0)
+	{
+		// the solver keeps one thread busy, columns requested by it
+		// are computed in parallel by the omp team
+		int32_t num_workers = Math::max(env()->get_num_threads() - 1, 1);
+		for (int32_t t = 0; t < num_workers; ++t)
+			prefetch_workers.emplace_back([this]() { prefetch_loop(); });
+	}
 }
 
 LibSVMKernel::~LibSVMKernel()
 {
+	{
+		std::lock_guard<std::mutex> lock(prefetch_mutex);
+		prefetch_stop = true;
+		prefetch_queue.clear();
+	}
+	prefetch_queued.notify_all();
+	for (auto& worker : prefetch_workers)
+		worker.join();
+
+	KernelRowCache::Statistics stats = cache->get_statistics();
+	SG_DEBUG("kernel row cache: {} hits, {} misses, {} evictions",
+		stats.hits, stats.misses, stats.evictions);
+
+	pinned[0] = KernelRowCache::Row();
+	pinned[1] = KernelRowCache::Row();
+	delete cache;
+	SG_FREE(pinned_buffer[0]);
+	SG_FREE(pinned_buffer[1]);
 	SG_FREE(x);
 	SG_FREE(x_square);
 }
 
+void LibSVMKernel::prefetch_Q(const int32_t* columns, int32_t num, int32_t len) const
+{
+	if (prefetch_workers.empty())
+		return;
+
+	{
+		std::lock_guard<std::mutex> lock(prefetch_mutex);
+		// older predictions are outdated by now
+		prefetch_queue.clear();
+		for (int32_t k = 0; k < num; ++k)
+		{
+			int32_t row = cache_index(columns[k]);
+			int32_t row_len = cache_len(len);
+			if (!cache->is_cached(row, row_len))
+				prefetch_queue.emplace_back(row, row_len);
+		}
+	}
+	prefetch_queued.notify_all();
+}
+
+void LibSVMKernel::wait_prefetch() const
+{
+	if (prefetch_workers.empty())
+		return;
+
+	std::unique_lock<std::mutex> lock(prefetch_mutex);
+	prefetch_queue.clear();
+	prefetch_done.wait(lock, [this]() { return prefetch_running == 0; });
+}
+
+void LibSVMKernel::prefetch_loop() const
+{
+	std::unique_lock<std::mutex> lock(prefetch_mutex);
+	while (true)
+	{
+		prefetch_queued.wait(lock, [this]() {
+			return prefetch_stop || !prefetch_queue.empty();
+		});
+		if (prefetch_stop)
+			return;
+
+		auto job = prefetch_queue.front();
+		prefetch_queue.pop_front();
+		++prefetch_running;
+		lock.unlock();
+
+		try
+		{
+			cache->get_row(job.first, job.second, [this](int32_t r, float64_t* data, int32_t start, int32_t end)
+			{
+				compute_Q(r, data, start, end, false);
+			});
+		}
+		catch (...)
+		{
+			// prefetching is best effort, the solver recomputes the
+			// column when it actually needs it
+		}
+
+		lock.lock();
+		if (--prefetch_running == 0)
+			prefetch_done.notify_all();
+	}
+}
+
 // Generalized SMO+SVMlight algorithm
 // Solves:
 //
@@ -342,6 +383,7 @@ protected:
 	bool is_free(int32_t i) { return alpha_status[i] == FREE; }
 	void swap_index(int32_t i, int32_t j);
 	void reconstruct_gradient();
+	void prefetch_working_set();
 	virtual int32_t select_working_set(int32_t &i, int32_t &j, float64_t &gap);
 	virtual float64_t calculate_rho();
 	virtual void do_shrinking();
@@ -369,6 +411,10 @@ protected:
 
 private:
 	bool be_shrunk(int32_t i, float64_t Gmax1, float64_t Gmax2);
+
+	// scratch space for predicting the next working sets
+	std::vector<std::pair<float64_t, int32_t>> violators;
+	std::vector<int32_t> prefetch_columns;
 };
 
 rxcpp::subscription Solver::connect_to_signal_handler()
@@ -392,6 +438,8 @@ void Solver::reset_computation_variables()
 
 void Solver::swap_index(int32_t i, int32_t j)
 {
+	// columns being computed in the background would get mixed up
+	Q->wait_prefetch();
 	Q->swap_index(i,j);
 	Math::swap(y[i],y[j]);
 	Math::swap(G[i],G[j]);
@@ -441,6 +489,47 @@ void Solver::reconstruct_gradient()
 	}
 }
 
+void Solver::prefetch_working_set()
+{
+	// rank the variables of I_up by -y*G and those of I_low by y*G, the
+	// next working pairs are very likely drawn from the top of both lists
+	int32_t per_set = Math::max(Q->prefetch_size / 2, 1);
+	prefetch_columns.clear();
+
+	for (int32_t up = 1; up >= 0; --up)
+	{
+		violators.clear();
+		for (int32_t t = 0; t < active_size; t++)
+		{
+			bool in_set = up ? (y[t] == +1 ? !is_upper_bound(t)
+			                               : !is_lower_bound(t))
+			                 : (y[t] == +1 ? !is_lower_bound(t)
+			                               : !is_upper_bound(t));
+			if (in_set)
+				violators.emplace_back(up ? -y[t] * G[t] : y[t] * G[t], t);
+		}
+
+		int32_t num = Math::min(per_set, (int32_t)violators.size());
+		std::partial_sort(
+		    violators.begin(), violators.begin() + num, violators.end(),
+		    [](const std::pair<float64_t, int32_t>& a,
+		       const std::pair<float64_t, int32_t>& b) {
+			    return a.first > b.first;
+		    });
+		for (int32_t k = 0; k < num; k++)
+		{
+			int32_t t = violators[k].second;
+			if (std::find(
+			        prefetch_columns.begin(), prefetch_columns.end(), t) ==
+			    prefetch_columns.end())
+				prefetch_columns.push_back(t);
+		}
+	}
+
+	Q->prefetch_Q(
+	    prefetch_columns.data(), prefetch_columns.size(), active_size);
+}
+
 void Solver::Solve(
 	int32_t p_l, const QMatrix& p_Q, const float64_t *p_p,
 	const schar *p_y, float64_t *p_alpha, float64_t p_Cp, float64_t p_Cn,
@@ -704,6 +793,11 @@ void Solver::Solve(
 			}
 		}
 
+		// compute the columns of likely next working sets in the
+		// background while the solver selects the next pair
+		if (Q->prefetch_size > 0)
+			prefetch_working_set();
+
 #ifdef MCSVM_DEBUG
 		// calculate objective value
 		{
@@ -720,6 +814,7 @@ void Solver::Solve(
 #endif
 	}
 	pb.complete_absolute();
+	Q->wait_prefetch();
 
 	// calculate rho
 
@@ -1287,7 +1382,6 @@ public:
 		nr_class=n_class;
 		factor=fac;
 		clone(y,y_,prob.l);
-		cache = new Cache(prob.l,(int64_t)(param.cache_size*(1l<<20)));
 		QD = SG_MALLOC(Qfloat, prob.l);
 		for(int32_t i=0;i<prob.l;i++)
 		{
@@ -1297,21 +1391,20 @@ public:
 
 	Qfloat *get_Q(int32_t i, int32_t len) const override
 	{
-		Qfloat *data;
-		int32_t start;
-		if((start = cache->get_data(i,&data,len)) < len)
-		{
-			compute_Q_parallel(data, NULL, i, start, len);
+		return get_cached_Q(i, len);
+	}
 
-			for(int32_t j=start;j<len;j++)
-			{
-				if (y[i]==y[j])
-					data[j] *= (factor*(nr_class-1));
-				else
-					data[j] *= (-factor);
-			}
+	void compute_Q(int32_t i, float64_t* data, int32_t start, int32_t len, bool parallel) const override
+	{
+		compute_Q_parallel(data, NULL, i, start, len, parallel);
+
+		for(int32_t j=start;j<len;j++)
+		{
+			if (y[i]==y[j])
+				data[j] *= (factor*(nr_class-1));
+			else
+				data[j] *= (-factor);
 		}
-		return data;
 	}
 
 	inline Qfloat get_orig_Qij(Qfloat Q, int32_t i, int32_t j)
@@ -1337,15 +1430,14 @@ public:
 
 	~SVC_QMC() override
 	{
+		wait_prefetch();
 		SG_FREE(y);
-		delete cache;
 		SG_FREE(QD);
 	}
 private:
 	float64_t factor;
 	float64_t nr_class;
 	schar *y;
-	Cache *cache;
 	Qfloat *QD;
 };
 
@@ -1667,7 +1759,6 @@ public:
 	:LibSVMKernel(prob.l, prob.x, param)
 	{
 		clone(y,y_,prob.l);
-		cache = new Cache(prob.l,(int64_t)(param.cache_size*(1l<<20)));
 		QD = SG_MALLOC(Qfloat, prob.l);
 		for(int32_t i=0;i<prob.l;i++)
 			QD[i]= (Qfloat)kernel_function(i,i);
@@ -1675,12 +1766,12 @@ public:
 
 	Qfloat *get_Q(int32_t i, int32_t len) const override
 	{
-		Qfloat *data;
-		int32_t start;
-		if((start = cache->get_data(i,&data,len)) < len)
-			compute_Q_parallel(data, y, i, start, len);
+		return get_cached_Q(i, len);
+	}
 
-		return data;
+	void compute_Q(int32_t i, float64_t* data, int32_t start, int32_t len, bool parallel) const override
+	{
+		compute_Q_parallel(data, y, i, start, len, parallel);
 	}
 
 	Qfloat *get_QD() const override
@@ -1698,13 +1789,12 @@ public:
 
 	~SVC_Q() override
 	{
+		wait_prefetch();
 		SG_FREE(y);
-		delete cache;
 		SG_FREE(QD);
 	}
 private:
 	schar *y;
-	Cache *cache;
 	Qfloat *QD;
 };
 
@@ -1715,7 +1805,6 @@ public:
 	ONE_CLASS_Q(const svm_problem& prob, const svm_parameter& param)
 	:LibSVMKernel(prob.l, prob.x, param)
 	{
-		cache = new Cache(prob.l,(int64_t)(param.cache_size*(1l<<20)));
 		QD = SG_MALLOC(Qfloat, prob.l);
 		for(int32_t i=0;i<prob.l;i++)
 			QD[i]= (Qfloat)kernel_function(i,i);
@@ -1723,12 +1812,12 @@ public:
 
 	Qfloat *get_Q(int32_t i, int32_t len) const override
 	{
-		Qfloat *data;
-		int32_t start;
-		if((start = cache->get_data(i,&data,len)) < len)
-			compute_Q_parallel(data, NULL, i, start, len);
+		return get_cached_Q(i, len);
+	}
 
-		return data;
+	void compute_Q(int32_t i, float64_t* data, int32_t start, int32_t len, bool parallel) const override
+	{
+		compute_Q_parallel(data, NULL, i, start, len, parallel);
 	}
 
 	Qfloat *get_QD() const override
@@ -1745,11 +1834,10 @@ public:
 
 	~ONE_CLASS_Q() override
 	{
-		delete cache;
+		wait_prefetch();
 		SG_FREE(QD);
 	}
 private:
-	Cache *cache;
 	Qfloat *QD;
 };
 
@@ -1760,7 +1848,6 @@ public:
 	:LibSVMKernel(prob.l, prob.x, param)
 	{
 		l = prob.l;
-		cache = new Cache(l,(int64_t)(param.cache_size*(1l<<20)));
 		QD = SG_MALLOC(Qfloat, 2*l);
 		sign = SG_MALLOC(schar, 2*l);
 		index = SG_MALLOC(int32_t, 2*l);
@@ -1787,17 +1874,27 @@ public:
 
 	Qfloat *get_Q(int32_t i, int32_t len) const override
 	{
-		Qfloat *data;
 		int32_t real_i = index[i];
-		if(cache->get_data(real_i,&data,l) < l)
-			compute_Q_parallel(data, NULL, real_i, 0, l);
+		KernelRowCache::Row row = cache->get_row(real_i, l,
+			[this](int32_t r, float64_t* data, int32_t start, int32_t end)
+			{
+				compute_Q(r, data, start, end, true);
+			});
 
 		// reorder and copy
 		Qfloat *buf = buffer[next_buffer];
 		next_buffer = 1 - next_buffer;
 		schar si = sign[i];
-		for(int32_t j=0;j<len;j++)
-			buf[j] = si * sign[j] * data[index[j]];
+		if (const Qfloat* data = row.data<Qfloat>())
+		{
+			for(int32_t j=0;j<len;j++)
+				buf[j] = si * sign[j] * data[index[j]];
+		}
+		else
+		{
+			for(int32_t j=0;j<len;j++)
+				buf[j] = si * sign[j] * row[index[j]];
+		}
 		return buf;
 	}
 
@@ -1806,9 +1903,25 @@ public:
 		return QD;
 	}
 
+	void compute_Q(int32_t i, float64_t* data, int32_t start, int32_t len, bool parallel) const override
+	{
+		compute_Q_parallel(data, NULL, i, start, len, parallel);
+	}
+
+	// rows are cached in their original order and always in full
+	int32_t cache_index(int32_t column) const override
+	{
+		return index[column];
+	}
+
+	int32_t cache_len(int32_t len) const override
+	{
+		return l;
+	}
+
 	~SVR_Q() override
 	{
-		delete cache;
+		wait_prefetch();
 		SG_FREE(sign);
 		SG_FREE(index);
 		SG_FREE(buffer[0]);
@@ -1818,7 +1931,6 @@ public:
 
 private:
 	int32_t l;
-	Cache *cache;
 	schar *sign;
 	int32_t *index;
 	mutable int32_t next_buffer;
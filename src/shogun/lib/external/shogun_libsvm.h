@@ -102,6 +102,10 @@ struct svm_parameter
 	/* these are for training only */
 	/** in MB */
 	float64_t cache_size;
+	/** storage precision of the kernel row cache */
+	EKernelCachePrecision cache_precision;
+	/** number of kernel columns to prefetch per iteration, 0 disables */
+	int32_t prefetch_size;
 	/** maximum training time */
 	float64_t max_train_time;
 	/** stopping criteria */
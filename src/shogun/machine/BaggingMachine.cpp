@@ -33,6 +33,7 @@ BaggingMachine::BaggingMachine(std::shared_ptr<Features> features, std::shared_p
 
 std::shared_ptr<BinaryLabels> BaggingMachine::apply_binary(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	SGMatrix<float64_t> output = apply_outputs_without_combination(data);
 
 	auto mean_rule = std::make_shared<MeanRule>();
@@ -46,6 +47,7 @@ std::shared_ptr<BinaryLabels> BaggingMachine::apply_binary(std::shared_ptr<Featu
 
 std::shared_ptr<MulticlassLabels> BaggingMachine::apply_multiclass(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	SGMatrix<float64_t> bagged_outputs =
 	    apply_outputs_without_combination(data);
 
@@ -87,6 +89,7 @@ std::shared_ptr<MulticlassLabels> BaggingMachine::apply_multiclass(std::shared_p
 
 std::shared_ptr<RegressionLabels> BaggingMachine::apply_regression(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	return std::make_shared<RegressionLabels>(apply_get_outputs(data));
 }
 
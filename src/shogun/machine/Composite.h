@@ -83,11 +83,13 @@ namespace shogun
 
 		std::shared_ptr<MulticlassLabels> apply_multiclass(std::shared_ptr<Features> data) override
 		{
+			load_lazy_parameters();
 			return m_ensemble_machine->apply_multiclass(data);
 		}
 
 		std::shared_ptr<BinaryLabels> apply_binary(std::shared_ptr<Features> data) override
 		{
+			load_lazy_parameters();
 			return m_ensemble_machine->apply_binary(data);
 		}
 	private:
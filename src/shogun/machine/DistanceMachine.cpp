@@ -99,6 +99,7 @@ void DistanceMachine::distances_rhs(SGVector<float64_t>& result, index_t idx_b1,
 
 std::shared_ptr<MulticlassLabels> DistanceMachine::apply_multiclass(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	if (data)
 	{
 		/* set distance features to given ones and apply to all */
@@ -122,6 +123,7 @@ std::shared_ptr<MulticlassLabels> DistanceMachine::apply_multiclass(std::shared_
 
 float64_t DistanceMachine::apply_one(int32_t num)
 {
+	load_lazy_parameters();
 	/* number of clusters */
 	auto lhs=distance->get_lhs();
 	int32_t num_clusters=lhs->get_num_vectors();
@@ -120,12 +120,14 @@ namespace shogun
 		std::shared_ptr<BinaryLabels>
 		apply_binary(std::shared_ptr<Features> data) override
 		{
+			load_lazy_parameters();
 			return std::make_shared<BinaryLabels>(apply_vector(data));
 		}
 
 		std::shared_ptr<MulticlassLabels>
 		apply_multiclass(std::shared_ptr<Features> data) override
 		{
+			load_lazy_parameters();
 			return std::make_shared<MulticlassLabels>(apply_vector(data));
 		}
 
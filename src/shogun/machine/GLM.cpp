@@ -71,6 +71,7 @@ GLM::GLM(
 std::shared_ptr<RegressionLabels>
 GLM::apply_regression(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	if (data)
 	{
 		if (!data->has_property(FP_DOT))
@@ -13,6 +13,7 @@
 #include <shogun/kernel/Kernel.h>
 #include <shogun/lib/config.h>
 #include <shogun/machine/GaussianProcess.h>
+#include <shogun/machine/gp/KrylovInferenceMethod.h>
 #include <shogun/machine/gp/LikelihoodModel.h>
 #include <shogun/machine/gp/SingleFITCInference.h>
 #include <shogun/mathematics/Math.h>
@@ -159,6 +160,24 @@ GaussianProcess::get_posterior_variances(const std::shared_ptr<Features>& data)
 	// compute Ks=Ks*scale^2
 	eigen_Ks *= Math::sq(m_method->get_scale());
 
+	// matrix-free inference solves for the test points instead of
+	// factorizing the kernel matrix
+	auto krylov_method =
+	    std::dynamic_pointer_cast<KrylovInferenceMethod>(m_method);
+	if (krylov_method)
+	{
+		// s2 = Kss - Ks' * (K + sigma^2 * I)^(-1) * Ks
+		SGMatrix<float64_t> V = krylov_method->solve_kernel_system(k_trts);
+		Map<MatrixXd> eigen_V(V.matrix, V.num_rows, V.num_cols);
+
+		SGVector<float64_t> s2(k_tsts.vlen);
+		Map<VectorXd> eigen_s2(s2.vector, s2.vlen);
+		eigen_s2 = eigen_Kss_diag -
+		           eigen_Ks.cwiseProduct(eigen_V).colwise().sum().adjoint();
+
+		return s2;
+	}
+
 	// get shogun representation of cholesky and create eigen representation
 	SGMatrix<float64_t> L = m_method->get_cholesky();
 	Map<MatrixXd> eigen_L(L.matrix, L.num_rows, L.num_cols);
@@ -239,12 +239,14 @@ bool KernelMachine::init_kernel_optimization()
 
 std::shared_ptr<RegressionLabels> KernelMachine::apply_regression(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	SGVector<float64_t> outputs = apply_get_outputs(data);
 	return std::make_shared<RegressionLabels>(outputs);
 }
 
 std::shared_ptr<BinaryLabels> KernelMachine::apply_binary(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	SGVector<float64_t> outputs = apply_get_outputs(data);
 	return std::make_shared<BinaryLabels>(outputs);
 }
@@ -410,6 +412,7 @@ void KernelMachine::store_model_features()
 
 float64_t KernelMachine::apply_one(int32_t num)
 {
+	load_lazy_parameters();
 	ASSERT(kernel)
 
 	if (kernel->has_property(KP_LINADD) && (kernel->get_is_initialized()))
@@ -40,6 +40,7 @@ LinearLatentMachine::~LinearLatentMachine()
 
 std::shared_ptr<LatentLabels> LinearLatentMachine::apply_latent(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	if (m_model == NULL)
 		error("LatentModel is not set!");
 
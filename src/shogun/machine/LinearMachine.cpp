@@ -50,17 +50,20 @@ LinearMachine::~LinearMachine()
 
 float64_t LinearMachine::apply_one(int32_t vec_idx)
 {
+	load_lazy_parameters();
 	return features->dot(vec_idx, m_w) + bias;
 }
 
 std::shared_ptr<RegressionLabels> LinearMachine::apply_regression(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	SGVector<float64_t> outputs = apply_get_outputs(data);
 	return std::make_shared<RegressionLabels>(outputs);
 }
 
 std::shared_ptr<BinaryLabels> LinearMachine::apply_binary(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	SGVector<float64_t> outputs = apply_get_outputs(data);
 	return std::make_shared<BinaryLabels>(outputs);
 }
@@ -42,6 +42,7 @@ SGVector< float64_t > LinearStructuredOutputMachine::get_w() const
 
 std::shared_ptr<StructuredLabels> LinearStructuredOutputMachine::apply_structured(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	if (data)
 	{
 		set_features(data);
@@ -33,6 +33,9 @@ Machine::~Machine()
 
 bool Machine::train(std::shared_ptr<Features> data)
 {
+	// members are used directly below, they have to hold the stored values
+	load_lazy_parameters();
+
 	if (train_require_labels())
 	{
 		if (m_labels == NULL)
@@ -117,6 +120,7 @@ std::shared_ptr<Labels> Machine::apply(std::shared_ptr<Features> data)
 	SG_TRACE("entering {}::apply({} at {})",
 			get_name(), data ? data->get_name() : "NULL", fmt::ptr(data.get()));
 
+	load_lazy_parameters();
 	std::shared_ptr<Labels> result=NULL;
 
 	switch (get_machine_problem_type())
@@ -73,6 +73,7 @@ float64_t MulticlassMachine::get_submachine_output(int32_t i, int32_t num)
 
 std::shared_ptr<MulticlassLabels> MulticlassMachine::apply_multiclass(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	SG_TRACE("entering {}::apply_multiclass({} at {})",
 			get_name(), data ? data->get_name() : "NULL", fmt::ptr(data.get()));
 
@@ -258,6 +259,7 @@ bool MulticlassMachine::train_machine(std::shared_ptr<Features> data)
 
 float64_t MulticlassMachine::apply_one(int32_t vec_idx)
 {
+	load_lazy_parameters();
 	init_machines_for_apply(NULL);
 
 	ASSERT(m_machines.size()>0)
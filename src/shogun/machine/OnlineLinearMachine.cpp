@@ -31,12 +31,14 @@ OnlineLinearMachine::~OnlineLinearMachine()
 
 std::shared_ptr<BinaryLabels> OnlineLinearMachine::apply_binary(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	SGVector<float64_t> outputs = apply_get_outputs(data);
 	return std::make_shared<BinaryLabels>(outputs);
 }
 
 std::shared_ptr<RegressionLabels> OnlineLinearMachine::apply_regression(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	SGVector<float64_t> outputs = apply_get_outputs(data);
 	return std::make_shared<RegressionLabels>(outputs);
 }
@@ -73,6 +75,7 @@ SGVector<float64_t> OnlineLinearMachine::apply_get_outputs(const std::shared_ptr
 
 float32_t OnlineLinearMachine::apply_one(float32_t* vec, int32_t len)
 {
+		load_lazy_parameters();
 		SGVector<float32_t> wrap(vec, len, false);
 		return linalg::dot(wrap, m_w)+bias;
 }
@@ -138,6 +138,41 @@ int32_t RandomForest::get_num_random_features() const
 	return m_machine->as<RandomCARTree>()->get_feature_subset_size();
 }
 
+void RandomForest::set_histogram_split(bool histogram_split)
+{
+	require(m_machine,"m_machine is NULL. It is expected to be RandomCARTree");
+	m_machine->as<RandomCARTree>()->set_histogram_split(histogram_split);
+}
+
+bool RandomForest::get_histogram_split() const
+{
+	require(m_machine,"m_machine is NULL. It is expected to be RandomCARTree");
+	return m_machine->as<RandomCARTree>()->get_histogram_split();
+}
+
+void RandomForest::compile()
+{
+	require(m_bags.size() > 0, "RandomForest is not trained!");
+
+	m_compiled.clear();
+	for (const auto& bag : m_bags)
+	{
+		auto tree = bag->as<RandomCARTree>();
+		m_compiled.add_tree(
+		    tree->get_root()->as<RandomCARTree::bnode_t>(),
+		    tree->get_feature_types());
+	}
+}
+
+SGMatrix<float64_t> RandomForest::apply_outputs_without_combination(std::shared_ptr<Features> data)
+{
+	auto dense_data = std::dynamic_pointer_cast<DenseFeatures<float64_t>>(data);
+	if (m_compiled.get_num_trees() == 0 || !dense_data)
+		return BaggingMachine::apply_outputs_without_combination(data);
+
+	return m_compiled.apply_outputs(dense_data);
+}
+
 void RandomForest::set_machine_parameters(std::shared_ptr<Machine> m, SGVector<index_t> idx)
 {
 	require(m,"Machine supplied is NULL");
@@ -158,7 +193,10 @@ void RandomForest::set_machine_parameters(std::shared_ptr<Machine> m, SGVector<i
 	}
 
 	tree->set_weights(weights);
-	tree->set_sorted_features(m_sorted_transposed_feats, m_sorted_indices);
+	if (get_histogram_split())
+		tree->set_binned_features(m_binned_feats, m_bin_edges);
+	else
+		tree->set_sorted_features(m_sorted_transposed_feats, m_sorted_indices);
 	// equate the machine problem types - cloning does not do this
 	tree->set_machine_problem_type(m_machine->as<RandomCARTree>()->get_machine_problem_type());
 }
@@ -171,9 +209,20 @@ bool RandomForest::train_machine(std::shared_ptr<Features> data)
 	}
 	
 	require(m_features, "Training features not set!");
+	m_compiled.clear();
 
-	m_machine->as<RandomCARTree>()->pre_sort_features(m_features, m_sorted_transposed_feats, m_sorted_indices);
+	// binned features take one byte per value instead of a sorted copy,
+	// they are computed once for all stored vectors and shared by all bags
+	if (get_histogram_split())
+	{
+		m_machine->as<RandomCARTree>()->bin_features(m_features, m_binned_feats, m_bin_edges);
+		auto trained = BaggingMachine::train_machine();
+		m_binned_feats = SGMatrix<uint8_t>();
+		m_bin_edges = SGMatrix<float64_t>();
+		return trained;
+	}
 
+	m_machine->as<RandomCARTree>()->pre_sort_features(m_features, m_sorted_transposed_feats, m_sorted_indices);
 	return BaggingMachine::train_machine();
 }
 
@@ -33,6 +33,7 @@
 
 #include <shogun/lib/config.h>
 #include <shogun/machine/BaggingMachine.h>
+#include <shogun/multiclass/tree/FlatTreeEnsemble.h>
 
 namespace shogun
 {
@@ -137,6 +138,26 @@ public:
 	 * @return number of randomly chosen features during each node split
 	 */
 	int32_t get_num_random_features() const;
+
+	/** set whether candidate trees find splits on histograms of binned
+	 * features, see CARTree::set_histogram_split
+	 *
+	 * @param histogram_split whether to use histogram splits
+	 */
+	void set_histogram_split(bool histogram_split);
+
+	/** get whether candidate trees find splits on histograms of binned
+	 * features
+	 *
+	 * @return whether histogram splits are used
+	 */
+	bool get_histogram_split() const;
+
+	/** flattens the trained trees into contiguous arrays, which are used
+	 * by apply until the forest is trained again
+	 */
+	void compile();
+
 	/** get feature importances of previous trained, use Mean Decrease
 	 * Impurity(MDI)
 	 *
@@ -154,6 +175,14 @@ protected:
 	 */
 	void set_machine_parameters(std::shared_ptr<Machine> m, SGVector<index_t> idx) override;
 
+	/** outputs of all trees, evaluated on the flattened trees if compiled
+	 *
+	 * @param data the data to compute the output for
+	 * @return num_vectors x num_bags predictions
+	 */
+	SGMatrix<float64_t>
+	apply_outputs_without_combination(std::shared_ptr<Features> data) override;
+
 private:
 	/** initialize parameters */
 	void init();
@@ -167,6 +196,15 @@ private:
 
 	/** Indices of pre-sorted features */
 	SGMatrix<index_t> m_sorted_indices;
+
+	/** Binned features */
+	SGMatrix<uint8_t> m_binned_feats;
+
+	/** Upper bin edges of binned features */
+	SGMatrix<float64_t> m_bin_edges;
+
+	/** Flattened trees, empty if not compiled */
+	FlatTreeEnsemble m_compiled;
 #ifndef SWIG
 public:
 	static constexpr std::string_view kWeights = "weights";
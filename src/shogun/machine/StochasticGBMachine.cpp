@@ -33,10 +33,21 @@
 #include <shogun/machine/StochasticGBMachine.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/RandomNamespace.h>
+#include <shogun/multiclass/tree/CARTree.h>
 #include <shogun/optimization/lbfgs/lbfgs.h>
 
 using namespace shogun;
 
+namespace
+{
+	/** lower bound of the second derivative in Newton steps relative to
+	 * its mean over the samples where the loss is curved, so that a leaf of
+	 * n samples has a total hessian of at least n times this fraction.
+	 * Guards against losses that are linear in parts like HuberLoss, whose
+	 * leaves would otherwise take steps of -sum(g)/lambda */
+	const float64_t NEWTON_MIN_HESSIAN_RATIO = 0.1;
+}
+
 StochasticGBMachine::StochasticGBMachine(const std::shared_ptr<Machine>& machine, const std::shared_ptr<LossFunction>& loss, int32_t num_iterations,
 						float64_t learning_rate, float64_t subset_fraction)
 : RandomMixin<Machine>()
@@ -134,11 +145,33 @@ float64_t StochasticGBMachine::get_learning_rate() const
 	return m_learning_rate;
 }
 
+void StochasticGBMachine::set_l2_regularization(float64_t lambda)
+{
+	require(lambda>=0,"L2 regularization should be non-negative. Supplied value is {}",lambda);
+
+	m_l2_regularization=lambda;
+}
+
 std::shared_ptr<RegressionLabels> StochasticGBMachine::apply_regression(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	require(data,"test data supplied is NULL");
 	auto feats=data->as<DenseFeatures<float64_t>>();
 
+	if (m_compiled.get_num_trees())
+	{
+		// the ensemble holds one tree per trained iteration, which may be
+		// fewer than m_num_iter if it was changed after training
+		SGVector<float64_t> weights(m_compiled.get_num_trees());
+		require(weights.vlen==(index_t)m_gamma.size(),
+			"The compiled ensemble ({} trees) does not match the weak learners ({})",
+			weights.vlen, m_gamma.size());
+		for (index_t i=0;i<weights.vlen;i++)
+			weights[i]=m_gamma[i]*m_learning_rate;
+
+		return std::make_shared<RegressionLabels>(m_compiled.apply_weighted_sum(feats, weights));
+	}
+
 	SGVector<float64_t> retlabs(feats->get_num_vectors());
 	retlabs.fill_vector(retlabs.vector,retlabs.vlen,0);
 	for (int32_t i=0;i<m_num_iter;i++)
@@ -161,6 +194,19 @@ std::shared_ptr<RegressionLabels> StochasticGBMachine::apply_regression(std::sha
 	return std::make_shared<RegressionLabels>(retlabs);
 }
 
+void StochasticGBMachine::compile()
+{
+	require(m_weak_learners.size() > 0, "StochasticGBMachine is not trained!");
+
+	m_compiled.clear();
+	for (const auto& learner : m_weak_learners)
+	{
+		auto tree = std::dynamic_pointer_cast<CARTree>(learner);
+		require(tree, "Only CARTree weak learners can be compiled, not {}", learner->get_name());
+		m_compiled.add_tree(tree->get_root()->as<CARTree::bnode_t>(), tree->get_feature_types());
+	}
+}
+
 bool StochasticGBMachine::train_machine(std::shared_ptr<Features> data)
 {
 	require(data,"training data not supplied!");
@@ -172,6 +218,15 @@ bool StochasticGBMachine::train_machine(std::shared_ptr<Features> data)
 
 	// initialize weak learners array and gamma array
 	initialize_learners();
+	m_compiled.clear();
+
+	// trees with histogram splits share the bins of all stored vectors,
+	// the random subsets of the iterations are views that address them by
+	// their absolute indices, also if the data has a subset already
+	auto tree = std::dynamic_pointer_cast<CARTree>(m_machine);
+	require(!m_newton_boosting || tree, "Newton boosting requires a CARTree as machine, not {}", m_machine->get_name());
+	if (tree && tree->get_histogram_split())
+		tree->bin_features(feats, m_binned_feats, m_bin_edges);
 
 	// cache predicted labels for intermediate models
 	auto interf=std::make_shared<RegressionLabels>(feats->get_num_vectors());
@@ -186,18 +241,27 @@ bool StochasticGBMachine::train_machine(std::shared_ptr<Features> data)
 		const auto& interf_iter = std::get<1>(result);
 		const auto& labels_iter = std::get<2>(result);
 
-		// compute pseudo-residuals
-		auto pres =
-		    compute_pseudo_residuals(interf_iter, labels_iter);
-
-		// fit learner
-		auto wlearner = fit_model(feats_iter, pres);
-		m_weak_learners.push_back(wlearner);
+		std::shared_ptr<Machine> wlearner;
+		float64_t gamma = 1.0;
+		if (m_newton_boosting)
+		{
+			// leaves hold the Newton steps already
+			wlearner = fit_newton_model(feats_iter, interf_iter, labels_iter);
+		}
+		else
+		{
+			// compute pseudo-residuals
+			auto pres =
+			    compute_pseudo_residuals(interf_iter, labels_iter);
 
-		// compute multiplier
-		auto hm = wlearner->apply_regression(feats_iter);
+			// fit learner
+			wlearner = fit_model(feats_iter, pres);
 
-		float64_t gamma = compute_multiplier(interf_iter, hm, labels_iter);
+			// compute multiplier
+			auto hm = wlearner->apply_regression(feats_iter);
+			gamma = compute_multiplier(interf_iter, hm, labels_iter);
+		}
+		m_weak_learners.push_back(wlearner);
 		m_gamma.push_back(gamma);
 
 		// update intermediate function value
@@ -205,13 +269,10 @@ bool StochasticGBMachine::train_machine(std::shared_ptr<Features> data)
 		SGVector<float64_t> delta=dlabels->get_labels();
 		for (int32_t j=0;j<interf->get_num_labels();j++)
 			interf->set_label(j,interf->get_label(j)+delta[j]*gamma*m_learning_rate);
-
-
-
-
 	}
 
-
+	m_binned_feats = SGMatrix<uint8_t>();
+	m_bin_edges = SGMatrix<float64_t>();
 	return true;
 }
 
@@ -236,6 +297,8 @@ std::shared_ptr<Machine> StochasticGBMachine::fit_model(const std::shared_ptr<De
 {
 	// clone base machine
 	auto c=m_machine->clone()->as<Machine>();
+	if (m_binned_feats.num_cols)
+		c->as<CARTree>()->set_binned_features(m_binned_feats, m_bin_edges);
 	// train cloned machine
 	c->set_labels(labels);
 	c->train(feats);
@@ -243,6 +306,70 @@ std::shared_ptr<Machine> StochasticGBMachine::fit_model(const std::shared_ptr<De
 	return c;
 }
 
+std::shared_ptr<Machine> StochasticGBMachine::fit_newton_model(
+    const std::shared_ptr<DenseFeatures<float64_t>>& feats,
+    const std::shared_ptr<RegressionLabels>& inter_f, const std::shared_ptr<Labels>& labs)
+{
+	auto labels = labs->as<DenseLabels>()->get_labels();
+	SGVector<float64_t> f=inter_f->get_labels();
+
+	// weighted least squares on -g/h with weights h has the Newton step
+	// -sum(g)/sum(h) as optimal value of every leaf
+	SGVector<float64_t> steps(f.vlen);
+	SGVector<float64_t> hessians(f.vlen);
+	#pragma omp parallel for
+	for (int32_t i=0;i<f.vlen;i++)
+		hessians[i]=std::max(m_loss->second_derivative(f[i],labels[i]), 0.0);
+
+	// without any curvature, e.g. all samples in the linear part of the
+	// loss, fall back to gradient steps
+	float64_t sum_hessian=0;
+	int32_t num_curved=0;
+	for (int32_t i=0;i<f.vlen;i++)
+	{
+		if (hessians[i]>0)
+		{
+			sum_hessian+=hessians[i];
+			num_curved++;
+		}
+	}
+	float64_t min_hessian=num_curved ? NEWTON_MIN_HESSIAN_RATIO*sum_hessian/num_curved : 1.0;
+	#pragma omp parallel for
+	for (int32_t i=0;i<f.vlen;i++)
+	{
+		hessians[i]=std::max(hessians[i], min_hessian);
+		steps[i]=-m_loss->first_derivative(f[i],labels[i])/hessians[i];
+	}
+
+	auto tree=m_machine->clone()->as<CARTree>();
+	if (m_binned_feats.num_cols)
+		tree->set_binned_features(m_binned_feats, m_bin_edges);
+	tree->set_weights(hessians);
+	tree->set_labels(std::make_shared<RegressionLabels>(steps));
+	tree->train(feats);
+	tree->clear_weights();
+
+	// total_weight of a node is sum(h), shrink to -sum(g)/(sum(h)+lambda)
+	if (m_l2_regularization>0)
+	{
+		std::vector<std::shared_ptr<CARTree::bnode_t>> nodes;
+		nodes.push_back(tree->get_root()->as<CARTree::bnode_t>());
+		while (!nodes.empty())
+		{
+			auto node=nodes.back();
+			nodes.pop_back();
+			auto& data=node->data;
+			data.node_label*=data.total_weight/(data.total_weight+m_l2_regularization);
+			if (node->left())
+				nodes.push_back(node->left());
+			if (node->right())
+				nodes.push_back(node->right());
+		}
+	}
+
+	return tree;
+}
+
 std::shared_ptr<RegressionLabels> StochasticGBMachine::compute_pseudo_residuals(
     const std::shared_ptr<RegressionLabels>& inter_f, const std::shared_ptr<Labels>& labs)
 {
@@ -373,6 +500,8 @@ void StochasticGBMachine::init()
 	m_num_iter=0;
 	m_subset_frac=0;
 	m_learning_rate=0;
+	m_newton_boosting=false;
+	m_l2_regularization=1.0;
 
 	m_weak_learners.clear();
 	m_gamma.clear();
@@ -382,6 +511,8 @@ void StochasticGBMachine::init()
 	SG_ADD(&m_num_iter, kNumIterations, "number of iterations");
 	SG_ADD(&m_subset_frac, kSubsetFrac, "subset fraction");
 	SG_ADD(&m_learning_rate, kLearningRate, "learning rate");
+	SG_ADD(&m_newton_boosting, kNewtonBoosting, "fit weak learners by Newton steps");
+	SG_ADD(&m_l2_regularization, kL2Regularization, "L2 regularization of leaf values in Newton boosting");
 	SG_ADD(&m_weak_learners, kWeakLearners, "array of weak learners");
 	SG_ADD(&m_gamma, kGamma, "array of learner weights");
 }
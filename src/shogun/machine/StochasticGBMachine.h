@@ -38,6 +38,7 @@
 #include <shogun/loss/LossFunction.h>
 #include <shogun/machine/Machine.h>
 #include <shogun/mathematics/RandomMixin.h>
+#include <shogun/multiclass/tree/FlatTreeEnsemble.h>
 
 #include <tuple>
 
@@ -49,6 +50,9 @@ namespace shogun
  * CLossFunction interface (cf. http://www.shogun-toolbox.org/doc/en/latest/classshogun_1_1CLossFunction.html). Additionally, it can create
  * an ensemble of any regressor class derived from the Machine class (cf. http://www.shogun-toolbox.org/doc/en/latest/classshogun_1_1Machine.html).
  * For one dimensional optimization, this class uses the backtracking linesearch accessed via Shogun's L-BFGS class.
+ * With set_newton_boosting(true) the class performs Newton boosting instead: each CARTree is fit to the Newton steps
+ * \f$-g_i/h_i\f$ of the loss, using the first (g) and second (h) derivatives of the loss as targets and vector weights. The
+ * value of a leaf is then the regularized Newton step \f$-\sum g_i/(\sum h_i+\lambda)\f$ and no linesearch is needed.
  * A concise description of the algorithm implemented can be found in the following link :
  * http://en.wikipedia.org/wiki/Gradient_boosting#Algorithm
  */
@@ -135,6 +139,35 @@ public:
 	 */
 	float64_t get_learning_rate() const;
 
+	/** set whether weak learners are fit by Newton steps of the loss
+	 * instead of pseudo residuals and a linesearch. Requires a CARTree
+	 * as machine.
+	 *
+	 * @param newton whether to use Newton boosting
+	 */
+	void set_newton_boosting(bool newton)
+	{
+		m_newton_boosting = newton;
+	}
+
+	/** get whether weak learners are fit by Newton steps
+	 *
+	 * @return whether Newton boosting is used
+	 */
+	bool get_newton_boosting() const { return m_newton_boosting; }
+
+	/** set L2 regularization of the leaf values in Newton boosting
+	 *
+	 * @param lambda regularization (non-negative, default 1)
+	 */
+	void set_l2_regularization(float64_t lambda);
+
+	/** get L2 regularization of the leaf values in Newton boosting
+	 *
+	 * @return regularization
+	 */
+	float64_t get_l2_regularization() const { return m_l2_regularization; }
+
 	/** apply_regression
 	 *
 	 * @param data test data
@@ -142,6 +175,12 @@ public:
 	 */
 	std::shared_ptr<RegressionLabels> apply_regression(std::shared_ptr<Features> data=NULL) override;
 
+	/** flattens the trained weak learners into contiguous arrays, which
+	 * are used by apply until the machine is trained again. All weak
+	 * learners have to be CARTrees.
+	 */
+	void compile();
+
 protected:
 	/** train machine
 	 *
@@ -169,6 +208,17 @@ protected:
 	 */
 	std::shared_ptr<Machine> fit_model(const std::shared_ptr<DenseFeatures<float64_t>>& feats, const std::shared_ptr<RegressionLabels>& labels);
 
+	/** train a CARTree on the Newton steps of the loss
+	 *
+	 * @param feats training data
+	 * @param inter_f intermediate boosted model labels for training data
+	 * @param labs training labels
+	 * @return trained tree whose leaves hold the Newton steps
+	 */
+	std::shared_ptr<Machine> fit_newton_model(
+		const std::shared_ptr<DenseFeatures<float64_t>>& feats,
+		const std::shared_ptr<RegressionLabels>& inter_f, const std::shared_ptr<Labels>& labs);
+
 	/** compute pseudo_residuals
 	 *
 	 * @param inter_f intermediate boosted model labels for training data
@@ -226,11 +276,26 @@ protected:
 	/** learning_rate */
 	float64_t m_learning_rate;
 
+	/** whether weak learners are fit by Newton steps */
+	bool m_newton_boosting;
+
+	/** L2 regularization of leaf values in Newton boosting */
+	float64_t m_l2_regularization;
+
 	/** array of weak learners */
 	std::vector<std::shared_ptr<Machine>> m_weak_learners;
 
 	/** gamma - weak learner weights */
 	std::vector<float64_t> m_gamma;
+
+	/** training data binned once for all weak learners with histogram splits */
+	SGMatrix<uint8_t> m_binned_feats;
+
+	/** upper bin edges of binned training data */
+	SGMatrix<float64_t> m_bin_edges;
+
+	/** flattened weak learners, empty if not compiled */
+	FlatTreeEnsemble m_compiled;
 #ifndef SWIG
 public:
 	static constexpr std::string_view kMachine = "machine";
@@ -240,6 +305,8 @@ public:
 	static constexpr std::string_view kLearningRate = "learning_rate";
 	static constexpr std::string_view kWeakLearners = "weak_learners";
 	static constexpr std::string_view kGamma = "gamma";
+	static constexpr std::string_view kNewtonBoosting = "newton_boosting";
+	static constexpr std::string_view kL2Regularization = "l2_regularization";
 #endif
 };
 }/* shogun */
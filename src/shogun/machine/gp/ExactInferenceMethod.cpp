@@ -90,6 +90,83 @@ void ExactInferenceMethod::update()
 	SG_TRACE("leaving");
 }
 
+void ExactInferenceMethod::add_training_points(
+	const std::shared_ptr<Features>& features,
+	const std::shared_ptr<Labels>& labels)
+{
+	require(features, "Features should not be NULL");
+	require(labels, "Labels should not be NULL");
+	require(labels->get_label_type()==LT_REGRESSION,
+		"Labels must be type of CRegressionLabels");
+	require(features->get_num_vectors()==labels->get_num_labels(),
+		"Number of new vectors ({}) must match number of new labels ({})",
+		features->get_num_vectors(), labels->get_num_labels());
+
+	// the factor of the current training points must be up to date
+	if (parameter_hash_changed())
+		update();
+
+	// get the sigma variable from the Gaussian likelihood model
+	auto lik = m_model->as<GaussianLikelihood>();
+	float64_t sigma=lik->get_sigma();
+	float64_t scale=std::exp(m_log_scale * 2.0) / Math::sq(sigma);
+
+	const index_t n=m_ktrtr.num_rows;
+	const index_t k=features->get_num_vectors();
+
+	auto all_features=m_features->create_merged_copy(features);
+
+	SGVector<float64_t> y=regression_labels(m_labels)->get_labels();
+	SGVector<float64_t> y_new=regression_labels(labels)->get_labels();
+	SGVector<float64_t> all_y(n+k);
+	Map<VectorXd> eigen_all_y(all_y.vector, all_y.vlen);
+	eigen_all_y.head(n)=Map<VectorXd>(y.vector, y.vlen);
+	eigen_all_y.tail(k)=Map<VectorXd>(y_new.vector, y_new.vlen);
+
+	// only the kernel values of the new points are computed
+	m_kernel->init(all_features, features);
+	SGMatrix<float64_t> k_new=m_kernel->get_kernel_matrix();
+	m_kernel->init(all_features, all_features);
+
+	SGMatrix<float64_t> ktrtr(n+k, n+k);
+	Map<MatrixXd> K(ktrtr.matrix, n+k, n+k);
+	K.topLeftCorner(n, n)=Map<MatrixXd>(m_ktrtr.matrix, n, n);
+	K.rightCols(k)=Map<MatrixXd>(k_new.matrix, n+k, k);
+	K.bottomLeftCorner(k, n)=K.topRightCorner(n, k).transpose();
+
+	/* the upper triangular factor of the extended matrix is [U S; 0 V],
+	 * with U^T * S = C and V^T * V = D - S^T * S for the new blocks C and D
+	 * of K*scale^2/sigma^2+I */
+	SGMatrix<float64_t> L(n+k, n+k);
+	Map<MatrixXd> eigen_L(L.matrix, n+k, n+k);
+	eigen_L.setZero();
+	eigen_L.topLeftCorner(n, n)=Map<MatrixXd>(m_L.matrix, n, n);
+
+	MatrixXd S=eigen_L.topLeftCorner(n, n).triangularView<Upper>().adjoint()
+		.solve(K.topRightCorner(n, k) * scale);
+	LLT<MatrixXd> llt(
+	    K.bottomRightCorner(k, k) * scale + MatrixXd::Identity(k, k) -
+	    S.adjoint() * S);
+	if (llt.info()!=Eigen::Success)
+	{
+		// leave the model on the current training points
+		m_kernel->init(m_features, m_features);
+		error("Cholesky update failed, the kernel matrix of the new points "
+			"is not positive definite");
+	}
+	eigen_L.topRightCorner(n, k)=S;
+	eigen_L.bottomRightCorner(k, k)=llt.matrixU();
+
+	m_ktrtr=ktrtr;
+	m_L=L;
+	m_features=all_features;
+	m_labels=std::make_shared<RegressionLabels>(all_y);
+
+	update_alpha();
+	m_gradient_update=false;
+	update_parameter_hash();
+}
+
 void ExactInferenceMethod::check_members() const
 {
 	Inference::check_members();
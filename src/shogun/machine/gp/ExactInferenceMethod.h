@@ -187,6 +187,22 @@ public:
 	/** update matrices except gradients*/
 	void update() override;
 
+	/** appends training points and extends the posterior without
+	 * refactorizing the kernel matrix.
+	 *
+	 * The Cholesky factor of the current training points is extended by
+	 * the rows and columns of the new points in \f$O(n^2k)\f$ for \f$n\f$
+	 * current and \f$k\f$ new points, and only the kernel values of the
+	 * new points are computed. Hyperparameters stay unchanged.
+	 *
+	 * @param features features of the new points, merged into the
+	 * training features with Features::create_merged_copy()
+	 * @param labels regression labels of the new points
+	 */
+	virtual void add_training_points(
+	    const std::shared_ptr<Features>& features,
+	    const std::shared_ptr<Labels>& labels);
+
         /** Set a minimizer
          *
          * @param minimizer minimizer used in inference method
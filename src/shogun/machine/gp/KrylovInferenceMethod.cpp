@@ -0,0 +1,629 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+#include <shogun/machine/gp/KrylovInferenceMethod.h>
+
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/lib/View.h>
+#include <shogun/machine/gp/GaussianLikelihood.h>
+#include <shogun/machine/visitors/ShapeVisitor.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/UniformIntDistribution.h>
+#include <shogun/mathematics/eigen3.h>
+
+#include <algorithm>
+#include <utility>
+
+using namespace shogun;
+using namespace Eigen;
+
+namespace
+{
+	/** number of rows and columns of the tiles of kernel values */
+	const index_t KRYLOV_TILE_SIZE = 256;
+}
+
+KrylovInferenceMethod::KrylovInferenceMethod() : RandomMixin<Inference>()
+{
+	init();
+}
+
+KrylovInferenceMethod::KrylovInferenceMethod(std::shared_ptr<Kernel> kern, std::shared_ptr<Features> feat,
+		std::shared_ptr<MeanFunction> m, std::shared_ptr<Labels> lab, std::shared_ptr<LikelihoodModel> mod) :
+		RandomMixin<Inference>(std::move(kern), std::move(feat), std::move(m), std::move(lab), std::move(mod))
+{
+	init();
+}
+
+KrylovInferenceMethod::~KrylovInferenceMethod()
+{
+}
+
+void KrylovInferenceMethod::init()
+{
+	m_num_probes=16;
+	m_max_iterations=1000;
+	m_tolerance=1e-6;
+	m_log_det=0;
+
+	SG_ADD(&m_num_probes, "num_probes",
+		"Number of random probe vectors of the stochastic estimates");
+	SG_ADD(&m_max_iterations, "max_iterations",
+		"Maximum number of conjugate gradient iterations");
+	SG_ADD(&m_tolerance, "tolerance",
+		"Relative residual norm at which conjugate gradients stop");
+	SG_ADD(&m_diagonal, "diagonal", "Jacobi preconditioner");
+	SG_ADD(&m_probes, "probes", "Random probe vectors");
+	SG_ADD(&m_probe_solutions, "probe_solutions",
+		"Solutions of the system for the probe vectors");
+	SG_ADD(&m_log_det, "log_det", "Estimate of the log-determinant");
+	SG_ADD(&m_K_alpha, "K_alpha", "Product of kernel matrix and alpha");
+}
+
+void KrylovInferenceMethod::register_minimizer(std::shared_ptr<Minimizer> minimizer)
+{
+	io::warn("The method does not require a minimizer. The provided minimizer will not be used.");
+}
+
+std::shared_ptr<KrylovInferenceMethod> KrylovInferenceMethod::obtain_from_generic(
+		const std::shared_ptr<Inference>& inference)
+{
+	if (inference==NULL)
+		return NULL;
+
+	if (inference->get_inference_type()!=INF_KRYLOV)
+		error("Provided inference is not of type KrylovInferenceMethod!");
+
+	return inference->as<KrylovInferenceMethod>();
+}
+
+void KrylovInferenceMethod::compute_gradient()
+{
+	Inference::compute_gradient();
+
+	if (!m_gradient_update)
+	{
+		update_deriv();
+		m_gradient_update=true;
+		update_parameter_hash();
+	}
+}
+
+void KrylovInferenceMethod::update()
+{
+	SG_TRACE("entering");
+
+	Inference::update();
+	update_chol();
+	update_alpha();
+	m_gradient_update=false;
+	update_parameter_hash();
+
+	SG_TRACE("leaving");
+}
+
+void KrylovInferenceMethod::check_members() const
+{
+	Inference::check_members();
+
+	require(m_model->get_model_type()==LT_GAUSSIAN,
+		"Krylov inference method can only use Gaussian likelihood function");
+	require(m_labels->get_label_type()==LT_REGRESSION,
+		"Labels must be type of CRegressionLabels");
+	require(m_num_probes>0, "Number of probes ({}) must be positive",
+		m_num_probes);
+	require(m_max_iterations>0,
+		"Maximum number of iterations ({}) must be positive",
+		m_max_iterations);
+}
+
+void KrylovInferenceMethod::update_train_kernel()
+{
+	// kernel values are computed on the fly by kernel_product
+	m_kernel->init(m_features, m_features);
+}
+
+SGVector<float64_t> KrylovInferenceMethod::get_diagonal_vector()
+{
+	if (parameter_hash_changed())
+		update();
+
+	// get the sigma variable from the Gaussian likelihood model
+	auto lik = m_model->as<GaussianLikelihood>();
+	float64_t sigma=lik->get_sigma();
+
+	// compute diagonal vector: sW=1/sigma
+	SGVector<float64_t> result(m_features->get_num_vectors());
+	result.fill_vector(result.vector, m_features->get_num_vectors(), 1.0/sigma);
+
+	return result;
+}
+
+float64_t KrylovInferenceMethod::get_negative_log_marginal_likelihood()
+{
+	if (parameter_hash_changed())
+		update();
+
+	// get the sigma variable from the Gaussian likelihood model
+	auto lik = m_model->as<GaussianLikelihood>();
+	float64_t sigma=lik->get_sigma();
+
+	Map<VectorXd> eigen_alpha(m_alpha.vector, m_alpha.vlen);
+
+	// get labels and mean vectors and create eigen representation
+	SGVector<float64_t> y=regression_labels(m_labels)->get_labels();
+	Map<VectorXd> eigen_y(y.vector, y.vlen);
+	SGVector<float64_t> m=m_mean->get_mean_vector(m_features);
+	Map<VectorXd> eigen_m(m.vector, m.vlen);
+
+	// compute negative log of the marginal likelihood:
+	// nlZ=(y-m)'*alpha/2+log(det(A))/2+n*log(2*pi*sigma^2)/2
+	float64_t result =
+	    (eigen_y - eigen_m).dot(eigen_alpha) / 2.0 + m_log_det / 2.0 +
+	    y.vlen * std::log(2 * Math::PI * Math::sq(sigma)) / 2.0;
+
+	return result;
+}
+
+SGVector<float64_t> KrylovInferenceMethod::get_alpha()
+{
+	if (parameter_hash_changed())
+		update();
+
+	return SGVector<float64_t>(m_alpha);
+}
+
+SGMatrix<float64_t> KrylovInferenceMethod::get_cholesky()
+{
+	error("{} does not compute a Cholesky factor", get_name());
+	return SGMatrix<float64_t>();
+}
+
+SGVector<float64_t> KrylovInferenceMethod::get_posterior_mean()
+{
+	compute_gradient();
+
+	// mu=K*scale^2*alpha
+	SGVector<float64_t> result(m_K_alpha.vlen);
+	Map<VectorXd> eigen_result(result.vector, result.vlen);
+	eigen_result = Map<VectorXd>(m_K_alpha.vector, m_K_alpha.vlen) *
+	               std::exp(m_log_scale * 2.0);
+
+	return result;
+}
+
+SGMatrix<float64_t> KrylovInferenceMethod::get_posterior_covariance()
+{
+	error("{} does not compute the dense posterior covariance", get_name());
+	return SGMatrix<float64_t>();
+}
+
+SGMatrix<float64_t> KrylovInferenceMethod::solve_kernel_system(
+		const SGMatrix<float64_t>& b)
+{
+	if (parameter_hash_changed())
+		update();
+
+	require(b.num_rows==m_diagonal.vlen,
+		"Number of rows ({}) must match number of training points ({})",
+		b.num_rows, m_diagonal.vlen);
+
+	auto lik = m_model->as<GaussianLikelihood>();
+	float64_t sigma=lik->get_sigma();
+
+	// (K*scale^2+sigma^2*I)^(-1)=A^(-1)/sigma^2
+	SGMatrix<float64_t> result=solve_system(b);
+	Map<MatrixXd> eigen_result(result.matrix, result.num_rows, result.num_cols);
+	eigen_result/=Math::sq(sigma);
+
+	return result;
+}
+
+void KrylovInferenceMethod::update_chol()
+{
+	// get the sigma variable from the Gaussian likelihood model
+	auto lik = m_model->as<GaussianLikelihood>();
+	float64_t sigma=lik->get_sigma();
+	float64_t scale=std::exp(m_log_scale * 2.0) / Math::sq(sigma);
+
+	// diagonal of A=K*scale^2/sigma^2+I
+	m_diagonal=m_kernel->get_kernel_diagonal();
+	Map<VectorXd> d(m_diagonal.vector, m_diagonal.vlen);
+	d=d*scale+VectorXd::Ones(d.size());
+
+	/* Rademacher vectors scaled by the square root of the preconditioner, so
+	 * that the preconditioned system is probed with unit covariance */
+	const index_t n=m_diagonal.vlen;
+	m_probes=SGMatrix<float64_t>(n, m_num_probes);
+	UniformIntDistribution<int32_t> uniform_int_dist(0, 1);
+	for (index_t j=0; j<m_num_probes; ++j)
+	{
+		for (index_t i=0; i<n; ++i)
+		{
+			float64_t sign=uniform_int_dist(m_prng) ? 1.0 : -1.0;
+			m_probes(i, j)=sign*std::sqrt(m_diagonal[i]);
+		}
+	}
+}
+
+void KrylovInferenceMethod::update_alpha()
+{
+	// get the sigma variable from the Gaussian likelihood model
+	auto lik = m_model->as<GaussianLikelihood>();
+	float64_t sigma=lik->get_sigma();
+
+	// get labels and mean vector and create eigen representation
+	SGVector<float64_t> y=regression_labels(m_labels)->get_labels();
+	Map<VectorXd> eigen_y(y.vector, y.vlen);
+	SGVector<float64_t> m=m_mean->get_mean_vector(m_features);
+	Map<VectorXd> eigen_m(m.vector, m.vlen);
+
+	const index_t n=y.vlen;
+	const index_t p=m_num_probes;
+
+	// the labels and the probes are solved together
+	SGMatrix<float64_t> b(n, p+1);
+	Map<MatrixXd> eigen_b(b.matrix, n, p+1);
+	Map<MatrixXd> eigen_probes(m_probes.matrix, n, p);
+	eigen_b.col(0)=eigen_y-eigen_m;
+	eigen_b.rightCols(p)=eigen_probes;
+
+	std::vector<std::vector<float64_t>> coefficients;
+	SGMatrix<float64_t> x=solve_system(b, &coefficients);
+	Map<MatrixXd> eigen_x(x.matrix, n, p+1);
+
+	// alpha=A^(-1)*(y-m)/sigma^2
+	m_alpha=SGVector<float64_t>(n);
+	Map<VectorXd> a(m_alpha.vector, m_alpha.vlen);
+	a=eigen_x.col(0)/Math::sq(sigma);
+
+	m_probe_solutions=SGMatrix<float64_t>(n, p);
+	Map<MatrixXd>(m_probe_solutions.matrix, n, p)=eigen_x.rightCols(p);
+
+	/* log(det(A))=log(det(D))+log(det(D^(-1/2)*A*D^(-1/2))), the second term
+	 * by Lanczos quadrature of the preconditioned system started at
+	 * D^(-1/2)*z for every probe z */
+	Map<VectorXd> d(m_diagonal.vector, m_diagonal.vlen);
+	m_log_det=d.array().log().sum();
+	for (index_t j=0; j<p; ++j)
+	{
+		const auto& c=coefficients[j+1];
+		const index_t steps=(c.size()+1)/2;
+		if (!steps)
+			continue;
+
+		// Lanczos tridiagonal matrix from the conjugate gradient steps
+		// c[2k] and direction updates c[2k+1]
+		MatrixXd T=MatrixXd::Zero(steps, steps);
+		for (index_t k=0; k<steps; ++k)
+		{
+			T(k, k)=1.0/c[2*k];
+			if (k>0)
+				T(k, k)+=c[2*k-1]/c[2*k-2];
+			if (k+1<steps)
+			{
+				T(k, k+1)=std::sqrt(c[2*k+1])/c[2*k];
+				T(k+1, k)=T(k, k+1);
+			}
+		}
+
+		SelfAdjointEigenSolver<MatrixXd> eig(T);
+		float64_t quadrature=(eig.eigenvectors().row(0).transpose().array().square()*
+			eig.eigenvalues().array().log()).sum();
+		float64_t norm2=eigen_probes.col(j).cwiseAbs2().cwiseQuotient(d).sum();
+
+		m_log_det+=norm2*quadrature/p;
+	}
+}
+
+void KrylovInferenceMethod::update_deriv()
+{
+	SGMatrix<float64_t> alpha(m_alpha.vector, m_alpha.vlen, 1, false);
+	SGMatrix<float64_t> K_alpha=kernel_product(alpha);
+
+	m_K_alpha=SGVector<float64_t>(m_alpha.vlen);
+	sg_memcpy(m_K_alpha.vector, K_alpha.matrix, sizeof(float64_t)*m_alpha.vlen);
+}
+
+SGMatrix<float64_t> KrylovInferenceMethod::kernel_product(
+		const SGMatrix<float64_t>& x)
+{
+	const index_t n=x.num_rows;
+	const index_t k=x.num_cols;
+	const index_t num_tiles=(n+KRYLOV_TILE_SIZE-1)/KRYLOV_TILE_SIZE;
+
+	SGMatrix<float64_t> result(n, k);
+	Map<MatrixXd> eigen_result(result.matrix, n, k);
+	Map<MatrixXd> eigen_x(x.matrix, n, k);
+	eigen_result.setZero();
+
+	// every thread owns the rows of its tiles, and the tile of kernel values
+	// is reused for all columns of x
+	#pragma omp parallel
+	{
+		SGMatrix<float64_t> tile_buffer(
+			std::min(KRYLOV_TILE_SIZE, n), std::min(KRYLOV_TILE_SIZE, n));
+
+		#pragma omp for schedule(dynamic)
+		for (index_t row_tile=0; row_tile<num_tiles; ++row_tile)
+		{
+			const index_t row_start=row_tile*KRYLOV_TILE_SIZE;
+			const index_t row_len=std::min(KRYLOV_TILE_SIZE, n-row_start);
+
+			for (index_t col_start=0; col_start<n; col_start+=KRYLOV_TILE_SIZE)
+			{
+				const index_t col_len=std::min(KRYLOV_TILE_SIZE, n-col_start);
+				SGMatrix<float64_t> tile(
+					tile_buffer.matrix, row_len, col_len, false);
+				m_kernel->kernel_block(row_start, row_len, col_start, col_len, tile);
+
+				eigen_result.middleRows(row_start, row_len).noalias()+=
+					Map<MatrixXd>(tile.matrix, row_len, col_len)*
+					eigen_x.middleRows(col_start, col_len);
+			}
+		}
+	}
+
+	return result;
+}
+
+SGMatrix<float64_t> KrylovInferenceMethod::solve_system(
+		const SGMatrix<float64_t>& b,
+		std::vector<std::vector<float64_t>>* coefficients)
+{
+	auto lik = m_model->as<GaussianLikelihood>();
+	float64_t sigma=lik->get_sigma();
+	float64_t scale=std::exp(m_log_scale * 2.0) / Math::sq(sigma);
+
+	const index_t n=b.num_rows;
+	const index_t k=b.num_cols;
+
+	Map<MatrixXd> eigen_b(b.matrix, n, k);
+	Map<VectorXd> d(m_diagonal.vector, m_diagonal.vlen);
+	VectorXd inv_d=d.cwiseInverse();
+
+	SGMatrix<float64_t> result(n, k);
+	Map<MatrixXd> x(result.matrix, n, k);
+	x.setZero();
+
+	// residuals, preconditioned residuals and directions of all columns
+	MatrixXd r=eigen_b;
+	MatrixXd z=inv_d.asDiagonal()*r;
+	MatrixXd p=z;
+	VectorXd rz=r.cwiseProduct(z).colwise().sum().transpose();
+	VectorXd b_norm=eigen_b.colwise().norm().transpose();
+
+	if (coefficients)
+		coefficients->assign(k, std::vector<float64_t>());
+
+	std::vector<index_t> active;
+	for (index_t j=0; j<k; ++j)
+	{
+		if (b_norm[j]>0)
+			active.push_back(j);
+	}
+
+	int32_t iteration=0;
+	for (; iteration<m_max_iterations && !active.empty(); ++iteration)
+	{
+		// one kernel product for the directions of all active columns
+		SGMatrix<float64_t> p_active(n, active.size());
+		Map<MatrixXd> eigen_p_active(p_active.matrix, n, active.size());
+		for (size_t c=0; c<active.size(); ++c)
+			eigen_p_active.col(c)=p.col(active[c]);
+
+		SGMatrix<float64_t> Kp=kernel_product(p_active);
+		Map<MatrixXd> Ap(Kp.matrix, n, active.size());
+		Ap=Ap*scale+eigen_p_active;
+
+		std::vector<index_t> still_active;
+		for (size_t c=0; c<active.size(); ++c)
+		{
+			const index_t j=active[c];
+			// A has eigenvalues of at least one for a valid kernel, a partial
+			// solution would silently bias alpha and the estimates
+			float64_t p_dot_Ap=p.col(j).dot(Ap.col(c));
+			require(p_dot_Ap>0.0, "Conjugate gradients broke down for system "
+				"{} after {} iterations, the kernel matrix is not positive "
+				"semi-definite", j, iteration);
+
+			float64_t step=rz[j]/p_dot_Ap;
+			x.col(j)+=step*p.col(j);
+			r.col(j)-=step*Ap.col(c);
+			if (coefficients)
+				(*coefficients)[j].push_back(step);
+
+			if (r.col(j).norm()<=m_tolerance*b_norm[j])
+				continue;
+
+			z.col(j)=inv_d.cwiseProduct(r.col(j));
+			float64_t rz_new=r.col(j).dot(z.col(j));
+			float64_t beta=rz_new/rz[j];
+			p.col(j)=z.col(j)+beta*p.col(j);
+			rz[j]=rz_new;
+			if (coefficients)
+				(*coefficients)[j].push_back(beta);
+
+			still_active.push_back(j);
+		}
+		active=std::move(still_active);
+
+		SG_DEBUG("CG iteration {}, {} of {} systems not converged",
+			iteration, active.size(), k);
+	}
+
+	if (!active.empty())
+		io::warn("{} of {} systems did not converge in {} iterations",
+			active.size(), k, m_max_iterations);
+
+	SG_DEBUG("Solved {} systems in {} iterations", k, iteration);
+
+	return result;
+}
+
+SGVector<float64_t> KrylovInferenceMethod::get_derivative_wrt_inference_method(
+		Parameters::const_reference param)
+{
+	require(param.first == "log_scale", "Can't compute derivative of "
+			"the nagative log marginal likelihood wrt {}.{} parameter",
+			get_name(), param.first);
+
+	Map<VectorXd> eigen_alpha(m_alpha.vector, m_alpha.vlen);
+	Map<VectorXd> eigen_K_alpha(m_K_alpha.vector, m_K_alpha.vlen);
+	Map<VectorXd> d(m_diagonal.vector, m_diagonal.vlen);
+	Map<MatrixXd> eigen_Z(m_probes.matrix, m_probes.num_rows, m_probes.num_cols);
+	Map<MatrixXd> eigen_W(m_probe_solutions.matrix, m_probe_solutions.num_rows,
+			m_probe_solutions.num_cols);
+
+	SGVector<float64_t> result(1);
+
+	// trace(A^(-1)) estimated with the probes: mean of (D^(-1)*z)'*A^(-1)*z
+	float64_t trace=(d.cwiseInverse().asDiagonal()*eigen_Z).cwiseProduct(
+		eigen_W).sum()/m_num_probes;
+
+	// compute derivative wrt kernel scale:
+	// dnlZ=trace(A^(-1)*K*scale^2)/sigma^2-alpha'*K*alpha*scale^2, where
+	// K*scale^2/sigma^2=A-I
+	result[0]=m_alpha.vlen-trace-
+		eigen_alpha.dot(eigen_K_alpha)*std::exp(m_log_scale * 2.0);
+
+	return result;
+}
+
+SGVector<float64_t> KrylovInferenceMethod::get_derivative_wrt_likelihood_model(
+		Parameters::const_reference param)
+{
+	require(param.first == "log_sigma", "Can't compute derivative of "
+			"the nagative log marginal likelihood wrt {}.{} parameter",
+			m_model->get_name(), param.first);
+
+	// get the sigma variable from the Gaussian likelihood model
+	auto lik = m_model->as<GaussianLikelihood>();
+	float64_t sigma=lik->get_sigma();
+
+	Map<VectorXd> eigen_alpha(m_alpha.vector, m_alpha.vlen);
+	Map<VectorXd> d(m_diagonal.vector, m_diagonal.vlen);
+	Map<MatrixXd> eigen_Z(m_probes.matrix, m_probes.num_rows, m_probes.num_cols);
+	Map<MatrixXd> eigen_W(m_probe_solutions.matrix, m_probe_solutions.num_rows,
+			m_probe_solutions.num_cols);
+
+	SGVector<float64_t> result(1);
+
+	float64_t trace=(d.cwiseInverse().asDiagonal()*eigen_Z).cwiseProduct(
+		eigen_W).sum()/m_num_probes;
+
+	// compute derivative wrt likelihood model parameter sigma:
+	// dnlZ=trace(A^(-1))-sigma^2*alpha'*alpha
+	result[0]=trace-Math::sq(sigma)*eigen_alpha.squaredNorm();
+
+	return result;
+}
+
+SGVector<float64_t> KrylovInferenceMethod::get_derivative_wrt_kernel(
+		Parameters::const_reference param)
+{
+	auto lik = m_model->as<GaussianLikelihood>();
+	float64_t sigma=lik->get_sigma();
+
+	const index_t n=m_alpha.vlen;
+	Map<VectorXd> eigen_alpha(m_alpha.vector, m_alpha.vlen);
+	Map<VectorXd> d(m_diagonal.vector, m_diagonal.vlen);
+	Map<MatrixXd> eigen_Z(m_probes.matrix, m_probes.num_rows, m_probes.num_cols);
+	Map<MatrixXd> eigen_W(m_probe_solutions.matrix, m_probe_solutions.num_rows,
+			m_probe_solutions.num_cols);
+	MatrixXd eigen_U=d.cwiseInverse().asDiagonal()*eigen_Z;
+
+	SGVector<float64_t> result;
+	auto visitor = std::make_unique<ShapeVisitor>();
+	param.second->get_value().visit(visitor.get());
+	int64_t len= visitor->get_size();
+	result=SGVector<float64_t>(len);
+
+	// the training points in tiles, as views that share the features
+	std::vector<std::shared_ptr<Features>> tiles;
+	for (index_t start=0; start<n; start+=KRYLOV_TILE_SIZE)
+	{
+		SGVector<index_t> idx(std::min(KRYLOV_TILE_SIZE, n-start));
+		idx.range_fill(start);
+		tiles.push_back(view(m_features, idx));
+	}
+
+	/* dK*U and dK*alpha for all components of the parameter, accumulated
+	 * from tiles of dK computed by the kernel on pairs of tiles, so that the
+	 * dense derivative of the kernel matrix is never stored */
+	std::vector<MatrixXd> dK_U(result.vlen, MatrixXd::Zero(n, m_num_probes));
+	std::vector<VectorXd> dK_alpha(result.vlen, VectorXd::Zero(n));
+	for (size_t r=0; r<tiles.size(); ++r)
+	{
+		const index_t row_start=r*KRYLOV_TILE_SIZE;
+		const index_t row_len=tiles[r]->get_num_vectors();
+		for (size_t c=0; c<tiles.size(); ++c)
+		{
+			const index_t col_start=c*KRYLOV_TILE_SIZE;
+			const index_t col_len=tiles[c]->get_num_vectors();
+			m_kernel->init(tiles[r], tiles[c]);
+
+			for (index_t i=0; i<result.vlen; i++)
+			{
+				SGMatrix<float64_t> dK;
+
+				if (result.vlen==1)
+					dK=m_kernel->get_parameter_gradient(param);
+				else
+					dK=m_kernel->get_parameter_gradient(param, i);
+
+				Map<MatrixXd> eigen_dK(dK.matrix, row_len, col_len);
+				dK_U[i].middleRows(row_start, row_len).noalias()+=
+					eigen_dK*eigen_U.middleRows(col_start, col_len);
+				dK_alpha[i].segment(row_start, row_len).noalias()+=
+					eigen_dK*eigen_alpha.segment(col_start, col_len);
+			}
+		}
+	}
+	update_train_kernel();
+
+	for (index_t i=0; i<result.vlen; i++)
+	{
+		// trace(A^(-1)*dK) estimated with the probes
+		float64_t trace=dK_U[i].cwiseProduct(eigen_W).sum()/m_num_probes;
+
+		// compute derivative wrt kernel parameter:
+		// dnlZ=(trace(A^(-1)*dK)/sigma^2-alpha'*dK*alpha)*scale^2/2
+		result[i]=trace/Math::sq(sigma)-eigen_alpha.dot(dK_alpha[i]);
+		result[i] *= std::exp(m_log_scale * 2.0) / 2.0;
+	}
+
+	return result;
+}
+
+SGVector<float64_t> KrylovInferenceMethod::get_derivative_wrt_mean(
+		Parameters::const_reference param)
+{
+	// create eigen representation of alpha vector
+	Map<VectorXd> eigen_alpha(m_alpha.vector, m_alpha.vlen);
+
+	SGVector<float64_t> result;
+	auto visitor = std::make_unique<ShapeVisitor>();
+	param.second->get_value().visit(visitor.get());
+	int64_t len= visitor->get_size();
+	result=SGVector<float64_t>(len);
+
+	for (index_t i=0; i<result.vlen; i++)
+	{
+		SGVector<float64_t> dmu;
+
+		if (result.vlen==1)
+			dmu=m_mean->get_parameter_derivative(m_features, param);
+		else
+			dmu=m_mean->get_parameter_derivative(m_features, param, i);
+
+		Map<VectorXd> eigen_dmu(dmu.vector, dmu.vlen);
+
+		// compute derivative wrt mean parameter: dnlZ=-dmu'*alpha
+		result[i]=-eigen_dmu.dot(eigen_alpha);
+	}
+
+	return result;
+}
@@ -0,0 +1,323 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+#ifndef KRYLOVINFERENCEMETHOD_H_
+#define KRYLOVINFERENCEMETHOD_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/machine/gp/Inference.h>
+#include <shogun/mathematics/RandomMixin.h>
+
+#include <vector>
+
+namespace shogun
+{
+
+/** @brief Matrix-free Gaussian inference method for large training sets.
+ *
+ * Computes the same posterior as ExactInferenceMethod without storing or
+ * factorizing the kernel matrix. All systems with
+ *
+ * \f[
+ * A = K\frac{s^2}{\sigma^2} + I
+ * \f]
+ *
+ * are solved with Jacobi preconditioned conjugate gradients, where the
+ * products with \f$K\f$ are computed in tiles of kernel values, so memory
+ * grows linearly with the number of training points.
+ *
+ * The labels and a number of random probe vectors are solved together, so
+ * every kernel value is computed once per iteration for all of them. The
+ * coefficients of the conjugate gradient iterations of the probes give the
+ * Lanczos tridiagonalization of the preconditioned system, from which
+ * \f$\log|A|\f$ is estimated by stochastic Lanczos quadrature. The solved
+ * probes give stochastic estimates of the traces in the derivatives of the
+ * negative log marginal likelihood.
+ *
+ * The negative log marginal likelihood and its derivatives are therefore
+ * stochastic estimates, their accuracy is controlled with
+ * set_num_probes(). Derivatives wrt kernel parameters are computed from
+ * tiles of the derivative of the kernel matrix as well.
+ *
+ * NOTE: The Gaussian Likelihood Function must be used for this inference
+ * method.
+ *
+ * For more details, see: Gardner, J. R., Pleiss, G., Bindel, D., Weinberger,
+ * K. Q., & Wilson, A. G. (2018). GPyTorch: Blackbox Matrix-Matrix Gaussian
+ * Process Inference with GPU Acceleration. NeurIPS 2018.
+ */
+class KrylovInferenceMethod: public RandomMixin<Inference>
+{
+public:
+	/** default constructor */
+	KrylovInferenceMethod();
+
+	/** constructor
+	 *
+	 * @param kernel covariance function
+	 * @param features features to use in inference
+	 * @param mean mean function to use
+	 * @param labels labels of the features
+	 * @param model likelihood model to use
+	 */
+	KrylovInferenceMethod(std::shared_ptr<Kernel> kernel, std::shared_ptr<Features> features,
+			std::shared_ptr<MeanFunction> mean, std::shared_ptr<Labels> labels, std::shared_ptr<LikelihoodModel> model);
+
+	~KrylovInferenceMethod() override;
+
+	/** return what type of inference we are
+	 *
+	 * @return inference type KRYLOV
+	 */
+	EInferenceType get_inference_type() const override { return INF_KRYLOV; }
+
+	/** returns the name of the inference method
+	 *
+	 * @return name KrylovInferenceMethod
+	 */
+	const char* get_name() const override { return "KrylovInferenceMethod"; }
+
+	/** helper method used to specialize a base class instance
+	 *
+	 * @param inference inference method
+	 * @return casted KrylovInferenceMethod object
+	 */
+	static std::shared_ptr<KrylovInferenceMethod> obtain_from_generic(const std::shared_ptr<Inference>& inference);
+
+	/** get negative log marginal likelihood
+	 *
+	 * @return estimate of the negative log of the marginal likelihood
+	 * function:
+	 *
+	 * \f[
+	 * -log(p(y|X, \theta))
+	 * \f]
+	 *
+	 * where \f$y\f$ are the labels, \f$X\f$ are the features, and \f$\theta\f$
+	 * represent hyperparameters.
+	 */
+	float64_t get_negative_log_marginal_likelihood() override;
+
+	/** get alpha vector
+	 *
+	 * @return vector to compute posterior mean of Gaussian Process:
+	 *
+	 * \f[
+	 * \mu = K\alpha
+	 * \f]
+	 *
+	 * where \f$\mu\f$ is the mean and \f$K\f$ is the prior covariance matrix.
+	 */
+	SGVector<float64_t> get_alpha() override;
+
+	/** not available, the method does not factorize the kernel matrix
+	 *
+	 * @return nothing, raises an error
+	 */
+	SGMatrix<float64_t> get_cholesky() override;
+
+	/** get diagonal vector
+	 *
+	 * @return diagonal of matrix used to calculate posterior covariance matrix
+	 *
+	 * \f[
+	 * Cov = (K^{-1}+sW^{2})^{-1}
+	 * \f]
+	 *
+	 * where \f$Cov\f$ is the posterior covariance matrix, \f$K\f$ is the prior
+	 * covariance matrix, and \f$sW\f$ is the diagonal vector.
+	 */
+	SGVector<float64_t> get_diagonal_vector() override;
+
+	/** returns mean vector \f$\mu\f$ of the posterior Gaussian distribution
+	 * \f$\mathcal{N}(\mu,\Sigma)\f$
+	 *
+	 * @return mean vector
+	 */
+	SGVector<float64_t> get_posterior_mean() override;
+
+	/** not available, the posterior covariance matrix is dense
+	 *
+	 * @return nothing, raises an error
+	 */
+	SGMatrix<float64_t> get_posterior_covariance() override;
+
+	/** solves the system with the noisy kernel matrix of the training points
+	 *
+	 * @param b right hand sides, one per column
+	 * @return \f$(Ks^2+\sigma^2I)^{-1}b\f$
+	 */
+	SGMatrix<float64_t> solve_kernel_system(const SGMatrix<float64_t>& b);
+
+	/**
+	 * @return whether combination of the inference method and given
+	 * likelihood function supports regression
+	 */
+	bool supports_regression() const override
+	{
+		check_members();
+		return m_model->supports_regression();
+	}
+
+	/** update alpha, log-determinant and trace estimates */
+	void update() override;
+
+	/** Set a minimizer
+	 *
+	 * @param minimizer minimizer used in inference method
+	 */
+	void register_minimizer(std::shared_ptr<Minimizer> minimizer) override;
+
+	/** get number of random probe vectors of the stochastic estimates
+	 *
+	 * @return number of probes
+	 */
+	int32_t get_num_probes() const { return m_num_probes; }
+
+	/** set number of random probe vectors of the stochastic estimates
+	 *
+	 * @param num_probes number of probes
+	 */
+	void set_num_probes(int32_t num_probes) { m_num_probes=num_probes; }
+
+	/** get maximum number of conjugate gradient iterations
+	 *
+	 * @return maximum number of iterations
+	 */
+	int32_t get_max_iterations() const { return m_max_iterations; }
+
+	/** set maximum number of conjugate gradient iterations
+	 *
+	 * @param max_iterations maximum number of iterations
+	 */
+	void set_max_iterations(int32_t max_iterations) { m_max_iterations=max_iterations; }
+
+	/** get relative residual norm at which conjugate gradients stop
+	 *
+	 * @return tolerance
+	 */
+	float64_t get_tolerance() const { return m_tolerance; }
+
+	/** set relative residual norm at which conjugate gradients stop
+	 *
+	 * @param tol tolerance
+	 */
+	void set_tolerance(float64_t tol) { m_tolerance=tol; }
+
+protected:
+	/** check if members of object are valid for inference */
+	void check_members() const override;
+
+	/** initializes the kernel on the training features, without computing
+	 * the kernel matrix
+	 */
+	void update_train_kernel() override;
+
+	/** solve for alpha and the probes, estimate the log-determinant */
+	void update_alpha() override;
+
+	/** update the preconditioner and draw the probe vectors */
+	void update_chol() override;
+
+	/** update the products of the kernel matrix required to compute the
+	 * posterior mean and the derivatives
+	 */
+	void update_deriv() override;
+
+	/** returns derivative of negative log marginal likelihood wrt parameter of
+	 * CInference class
+	 *
+	 * @param param parameter of CInference class
+	 *
+	 * @return derivative of negative log marginal likelihood
+	 */
+	SGVector<float64_t> get_derivative_wrt_inference_method(
+			Parameters::const_reference param) override;
+
+	/** returns derivative of negative log marginal likelihood wrt parameter of
+	 * likelihood model
+	 *
+	 * @param param parameter of given likelihood model
+	 *
+	 * @return derivative of negative log marginal likelihood
+	 */
+	SGVector<float64_t> get_derivative_wrt_likelihood_model(
+			Parameters::const_reference param) override;
+
+	/** returns derivative of negative log marginal likelihood wrt kernel's
+	 * parameter
+	 *
+	 * @param param parameter of given kernel
+	 *
+	 * @return derivative of negative log marginal likelihood
+	 */
+	SGVector<float64_t> get_derivative_wrt_kernel(
+			Parameters::const_reference param) override;
+
+	/** returns derivative of negative log marginal likelihood wrt mean
+	 * function's parameter
+	 *
+	 * @param param parameter of given mean function
+	 *
+	 * @return derivative of negative log marginal likelihood
+	 */
+	SGVector<float64_t> get_derivative_wrt_mean(
+			Parameters::const_reference param) override;
+
+	/** update gradients */
+	void compute_gradient() override;
+
+private:
+	/** initialize with default values and register params */
+	void init();
+
+	/** computes the product of the kernel matrix of the training points
+	 * with a matrix, in tiles of kernel values
+	 *
+	 * @param x matrix with one row per training point
+	 * @return \f$Kx\f$
+	 */
+	SGMatrix<float64_t> kernel_product(const SGMatrix<float64_t>& x);
+
+	/** solves \f$Ax=b\f$ for all columns of b with preconditioned conjugate
+	 * gradients, sharing the products with the kernel matrix
+	 *
+	 * @param b right hand sides
+	 * @param coefficients if given, the step sizes and the direction updates
+	 * of the iterations of every column, alternating
+	 * @return solutions, raises an error if the kernel matrix turns out not
+	 * to be positive semi-definite
+	 */
+	SGMatrix<float64_t> solve_system(const SGMatrix<float64_t>& b,
+			std::vector<std::vector<float64_t>>* coefficients=nullptr);
+
+private:
+	/** number of random probe vectors */
+	int32_t m_num_probes;
+
+	/** maximum number of conjugate gradient iterations */
+	int32_t m_max_iterations;
+
+	/** relative residual norm at which conjugate gradients stop */
+	float64_t m_tolerance;
+
+	/** diagonal of the system matrix, the Jacobi preconditioner */
+	SGVector<float64_t> m_diagonal;
+
+	/** probe vectors, drawn with covariance of the preconditioner */
+	SGMatrix<float64_t> m_probes;
+
+	/** solutions of the system for the probe vectors */
+	SGMatrix<float64_t> m_probe_solutions;
+
+	/** estimate of the log-determinant of the system matrix */
+	float64_t m_log_det;
+
+	/** product of the kernel matrix and alpha */
+	SGVector<float64_t> m_K_alpha;
+};
+}
+#endif /* KRYLOVINFERENCEMETHOD_H_ */
@@ -62,7 +62,33 @@ SparseMatrix<T> EigenSparseUtil<T>::toEigenSparse(SGSparseMatrix<T> sg_matrix)
 		return M;
 	}
 
+template<typename T>
+SGSparseMatrix<T> EigenSparseUtil<T>::fromEigenSparse(
+	const SparseMatrix<T>& eigen_matrix)
+	{
+		typedef SparseMatrix<T, RowMajor> RowMajorMatrixType;
+		RowMajorMatrixType M(eigen_matrix);
+
+		SGSparseMatrix<T> sg_matrix(M.cols(), M.rows());
+		for (index_t i=0; i<M.outerSize(); ++i)
+		{
+			sg_matrix[i]=SGSparseVector<T>(M.innerVector(i).nonZeros());
+
+			index_t k=0;
+			for (typename RowMajorMatrixType::InnerIterator it(M, i); it;
+				++it, ++k)
+			{
+				sg_matrix[i].features[k].feat_index=it.col();
+				sg_matrix[i].features[k].entry=it.value();
+			}
+		}
+
+		return sg_matrix;
+	}
+
 template class EigenSparseUtil<bool>;
+template class EigenSparseUtil<float32_t>;
 template class EigenSparseUtil<float64_t>;
+template class EigenSparseUtil<floatmax_t>;
 template class EigenSparseUtil<complex128_t>;
 }
@@ -27,7 +27,7 @@ template<class T> class SGSparseMatrix;
 
 /** @brief This class contains some utilities for Eigen3 Sparse Matrix
  * integration with shogun. Currently it provides a method for
- * converting SGSparseMatrix to Eigen3 SparseMatrix.
+ * converting between SGSparseMatrix and Eigen3 SparseMatrix.
  */
 template<typename T> class EigenSparseUtil
 {
@@ -39,6 +39,15 @@ template<typename T> class EigenSparseUtil
 	 * @return Eigen3 SparseMatrix representation of sg_matrix
 	 */
 	static Eigen::SparseMatrix<T> toEigenSparse(SGSparseMatrix<T> sg_matrix);
+
+	/** Converts a Eigen3 SparseMatrix to SGSparseMatrix by copying
+	 * its non-zero co-efficients, each row becoming a sparse vector.
+	 *
+	 * @param eigen_matrix the Eigen3 SparseMatrix
+	 * @return SGSparseMatrix representation of eigen_matrix
+	 */
+	static SGSparseMatrix<T>
+	fromEigenSparse(const Eigen::SparseMatrix<T>& eigen_matrix);
 };
 
 }
@@ -36,6 +36,8 @@
 #include <memory>
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseMatrix.h>
+#include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/common.h>
 #include <shogun/lib/config.h>
@@ -540,6 +542,57 @@ namespace shogun
 		DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_IN_PLACE_MATRIX_PROD, SGMatrix)
 #undef BACKEND_GENERIC_IN_PLACE_MATRIX_PROD
 
+/**
+ * Wrapper method of sparse matrix times dense vector or matrix product method.
+ *
+ * @see linalg::matrix_prod
+ */
+#define BACKEND_GENERIC_IN_PLACE_SPARSE_MATRIX_PROD(Type, Container)           \
+	virtual void matrix_prod(                                                  \
+	    const SGSparseMatrix<Type>& a, const Container<Type>& b,               \
+	    Container<Type>& result, bool transpose_A, bool transpose_B) const     \
+	{                                                                          \
+		not_implemented(SOURCE_LOCATION);;                                     \
+	}
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_IN_PLACE_SPARSE_MATRIX_PROD, SGVector)
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_IN_PLACE_SPARSE_MATRIX_PROD, SGMatrix)
+#undef BACKEND_GENERIC_IN_PLACE_SPARSE_MATRIX_PROD
+
+/**
+ * Wrapper method of dense matrix times sparse matrix product method.
+ *
+ * @see linalg::matrix_prod
+ */
+#define BACKEND_GENERIC_IN_PLACE_DENSE_SPARSE_MATRIX_PROD(Type, Container)     \
+	virtual void matrix_prod(                                                  \
+	    const Container<Type>& a, const SGSparseMatrix<Type>& b,               \
+	    Container<Type>& result, bool transpose_A, bool transpose_B) const     \
+	{                                                                          \
+		not_implemented(SOURCE_LOCATION);;                                     \
+	}
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_IN_PLACE_DENSE_SPARSE_MATRIX_PROD, SGMatrix)
+#undef BACKEND_GENERIC_IN_PLACE_DENSE_SPARSE_MATRIX_PROD
+
+/**
+ * Wrapper method of sparse matrix times sparse matrix product method.
+ *
+ * @see linalg::matrix_prod
+ */
+#define BACKEND_GENERIC_SPARSE_SPARSE_MATRIX_PROD(Type, Container)             \
+	virtual Container<Type> matrix_prod(                                       \
+	    const Container<Type>& a, const Container<Type>& b, bool transpose_A,  \
+	    bool transpose_B) const                                                \
+	{                                                                          \
+		not_implemented(SOURCE_LOCATION);;                                     \
+		return Container<Type>();                                              \
+	}
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_SPARSE_SPARSE_MATRIX_PROD, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_SPARSE_MATRIX_PROD
+
 /**
  * Wrapper method of max method. Return the largest element in a vector or
  * matrix.
@@ -710,6 +763,21 @@ namespace shogun
 		DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_IN_PLACE_COLWISE_SCALE, SGMatrix)
 #undef BACKEND_GENERIC_IN_PLACE_COLWISE_SCALE
 
+/**
+ * Wrapper method of scale method for sparse matrices.
+ *
+ * @see linalg::scale
+ */
+#define BACKEND_GENERIC_IN_PLACE_SPARSE_SCALE(Type, Container)                 \
+	virtual void scale(                                                        \
+	    const Container<Type>& a, Type alpha, Container<Type>& result) const   \
+	{                                                                          \
+		not_implemented(SOURCE_LOCATION);;                                     \
+	}
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_IN_PLACE_SPARSE_SCALE, SGSparseMatrix)
+#undef BACKEND_GENERIC_IN_PLACE_SPARSE_SCALE
+
 /**
  * Wrapper method that sets const values to vectors or matrices.
  *
@@ -882,6 +950,38 @@ namespace shogun
 		DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_BLOCK_ROWWISE_SUM, SGMatrix)
 #undef BACKEND_GENERIC_BLOCK_ROWWISE_SUM
 
+/**
+ * Wrapper method of matrix colwise sum that works with sparse matrices.
+ *
+ * @see linalg::colwise_sum
+ */
+#define BACKEND_GENERIC_SPARSE_COLWISE_SUM(Type, Container)                    \
+	virtual SGVector<Type> colwise_sum(const Container<Type>& a, bool no_diag) \
+	    const                                                                  \
+	{                                                                          \
+		not_implemented(SOURCE_LOCATION);;                                     \
+		return 0;                                                              \
+	}
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_SPARSE_COLWISE_SUM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_COLWISE_SUM
+
+/**
+ * Wrapper method of matrix rowwise sum that works with sparse matrices.
+ *
+ * @see linalg::rowwise_sum
+ */
+#define BACKEND_GENERIC_SPARSE_ROWWISE_SUM(Type, Container)                    \
+	virtual SGVector<Type> rowwise_sum(const Container<Type>& a, bool no_diag) \
+	    const                                                                  \
+	{                                                                          \
+		not_implemented(SOURCE_LOCATION);;                                     \
+		return 0;                                                              \
+	}
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_SPARSE_ROWWISE_SUM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_ROWWISE_SUM
+
 /**
  * Wrapper method of svd computation.
  *
@@ -301,6 +301,35 @@ namespace shogun
 		DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_IN_PLACE_MATRIX_PROD, SGMatrix)
 #undef BACKEND_GENERIC_IN_PLACE_MATRIX_PROD
 
+/** Implementation of @see LinalgBackendBase::matrix_prod */
+#define BACKEND_GENERIC_IN_PLACE_SPARSE_MATRIX_PROD(Type, Container)           \
+	virtual void matrix_prod(                                                  \
+	    const SGSparseMatrix<Type>& a, const Container<Type>& b,               \
+	    Container<Type>& result, bool transpose_A, bool transpose_B) const;
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_IN_PLACE_SPARSE_MATRIX_PROD, SGVector)
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_IN_PLACE_SPARSE_MATRIX_PROD, SGMatrix)
+#undef BACKEND_GENERIC_IN_PLACE_SPARSE_MATRIX_PROD
+
+/** Implementation of @see LinalgBackendBase::matrix_prod */
+#define BACKEND_GENERIC_IN_PLACE_DENSE_SPARSE_MATRIX_PROD(Type, Container)     \
+	virtual void matrix_prod(                                                  \
+	    const Container<Type>& a, const SGSparseMatrix<Type>& b,               \
+	    Container<Type>& result, bool transpose_A, bool transpose_B) const;
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_IN_PLACE_DENSE_SPARSE_MATRIX_PROD, SGMatrix)
+#undef BACKEND_GENERIC_IN_PLACE_DENSE_SPARSE_MATRIX_PROD
+
+/** Implementation of @see LinalgBackendBase::matrix_prod */
+#define BACKEND_GENERIC_SPARSE_SPARSE_MATRIX_PROD(Type, Container)             \
+	virtual Container<Type> matrix_prod(                                       \
+	    const Container<Type>& a, const Container<Type>& b, bool transpose_A,  \
+	    bool transpose_B) const;
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_SPARSE_SPARSE_MATRIX_PROD, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_SPARSE_MATRIX_PROD
+
 /** Implementation of @see LinalgBackendBase::max */
 #define BACKEND_GENERIC_MAX(Type, Container)                                   \
 	virtual Type max(const Container<Type>& a) const;
@@ -383,6 +412,14 @@ namespace shogun
 		DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_IN_PLACE_COLWISE_SCALE, SGMatrix)
 #undef BACKEND_GENERIC_IN_PLACE_COLWISE_SCALE
 
+/** Implementation of @see LinalgBackendBase::scale */
+#define BACKEND_GENERIC_IN_PLACE_SPARSE_SCALE(Type, Container)                 \
+	virtual void scale(                                                        \
+	    const Container<Type>& a, Type alpha, Container<Type>& result) const;
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_IN_PLACE_SPARSE_SCALE, SGSparseMatrix)
+#undef BACKEND_GENERIC_IN_PLACE_SPARSE_SCALE
+
 /** Implementation of @see LinalgBackendBase::set_const */
 #define BACKEND_GENERIC_SET_CONST(Type, Container)                             \
 	virtual void set_const(Container<Type>& a, const Type value) const;
@@ -467,6 +504,22 @@ namespace shogun
 		DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_BLOCK_ROWWISE_SUM, SGMatrix)
 #undef BACKEND_GENERIC_BLOCK_ROWWISE_SUM
 
+/** Implementation of @see LinalgBackendBase::colwise_sum */
+#define BACKEND_GENERIC_SPARSE_COLWISE_SUM(Type, Container)                    \
+	virtual SGVector<Type> colwise_sum(const Container<Type>& a, bool no_diag) \
+	    const;
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_SPARSE_COLWISE_SUM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_COLWISE_SUM
+
+/** Implementation of @see LinalgBackendBase::rowwise_sum */
+#define BACKEND_GENERIC_SPARSE_ROWWISE_SUM(Type, Container)                    \
+	virtual SGVector<Type> rowwise_sum(const Container<Type>& a, bool no_diag) \
+	    const;
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_SPARSE_ROWWISE_SUM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_ROWWISE_SUM
+
 /** Implementation of @see LinalgBackendBase::svd */
 #define BACKEND_GENERIC_SVD(Type, Container)                                   \
 	virtual void svd(                                                          \
@@ -777,6 +830,30 @@ namespace shogun
 		    const SGMatrix<T>& a, const SGMatrix<T>& b, SGMatrix<T>& result,
 		    bool transpose_A, bool transpose_B) const;
 
+		/** Eigen3 sparse matrix * vector in-place product method */
+		template <typename T>
+		void matrix_prod_impl(
+		    const SGSparseMatrix<T>& a, const SGVector<T>& b,
+		    SGVector<T>& result, bool transpose, bool transpose_B) const;
+
+		/** Eigen3 sparse matrix * matrix in-place product method */
+		template <typename T>
+		void matrix_prod_impl(
+		    const SGSparseMatrix<T>& a, const SGMatrix<T>& b,
+		    SGMatrix<T>& result, bool transpose_A, bool transpose_B) const;
+
+		/** Eigen3 matrix * sparse matrix in-place product method */
+		template <typename T>
+		void matrix_prod_impl(
+		    const SGMatrix<T>& a, const SGSparseMatrix<T>& b,
+		    SGMatrix<T>& result, bool transpose_A, bool transpose_B) const;
+
+		/** Eigen3 sparse matrix * sparse matrix product method */
+		template <typename T>
+		SGSparseMatrix<T> matrix_prod_impl(
+		    const SGSparseMatrix<T>& a, const SGSparseMatrix<T>& b,
+		    bool transpose_A, bool transpose_B) const;
+
 		/** Return the largest element in the vector with Eigen3 library */
 		template <typename T>
 		T max_impl(const SGVector<T>& vec) const;
@@ -851,6 +928,12 @@ namespace shogun
 		    const SGMatrix<T>& a, const SGVector<T>& alphas,
 		    SGMatrix<T>& result) const;
 
+		/** Sparse matrix inplace scale method: result = alpha * A */
+		template <typename T>
+		void scale_impl(
+		    const SGSparseMatrix<T>& a, T alpha,
+		    SGSparseMatrix<T>& result) const;
+
 		/** Eigen3 set const method */
 		template <typename T>
 		void set_const_impl(SGVector<T>& a, T value) const;
@@ -921,6 +1004,16 @@ namespace shogun
 		SGVector<T> rowwise_sum_impl(
 		    const linalg::Block<SGMatrix<T>>& mat, bool no_diag) const;
 
+		/** Sparse matrix colwise sum method */
+		template <typename T>
+		SGVector<T>
+		colwise_sum_impl(const SGSparseMatrix<T>& mat, bool no_diag) const;
+
+		/** Sparse matrix rowwise sum method */
+		template <typename T>
+		SGVector<T>
+		rowwise_sum_impl(const SGSparseMatrix<T>& mat, bool no_diag) const;
+
 		/** Eigen3 compute svd method */
 		template <typename T>
 		void svd_impl(
@@ -1631,6 +1631,232 @@ namespace shogun
 			return result;
 		}
 
+		/** Performs the operation of a sparse matrix multiplies a vector
+		 * \f$x = Ab\f$.
+		 * The sparse matrix is treated as a num_vectors x num_features
+		 * matrix, i.e. each sparse vector is one of its rows.
+		 * This operation works with CPU backends only.
+		 *
+		 * This version returns the result in-place.
+		 * User should pass an appropriately allocated memory vector.
+		 *
+		 * @param A The sparse matrix
+		 * @param b The vector
+		 * @param result Result vector
+		 * @param transpose Whether to transpose the matrix. Default false
+		 */
+		template <typename T>
+		void matrix_prod(
+		    const SGSparseMatrix<T>& A, const SGVector<T>& b,
+		    SGVector<T>& result, bool transpose = false)
+		{
+			const index_t rows = transpose ? A.num_features : A.num_vectors;
+			const index_t cols = transpose ? A.num_vectors : A.num_features;
+			require(
+			    cols == b.vlen,
+			    "Column number of Matrix A ({}) doesn't match length of "
+			    "vector b ({}).",
+			    cols, b.vlen);
+			require(
+			    result.vlen == rows,
+			    "Length of vector result ({}) doesn't match row number of "
+			    "Matrix A ({}).",
+			    result.vlen, rows);
+			require(
+			    !b.on_gpu() && !result.on_gpu(),
+			    "Sparse matrix products only work on CPU.");
+
+			env()->linalg()->get_cpu_backend()->matrix_prod(
+			    A, b, result, transpose, false);
+		}
+
+		/** Performs the operation of a sparse matrix multiplies a vector
+		 * \f$x = Ab\f$.
+		 * This version returns the result in a newly created vector.
+		 *
+		 * @see linalg::matrix_prod
+		 *
+		 * @param A The sparse matrix
+		 * @param b The vector
+		 * @param transpose Whether to transpose the matrix. Default false
+		 * @return result Result vector
+		 */
+		template <typename T>
+		SGVector<T> matrix_prod(
+		    const SGSparseMatrix<T>& A, const SGVector<T>& b,
+		    bool transpose = false)
+		{
+			SGVector<T> result(transpose ? A.num_features : A.num_vectors);
+			matrix_prod(A, b, result, transpose);
+			return result;
+		}
+
+		/** Performs the operation C = A * B where A is a sparse and B a
+		 * dense matrix.
+		 * The sparse matrix is treated as a num_vectors x num_features
+		 * matrix, i.e. each sparse vector is one of its rows.
+		 * This operation works with CPU backends only.
+		 *
+		 * This version returns the result in-place.
+		 * User should pass an appropriately allocated memory matrix
+		 *
+		 * @param A Sparse matrix
+		 * @param B Dense matrix
+		 * @param result Result matrix
+		 * @param transpose_A whether to transpose matrix A
+		 * @param transpose_B whether to transpose matrix B
+		 */
+		template <typename T>
+		void matrix_prod(
+		    const SGSparseMatrix<T>& A, const SGMatrix<T>& B,
+		    SGMatrix<T>& result, bool transpose_A = false,
+		    bool transpose_B = false)
+		{
+			const index_t rows_A =
+			    transpose_A ? A.num_features : A.num_vectors;
+			const index_t cols_A =
+			    transpose_A ? A.num_vectors : A.num_features;
+			const index_t rows_B = transpose_B ? B.num_cols : B.num_rows;
+			const index_t cols_B = transpose_B ? B.num_rows : B.num_cols;
+			require(
+			    cols_A == rows_B,
+			    "Number of columns for A ({}) and number of rows for B ({}) "
+			    "should be equal!",
+			    cols_A, rows_B);
+			require(
+			    result.num_rows == rows_A && result.num_cols == cols_B,
+			    "Dimensions of result ({}x{}) should be {}x{}!",
+			    result.num_rows, result.num_cols, rows_A, cols_B);
+			require(
+			    !B.on_gpu() && !result.on_gpu(),
+			    "Sparse matrix products only work on CPU.");
+
+			env()->linalg()->get_cpu_backend()->matrix_prod(
+			    A, B, result, transpose_A, transpose_B);
+		}
+
+		/** Performs the operation C = A * B where A is a sparse and B a
+		 * dense matrix.
+		 * This version returns the result in a newly created matrix.
+		 *
+		 * @see linalg::matrix_prod
+		 *
+		 * @param A Sparse matrix
+		 * @param B Dense matrix
+		 * @param transpose_A whether to transpose matrix A
+		 * @param transpose_B whether to transpose matrix B
+		 * @return The result of the operation
+		 */
+		template <typename T>
+		SGMatrix<T> matrix_prod(
+		    const SGSparseMatrix<T>& A, const SGMatrix<T>& B,
+		    bool transpose_A = false, bool transpose_B = false)
+		{
+			SGMatrix<T> result(
+			    transpose_A ? A.num_features : A.num_vectors,
+			    transpose_B ? B.num_rows : B.num_cols);
+			matrix_prod(A, B, result, transpose_A, transpose_B);
+			return result;
+		}
+
+		/** Performs the operation C = A * B where A is a dense and B a
+		 * sparse matrix.
+		 * The sparse matrix is treated as a num_vectors x num_features
+		 * matrix, i.e. each sparse vector is one of its rows.
+		 * This operation works with CPU backends only.
+		 *
+		 * This version returns the result in-place.
+		 * User should pass an appropriately allocated memory matrix
+		 *
+		 * @param A Dense matrix
+		 * @param B Sparse matrix
+		 * @param result Result matrix
+		 * @param transpose_A whether to transpose matrix A
+		 * @param transpose_B whether to transpose matrix B
+		 */
+		template <typename T>
+		void matrix_prod(
+		    const SGMatrix<T>& A, const SGSparseMatrix<T>& B,
+		    SGMatrix<T>& result, bool transpose_A = false,
+		    bool transpose_B = false)
+		{
+			const index_t rows_A = transpose_A ? A.num_cols : A.num_rows;
+			const index_t cols_A = transpose_A ? A.num_rows : A.num_cols;
+			const index_t rows_B =
+			    transpose_B ? B.num_features : B.num_vectors;
+			const index_t cols_B =
+			    transpose_B ? B.num_vectors : B.num_features;
+			require(
+			    cols_A == rows_B,
+			    "Number of columns for A ({}) and number of rows for B ({}) "
+			    "should be equal!",
+			    cols_A, rows_B);
+			require(
+			    result.num_rows == rows_A && result.num_cols == cols_B,
+			    "Dimensions of result ({}x{}) should be {}x{}!",
+			    result.num_rows, result.num_cols, rows_A, cols_B);
+			require(
+			    !A.on_gpu() && !result.on_gpu(),
+			    "Sparse matrix products only work on CPU.");
+
+			env()->linalg()->get_cpu_backend()->matrix_prod(
+			    A, B, result, transpose_A, transpose_B);
+		}
+
+		/** Performs the operation C = A * B where A is a dense and B a
+		 * sparse matrix.
+		 * This version returns the result in a newly created matrix.
+		 *
+		 * @see linalg::matrix_prod
+		 *
+		 * @param A Dense matrix
+		 * @param B Sparse matrix
+		 * @param transpose_A whether to transpose matrix A
+		 * @param transpose_B whether to transpose matrix B
+		 * @return The result of the operation
+		 */
+		template <typename T>
+		SGMatrix<T> matrix_prod(
+		    const SGMatrix<T>& A, const SGSparseMatrix<T>& B,
+		    bool transpose_A = false, bool transpose_B = false)
+		{
+			SGMatrix<T> result(
+			    transpose_A ? A.num_cols : A.num_rows,
+			    transpose_B ? B.num_vectors : B.num_features);
+			matrix_prod(A, B, result, transpose_A, transpose_B);
+			return result;
+		}
+
+		/** Performs the operation C = A * B of two sparse matrices.
+		 * The sparse matrices are treated as num_vectors x num_features
+		 * matrices, i.e. each sparse vector is one of their rows.
+		 * This operation works with CPU backends only.
+		 *
+		 * @param A First sparse matrix
+		 * @param B Second sparse matrix
+		 * @param transpose_A whether to transpose matrix A
+		 * @param transpose_B whether to transpose matrix B
+		 * @return The sparse result of the operation
+		 */
+		template <typename T>
+		SGSparseMatrix<T> matrix_prod(
+		    const SGSparseMatrix<T>& A, const SGSparseMatrix<T>& B,
+		    bool transpose_A = false, bool transpose_B = false)
+		{
+			const index_t cols_A =
+			    transpose_A ? A.num_vectors : A.num_features;
+			const index_t rows_B =
+			    transpose_B ? B.num_features : B.num_vectors;
+			require(
+			    cols_A == rows_B,
+			    "Number of columns for A ({}) and number of rows for B ({}) "
+			    "should be equal!",
+			    cols_A, rows_B);
+
+			return env()->linalg()->get_cpu_backend()->matrix_prod(
+			    A, B, transpose_A, transpose_B);
+		}
+
 		/**
 		 * Performs the operation y = \alpha ax + \beta y
 		 * This function multiplies a * x (after transposing a, if needed)
@@ -1825,7 +2051,6 @@ namespace shogun
 				auto max_it = std::max_element(a_copy.begin(), a_copy.begin() + n);
 				result = (a_copy[n] + *max_it) / 2;
 			}
-		}
 
 			return result;
 		}
@@ -1843,6 +2068,25 @@ namespace shogun
 			return std::sqrt(dot(a, a));
 		}
 
+		/**
+		 * Method that computes the squared euclidean norm of every column
+		 * of a dense matrix.
+		 *
+		 * @param mat SGMatrix
+		 * @return The squared column norms \f$s_j=\sum_{i}a_{i,j}^2\f$
+		 */
+		template <typename T>
+		SGVector<T> colwise_squared_norm(const SGMatrix<T>& mat)
+		{
+			SGVector<T> norms(mat.num_cols);
+			for (index_t j = 0; j < mat.num_cols; ++j)
+			{
+				SGVector<T> col(mat.get_column_vector(j), mat.num_rows, false);
+				norms[j] = dot(col, col);
+			}
+			return norms;
+		}
+
 		/**
 		 * Solve the linear equations \f$Ax=b\f$ through the
 		 * QR decomposition of A.
@@ -1956,6 +2200,60 @@ namespace shogun
 			infer_backend(A, result)->scale(A, alphas, result);
 		}
 
+		/**
+		 * Performs the operation result = alpha * A on sparse matrices
+		 * This operation works with CPU backends only.
+		 * This version returns the result in-place.
+		 * User should pass a sparse matrix with the same number of entries
+		 * in each sparse vector as A, or pass A as result
+		 *
+		 * @param A Sparse matrix
+		 * @param alpha Scale factor
+		 * @param result The sparse matrix of alpha * A
+		 */
+		template <typename T>
+		void
+		scale(const SGSparseMatrix<T>& A, SGSparseMatrix<T>& result, T alpha = 1)
+		{
+			require(
+			    A.num_vectors == result.num_vectors &&
+			        A.num_features == result.num_features,
+			    "Dimensions of sparse matrix A ({}x{}) must match sparse "
+			    "matrix result ({}x{}).",
+			    A.num_vectors, A.num_features, result.num_vectors,
+			    result.num_features);
+			for (index_t i = 0; i < A.num_vectors; ++i)
+			{
+				require(
+				    A.sparse_matrix[i].num_feat_entries ==
+				        result.sparse_matrix[i].num_feat_entries,
+				    "Number of entries of sparse vector {} in A ({}) must "
+				    "match result ({}).",
+				    i, A.sparse_matrix[i].num_feat_entries,
+				    result.sparse_matrix[i].num_feat_entries);
+			}
+			env()->linalg()->get_cpu_backend()->scale(A, alpha, result);
+		}
+
+		/**
+		 * Performs the operation B = alpha * A on sparse matrices
+		 * This version returns the result in a newly created sparse matrix.
+		 *
+		 * @param A Sparse matrix
+		 * @param alpha Scale factor
+		 * @return Sparse matrix of alpha * A
+		 */
+		template <typename T>
+		SGSparseMatrix<T> scale(const SGSparseMatrix<T>& A, T alpha = 1)
+		{
+			SGSparseMatrix<T> result(A.num_features, A.num_vectors);
+			for (index_t i = 0; i < A.num_vectors; ++i)
+				result.sparse_matrix[i] =
+				    SGSparseVector<T>(A.sparse_matrix[i].num_feat_entries);
+			scale(A, result, alpha);
+			return result;
+		}
+
 		/**
 		 * Performs the operation B = alpha * A on vectors or matrices
 		 * This version returns the result in a newly created vector or matrix.
@@ -2113,6 +2411,44 @@ namespace shogun
 			return env()->linalg()->get_cpu_backend()->rowwise_sum(a, no_diag);
 		}
 
+		/**
+		 * Method that computes colwise sum of co-efficients of a sparse
+		 * matrix, treated as a num_vectors x num_features matrix.
+		 * This operation works with CPU backends only.
+		 *
+		 * @param mat a sparse matrix whose colwise sum has to be computed
+		 * @param no_diag If true, diagonal entries are excluded from the sum.
+		 * Default: false
+		 * @return the colwise sum of co-efficients computed as
+		 * \f$s_j=\sum_{i}m_{i,j}\f$
+		 */
+		template <typename T>
+		SGVector<T>
+		colwise_sum(const SGSparseMatrix<T>& mat, bool no_diag = false)
+		{
+			return env()->linalg()->get_cpu_backend()->colwise_sum(
+			    mat, no_diag);
+		}
+
+		/**
+		 * Method that computes rowwise sum of co-efficients of a sparse
+		 * matrix, i.e. the sum of each sparse vector.
+		 * This operation works with CPU backends only.
+		 *
+		 * @param mat a sparse matrix whose rowwise sum has to be computed
+		 * @param no_diag If true, diagonal entries are excluded from the sum.
+		 * Default: false
+		 * @return the rowwise sum of co-efficients computed as
+		 * \f$s_i=\sum_{j}m_{i,j}\f$
+		 */
+		template <typename T>
+		SGVector<T>
+		rowwise_sum(const SGSparseMatrix<T>& mat, bool no_diag = false)
+		{
+			return env()->linalg()->get_cpu_backend()->rowwise_sum(
+			    mat, no_diag);
+		}
+
 		/**
 		 * Compute the singular value decomposition \f$A = U S V^{*}\f$ of a
 		 * matrix.
@@ -0,0 +1,219 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/lib/SGSparseVector.h>
+#include <shogun/mathematics/linalg/LinalgBackendEigen.h>
+#include <shogun/mathematics/linalg/LinalgMacros.h>
+
+using namespace shogun;
+
+#define BACKEND_GENERIC_IN_PLACE_SPARSE_MATRIX_PROD(Type, Container)           \
+	void LinalgBackendEigen::matrix_prod(                                      \
+	    const SGSparseMatrix<Type>& a, const Container<Type>& b,               \
+	    Container<Type>& result, bool transpose_A, bool transpose_B) const     \
+	{                                                                          \
+		matrix_prod_impl(a, b, result, transpose_A, transpose_B);              \
+	}
+DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_IN_PLACE_SPARSE_MATRIX_PROD, SGVector)
+DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_IN_PLACE_SPARSE_MATRIX_PROD, SGMatrix)
+#undef BACKEND_GENERIC_IN_PLACE_SPARSE_MATRIX_PROD
+
+#define BACKEND_GENERIC_IN_PLACE_DENSE_SPARSE_MATRIX_PROD(Type, Container)     \
+	void LinalgBackendEigen::matrix_prod(                                      \
+	    const Container<Type>& a, const SGSparseMatrix<Type>& b,               \
+	    Container<Type>& result, bool transpose_A, bool transpose_B) const     \
+	{                                                                          \
+		matrix_prod_impl(a, b, result, transpose_A, transpose_B);              \
+	}
+DEFINE_FOR_NON_INTEGER_PTYPE(
+    BACKEND_GENERIC_IN_PLACE_DENSE_SPARSE_MATRIX_PROD, SGMatrix)
+#undef BACKEND_GENERIC_IN_PLACE_DENSE_SPARSE_MATRIX_PROD
+
+#define BACKEND_GENERIC_SPARSE_SPARSE_MATRIX_PROD(Type, Container)             \
+	Container<Type> LinalgBackendEigen::matrix_prod(                           \
+	    const Container<Type>& a, const Container<Type>& b, bool transpose_A,  \
+	    bool transpose_B) const                                                \
+	{                                                                          \
+		return matrix_prod_impl(a, b, transpose_A, transpose_B);               \
+	}
+DEFINE_FOR_NON_INTEGER_PTYPE(
+    BACKEND_GENERIC_SPARSE_SPARSE_MATRIX_PROD, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_SPARSE_MATRIX_PROD
+
+#define BACKEND_GENERIC_IN_PLACE_SPARSE_SCALE(Type, Container)                 \
+	void LinalgBackendEigen::scale(                                            \
+	    const Container<Type>& a, Type alpha, Container<Type>& result) const   \
+	{                                                                          \
+		scale_impl(a, alpha, result);                                          \
+	}
+DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_IN_PLACE_SPARSE_SCALE, SGSparseMatrix)
+#undef BACKEND_GENERIC_IN_PLACE_SPARSE_SCALE
+
+#define BACKEND_GENERIC_SPARSE_COLWISE_SUM(Type, Container)                    \
+	SGVector<Type> LinalgBackendEigen::colwise_sum(                            \
+	    const Container<Type>& a, bool no_diag) const                          \
+	{                                                                          \
+		return colwise_sum_impl(a, no_diag);                                   \
+	}
+DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_SPARSE_COLWISE_SUM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_COLWISE_SUM
+
+#define BACKEND_GENERIC_SPARSE_ROWWISE_SUM(Type, Container)                    \
+	SGVector<Type> LinalgBackendEigen::rowwise_sum(                            \
+	    const Container<Type>& a, bool no_diag) const                          \
+	{                                                                          \
+		return rowwise_sum_impl(a, no_diag);                                   \
+	}
+DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_SPARSE_ROWWISE_SUM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_ROWWISE_SUM
+
+#undef DEFINE_FOR_ALL_PTYPE
+#undef DEFINE_FOR_NON_COMPLEX_PTYPE
+#undef DEFINE_FOR_NON_INTEGER_PTYPE
+#undef DEFINE_FOR_NUMERIC_PTYPE
+#undef DEFINE_FOR_ALL_PTYPE_EXCEPT_FLOAT64
+
+template <typename T>
+void LinalgBackendEigen::matrix_prod_impl(
+    const SGSparseMatrix<T>& a, const SGVector<T>& b, SGVector<T>& result,
+    bool transpose, bool transpose_B) const
+{
+	const Eigen::SparseMatrix<T> a_eig = EigenSparseUtil<T>::toEigenSparse(a);
+	typename SGVector<T>::EigenVectorXtMap b_eig = b;
+	typename SGVector<T>::EigenVectorXtMap result_eig = result;
+
+	if (transpose)
+		result_eig = a_eig.transpose() * b_eig;
+	else
+		result_eig = a_eig * b_eig;
+}
+
+template <typename T>
+void LinalgBackendEigen::matrix_prod_impl(
+    const SGSparseMatrix<T>& a, const SGMatrix<T>& b, SGMatrix<T>& result,
+    bool transpose_A, bool transpose_B) const
+{
+	const Eigen::SparseMatrix<T> a_eig = EigenSparseUtil<T>::toEigenSparse(a);
+	typename SGMatrix<T>::EigenMatrixXtMap b_eig = b;
+	typename SGMatrix<T>::EigenMatrixXtMap result_eig = result;
+
+	if (transpose_A && transpose_B)
+		result_eig = a_eig.transpose() * b_eig.transpose();
+
+	else if (transpose_A)
+		result_eig = a_eig.transpose() * b_eig;
+
+	else if (transpose_B)
+		result_eig = a_eig * b_eig.transpose();
+
+	else
+		result_eig = a_eig * b_eig;
+}
+
+template <typename T>
+void LinalgBackendEigen::matrix_prod_impl(
+    const SGMatrix<T>& a, const SGSparseMatrix<T>& b, SGMatrix<T>& result,
+    bool transpose_A, bool transpose_B) const
+{
+	typename SGMatrix<T>::EigenMatrixXtMap a_eig = a;
+	const Eigen::SparseMatrix<T> b_eig = EigenSparseUtil<T>::toEigenSparse(b);
+	typename SGMatrix<T>::EigenMatrixXtMap result_eig = result;
+
+	if (transpose_A && transpose_B)
+		result_eig = a_eig.transpose() * b_eig.transpose();
+
+	else if (transpose_A)
+		result_eig = a_eig.transpose() * b_eig;
+
+	else if (transpose_B)
+		result_eig = a_eig * b_eig.transpose();
+
+	else
+		result_eig = a_eig * b_eig;
+}
+
+template <typename T>
+SGSparseMatrix<T> LinalgBackendEigen::matrix_prod_impl(
+    const SGSparseMatrix<T>& a, const SGSparseMatrix<T>& b, bool transpose_A,
+    bool transpose_B) const
+{
+	const Eigen::SparseMatrix<T> a_eig = EigenSparseUtil<T>::toEigenSparse(a);
+	const Eigen::SparseMatrix<T> b_eig = EigenSparseUtil<T>::toEigenSparse(b);
+	Eigen::SparseMatrix<T> result_eig;
+
+	if (transpose_A && transpose_B)
+		result_eig = a_eig.transpose() * b_eig.transpose();
+
+	else if (transpose_A)
+		result_eig = a_eig.transpose() * b_eig;
+
+	else if (transpose_B)
+		result_eig = a_eig * b_eig.transpose();
+
+	else
+		result_eig = a_eig * b_eig;
+
+	return EigenSparseUtil<T>::fromEigenSparse(result_eig);
+}
+
+template <typename T>
+void LinalgBackendEigen::scale_impl(
+    const SGSparseMatrix<T>& a, T alpha, SGSparseMatrix<T>& result) const
+{
+	for (index_t i = 0; i < a.num_vectors; ++i)
+	{
+		const SGSparseVector<T>& vec = a.sparse_matrix[i];
+		SGSparseVector<T>& result_vec = result.sparse_matrix[i];
+
+		for (index_t k = 0; k < vec.num_feat_entries; ++k)
+		{
+			result_vec.features[k].feat_index = vec.features[k].feat_index;
+			result_vec.features[k].entry = alpha * vec.features[k].entry;
+		}
+	}
+}
+
+template <typename T>
+SGVector<T> LinalgBackendEigen::colwise_sum_impl(
+    const SGSparseMatrix<T>& mat, bool no_diag) const
+{
+	SGVector<T> result(mat.num_features);
+	result.zero();
+
+	for (index_t i = 0; i < mat.num_vectors; ++i)
+	{
+		const SGSparseVector<T>& vec = mat.sparse_matrix[i];
+		for (index_t k = 0; k < vec.num_feat_entries; ++k)
+		{
+			const index_t j = vec.features[k].feat_index;
+			if (!no_diag || i != j)
+				result[j] += vec.features[k].entry;
+		}
+	}
+
+	return result;
+}
+
+template <typename T>
+SGVector<T> LinalgBackendEigen::rowwise_sum_impl(
+    const SGSparseMatrix<T>& mat, bool no_diag) const
+{
+	SGVector<T> result(mat.num_vectors);
+
+	for (index_t i = 0; i < mat.num_vectors; ++i)
+	{
+		const SGSparseVector<T>& vec = mat.sparse_matrix[i];
+		T sum = 0;
+		for (index_t k = 0; k < vec.num_feat_entries; ++k)
+		{
+			if (!no_diag || vec.features[k].feat_index != i)
+				sum += vec.features[k].entry;
+		}
+		result[i] = sum;
+	}
+
+	return result;
+}
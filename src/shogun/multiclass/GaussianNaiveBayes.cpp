@@ -158,6 +158,7 @@ bool GaussianNaiveBayes::train_machine(std::shared_ptr<Features> data)
 
 std::shared_ptr<MulticlassLabels> GaussianNaiveBayes::apply_multiclass(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	if (data)
 		set_features(data);
 
@@ -180,6 +181,7 @@ std::shared_ptr<MulticlassLabels> GaussianNaiveBayes::apply_multiclass(std::shar
 
 float64_t GaussianNaiveBayes::apply_one(int32_t idx)
 {
+	load_lazy_parameters();
 	// get [idx] feature vector
 	SGVector<float64_t> feature_vector = m_features->get_computed_dot_feature_vector(idx);
 
@@ -7,20 +7,32 @@
  */
 
 #include <shogun/base/progress.h>
+#include <shogun/features/DenseFeatures.h>
 #include <shogun/labels/Labels.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/Time.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/multiclass/KNN.h>
+#include <shogun/multiclass/tree/KNNHeap.h>
 
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 #include <utility>
+#include <vector>
 
 //#define DEBUG_KNN
 
 using namespace shogun;
 
+namespace
+{
+	/** number of test vectors handled by a thread at once */
+	const index_t KNN_TEST_BLOCK_SIZE = 256;
+	/** number of training vectors whose distances to a block of test
+	 * vectors are computed by a single matrix product */
+	const index_t KNN_TRAIN_BLOCK_SIZE = 2048;
+}
+
 KNN::KNN()
 : DistanceMachine()
 {
@@ -115,6 +127,9 @@ SGMatrix<index_t> KNN::nearest_neighbors()
 	    n >= m_k,
 	    "K ({}) must not be larger than the number of examples ({}).", m_k, n);
 
+	if (use_blocked_nearest_neighbors())
+		return nearest_neighbors_blocked();
+
 	//distances to train data
 	SGVector<float64_t> dists(m_train_labels.vlen);
 	//indices to train data
@@ -156,8 +171,132 @@ SGMatrix<index_t> KNN::nearest_neighbors()
 	return NN;
 }
 
+bool KNN::use_blocked_nearest_neighbors() const
+{
+	auto type = distance->get_distance_type();
+	if (type != D_EUCLIDEAN && type != D_COSINE)
+		return false;
+
+	for (const auto& feats : {distance->get_lhs(), distance->get_rhs()})
+	{
+		if (!feats || feats->get_feature_class() != C_DENSE ||
+		    feats->get_feature_type() != F_DREAL)
+			return false;
+	}
+	return true;
+}
+
+SGMatrix<index_t> KNN::nearest_neighbors_blocked()
+{
+	// copies the vectors if subsets or preprocessors have to be applied
+	auto lhs = distance->get_lhs()->as<DenseFeatures<float64_t>>();
+	auto rhs = distance->get_rhs()->as<DenseFeatures<float64_t>>();
+	auto train = lhs->get_feature_matrix_block(0, lhs->get_num_vectors());
+	auto test = rhs->get_feature_matrix_block(0, rhs->get_num_vectors());
+	require(
+	    train.num_rows == test.num_rows,
+	    "Dimension of training ({}) and test ({}) vectors differ.",
+	    train.num_rows, test.num_rows);
+
+	const bool cosine = distance->get_distance_type() == D_COSINE;
+	const index_t num_train = train.num_cols;
+	const index_t num_test = test.num_cols;
+	const index_t dim = train.num_rows;
+	const index_t num_blocks =
+	    (num_test + KNN_TEST_BLOCK_SIZE - 1) / KNN_TEST_BLOCK_SIZE;
+
+	auto train_norms = linalg::colwise_squared_norm(train);
+	auto test_norms = linalg::colwise_squared_norm(test);
+
+	// blocks skipped after a cancellation still yield valid indices
+	SGMatrix<index_t> NN(m_k, num_test);
+	NN.zero();
+
+	auto pb = SG_PROGRESS(range(num_blocks));
+#pragma omp parallel
+	{
+		// inner products of a block of train and a block of test vectors,
+		// this is the only buffer that grows with the number of vectors
+		SGMatrix<float64_t> products(
+		    std::min(KNN_TRAIN_BLOCK_SIZE, num_train),
+		    std::min(KNN_TEST_BLOCK_SIZE, num_test));
+		std::vector<KNNHeap> heaps;
+		heaps.reserve(products.num_cols);
+
+#pragma omp for schedule(dynamic)
+		for (index_t block = 0; block < num_blocks; ++block)
+		{
+			if (cancel_computation())
+				continue;
+
+			const index_t test_start = block * KNN_TEST_BLOCK_SIZE;
+			const index_t test_len =
+			    std::min(KNN_TEST_BLOCK_SIZE, num_test - test_start);
+			SGMatrix<float64_t> test_block(
+			    test.get_column_vector(test_start), dim, test_len, false);
+
+			heaps.clear();
+			for (index_t j = 0; j < test_len; ++j)
+				heaps.emplace_back(m_k);
+
+			for (index_t train_start = 0; train_start < num_train;
+			     train_start += KNN_TRAIN_BLOCK_SIZE)
+			{
+				const index_t train_len =
+				    std::min(KNN_TRAIN_BLOCK_SIZE, num_train - train_start);
+				SGMatrix<float64_t> train_block(
+				    train.get_column_vector(train_start), dim, train_len,
+				    false);
+				SGMatrix<float64_t> block_products(
+				    products.matrix, train_len, test_len, false);
+				linalg::matrix_prod(
+				    train_block, test_block, block_products, true, false);
+
+				for (index_t j = 0; j < test_len; ++j)
+				{
+					const float64_t test_norm = test_norms[test_start + j];
+					const float64_t* column =
+					    block_products.get_column_vector(j);
+					for (index_t i = 0; i < train_len; ++i)
+					{
+						const float64_t train_norm =
+						    train_norms[train_start + i];
+						float64_t dist;
+						if (cosine)
+						{
+							// same as CosineDistance::compute
+							float64_t s =
+							    std::sqrt(train_norm) * std::sqrt(test_norm);
+							dist = s == 0 ? 0 : 1 - column[i] / s;
+						}
+						else
+						{
+							// squared euclidean distance, which yields the
+							// same neighbors
+							dist = train_norm + test_norm - 2 * column[i];
+						}
+						heaps[j].push(train_start + i, std::max(dist, 0.0));
+					}
+				}
+			}
+
+			for (index_t j = 0; j < test_len; ++j)
+			{
+				auto indices = heaps[j].get_indices();
+				for (int32_t l = 0; l < m_k; ++l)
+					NN(l, test_start + j) = indices[l];
+			}
+			pb.print_progress();
+		}
+	}
+	pb.complete();
+
+	return NN;
+}
+
 std::shared_ptr<MulticlassLabels> KNN::apply_multiclass(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	if (data)
 		init_distance(data);
 
@@ -198,6 +337,16 @@ std::shared_ptr<MulticlassLabels> KNN::classify_NN()
 
 	io::info("{} test examples", num_lab);
 
+	if (use_blocked_nearest_neighbors())
+	{
+		SGMatrix<index_t> NN = nearest_neighbors_blocked();
+		// like the serial loop below, stop labelling once cancelled
+		for (int32_t i = 0; i < num_lab && !cancel_computation(); i++)
+			output->set_label(i, m_train_labels.vector[NN(0, i)] + m_min_label);
+
+		return output;
+	}
+
 	distance->precompute_lhs();
 
 	// for each test example
@@ -304,11 +453,11 @@ void KNN::init_solver(KNN_SOLVER knn_solver)
 	{
 #ifdef USE_GPL_SHOGUN
 		solver = std::make_shared<CoverTreeKNNSolver>(m_k, m_q, m_num_classes, m_min_label, m_train_labels);
-
-		break;
 #else
-		gpl_only(SOURCE_LOCATION);
+		solver = std::make_shared<MetricCoverTreeKNNSolver>(m_k, m_q, m_num_classes, m_min_label, m_train_labels);
 #endif // USE_GPL_SHOGUN
+
+		break;
 	}
 	case KNN_LSH:
 	{
@@ -22,6 +22,8 @@
 #include <shogun/multiclass/KDTreeKNNSolver.h>
 #ifdef USE_GPL_SHOGUN
 #include <shogun/multiclass/CoverTreeKNNSolver.h>
+#else
+#include <shogun/multiclass/MetricCoverTreeKNNSolver.h>
 #endif
 #include <shogun/multiclass/LSHKNNSolver.h>
 
@@ -267,6 +269,23 @@ class KNN : public DistanceMachine
 		 */
 		void init_solver(KNN_SOLVER knn_solver);
 
+		/** @return whether nearest_neighbors_blocked() supports the distance
+		 * and its features, i.e. euclidean or cosine distance on dense
+		 * real-valued features
+		 */
+		bool use_blocked_nearest_neighbors() const;
+
+		/** same as nearest_neighbors(), but computes the distances between
+		 * blocks of test and training vectors at once from their inner
+		 * products with a matrix product. Test blocks are processed in
+		 * parallel and only a block of distances is kept in memory at a
+		 * time, the k nearest neighbors of each test vector are collected
+		 * in a KNNHeap.
+		 *
+		 * @return matrix with indices to the nearest neighbors
+		 */
+		SGMatrix<index_t> nearest_neighbors_blocked();
+
 	protected:
 		/// the k parameter in KNN
 		int32_t m_k;
@@ -79,6 +79,7 @@ void MCLDA::cleanup()
 
 std::shared_ptr<MulticlassLabels> MCLDA::apply_multiclass(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	if (data)
 	{
 		if (!data->has_property(FP_DOT))
@@ -0,0 +1,72 @@
+/* This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/multiclass/MetricCoverTreeKNNSolver.h>
+#include <shogun/lib/Signal.h>
+
+using namespace shogun;
+
+MetricCoverTreeKNNSolver::MetricCoverTreeKNNSolver(const int32_t k, const float64_t q, const int32_t num_classes, const int32_t min_label, const SGVector<int32_t> train_labels):
+KNNSolver(k, q, num_classes, min_label, train_labels)
+{
+}
+
+void MetricCoverTreeKNNSolver::query_knn(std::shared_ptr<Distance> knn_distance, MetricCoverTree& tree) const
+{
+	auto lhs = knn_distance->get_lhs();
+
+	// the tree is built from distances among the training vectors, the
+	// distance stays initialized and only its rhs is swapped temporarily
+	auto rhs_cache = knn_distance->replace_rhs(lhs);
+	tree.build_tree(lhs->get_num_vectors(), [&knn_distance](index_t a, index_t b) {
+		return knn_distance->distance(a, b);
+	});
+	knn_distance->replace_rhs(rhs_cache);
+
+	tree.query_knn(rhs_cache->get_num_vectors(), m_k, [&knn_distance](index_t a, index_t b) {
+		return knn_distance->distance(a, b);
+	});
+}
+
+std::shared_ptr<MulticlassLabels> MetricCoverTreeKNNSolver::classify_objects(std::shared_ptr<Distance> knn_distance, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<float64_t>& classes) const
+{
+	auto output=std::make_shared<MulticlassLabels>(num_lab);
+
+	MetricCoverTree tree;
+	query_knn(knn_distance, tree);
+	SGMatrix<index_t> NN = tree.get_knn_indices();
+	for (int32_t i = 0; i < num_lab && (!cancel_computation()); i++)
+	{
+		//write the labels of the k nearest neighbors from theirs indices
+		for (int32_t j=0; j<m_k; j++)
+			train_lab[j] = m_train_labels[ NN(j,i) ];
+
+		//get the index of the 'nearest' class
+		int32_t out_idx = choose_class(classes.vector, train_lab.vector);
+		//write the label of 'nearest' in the output
+		output->set_label(i, out_idx + m_min_label);
+	}
+	return output;
+}
+
+SGVector<int32_t> MetricCoverTreeKNNSolver::classify_objects_k(std::shared_ptr<Distance> knn_distance, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<int32_t>& classes) const
+{
+	SGVector<int32_t> output(m_k*num_lab);
+
+	MetricCoverTree tree;
+	query_knn(knn_distance, tree);
+	// neighbors are already ordered by increasing distance
+	SGMatrix<index_t> NN = tree.get_knn_indices();
+	for (index_t i = 0; i < num_lab && (!cancel_computation()); i++)
+	{
+		//write the labels of the k nearest neighbors from theirs indices
+		for (index_t j=0; j<m_k; j++)
+			train_lab[j] = m_train_labels[ NN(j,i) ];
+
+		choose_class_for_multiple_k(output.vector+i, classes.vector, train_lab.vector, num_lab);
+	}
+
+	return output;
+}
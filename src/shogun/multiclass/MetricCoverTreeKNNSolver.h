@@ -0,0 +1,67 @@
+/* This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#ifndef METRICCOVERTREEKNNSOLVER_H__
+#define METRICCOVERTREEKNNSOLVER_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/distance/Distance.h>
+#include <shogun/multiclass/KNNSolver.h>
+#include <shogun/multiclass/tree/MetricCoverTree.h>
+
+namespace shogun
+{
+
+/**
+ * Cover tree solver. It builds a cover tree over the training vectors and
+ * uses it to find the exact nearest neighbours of the test vectors, see
+ * MetricCoverTree.
+ *
+ * Unlike KDTREEKNNSolver, the tree only relies on the triangle inequality,
+ * hence it works with any Distance that is a metric (e.g. Chi2Distance,
+ * JensenMetric, ManhattanMetric) and any features that distance supports.
+ * Test vectors are queried in parallel.
+ */
+class MetricCoverTreeKNNSolver : public KNNSolver
+{
+	public:
+		/** default constructor */
+		MetricCoverTreeKNNSolver() : KNNSolver() { }
+
+		/** deconstructor */
+		~MetricCoverTreeKNNSolver() override { /* nothing to do */ }
+
+		/** constructor
+		 *
+		 * @param k k
+		 * @param q m_q
+		 * @param num_classes m_num_classes
+		 * @param min_label m_min_label
+		 * @param train_labels m_train_labels
+		 */
+		MetricCoverTreeKNNSolver(const int32_t k, const float64_t q, const int32_t num_classes, const int32_t min_label, const SGVector<int32_t> train_labels);
+
+		std::shared_ptr<MulticlassLabels> classify_objects(std::shared_ptr<Distance> d, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<float64_t>& classes) const override;
+
+		SGVector<int32_t> classify_objects_k(std::shared_ptr<Distance> d, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<int32_t>& classes) const override;
+
+		/** @return object name */
+		const char* get_name() const override { return "MetricCoverTreeKNNSolver"; }
+
+	private:
+		/** build a cover tree over the lhs of the distance and query the
+		 * k nearest neighbours of all rhs vectors
+		 *
+		 * @param knn_distance distance initialized with training (lhs) and
+		 * test (rhs) features
+		 * @param tree the tree to build
+		 */
+		void query_knn(std::shared_ptr<Distance> knn_distance, MetricCoverTree& tree) const;
+};
+}
+
+#endif
@@ -90,6 +90,8 @@ bool MulticlassLibSVM::train_machine(std::shared_ptr<Features> data)
 	param.nu = get_nu(); // Nu
 	param.kernel=m_kernel.get();
 	param.cache_size = m_kernel->get_cache_size();
+	param.cache_precision = m_kernel->get_cache_precision();
+	param.prefetch_size = 0;
 	param.max_train_time = m_max_train_time;
 	param.C = get_C();
 	param.eps = get_epsilon();
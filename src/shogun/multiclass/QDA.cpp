@@ -107,6 +107,7 @@ void QDA::cleanup()
 
 std::shared_ptr<MulticlassLabels> QDA::apply_multiclass(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	if (data)
 	{
 		if (!data->has_property(FP_DOT))
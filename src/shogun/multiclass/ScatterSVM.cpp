@@ -176,6 +176,8 @@ bool ScatterSVM::train_no_bias_libsvm()
 				m_num_classes-1, -1, m_labels, prev_normalizer));
 	param.kernel=m_kernel.get();
 	param.cache_size = m_kernel->get_cache_size();
+	param.cache_precision = m_kernel->get_cache_precision();
+	param.prefetch_size = 0;
 	param.C = 0;
 	param.eps = get_epsilon();
 	param.p = 0.1;
@@ -313,6 +315,8 @@ bool ScatterSVM::train_testrule12()
 	param.nu = get_nu(); // Nu
 	param.kernel=m_kernel.get();
 	param.cache_size = m_kernel->get_cache_size();
+	param.cache_precision = m_kernel->get_cache_precision();
+	param.prefetch_size = 0;
 	param.C = 0;
 	param.eps = get_epsilon();
 	param.p = 0.1;
@@ -514,6 +518,7 @@ std::shared_ptr<Labels> ScatterSVM::classify_one_vs_rest()
 
 float64_t ScatterSVM::apply_one(int32_t num)
 {
+	load_lazy_parameters();
 	ASSERT(!m_machines.empty())
 	float64_t* outputs=SG_MALLOC(float64_t, m_machines.size());
 	int32_t winner=0;
@@ -52,6 +52,7 @@ C45ClassifierTree::~C45ClassifierTree()
 
 std::shared_ptr<MulticlassLabels> C45ClassifierTree::apply_multiclass(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	require(data, "Data required for classification in apply_multiclass");
 
 	// apply multiclass starting from root
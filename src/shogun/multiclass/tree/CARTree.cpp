@@ -29,7 +29,10 @@
  */
 
 #include <algorithm>
+#include <array>
 #include <iterator>
+#include <numeric>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/lib/View.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/RandomNamespace.h>
@@ -44,6 +47,70 @@ using namespace shogun;
 const float64_t CARTree::MISSING=Math::MAX_REAL_NUMBER;
 const float64_t CARTree::EQ_DELTA=1e-7;
 const float64_t CARTree::MIN_SPLIT_GAIN=1e-7;
+const uint8_t CARTree::MISSING_BIN=255;
+
+namespace
+{
+	/** returns the impurity of a node from its label statistics - the Gini
+	 * index of the class weights in classification, the least squares
+	 * deviation of the moments {sum w, sum w*y, sum w*y^2} in regression
+	 */
+	float64_t histogram_impurity(
+	    const float64_t* stats, index_t num_stats, bool regression,
+	    float64_t& total_weight)
+	{
+		if (regression)
+		{
+			total_weight = stats[0];
+			if (total_weight <= 0)
+				return 0;
+			float64_t mean = stats[1] / total_weight;
+			return std::max(stats[2] / total_weight - mean * mean, 0.0);
+		}
+
+		total_weight = 0;
+		float64_t sum_sq = 0;
+		for (index_t k = 0; k < num_stats; ++k)
+		{
+			total_weight += stats[k];
+			sum_sq += stats[k] * stats[k];
+		}
+		if (total_weight <= 0)
+			return 0;
+		return 1.0 - sum_sq / (total_weight * total_weight);
+	}
+
+	/** returns the total weight of label statistics */
+	float64_t histogram_weight(
+	    const float64_t* stats, index_t num_stats, bool regression)
+	{
+		if (regression)
+			return stats[0];
+		return std::accumulate(stats, stats + num_stats, 0.0);
+	}
+
+	/** split of a node found on the histogram of an attribute */
+	struct HistogramSplit
+	{
+		/** gain of the split */
+		float64_t gain = CARTree::MIN_SPLIT_GAIN;
+		/** attribute, -1 if the node is not split */
+		index_t attribute = -1;
+		/** last bin of the left child of a continuous attribute */
+		index_t last_left_bin = -1;
+		/** whether the vectors of a bin go to the left child */
+		std::array<bool, 256> is_left_bin;
+	};
+
+	/** node of the level grown in CARTtrain_binned */
+	struct BinnedNode
+	{
+		/** tree node */
+		std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>> node;
+		/** training vectors in the node */
+		std::vector<index_t> vecs;
+	};
+}
 
 CARTree::CARTree() : RandomMixin<FeatureImportanceTree<CARTreeNodeData>>()
 {
@@ -104,6 +171,7 @@ bool CARTree::is_label_valid(std::shared_ptr<Labels> lab) const
 
 std::shared_ptr<MulticlassLabels> CARTree::apply_multiclass(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	require(data, "Data required for classification in apply_multiclass");
 
 	// apply multiclass starting from root
@@ -136,6 +204,7 @@ std::shared_ptr<MulticlassLabels> CARTree::apply_multiclass(std::shared_ptr<Feat
 
 std::shared_ptr<RegressionLabels> CARTree::apply_regression(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	require(data, "Data required for classification in apply_multiclass");
 
 	// apply regression starting from root
@@ -194,6 +263,7 @@ void CARTree::clear_weights()
 void CARTree::set_feature_types(SGVector<bool> ft)
 {
 	m_nominal=ft;
+	m_compiled.clear();
 }
 
 SGVector<bool> CARTree::get_feature_types() const
@@ -204,6 +274,7 @@ SGVector<bool> CARTree::get_feature_types() const
 void CARTree::clear_feature_types()
 {
 	m_nominal=SGVector<bool>();
+	m_compiled.clear();
 }
 
 int32_t CARTree::get_num_folds() const
@@ -259,6 +330,7 @@ bool CARTree::train_machine(std::shared_ptr<Features> data)
 {
 	require(data,"Data required for training");
 	require(data->get_feature_class()==C_DENSE,"Dense data required for training");
+	m_compiled.clear();
 
 	auto dense_features = data->as<DenseFeatures<float64_t>>();
 	auto num_features = dense_features->get_num_features();
@@ -293,7 +365,41 @@ bool CARTree::train_machine(std::shared_ptr<Features> data)
 	}
 
 	auto dense_labels = m_labels->as<DenseLabels>();
-	set_root(CARTtrain(dense_features,m_weights,dense_labels,0));
+	if (m_histogram_split)
+	{
+		auto binned_feats = m_binned_features;
+		auto bin_edges = m_bin_edges;
+		if (binned_feats.num_cols == 0)
+			bin_features(dense_features, binned_feats, bin_edges);
+
+		// the bins hold all stored vectors, the training vectors are
+		// addressed by their absolute indices
+		int32_t num_stored_features, num_stored_vectors;
+		dense_features->get_feature_matrix(num_stored_features, num_stored_vectors);
+		require(
+		    binned_feats.num_cols == num_features,
+		    "Binned features have {} attributes but data has {}",
+		    binned_feats.num_cols, num_features);
+		require(
+		    binned_feats.num_rows == num_stored_vectors,
+		    "Binned features have {} vectors but data stores {}",
+		    binned_feats.num_rows, num_stored_vectors);
+		SGVector<index_t> rows(num_vectors);
+		auto subset_stack = dense_features->get_subset_stack();
+		if (subset_stack->has_subsets())
+			rows = (subset_stack->get_last_subset())->get_subset_idx();
+		else
+			linalg::range_fill(rows);
+		set_root(CARTtrain_binned(
+		    binned_feats, bin_edges, rows, m_weights, dense_labels));
+
+		// binned features are shared by the trees of an ensemble, do not
+		// keep them alive with the trained tree
+		m_binned_features = SGMatrix<uint8_t>();
+		m_bin_edges = SGMatrix<float64_t>();
+	}
+	else
+		set_root(CARTtrain(dense_features,m_weights,dense_labels,0));
 
 	if (m_apply_cv_pruning)
 	{
@@ -307,6 +413,19 @@ bool CARTree::train_machine(std::shared_ptr<Features> data)
 	return true;
 }
 
+void CARTree::set_root(std::shared_ptr<TreeMachineNode<CARTreeNodeData>> root)
+{
+	m_compiled.clear();
+	TreeMachine<CARTreeNodeData>::set_root(std::move(root));
+}
+
+void CARTree::compile()
+{
+	require(m_root, "Tree machine not yet trained.");
+	m_compiled.clear();
+	m_compiled.add_tree(get_root()->as<bnode_t>(), m_nominal);
+}
+
 SGVector<float64_t> CARTree::get_feature_importance()
 {
 	require(
@@ -342,6 +461,101 @@ void CARTree::pre_sort_features(const std::shared_ptr<Features>& data, SGMatrix<
 
 }
 
+void CARTree::set_num_bins(int32_t num_bins)
+{
+	require(
+	    num_bins > 1 && num_bins < 256,
+	    "Number of bins should be between 2 and 255. Supplied value is {}",
+	    num_bins);
+	m_num_bins = num_bins;
+}
+
+void CARTree::set_binned_features(SGMatrix<uint8_t>& binned_feats, SGMatrix<float64_t>& bin_edges)
+{
+	m_histogram_split=true;
+	m_binned_features=binned_feats;
+	m_bin_edges=bin_edges;
+}
+
+void CARTree::bin_features(const std::shared_ptr<Features>& data, SGMatrix<uint8_t>& binned_feats, SGMatrix<float64_t>& bin_edges)
+{
+	// the subset is ignored, trees are trained on subsets of the binned
+	// vectors by their absolute indices
+	int32_t num_feats, num_vecs;
+	auto matrix = data->as<DenseFeatures<float64_t>>()->get_feature_matrix(num_feats, num_vecs);
+	require(matrix, "Binning requires features with a stored feature matrix");
+	SGMatrix<float64_t> mat(matrix, num_feats, num_vecs, false);
+	require(
+	    m_nominal.vlen == 0 || m_nominal.vlen == num_feats,
+	    "Length of m_nominal vector (currently {}) should "
+	    "be same as number of features in data (presently {}).",
+	    m_nominal.vlen, num_feats);
+
+	binned_feats = SGMatrix<uint8_t>(num_vecs, num_feats);
+	bin_edges = SGMatrix<float64_t>(m_num_bins, num_feats);
+	bin_edges.set_const(MISSING);
+	SGVector<index_t> num_unique(num_feats);
+
+	#pragma omp parallel for schedule(dynamic)
+	for (index_t f = 0; f < num_feats; ++f)
+	{
+		std::vector<float64_t> values;
+		values.reserve(num_vecs);
+		for (index_t i = 0; i < num_vecs; ++i)
+		{
+			if (mat(f, i) != MISSING)
+				values.push_back(mat(f, i));
+		}
+		std::sort(values.begin(), values.end());
+
+		num_unique[f] = 0;
+		for (size_t i = 0; i < values.size(); ++i)
+		{
+			if (i == 0 || values[i] != values[i - 1])
+				++num_unique[f];
+		}
+
+		auto edges = bin_edges.get_column_vector(f);
+		index_t num_edges = 0;
+		if (num_unique[f] <= m_num_bins)
+		{
+			// one bin per value
+			for (size_t i = 0; i < values.size(); ++i)
+			{
+				if (i == 0 || values[i] != values[i - 1])
+					edges[num_edges++] = values[i];
+			}
+		}
+		else if (m_nominal.vlen == 0 || !m_nominal[f])
+		{
+			// quantiles, a frequent value can cover several of them
+			for (int64_t b = 1; b <= m_num_bins; ++b)
+			{
+				auto edge = values[values.size() * b / m_num_bins - 1];
+				if (num_edges == 0 || edge > edges[num_edges - 1])
+					edges[num_edges++] = edge;
+			}
+		}
+
+		for (index_t i = 0; i < num_vecs; ++i)
+		{
+			auto value = mat(f, i);
+			binned_feats(i, f) = value == MISSING
+			    ? MISSING_BIN
+			    : std::lower_bound(edges, edges + num_edges, value) - edges;
+		}
+	}
+
+	for (index_t f = 0; f < m_nominal.vlen; ++f)
+	{
+		require(
+		    !m_nominal[f] || num_unique[f] <= m_num_bins,
+		    "Nominal attribute {} has {} categories, histogram splits "
+		    "support at most {}",
+		    f, num_unique[f], m_num_bins);
+	}
+}
+
 std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>> CARTree::CARTtrain(std::shared_ptr<DenseFeatures<float64_t>> data, const SGVector<float64_t>& weights, std::shared_ptr<DenseLabels> labels, int32_t level)
 {
 	require(labels,"labels have to be supplied");
@@ -532,6 +746,312 @@ std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>> CARTree::CARTtrain(std::
 	return node;
 }
 
+std::shared_ptr<CARTree::bnode_t> CARTree::CARTtrain_binned(
+    const SGMatrix<uint8_t>& binned_feats, const SGMatrix<float64_t>& bin_edges,
+    const SGVector<index_t>& rows, const SGVector<float64_t>& weights,
+    std::shared_ptr<DenseLabels> labels)
+{
+	require(labels,"labels have to be supplied");
+	require(
+	    m_mode == PT_MULTICLASS || m_mode == PT_REGRESSION,
+	    "mode should be either PT_MULTICLASS or PT_REGRESSION");
+
+	const bool regression = m_mode == PT_REGRESSION;
+	auto labels_vec = labels->get_labels();
+	auto num_vecs = labels_vec.vlen;
+	auto num_feats = binned_feats.num_cols;
+
+	// label statistics are the weights of the classes in classification
+	// and the weighted moments of the labels in regression
+	index_t num_stats = 3;
+	SGVector<float64_t> ulabels;
+	SGVector<index_t> classes;
+	if (!regression)
+	{
+		ulabels = get_unique_labels(labels_vec, num_stats);
+		classes = SGVector<index_t>(num_vecs);
+		for (index_t i = 0; i < num_vecs; ++i)
+		{
+			classes[i] = std::lower_bound(
+			                 ulabels.begin(), ulabels.begin() + num_stats,
+			                 labels_vec[i]) -
+			             ulabels.begin();
+		}
+	}
+	auto add_stats = [&](float64_t* stats, index_t v) {
+		if (regression)
+		{
+			stats[0] += weights[v];
+			stats[1] += weights[v] * labels_vec[v];
+			stats[2] += weights[v] * labels_vec[v] * labels_vec[v];
+		}
+		else
+			stats[classes[v]] += weights[v];
+	};
+
+	SGVector<index_t> num_bins(num_feats);
+	for (index_t f = 0; f < num_feats; ++f)
+	{
+		auto edges = bin_edges.get_column_vector(f);
+		num_bins[f] = std::find(edges, edges + bin_edges.num_rows, MISSING) - edges;
+	}
+
+	// finds the best split of a node and creates its children
+	auto split_node = [&](BinnedNode& current, int32_t level,
+	                      const index_t* attributes, index_t num_attributes,
+	                      bool parallel_attributes, BinnedNode* children) {
+		auto& data = current.node->data;
+		const auto& vecs = current.vecs;
+
+		std::vector<float64_t> total(num_stats, 0.0);
+		for (auto v : vecs)
+			add_stats(total.data(), v);
+
+		float64_t total_weight = 0;
+		float64_t node_impurity = histogram_impurity(
+		    total.data(), num_stats, regression, total_weight);
+		index_t max_class =
+		    std::max_element(total.begin(), total.end()) - total.begin();
+		if (regression)
+		{
+			data.node_label = total[1] / total_weight;
+			data.weight_minus_node = node_impurity * total_weight;
+		}
+		else
+		{
+			data.node_label = ulabels[max_class];
+			data.weight_minus_node = total_weight - total[max_class];
+		}
+		data.total_weight = total_weight;
+		data.impurity = node_impurity;
+		data.num_leaves = 1;
+		data.weight_minus_branch = data.weight_minus_node;
+
+		// check stopping rules
+		if ((m_max_depth > 0) && (level == m_max_depth))
+			return false;
+		if ((m_min_node_size > 1) && ((index_t)vecs.size() <= m_min_node_size))
+			return false;
+
+		std::vector<HistogramSplit> splits(num_attributes);
+		#pragma omp parallel for schedule(dynamic) if (parallel_attributes)
+		for (index_t a = 0; a < num_attributes; ++a)
+		{
+			auto attribute = attributes[a];
+			auto attribute_bins = num_bins[attribute];
+			auto bins = binned_feats.get_column_vector(attribute);
+
+			// O(N) histogram, missing values are kept in the last bin
+			std::vector<float64_t> hist((attribute_bins + 1) * num_stats, 0.0);
+			for (auto v : vecs)
+			{
+				index_t bin = bins[rows[v]];
+				if (bin == MISSING_BIN)
+					bin = attribute_bins;
+				add_stats(&hist[bin * num_stats], v);
+			}
+
+			// order in which the non-empty bins are moved to the left child
+			std::vector<index_t> order;
+			std::vector<float64_t> key(attribute_bins);
+			for (index_t b = 0; b < attribute_bins; ++b)
+			{
+				auto bin_weight = histogram_weight(
+				    &hist[b * num_stats], num_stats, regression);
+				if (bin_weight <= 0)
+					continue;
+
+				order.push_back(b);
+				if (regression)
+					key[b] = hist[b * num_stats + 1] / bin_weight;
+				else
+					key[b] = hist[b * num_stats + max_class] / bin_weight;
+			}
+			if (m_nominal[attribute])
+			{
+				std::stable_sort(
+				    order.begin(), order.end(),
+				    [&key](index_t i, index_t j) { return key[i] < key[j]; });
+			}
+
+			// O(B) scan of the splits between consecutive bins
+			std::vector<float64_t> left(num_stats, 0.0);
+			std::vector<float64_t> right(num_stats);
+			index_t best_k = -1;
+			for (index_t k = 0; k + 1 < (index_t)order.size(); ++k)
+			{
+				for (index_t j = 0; j < num_stats; ++j)
+				{
+					left[j] += hist[order[k] * num_stats + j];
+					right[j] = total[j] - left[j];
+				}
+
+				float64_t left_weight = 0;
+				float64_t right_weight = 0;
+				auto left_impurity = histogram_impurity(
+				    left.data(), num_stats, regression, left_weight);
+				auto right_impurity = histogram_impurity(
+				    right.data(), num_stats, regression, right_weight);
+				auto g = node_impurity -
+				         left_impurity * (left_weight / total_weight) -
+				         right_impurity * (right_weight / total_weight);
+				if (g > splits[a].gain)
+				{
+					splits[a].gain = g;
+					best_k = k;
+				}
+			}
+
+			if (best_k < 0)
+				continue;
+
+			auto& split = splits[a];
+			split.attribute = attribute;
+			split.is_left_bin.fill(false);
+			if (m_nominal[attribute])
+			{
+				for (index_t k = 0; k <= best_k; ++k)
+					split.is_left_bin[order[k]] = true;
+			}
+			else
+			{
+				split.last_left_bin = order[best_k];
+				for (index_t b = 0; b <= split.last_left_bin; ++b)
+					split.is_left_bin[b] = true;
+			}
+		}
+
+		// first attribute with the maximal gain
+		const HistogramSplit* best = nullptr;
+		for (const auto& split : splits)
+		{
+			if (split.attribute >= 0 && (!best || split.gain > best->gain))
+				best = &split;
+		}
+		if (!best)
+			return false;
+
+		auto bins = binned_feats.get_column_vector(best->attribute);
+		for (auto v : vecs)
+			children[best->is_left_bin[bins[rows[v]]] ? 0 : 1].vecs.push_back(v);
+
+		// transit values are the upper bin edges of the continuous split or
+		// the categories present in each child of the nominal split
+		auto edges = bin_edges.get_column_vector(best->attribute);
+		std::vector<float64_t> transit[2];
+		if (m_nominal[best->attribute])
+		{
+			std::vector<bool> present(num_bins[best->attribute], false);
+			for (auto v : vecs)
+			{
+				if (bins[rows[v]] != MISSING_BIN)
+					present[bins[rows[v]]] = true;
+			}
+			for (index_t b = 0; b < num_bins[best->attribute]; ++b)
+			{
+				if (present[b])
+					transit[best->is_left_bin[b] ? 0 : 1].push_back(edges[b]);
+			}
+		}
+		else
+		{
+			transit[0].push_back(edges[best->last_left_bin]);
+			transit[1].push_back(edges[best->last_left_bin]);
+		}
+
+		data.attribute_id = best->attribute;
+		for (int32_t c = 0; c < 2; ++c)
+		{
+			children[c].node = std::make_shared<bnode_t>();
+			children[c].node->data.transit_into_values =
+			    SGVector<float64_t>(transit[c].size());
+			std::copy(
+			    transit[c].begin(), transit[c].end(),
+			    children[c].node->data.transit_into_values.begin());
+		}
+		current.node->left(children[0].node);
+		current.node->right(children[1].node);
+		return true;
+	};
+
+	auto root = std::make_shared<bnode_t>();
+	std::vector<BinnedNode> level_nodes(1);
+	level_nodes[0].node = root;
+	level_nodes[0].vecs.resize(num_vecs);
+	std::iota(level_nodes[0].vecs.begin(), level_nodes[0].vecs.end(), 0);
+
+	// split nodes in breadth first order, for computing subtree statistics
+	std::vector<std::shared_ptr<bnode_t>> split_nodes;
+	index_t subset_size = split_subset_size(num_feats);
+	index_t num_attributes = subset_size ? subset_size : num_feats;
+	int32_t num_threads = env()->get_num_threads();
+	for (int32_t level = 0; !level_nodes.empty(); ++level)
+	{
+		auto num_nodes = (index_t)level_nodes.size();
+
+		// random attribute subsets are drawn up front since the nodes are
+		// split in parallel, otherwise all nodes share one column
+		SGMatrix<index_t> attributes(num_attributes, subset_size ? num_nodes : 1);
+		SGVector<index_t> idx(num_feats);
+		for (index_t n = 0; n < attributes.num_cols; ++n)
+		{
+			linalg::range_fill(idx);
+			if (subset_size)
+				random::shuffle(idx, m_prng);
+			sg_memcpy(
+			    attributes.get_column_vector(n), idx.vector,
+			    num_attributes * sizeof(index_t));
+		}
+
+		// parallelize over the nodes of a level once there are enough of
+		// them, and over the attributes of a node before
+		bool parallel_nodes = num_nodes >= num_threads;
+		std::vector<std::array<BinnedNode, 2>> children(num_nodes);
+		std::vector<char> is_split(num_nodes);
+		#pragma omp parallel for schedule(dynamic) if (parallel_nodes)
+		for (index_t n = 0; n < num_nodes; ++n)
+		{
+			is_split[n] = split_node(
+			    level_nodes[n], level,
+			    attributes.get_column_vector(subset_size ? n : 0),
+			    num_attributes, !parallel_nodes, children[n].data());
+			// vectors of a node are not needed anymore once it is split
+			std::vector<index_t>().swap(level_nodes[n].vecs);
+		}
+
+		std::vector<BinnedNode> next_level;
+		for (index_t n = 0; n < num_nodes; ++n)
+		{
+			if (!is_split[n])
+				continue;
+
+			split_nodes.push_back(level_nodes[n].node);
+			next_level.push_back(std::move(children[n][0]));
+			next_level.push_back(std::move(children[n][1]));
+		}
+		level_nodes = std::move(next_level);
+	}
+
+	for (auto it = split_nodes.rbegin(); it != split_nodes.rend(); ++it)
+	{
+		auto& node = *it;
+		auto left_child = node->left();
+		auto right_child = node->right();
+		node->data.num_leaves =
+		    left_child->data.num_leaves + right_child->data.num_leaves;
+		node->data.weight_minus_branch =
+		    left_child->data.weight_minus_branch +
+		    right_child->data.weight_minus_branch;
+	}
+
+	return root;
+}
+
+index_t CARTree::split_subset_size(index_t num_feats)
+{
+	return 0;
+}
+
 SGVector<float64_t> CARTree::get_unique_labels(const SGVector<float64_t>& labels_vec, index_t &n_ulabels) const
 {
 	float64_t delta=0;
@@ -1145,6 +1665,15 @@ std::shared_ptr<Labels> CARTree::apply_from_current_node(const std::shared_ptr<D
 	auto num_vecs=feats->get_num_vectors();
 	require(num_vecs>0, "No data provided in apply");
 
+	if (m_compiled.get_num_trees() && current == m_compiled.get_source_root(0))
+	{
+		auto outputs=m_compiled.apply_weighted_sum(feats, SGVector<float64_t>{1.0});
+		if (m_mode==PT_MULTICLASS)
+			return std::make_shared<MulticlassLabels>(outputs);
+		if (m_mode==PT_REGRESSION)
+			return std::make_shared<RegressionLabels>(outputs);
+	}
+
 	SGVector<float64_t> labels(num_vecs);
 	for (index_t i=0;i<num_vecs;++i)
 	{
@@ -1500,6 +2029,8 @@ void CARTree::init()
 	m_weights=SGVector<float64_t>();
 	m_mode=PT_MULTICLASS;
 	m_pre_sort=false;
+	m_histogram_split=false;
+	m_num_bins=255;
 	m_apply_cv_pruning=false;
 	m_folds=5;
 
@@ -1516,6 +2047,10 @@ void CARTree::init()
 	SG_ADD(&m_pre_sort, "pre_sort", "presort");
 	SG_ADD(&m_sorted_features, "sorted_features", "sorted feats");
 	SG_ADD(&m_sorted_indices, "sorted_indices", "sorted indices");
+	SG_ADD(&m_histogram_split, "histogram_split", "histogram splits on binned features");
+	SG_ADD(&m_num_bins, "num_bins", "max number of bins per attribute");
+	SG_ADD(&m_binned_features, "binned_features", "binned features");
+	SG_ADD(&m_bin_edges, "bin_edges", "upper bin edges");
 	SG_ADD(&m_nominal, "nominal", "feature types");
 	SG_ADD(&m_weights, "weights", "weights");
 	SG_ADD(
@@ -40,6 +40,7 @@
 #include <shogun/mathematics/RandomMixin.h>
 #include <shogun/multiclass/tree/CARTreeNodeData.h>
 #include <shogun/multiclass/tree/FeatureImportanceTree.h>
+#include <shogun/multiclass/tree/FlatTreeEnsemble.h>
 #include <shogun/multiclass/tree/TreeMachine.h>
 
 #include <vector>
@@ -80,7 +81,17 @@ namespace shogun
  * have been sent to left/right child. If all possible surrogate splits are used up but some data points are still to be
  * assigned left/right child, majority rule is used, ie. the data points are assigned the child where majority of data points
  * have gone from the node. \n
- * cf. http://pic.dhe.ibm.com/infocenter/spssstat/v20r0m0/index.jsp?topic=%2Fcom.ibm.spss.statistics.help%2Falg_tree-cart.htm
+ * cf. http://pic.dhe.ibm.com/infocenter/spssstat/v20r0m0/index.jsp?topic=%2Fcom.ibm.spss.statistics.help%2Falg_tree-cart.htm \n \n
+ *
+ * HISTOGRAM SPLITS : \n
+ * With set_histogram_split(true) every attribute is quantized into at most 255 bins (see set_num_bins()) before training and
+ * the tree is grown one level at a time. A split only has to sum up the weighted label statistics of the vectors in a node per
+ * bin, and candidate thresholds are the upper bin edges. Nodes of the same depth are split in parallel, or the attributes of a
+ * node if a level has fewer nodes than threads. Only the bin indices (one byte per value) are kept during training instead of
+ * sorted copies of the data. The categories of nominal attributes are ordered by their mean label (regression) or by the
+ * proportion of the majority class of the node (classification) and split like continuous attributes. This is the exact best
+ * split for regression and two class problems. Missing values are not handled with surrogate splits in this mode but always
+ * sent to the right child, which is also where apply sends them.
  */
 class CARTree : public RandomMixin<FeatureImportanceTree<CARTreeNodeData>>
 {
@@ -238,6 +249,66 @@ public:
 
 	void set_sorted_features(SGMatrix<float64_t>& sorted_feats, SGMatrix<index_t>& sorted_indices);
 
+	/** quantizes the attributes of the data into bins for histogram splits
+	 *
+	 * The subset of the data is ignored, all stored vectors are binned so
+	 * that the absolute indices of any subset address the rows of
+	 * binned_feats.
+	 *
+	 * @param data training data
+	 * @param binned_feats stores the bin index of every stored vector, one column per attribute
+	 * @param bin_edges stores the upper edges of the bins, one column per attribute, padded with MISSING
+	 */
+	void bin_features(const std::shared_ptr<Features>& data, SGMatrix<uint8_t>& binned_feats, SGMatrix<float64_t>& bin_edges);
+
+	/** set binned features to be used in the next training, enables
+	 * histogram splits. The features given to train() have to be the
+	 * binned data, with any subset.
+	 *
+	 * @param binned_feats bin indices computed by bin_features
+	 * @param bin_edges bin edges computed by bin_features
+	 */
+	void set_binned_features(SGMatrix<uint8_t>& binned_feats, SGMatrix<float64_t>& bin_edges);
+
+	/** set whether splits are found on histograms of binned attributes
+	 *
+	 * @param histogram_split whether to use histogram splits
+	 */
+	void set_histogram_split(bool histogram_split)
+	{
+		m_histogram_split = histogram_split;
+	}
+
+	/** get whether splits are found on histograms of binned attributes
+	 *
+	 * @return whether histogram splits are used
+	 */
+	bool get_histogram_split() const { return m_histogram_split; }
+
+	/** get max number of bins per attribute in histogram splits
+	 *
+	 * @return max number of bins
+	 */
+	int32_t get_num_bins() const { return m_num_bins; }
+
+	/** set max number of bins per attribute in histogram splits
+	 *
+	 * @param num_bins max number of bins, between 2 and 255
+	 */
+	void set_num_bins(int32_t num_bins);
+
+	/** set root, discards the compiled tree
+	 *
+	 * @param root the root node of the tree
+	 */
+	void set_root(std::shared_ptr<TreeMachineNode<CARTreeNodeData>> root) override;
+
+	/** flattens the trained tree into contiguous arrays, which are used by
+	 * apply until the tree is trained, pruned or replaced. Nodes edited
+	 * in place through get_root() require another call to compile().
+	 */
+	void compile();
+
 	/**return feature importance
 	 * this way is the same as sklearn
 	 */
@@ -260,6 +331,26 @@ protected:
 	 */
 	virtual std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>> CARTtrain(std::shared_ptr<DenseFeatures<float64_t>> data, const SGVector<float64_t>& weights, std::shared_ptr<DenseLabels> labels, int32_t level);
 
+	/** CARTtrain_binned - CART training on binned features, grows the
+	 * tree level by level using histogram splits
+	 *
+	 * @param binned_feats bin indices, one column per attribute
+	 * @param bin_edges upper edges of the bins, one column per attribute
+	 * @param rows row in binned_feats of every training vector
+	 * @param weights vector of weights of data points
+	 * @param labels labels of data points
+	 * @return pointer to the root of the CART
+	 */
+	std::shared_ptr<bnode_t> CARTtrain_binned(const SGMatrix<uint8_t>& binned_feats, const SGMatrix<float64_t>& bin_edges,
+		const SGVector<index_t>& rows, const SGVector<float64_t>& weights, std::shared_ptr<DenseLabels> labels);
+
+	/** number of randomly chosen attributes considered in a node split
+	 *
+	 * @param num_feats total number of attributes
+	 * @return size of the random subset, 0 to consider all attributes
+	 */
+	virtual index_t split_subset_size(index_t num_feats);
+
 	/** modify labels for compute_best_attribute
 	 *
 	 * @param labels_vec labels vector
@@ -439,6 +530,9 @@ public:
 	/** equality epsilon */
 	static const float64_t EQ_DELTA;
 
+	/** bin of missing values in binned features */
+	static const uint8_t MISSING_BIN;
+
 protected:
 	/** Returns whether the type of various feature dimensions are specified
 	 * using is_nominal_feature
@@ -466,6 +560,21 @@ protected:
 	/** If pre sorted features are used in train */
 	bool m_pre_sort;
 
+	/** binned features, one column per attribute */
+	SGMatrix<uint8_t> m_binned_features;
+
+	/** upper bin edges, one column per attribute */
+	SGMatrix<float64_t> m_bin_edges;
+
+	/** If splits are found on histograms of binned features */
+	bool m_histogram_split;
+
+	/** max number of bins per attribute in histogram splits */
+	int32_t m_num_bins;
+
+	/** flattened tree used by apply, empty if not compiled */
+	FlatTreeEnsemble m_compiled;
+
 	/** flag indicating whether cross validation pruning has to be applied or not - false by default **/
 	bool m_apply_cv_pruning;
 
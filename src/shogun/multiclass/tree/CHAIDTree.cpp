@@ -99,6 +99,7 @@ bool CHAIDTree::is_label_valid(std::shared_ptr<Labels> lab) const
 
 std::shared_ptr<MulticlassLabels> CHAIDTree::apply_multiclass(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	require(data, "Data required for classification in apply_multiclass");
 
 	return apply_tree(data)->as<MulticlassLabels>();
@@ -106,6 +107,7 @@ std::shared_ptr<MulticlassLabels> CHAIDTree::apply_multiclass(std::shared_ptr<Fe
 
 std::shared_ptr<RegressionLabels> CHAIDTree::apply_regression(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	require(data, "Data required for regression in apply_regression");
 
 	return apply_tree(data)->as<RegressionLabels>();
@@ -17,6 +17,7 @@ using namespace std;
 
 std::shared_ptr<MulticlassLabels> ConditionalProbabilityTree::apply_multiclass(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	if (data)
 	{
 		if (data->get_feature_class() != C_STREAMING_DENSE)
@@ -0,0 +1,186 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/io/SGIO.h>
+#include <shogun/multiclass/tree/FlatTreeEnsemble.h>
+
+#include <algorithm>
+#include <utility>
+
+using namespace shogun;
+
+namespace
+{
+	/** number of vectors evaluated by all trees at once */
+	const index_t FLAT_TREE_BLOCK_SIZE = 64;
+}
+
+void FlatTreeEnsemble::add_tree(
+    const std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>>& root,
+    const SGVector<bool>& nominal)
+{
+	require(root, "Tree is not trained");
+
+	using node_t = BinaryTreeMachineNode<CARTreeNodeData>;
+	auto append_node = [this]() {
+		m_attribute.push_back(-1);
+		m_value.push_back(0);
+		m_left.push_back(-1);
+		m_categories_begin.push_back(-1);
+		m_categories_end.push_back(-1);
+		return (int32_t)m_attribute.size() - 1;
+	};
+
+	m_roots.push_back(append_node());
+	m_source_roots.push_back(root);
+
+	// children are appended as pairs, breadth first
+	std::vector<std::pair<std::shared_ptr<node_t>, int32_t>> queue;
+	queue.emplace_back(root, m_roots.back());
+	for (size_t q = 0; q < queue.size(); ++q)
+	{
+		auto node = queue[q].first;
+		auto index = queue[q].second;
+
+		// same leaf criterion as CARTree::apply_from_current_node
+		if (node->data.num_leaves == 1)
+		{
+			m_value[index] = node->data.node_label;
+			continue;
+		}
+
+		auto attribute = node->data.attribute_id;
+		auto left_child = node->left();
+		auto right_child = node->right();
+		require(
+		    attribute >= 0 && attribute < nominal.vlen,
+		    "Split attribute {} of node {} out of range", attribute, index);
+
+		auto left = append_node();
+		append_node();
+		m_attribute[index] = attribute;
+		m_left[index] = left;
+
+		const auto& transit = left_child->data.transit_into_values;
+		if (nominal[attribute])
+		{
+			m_categories_begin[index] = m_categories.size();
+			m_categories.insert(m_categories.end(), transit.begin(), transit.end());
+			m_categories_end[index] = m_categories.size();
+		}
+		else
+			m_value[index] = transit[0];
+
+		queue.emplace_back(left_child, left);
+		queue.emplace_back(right_child, left + 1);
+	}
+}
+
+void FlatTreeEnsemble::clear()
+{
+	m_roots.clear();
+	m_source_roots.clear();
+	m_attribute.clear();
+	m_value.clear();
+	m_left.clear();
+	m_categories_begin.clear();
+	m_categories_end.clear();
+	m_categories.clear();
+}
+
+float64_t FlatTreeEnsemble::evaluate(int32_t tree, const float64_t* vec) const
+{
+	auto node = m_roots[tree];
+	while (m_attribute[node] >= 0)
+	{
+		auto value = vec[m_attribute[node]];
+		bool is_left;
+		if (m_categories_begin[node] < 0)
+			is_left = value <= m_value[node];
+		else
+		{
+			auto begin = m_categories.data() + m_categories_begin[node];
+			auto end = m_categories.data() + m_categories_end[node];
+			is_left = std::find(begin, end, value) != end;
+		}
+		node = m_left[node] + !is_left;
+	}
+	return m_value[node];
+}
+
+template <class F>
+void FlatTreeEnsemble::apply_blocks(
+    const std::shared_ptr<DenseFeatures<float64_t>>& feats, F fn) const
+{
+	auto num_vecs = feats->get_num_vectors();
+	auto num_trees = get_num_trees();
+	auto num_blocks = (num_vecs + FLAT_TREE_BLOCK_SIZE - 1) / FLAT_TREE_BLOCK_SIZE;
+
+	#pragma omp parallel
+	{
+		SGMatrix<float64_t> outputs(num_trees, FLAT_TREE_BLOCK_SIZE);
+
+		#pragma omp for schedule(dynamic)
+		for (index_t b = 0; b < num_blocks; ++b)
+		{
+			auto begin = b * FLAT_TREE_BLOCK_SIZE;
+			auto size = std::min(FLAT_TREE_BLOCK_SIZE, num_vecs - begin);
+			auto block = feats->get_feature_matrix_block(begin, size);
+
+			for (int32_t t = 0; t < num_trees; ++t)
+			{
+				for (index_t i = 0; i < size; ++i)
+					outputs(t, i) = evaluate(t, block.get_column_vector(i));
+			}
+			fn(begin, size, outputs);
+		}
+	}
+}
+
+SGMatrix<float64_t> FlatTreeEnsemble::apply_outputs(
+    const std::shared_ptr<DenseFeatures<float64_t>>& feats) const
+{
+	require(feats, "No features provided");
+	require(get_num_trees() > 0, "Tree ensemble is not compiled");
+
+	SGMatrix<float64_t> result(feats->get_num_vectors(), get_num_trees());
+	apply_blocks(
+	    feats, [&](index_t begin, index_t size,
+	               const SGMatrix<float64_t>& outputs) {
+		    for (int32_t t = 0; t < outputs.num_rows; ++t)
+		    {
+			    for (index_t i = 0; i < size; ++i)
+				    result(begin + i, t) = outputs(t, i);
+		    }
+	    });
+	return result;
+}
+
+SGVector<float64_t> FlatTreeEnsemble::apply_weighted_sum(
+    const std::shared_ptr<DenseFeatures<float64_t>>& feats,
+    const SGVector<float64_t>& weights) const
+{
+	require(feats, "No features provided");
+	require(get_num_trees() > 0, "Tree ensemble is not compiled");
+	require(
+	    weights.vlen == get_num_trees(),
+	    "Number of weights ({}) does not match number of trees ({})",
+	    weights.vlen, get_num_trees());
+
+	SGVector<float64_t> result(feats->get_num_vectors());
+	apply_blocks(
+	    feats, [&](index_t begin, index_t size,
+	               const SGMatrix<float64_t>& outputs) {
+		    for (index_t i = 0; i < size; ++i)
+		    {
+			    float64_t sum = 0;
+			    for (int32_t t = 0; t < outputs.num_rows; ++t)
+				    sum += weights[t] * outputs(t, i);
+			    result[begin + i] = sum;
+		    }
+	    });
+	return result;
+}
@@ -0,0 +1,141 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+#ifndef __FLATTREEENSEMBLE_H__
+#define __FLATTREEENSEMBLE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/multiclass/tree/BinaryTreeMachineNode.h>
+#include <shogun/multiclass/tree/CARTreeNodeData.h>
+
+#include <memory>
+#include <vector>
+
+namespace shogun
+{
+
+/** @brief Class FlatTreeEnsemble stores trained CART trees in contiguous
+ * arrays for fast inference.
+ *
+ * The nodes of all trees are stored as a struct of arrays: the attribute
+ * of a split (-1 for leaves), the threshold of a continuous split or the
+ * label of a leaf, and the index of the left child. The right child is
+ * always stored right after the left child. The categories sent to the
+ * left child by a nominal split are kept in a separate array.
+ *
+ * Vectors are evaluated in blocks: all trees are applied to one block of
+ * vectors before moving to the next, so the nodes of a tree stay in cache
+ * for the whole block. Blocks are evaluated in parallel.
+ *
+ * Missing values are sent to the right child, like CARTree::apply does.
+ */
+class FlatTreeEnsemble
+{
+public:
+	/** appends a tree
+	 *
+	 * @param root root of the trained tree
+	 * @param nominal whether the attributes are nominal
+	 */
+	void add_tree(
+	    const std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>>& root,
+	    const SGVector<bool>& nominal);
+
+	/** removes all trees */
+	void clear();
+
+	/** get number of trees
+	 *
+	 * @return number of trees
+	 */
+	int32_t get_num_trees() const
+	{
+		return m_roots.size();
+	}
+
+	/** get number of nodes of all trees
+	 *
+	 * @return number of nodes
+	 */
+	int32_t get_num_nodes() const
+	{
+		return m_attribute.size();
+	}
+
+	/** get root of a tree the ensemble was compiled from
+	 *
+	 * @param tree index of the tree
+	 * @return root of the tree
+	 */
+	std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>>
+	get_source_root(int32_t tree) const
+	{
+		return m_source_roots[tree];
+	}
+
+	/** outputs of every tree for every vector
+	 *
+	 * @param feats features
+	 * @return matrix of num_vectors x num_trees outputs
+	 */
+	SGMatrix<float64_t>
+	apply_outputs(const std::shared_ptr<DenseFeatures<float64_t>>& feats) const;
+
+	/** weighted sum of the outputs of the trees for every vector
+	 *
+	 * @param feats features
+	 * @param weights weight of every tree
+	 * @return weighted sums
+	 */
+	SGVector<float64_t> apply_weighted_sum(
+	    const std::shared_ptr<DenseFeatures<float64_t>>& feats,
+	    const SGVector<float64_t>& weights) const;
+
+private:
+	/** output of a tree for a vector
+	 *
+	 * @param tree index of the tree
+	 * @param vec feature vector
+	 * @return label of the leaf the vector ends in
+	 */
+	float64_t evaluate(int32_t tree, const float64_t* vec) const;
+
+	/** evaluates all trees on the blocks of vectors
+	 *
+	 * @param feats features
+	 * @param fn function called with the first vector, the block and
+	 * the outputs of all trees for the vectors of the block in a
+	 * num_trees x block size matrix
+	 */
+	template <class F>
+	void apply_blocks(
+	    const std::shared_ptr<DenseFeatures<float64_t>>& feats, F fn) const;
+
+private:
+	/** first node of every tree */
+	std::vector<int32_t> m_roots;
+	/** roots of the trees the nodes were created from */
+	std::vector<std::shared_ptr<BinaryTreeMachineNode<CARTreeNodeData>>>
+	    m_source_roots;
+	/** attribute of a split, -1 for leaves */
+	std::vector<int32_t> m_attribute;
+	/** threshold of a continuous split, label of a leaf */
+	std::vector<float64_t> m_value;
+	/** left child of a split */
+	std::vector<int32_t> m_left;
+	/** first category sent to the left child by a nominal split,
+	 * -1 for continuous splits */
+	std::vector<int32_t> m_categories_begin;
+	/** end of the categories sent to the left child by a nominal split */
+	std::vector<int32_t> m_categories_end;
+	/** categories of all nominal splits */
+	std::vector<float64_t> m_categories;
+};
+}
+#endif // __FLATTREEENSEMBLE_H__
@@ -52,6 +52,7 @@ ID3ClassifierTree::~ID3ClassifierTree()
 
 std::shared_ptr<MulticlassLabels> ID3ClassifierTree::apply_multiclass(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	require(data, "Data required for classification in apply_multiclass");
 
 	auto current = get_root()->as<node_t>();
@@ -0,0 +1,224 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <shogun/io/SGIO.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/multiclass/tree/MetricCoverTree.h>
+#include <shogun/multiclass/tree/KNNHeap.h>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+using namespace shogun;
+
+MetricCoverTree::MetricCoverTree() : m_root(-1), m_num_points(0)
+{
+}
+
+float64_t MetricCoverTree::covdist(int32_t node) const
+{
+	return std::ldexp(1.0, m_nodes[node].level);
+}
+
+float64_t MetricCoverTree::maxdist(int32_t node) const
+{
+	return std::ldexp(1.0, m_nodes[node].level + 1);
+}
+
+int32_t MetricCoverTree::new_node(index_t point, int32_t level)
+{
+	Node node;
+	node.point = point;
+	node.level = level;
+	m_nodes.push_back(std::move(node));
+	return m_nodes.size() - 1;
+}
+
+void MetricCoverTree::build_tree(index_t num_points, const DistanceFunction& distance)
+{
+	require(num_points > 0, "No reference points given");
+
+	m_nodes.clear();
+	m_nodes.reserve(num_points);
+	m_root = -1;
+	m_num_points = num_points;
+
+	for (index_t i = 0; i < num_points; ++i)
+		insert(i, distance);
+
+	SG_DEBUG(
+	    "Built cover tree of depth {} over {} points ({} nodes)", get_depth(),
+	    num_points, m_nodes.size());
+}
+
+void MetricCoverTree::insert(index_t point, const DistanceFunction& distance)
+{
+	if (m_root < 0)
+	{
+		m_root = new_node(point, 0);
+		return;
+	}
+
+	float64_t dist = distance(m_nodes[m_root].point, point);
+	if (dist == 0)
+	{
+		m_nodes[m_root].duplicates.push_back(point);
+		return;
+	}
+
+	if (dist <= covdist(m_root))
+	{
+		insert_below(m_root, point, distance);
+		return;
+	}
+
+	// the point is too far away, so the tree has to grow at the top
+	while (dist > 2 * covdist(m_root))
+	{
+		if (m_nodes[m_root].children.empty())
+		{
+			m_nodes[m_root].level++;
+			continue;
+		}
+
+		// any leaf is within maxdist of the root, so it can cover the
+		// current tree one level higher
+		int32_t leaf = remove_leaf(m_root);
+		m_nodes[leaf].level = m_nodes[m_root].level + 1;
+		m_nodes[leaf].children.push_back(m_root);
+		m_root = leaf;
+		dist = distance(m_nodes[m_root].point, point);
+		if (dist == 0)
+		{
+			m_nodes[m_root].duplicates.push_back(point);
+			return;
+		}
+	}
+
+	int32_t root = new_node(point, m_nodes[m_root].level + 1);
+	m_nodes[root].children.push_back(m_root);
+	m_root = root;
+}
+
+void MetricCoverTree::insert_below(
+    int32_t node, index_t point, const DistanceFunction& distance)
+{
+	while (true)
+	{
+		int32_t next = -1;
+		for (auto child : m_nodes[node].children)
+		{
+			float64_t dist = distance(m_nodes[child].point, point);
+			if (dist == 0)
+			{
+				m_nodes[child].duplicates.push_back(point);
+				return;
+			}
+			if (dist <= covdist(child))
+			{
+				next = child;
+				break;
+			}
+		}
+
+		if (next < 0)
+		{
+			int32_t leaf = new_node(point, m_nodes[node].level - 1);
+			m_nodes[node].children.push_back(leaf);
+			return;
+		}
+		node = next;
+	}
+}
+
+int32_t MetricCoverTree::remove_leaf(int32_t node)
+{
+	int32_t parent = node;
+	int32_t child = m_nodes[node].children.back();
+	while (!m_nodes[child].children.empty())
+	{
+		parent = child;
+		child = m_nodes[child].children.back();
+	}
+	m_nodes[parent].children.pop_back();
+	return child;
+}
+
+template <class Heap>
+void MetricCoverTree::query_node(
+    int32_t node, float64_t node_dist, index_t query, Heap& heap,
+    const DistanceFunction& distance) const
+{
+	const auto& n = m_nodes[node];
+	heap.push(n.point, node_dist);
+	for (auto duplicate : n.duplicates)
+		heap.push(duplicate, node_dist);
+
+	if (n.children.empty())
+		return;
+
+	// visit closer children first, they are likely to shrink the heap
+	std::vector<std::pair<float64_t, int32_t>> children;
+	children.reserve(n.children.size());
+	for (auto child : n.children)
+	{
+		// the distance of a child's descendant is at least the distance
+		// to the child minus the maximal distance of its descendants.
+		// As the child itself is within covdist of this node, it can be
+		// skipped without evaluating its distance if even this bound
+		// cannot beat the heap.
+		if (node_dist - covdist(node) - maxdist(child) > heap.get_max_dist())
+			continue;
+		children.emplace_back(distance(m_nodes[child].point, query), child);
+	}
+	std::sort(children.begin(), children.end());
+
+	for (const auto& child : children)
+	{
+		if (child.first - maxdist(child.second) > heap.get_max_dist())
+			continue;
+		query_node(child.second, child.first, query, heap, distance);
+	}
+}
+
+void MetricCoverTree::query_knn(
+    index_t num_queries, int32_t k, const DistanceFunction& distance)
+{
+	require(m_root >= 0, "Tree not built");
+	require(
+	    k > 0 && k <= m_num_points,
+	    "Number of neighbours ({}) must be in [1, {}]", k, m_num_points);
+
+	m_knn_indices = SGMatrix<index_t>(k, num_queries);
+	m_knn_dists = SGMatrix<float64_t>(k, num_queries);
+
+#pragma omp parallel for schedule(dynamic, 16)
+	for (index_t i = 0; i < num_queries; ++i)
+	{
+		KNNHeap heap(k);
+		float64_t root_dist = distance(m_nodes[m_root].point, i);
+		query_node(m_root, root_dist, i, heap, distance);
+
+		auto dists = heap.get_dists();
+		auto indices = heap.get_indices();
+		sg_memcpy(m_knn_dists.get_column_vector(i), dists.vector, k * sizeof(float64_t));
+		sg_memcpy(m_knn_indices.get_column_vector(i), indices.vector, k * sizeof(index_t));
+	}
+}
+
+int32_t MetricCoverTree::depth(int32_t node) const
+{
+	int32_t result = 0;
+	for (auto child : m_nodes[node].children)
+		result = Math::max(result, depth(child) + 1);
+	return result;
+}
+
+int32_t MetricCoverTree::get_depth() const
+{
+	return m_root < 0 ? 0 : depth(m_root);
+}
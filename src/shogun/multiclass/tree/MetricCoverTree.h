@@ -0,0 +1,152 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#ifndef _METRICCOVERTREE_H__
+#define _METRICCOVERTREE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/common.h>
+
+#include <functional>
+#include <vector>
+
+namespace shogun
+{
+
+/** @brief Cover tree for exact nearest neighbour search in arbitrary metric
+ * spaces.
+ *
+ * Implements the simplified cover tree of Izbicki and Shelton, "Faster Cover
+ * Trees" (ICML 2015), which in turn is based on Beygelzimer, Kakade and
+ * Langford, "Cover Trees for Nearest Neighbor" (ICML 2006). Each node
+ * corresponds to exactly one reference point and has an integer level
+ * \f$l\f$, such that all its children are within distance \f$2^l\f$ and all
+ * its descendants are within distance \f$2^{l+1}\f$ of it. These bounds are
+ * used to prune subtrees during k-nearest neighbour queries.
+ *
+ * The tree only accesses the data through a distance callback, hence any
+ * distance can be used as long as it fulfills the triangle inequality, which
+ * is required for the queries to be exact.
+ *
+ * Queries of several points are processed in parallel.
+ */
+class MetricCoverTree
+{
+public:
+	/** distance between two points given by their indices */
+	typedef std::function<float64_t(index_t, index_t)> DistanceFunction;
+
+	/** constructor */
+	MetricCoverTree();
+
+	/** destructor */
+	~MetricCoverTree() { }
+
+	/** build the tree by inserting all reference points
+	 *
+	 * @param num_points number of reference points
+	 * @param distance distance between two reference points
+	 */
+	void build_tree(index_t num_points, const DistanceFunction& distance);
+
+	/** find the k nearest reference points of each query point
+	 *
+	 * @param num_queries number of query points
+	 * @param k number of neighbours
+	 * @param distance distance between a reference point (first argument)
+	 * and a query point (second argument). Called concurrently from several
+	 * threads.
+	 */
+	void query_knn(
+	    index_t num_queries, int32_t k, const DistanceFunction& distance);
+
+	/** @return k x num_queries matrix of neighbour indices of the last
+	 * query, each column is sorted by increasing distance
+	 */
+	SGMatrix<index_t> get_knn_indices() const
+	{
+		return m_knn_indices;
+	}
+
+	/** @return k x num_queries matrix of neighbour distances of the last
+	 * query, each column is sorted increasingly
+	 */
+	SGMatrix<float64_t> get_knn_dists() const
+	{
+		return m_knn_dists;
+	}
+
+	/** @return number of levels between root and deepest node */
+	int32_t get_depth() const;
+
+	/** @return number of reference points in the tree */
+	index_t get_num_points() const
+	{
+		return m_num_points;
+	}
+
+private:
+	/** tree node */
+	struct Node
+	{
+		/** index of the reference point */
+		index_t point;
+		/** level, all children are within distance 2^level */
+		int32_t level;
+		/** child nodes */
+		std::vector<int32_t> children;
+		/** reference points at distance zero to this one */
+		std::vector<index_t> duplicates;
+	};
+
+	/** @return maximal distance of children of node */
+	float64_t covdist(int32_t node) const;
+
+	/** @return maximal distance of descendants of node */
+	float64_t maxdist(int32_t node) const;
+
+	/** insert a point */
+	void insert(index_t point, const DistanceFunction& distance);
+
+	/** insert a point below node, which is known to cover it */
+	void insert_below(
+	    int32_t node, index_t point, const DistanceFunction& distance);
+
+	/** detach any leaf from the subtree rooted at node */
+	int32_t remove_leaf(int32_t node);
+
+	/** create a new node */
+	int32_t new_node(index_t point, int32_t level);
+
+	/** collect neighbours of a query from the subtree rooted at node */
+	template <class Heap>
+	void query_node(
+	    int32_t node, float64_t node_dist, index_t query, Heap& heap,
+	    const DistanceFunction& distance) const;
+
+	int32_t depth(int32_t node) const;
+
+private:
+	/** all nodes, the tree structure is given by the children */
+	std::vector<Node> m_nodes;
+
+	/** root node, -1 if empty */
+	int32_t m_root;
+
+	/** number of reference points */
+	index_t m_num_points;
+
+	/** neighbour indices of last query */
+	SGMatrix<index_t> m_knn_indices;
+
+	/** neighbour distances of last query */
+	SGMatrix<float64_t> m_knn_dists;
+};
+}
+
+#endif /* _METRICCOVERTREE_H__ */
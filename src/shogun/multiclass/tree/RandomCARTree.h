@@ -93,6 +93,14 @@ protected:
 		float64_t& impurity, index_t subset_size = 0,
 		const SGVector<index_t>& active_indices = SGVector<index_t>()) override;
 
+	/** number of randomly chosen attributes considered in a node split,
+	 * sqrt(num_feats) if the subset size is not set
+	 *
+	 * @param num_feats total number of attributes
+	 * @return size of the random subset
+	 */
+	index_t split_subset_size(index_t num_feats) override;
+
 private:
 	/** initialize parameters */
 	void init();
@@ -36,6 +36,7 @@ RelaxedTree::~RelaxedTree()
 
 std::shared_ptr<MulticlassLabels> RelaxedTree::apply_multiclass(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	if (data != NULL)
 	{
 		auto feats = data->as<DenseFeatures<float64_t>>();
@@ -63,6 +64,7 @@ std::shared_ptr<MulticlassLabels> RelaxedTree::apply_multiclass(std::shared_ptr<
 
 float64_t RelaxedTree::apply_one(int32_t idx)
 {
+	load_lazy_parameters();
 	auto node = m_root->as<bnode_t>();
 	int32_t klass = -1;
 	while (node != NULL)
@@ -78,7 +78,7 @@ public:
 	/** set root
 	 * @param root the root node of the tree
 	 */
-	void set_root(std::shared_ptr<TreeMachineNode<T>> root)
+	virtual void set_root(std::shared_ptr<TreeMachineNode<T>> root)
 	{
 		m_root=root;
 	}
@@ -162,6 +162,7 @@ NeuralNetwork::~NeuralNetwork()
 
 std::shared_ptr<BinaryLabels> NeuralNetwork::apply_binary(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	SGMatrix<float64_t> output_activations = forward_propagate(data);
 	auto labels = std::make_shared<BinaryLabels>(m_batch_size);
 
@@ -191,6 +192,7 @@ std::shared_ptr<BinaryLabels> NeuralNetwork::apply_binary(std::shared_ptr<Featur
 
 std::shared_ptr<RegressionLabels> NeuralNetwork::apply_regression(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	SGMatrix<float64_t> output_activations = forward_propagate(data);
 	SGVector<float64_t> labels_vec(m_batch_size);
 
@@ -203,6 +205,7 @@ std::shared_ptr<RegressionLabels> NeuralNetwork::apply_regression(std::shared_pt
 
 std::shared_ptr<MulticlassLabels> NeuralNetwork::apply_multiclass(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	SGMatrix<float64_t> output_activations = forward_propagate(data);
 	SGVector<float64_t> labels_vec(m_batch_size);
 
@@ -32,7 +32,10 @@
 #ifndef FIRSTORDERSTOCHASTICCOSTFUNCTION_H
 #define FIRSTORDERSTOCHASTICCOSTFUNCTION_H
 #include <shogun/lib/config.h>
+#include <shogun/lib/SGSparseVector.h>
 #include <shogun/optimization/FirstOrderCostFunction.h>
+
+#include <vector>
 namespace shogun
 {
 /** @brief The first order stochastic cost function base class.
@@ -79,6 +82,73 @@ public:
 	 */
 	SGVector<float64_t> get_gradient() override =0;
 
+	/** Get the number of samples that can be accessed by get_sample_gradient()
+	 *
+	 * @return the number of samples, 0 if samples are only available
+	 * through begin_sample() and next_sample()
+	 */
+	virtual index_t get_num_samples() const { return 0; }
+
+	/** Get the SAMPLE gradient value of the idx-th sample wrt target variables
+	 *
+	 * Unlike get_gradient(), the sample is given by its index and the
+	 * gradient is evaluated at the given target variables, so the method
+	 * can be called concurrently for different samples (eg,
+	 * SGDMinimizer::set_hogwild() ), while other threads update the
+	 * variable. The variable should then be read entry by entry, and may be
+	 * partially updated. Only the non-zero entries of
+	 * \f$ \frac{\partial f_i(w) }{\partial w} \f$ have to be stored, which
+	 * keeps the updates of sparse samples sparse.
+	 *
+	 * @param idx index of the sample, smaller than get_num_samples()
+	 * @param variable target variables
+	 * @param gradient buffer for the non-zero entries of the sample gradient,
+	 * empty on entry, its memory is reused across samples by the caller
+	 */
+	virtual void get_sample_gradient(index_t idx, const SGVector<float64_t>& variable,
+		std::vector<SGSparseVectorEntry<float64_t>>& gradient) const
+	{
+		not_implemented(SOURCE_LOCATION);
+	}
+
+	/** Get the AVERAGE SAMPLE gradient of a mini-batch wrt target variables
+	 *
+	 * This method returns
+	 * \f$ \frac{1}{|B|}\sum_{i \in B}{ \frac{\partial f_i(w) }{\partial w} } \f$
+	 * where \f$B\f$ is the mini-batch of sample indices.
+	 *
+	 * The default implementation sums get_sample_gradient() of the samples.
+	 * Cost functions of linear models should override it to compute the
+	 * predictions and the gradient of the mini-batch with matrix products.
+	 * Like get_sample_gradient(), it can be called concurrently for
+	 * different mini-batches.
+	 *
+	 * @param batch indices of the samples, smaller than get_num_samples()
+	 * @param variable target variables
+	 * @param gradient buffer of the length of the target variables for the
+	 * average gradient, overwritten
+	 */
+	virtual void get_batch_gradient(const SGVector<index_t>& batch,
+		const SGVector<float64_t>& variable, SGVector<float64_t> gradient) const
+	{
+		require(batch.vlen>0, "The mini-batch must not be empty");
+		require(gradient.vlen==variable.vlen,
+			"The length of gradient ({}) and the length of variable ({}) do not match",
+			gradient.vlen, variable.vlen);
+
+		gradient.zero();
+		std::vector<SGSparseVectorEntry<float64_t>> sample_gradient;
+		for(index_t i=0; i<batch.vlen; i++)
+		{
+			sample_gradient.clear();
+			get_sample_gradient(batch[i], variable, sample_gradient);
+			for(const auto& entry : sample_gradient)
+				gradient[entry.feat_index]+=entry.entry;
+		}
+		for(index_t idx=0; idx<gradient.vlen; idx++)
+			gradient[idx]/=batch.vlen;
+	}
+
 	/** Get the cost given current target variables 
 	 *
 	 * For least squares, that is the value of \f$f(w)\f$.
@@ -33,6 +33,9 @@
 #include <shogun/optimization/SparsePenalty.h>
 #include <shogun/optimization/ProximalPenalty.h>
 
+#include <algorithm>
+#include <numeric>
+
 using namespace shogun;
 
 void FirstOrderStochasticMinimizer::set_gradient_updater(std::shared_ptr<DescendUpdater> gradient_updater)
@@ -68,6 +71,58 @@ void FirstOrderStochasticMinimizer::set_learning_rate(std::shared_ptr<LearningRa
 	}
 }
 
+void FirstOrderStochasticMinimizer::set_batch_size(int32_t batch_size)
+{
+	require(batch_size>0, "The batch size ({}) must be positive", batch_size);
+	m_batch_size=batch_size;
+}
+
+void FirstOrderStochasticMinimizer::begin_pass(const std::shared_ptr<FirstOrderStochasticCostFunction>& fun)
+{
+	if(m_batch_size==1)
+	{
+		fun->begin_sample();
+		return;
+	}
+
+	index_t num_samples=fun->get_num_samples();
+	require(num_samples>0,
+		"Mini-batches require a cost function with indexed samples, see "
+		"FirstOrderStochasticCostFunction::get_batch_gradient()");
+	if((index_t)m_batch_order.size()!=num_samples)
+	{
+		m_batch_order.resize(num_samples);
+		std::iota(m_batch_order.begin(), m_batch_order.end(), 0);
+	}
+	m_batch_begin=0;
+}
+
+bool FirstOrderStochasticMinimizer::next_batch(const std::shared_ptr<FirstOrderStochasticCostFunction>& fun)
+{
+	if(m_batch_size==1)
+		return fun->next_sample();
+
+	index_t num_samples=m_batch_order.size();
+	if(m_batch_begin>=num_samples)
+		return false;
+
+	index_t batch_size=std::min<index_t>(m_batch_size, num_samples-m_batch_begin);
+	m_batch=SGVector<index_t>(m_batch_order.data()+m_batch_begin, batch_size, false);
+	m_batch_begin+=batch_size;
+	return true;
+}
+
+SGVector<float64_t> FirstOrderStochasticMinimizer::get_batch_gradient(
+	const std::shared_ptr<FirstOrderStochasticCostFunction>& fun,
+	const SGVector<float64_t>& variable, SGVector<float64_t> buffer)
+{
+	if(m_batch_size==1)
+		return fun->get_gradient();
+
+	fun->get_batch_gradient(m_batch, variable, buffer);
+	return buffer;
+}
+
 void FirstOrderStochasticMinimizer::do_proximal_operation(SGVector<float64_t>variable_reference)
 {
 	auto proximal_penalty=std::dynamic_pointer_cast<ProximalPenalty>(m_penalty_type);
@@ -99,6 +154,8 @@ void FirstOrderStochasticMinimizer::init()
 	m_num_passes=0;
 	m_cur_passes=0;
 	m_iter_counter=0;
+	m_batch_size=1;
+	m_batch_begin=0;
 
 	SG_ADD((std::shared_ptr<SGObject>*)&m_learning_rate, "FirstOrderMinimizer__m_learning_rate",
 		"learning_rate in FirstOrderStochasticMinimizer");
@@ -110,4 +167,6 @@ void FirstOrderStochasticMinimizer::init()
 		"cur_passes in FirstOrderStochasticMinimizer");
 	SG_ADD(&m_iter_counter, "FirstOrderMinimizer__m_iter_counter",
 		"m_iter_counter in FirstOrderStochasticMinimizer");
+	SG_ADD(&m_batch_size, "FirstOrderMinimizer__m_batch_size",
+		"batch_size in FirstOrderStochasticMinimizer");
 }
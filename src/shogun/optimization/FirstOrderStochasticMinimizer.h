@@ -34,6 +34,8 @@
 #include <shogun/optimization/FirstOrderStochasticCostFunction.h>
 #include <shogun/optimization/DescendUpdater.h>
 #include <shogun/optimization/LearningRate.h>
+
+#include <vector>
 namespace shogun
 {
 
@@ -129,6 +131,25 @@ public:
 	 */
 	virtual void set_learning_rate(std::shared_ptr<LearningRate >learning_rate);
 
+	/** Set the number of samples per update
+	 *
+	 * With a batch size of one, the minimizer updates the target variables
+	 * for every sample of FirstOrderStochasticCostFunction::next_sample().
+	 * With a larger batch size, every pass goes through the indexed samples
+	 * in mini-batches and the minimizer updates the target variables with
+	 * FirstOrderStochasticCostFunction::get_batch_gradient() of every
+	 * mini-batch.
+	 *
+	 * @param batch_size the number of samples per update
+	 */
+	virtual void set_batch_size(int32_t batch_size);
+
+	/** Get the number of samples per update
+	 *
+	 * @return the number of samples per update
+	 */
+	virtual int32_t get_batch_size() const { return m_batch_size; }
+
 	/** How many samples/mini-batch does the minimizer use?
 	 *
 	 * @return the number of samples/mini-batches used in optimization
@@ -146,6 +167,32 @@ protected:
 	/** init the minimization process*/
 	virtual void init_minimization();
 
+	/** Start a pass through the samples or the mini-batches, see
+	 * set_batch_size()
+	 *
+	 * @param fun stochastic cost function
+	 */
+	virtual void begin_pass(const std::shared_ptr<FirstOrderStochasticCostFunction>& fun);
+
+	/** Move to the next sample or mini-batch of the pass
+	 *
+	 * @param fun stochastic cost function
+	 * @return false if reach the end of the pass
+	 */
+	virtual bool next_batch(const std::shared_ptr<FirstOrderStochasticCostFunction>& fun);
+
+	/** Get the gradient of the current sample or the average gradient of the
+	 * current mini-batch
+	 *
+	 * @param fun stochastic cost function
+	 * @param variable target variables, must be the variable reference of
+	 * the cost function when the batch size is one
+	 * @param buffer buffer for the gradient of a mini-batch
+	 * @return the gradient, the buffer for a mini-batch
+	 */
+	SGVector<float64_t> get_batch_gradient(const std::shared_ptr<FirstOrderStochasticCostFunction>& fun,
+		const SGVector<float64_t>& variable, SGVector<float64_t> buffer);
+
 	/** the gradient update step */
 	std::shared_ptr<DescendUpdater> m_gradient_updater;
 
@@ -160,6 +207,18 @@ protected:
 
 	/** learning_rate object */
 	std::shared_ptr<LearningRate> m_learning_rate;
+
+	/** number of samples per update */
+	int32_t m_batch_size;
+
+	/** indices of the samples in the order of the mini-batches of a pass */
+	std::vector<index_t> m_batch_order;
+
+	/** position of the next mini-batch in m_batch_order */
+	index_t m_batch_begin;
+
+	/** indices of the samples of the current mini-batch */
+	SGVector<index_t> m_batch;
 	
 private:
 	/** Init */
@@ -30,13 +30,19 @@
  */
 #include <shogun/optimization/SGDMinimizer.h>
 #include <shogun/optimization/GradientDescendUpdater.h>
+#include <shogun/optimization/ProximalPenalty.h>
+#include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/lib/config.h>
 
+#include <algorithm>
+#include <limits>
+#include <numeric>
 #include <utility>
+#include <vector>
 using namespace shogun;
 
 SGDMinimizer::SGDMinimizer()
-	:FirstOrderStochasticMinimizer()
+	:RandomMixin<FirstOrderStochasticMinimizer>()
 {
 	init();
 }
@@ -46,7 +52,7 @@ SGDMinimizer::~SGDMinimizer()
 }
 
 SGDMinimizer::SGDMinimizer(std::shared_ptr<FirstOrderStochasticCostFunction >fun)
-	:FirstOrderStochasticMinimizer(std::move(fun))
+	:RandomMixin<FirstOrderStochasticMinimizer>(std::move(fun))
 {
 	init();
 }
@@ -58,16 +64,27 @@ float64_t SGDMinimizer::minimize()
 	SGVector<float64_t> variable_reference=m_fun->obtain_variable_reference();
 	auto fun= m_fun->as<FirstOrderStochasticCostFunction>();
 	require(fun,"the cost function must be a stochastic cost function");
+	if(m_hogwild)
+	{
+		minimize_hogwild(fun,variable_reference);
+		return m_fun->get_cost()+get_penalty(variable_reference);
+	}
+
+	// reused for all mini-batches
+	SGVector<float64_t> batch_gradient;
+	if(m_batch_size>1)
+		batch_gradient=SGVector<float64_t>(variable_reference.vlen);
+
 	for(;m_cur_passes<m_num_passes;m_cur_passes++)
 	{
-		fun->begin_sample();
-		while(fun->next_sample())
+		begin_pass(fun);
+		while(next_batch(fun))
 		{
 			m_iter_counter++;
 			float64_t learning_rate=1.0;
 			if(m_learning_rate)
 				learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
-			SGVector<float64_t> grad=m_fun->get_gradient();
+			SGVector<float64_t> grad=get_batch_gradient(fun,variable_reference,batch_gradient);
 			update_gradient(grad,variable_reference);
 			m_gradient_updater->update_variable(variable_reference,grad,learning_rate);
 
@@ -78,8 +95,92 @@ float64_t SGDMinimizer::minimize()
 	return cost+get_penalty(variable_reference);
 }
 
+void SGDMinimizer::begin_pass(const std::shared_ptr<FirstOrderStochasticCostFunction>& fun)
+{
+	FirstOrderStochasticMinimizer::begin_pass(fun);
+	if(m_batch_size>1)
+		random::shuffle(m_batch_order, m_prng);
+}
+
+void SGDMinimizer::minimize_hogwild(const std::shared_ptr<FirstOrderStochasticCostFunction>& fun,
+	SGVector<float64_t> variable_reference)
+{
+	auto updater=std::dynamic_pointer_cast<GradientDescendUpdater>(m_gradient_updater);
+	require(updater && !updater->enables_descend_correction(),
+		"Hogwild only supports GradientDescendUpdater without descend correction");
+	require(!std::dynamic_pointer_cast<ProximalPenalty>(m_penalty_type),
+		"Hogwild does not support proximal penalties");
+	if(m_penalty_type)
+		require(m_penalty_weight>0,"The weight of penalty must be set first");
+	require(m_batch_size==1, "Hogwild updates the target variables per sample, "
+		"the batch size ({}) must be one", m_batch_size);
+
+	index_t num_samples=fun->get_num_samples();
+	require(num_samples>0,
+		"Hogwild requires a cost function with indexed samples, see "
+		"FirstOrderStochasticCostFunction::get_sample_gradient()");
+
+	std::vector<index_t> order(num_samples);
+	std::iota(order.begin(), order.end(), 0);
+
+	int32_t first_pass=m_cur_passes;
+	// the iteration count can exceed int32_t on large data, the learning
+	// rate then stays at that of the last representable iteration
+	const int64_t max_iter=std::numeric_limits<int32_t>::max();
+	int64_t first_iter=m_iter_counter;
+
+	#pragma omp parallel
+	{
+		// reused for all samples of the thread
+		std::vector<SGSparseVectorEntry<float64_t>> gradient;
+
+		for(int32_t pass=first_pass; pass<m_num_passes; pass++)
+		{
+			#pragma omp single
+			random::shuffle(order, m_prng);
+
+			// static schedule: every thread gets a contiguous shard of the
+			// shuffled samples, updates of the variables are not synchronized
+			#pragma omp for schedule(static)
+			for(index_t i=0; i<num_samples; i++)
+			{
+				int64_t iter=first_iter+int64_t(pass-first_pass)*num_samples+i+1;
+				float64_t learning_rate=1.0;
+				if(m_learning_rate)
+					learning_rate=m_learning_rate->get_learning_rate(
+						(int32_t)std::min(iter, max_iter));
+
+				gradient.clear();
+				fun->get_sample_gradient(order[i], variable_reference, gradient);
+				for(const auto& entry : gradient)
+				{
+					float64_t grad=entry.entry;
+					float64_t& variable=variable_reference[entry.feat_index];
+					if(m_penalty_type)
+					{
+						float64_t value;
+						#pragma omp atomic read
+						value=variable;
+						grad+=m_penalty_weight*m_penalty_type->get_penalty_gradient(value,grad);
+					}
+					// concurrent updates of the same variable are not lost
+					#pragma omp atomic
+					variable-=learning_rate*grad;
+				}
+			}
+		}
+	}
+
+	m_iter_counter=(int32_t)std::min(
+		first_iter+int64_t(m_num_passes-first_pass)*num_samples, max_iter);
+	m_cur_passes=m_num_passes;
+}
+
 void SGDMinimizer::init()
 {
+	m_hogwild=false;
+	SG_ADD(&m_hogwild, "hogwild",
+		"whether to minimize in parallel without locking");
 }
 
 void SGDMinimizer::init_minimization()
@@ -32,6 +32,7 @@
 #ifndef SGDMINIMIZER_H
 #define SGDMINIMIZER_H
 #include <shogun/optimization/FirstOrderStochasticMinimizer.h>
+#include <shogun/mathematics/RandomMixin.h>
 
 namespace shogun
 {
@@ -40,9 +41,15 @@ namespace shogun
  *
  * A good introduction to SGD can be found at
  * http://cs231n.github.io/neural-networks-3/#sgd
+ *
+ * With set_hogwild(), the samples are processed by all threads at once,
+ * without locking the target variables, see
+ * Recht, Benjamin, et al. "Hogwild: A lock-free approach to parallelizing
+ * stochastic gradient descent." Advances in Neural Information Processing
+ * Systems. 2011.
  */
 
-class SGDMinimizer: public FirstOrderStochasticMinimizer
+class SGDMinimizer: public RandomMixin<FirstOrderStochasticMinimizer>
 {
 public:
 	/** Default constructor */
@@ -69,10 +76,50 @@ public:
 	 */
 	float64_t minimize() override;
 
+	/** Set whether to minimize in parallel without locking (Hogwild)
+	 *
+	 * Every pass shuffles the samples of
+	 * FirstOrderStochasticCostFunction::get_sample_gradient() and splits them
+	 * into one shard per thread. The threads update the shared target
+	 * variables with the non-zero entries of the sample gradients only, so
+	 * the updates of sparse samples rarely overlap. Each variable is
+	 * updated atomically, but the threads are not synchronized otherwise:
+	 * get_sample_gradient() may read the variables while other threads
+	 * update them, and thus see some updates of a concurrent sample but not
+	 * others. The result hence depends on the scheduling of the threads.
+	 *
+	 * Only supported with a GradientDescendUpdater without correction and
+	 * without proximal penalties. The penalty gradient is applied to the
+	 * non-zero entries of the sample gradients only.
+	 *
+	 * @param hogwild whether to minimize in parallel
+	 */
+	void set_hogwild(bool hogwild) { m_hogwild=hogwild; }
+
+	/** Get whether to minimize in parallel without locking (Hogwild)
+	 *
+	 * @return whether to minimize in parallel
+	 */
+	bool get_hogwild() const { return m_hogwild; }
+
 protected:
 	/*  init the minimization process */
 	void init_minimization() override;
 
+	/** start a pass, shuffles the samples of the mini-batches */
+	void begin_pass(const std::shared_ptr<FirstOrderStochasticCostFunction>& fun) override;
+
+	/** minimize with one shard of the samples per thread, see set_hogwild()
+	 *
+	 * @param fun stochastic cost function
+	 * @param variable_reference target variables
+	 */
+	void minimize_hogwild(const std::shared_ptr<FirstOrderStochasticCostFunction>& fun,
+		SGVector<float64_t> variable_reference);
+
+	/** whether to minimize in parallel without locking */
+	bool m_hogwild;
+
 private:
 	  /* Init */
 	void init();
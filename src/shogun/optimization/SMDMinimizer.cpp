@@ -58,17 +58,22 @@ float64_t SMDMinimizer::minimize()
 	SGVector<float64_t> dual_variable=m_mapping_fun->get_dual_variable(variable_reference);
 	auto fun=m_fun->as<FirstOrderStochasticCostFunction>();
 	require(fun,"the cost function must be a stochastic cost function");
+	// reused for all mini-batches
+	SGVector<float64_t> batch_gradient;
+	if(m_batch_size>1)
+		batch_gradient=SGVector<float64_t>(variable_reference.vlen);
+
 	for(;m_cur_passes<m_num_passes;m_cur_passes++)
 	{
-		fun->begin_sample();
-		while(fun->next_sample())
+		begin_pass(fun);
+		while(next_batch(fun))
 		{
 			m_iter_counter++;
 			float64_t learning_rate=1.0;
 			if(m_learning_rate)
 				learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
 
-			SGVector<float64_t> grad=m_fun->get_gradient();
+			SGVector<float64_t> grad=get_batch_gradient(fun,variable_reference,batch_gradient);
 			update_gradient(grad,variable_reference);
 			m_gradient_updater->update_variable(dual_variable,grad,learning_rate);
 			m_mapping_fun->update_variable(variable_reference,dual_variable);
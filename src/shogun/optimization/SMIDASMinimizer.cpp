@@ -72,15 +72,20 @@ float64_t SMIDASMinimizer::minimize()
 
 	auto fun=m_fun->as<FirstOrderStochasticCostFunction>();
 	require(fun,"the cost function must be a stochastic cost function");
+	// reused for all mini-batches
+	SGVector<float64_t> batch_gradient;
+	if(m_batch_size>1)
+		batch_gradient=SGVector<float64_t>(variable_reference.vlen);
+
 	for(;m_cur_passes<m_num_passes;m_cur_passes++)
 	{
-		fun->begin_sample();
-		while(fun->next_sample())
+		begin_pass(fun);
+		while(next_batch(fun))
 		{
 			m_iter_counter++;
 			float64_t learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
 
-			SGVector<float64_t> grad=m_fun->get_gradient();
+			SGVector<float64_t> grad=get_batch_gradient(fun,variable_reference,batch_gradient);
 			m_gradient_updater->update_variable(m_dual_variable,grad, learning_rate);
 			penalty_type->update_variable_for_proximity(m_dual_variable, m_penalty_weight*learning_rate);
 			m_mapping_fun->update_variable(variable_reference, m_dual_variable);
@@ -30,11 +30,23 @@
  */
 #include <shogun/optimization/SVRGMinimizer.h>
 #include <shogun/optimization/SGDMinimizer.h>
+#include <shogun/optimization/GradientDescendUpdater.h>
+#include <shogun/optimization/L2Penalty.h>
+#include <shogun/mathematics/RandomNamespace.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <vector>
+
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
 
 using namespace shogun;
 
 SVRGMinimizer::SVRGMinimizer()
-	:FirstOrderStochasticMinimizer()
+	:RandomMixin<FirstOrderStochasticMinimizer>()
 {
 	init();
 }
@@ -44,7 +56,7 @@ SVRGMinimizer::~SVRGMinimizer()
 }
 
 SVRGMinimizer::SVRGMinimizer(const std::shared_ptr<FirstOrderSAGCostFunction >&fun)
-	:FirstOrderStochasticMinimizer(fun)
+	:RandomMixin<FirstOrderStochasticMinimizer>(fun)
 {
 	init();
 }
@@ -55,6 +67,7 @@ void SVRGMinimizer::init()
 	m_svrg_interval=0;
 	m_average_gradient=SGVector<float64_t>();
 	m_previous_variable=SGVector<float64_t>();
+	m_lazy_updates=false;
 
 	SG_ADD(&m_num_sgd_passes, "SVRGMinimizer__m_num_sgd_passes",
 		"num_sgd_passes in SVRGMinimizer");
@@ -64,6 +77,8 @@ void SVRGMinimizer::init()
 		"average_gradient in SVRGMinimizer");
 	SG_ADD(&m_previous_variable, "SVRGMinimizer__m_previous_variable",
 		"previous_variable in SVRGMinimizer");
+	SG_ADD(&m_lazy_updates, "SVRGMinimizer__m_lazy_updates",
+		"lazy_updates in SVRGMinimizer");
 }
 
 void SVRGMinimizer::init_minimization()
@@ -81,6 +96,7 @@ void SVRGMinimizer::init_minimization()
 		sgd.set_penalty_weight(m_penalty_weight);
 		sgd.set_penalty_type(m_penalty_type);
 		sgd.set_learning_rate(m_learning_rate);
+		sgd.set_batch_size(m_batch_size);
 		sgd.minimize();
 		m_iter_counter+=sgd.get_iteration_counter();
 	}
@@ -93,6 +109,20 @@ float64_t SVRGMinimizer::minimize()
 	SGVector<float64_t> variable_reference=m_fun->obtain_variable_reference();
 	auto fun=m_fun->as<FirstOrderSAGCostFunction>();
 	require(fun,"the cost function must be a stochastic average gradient cost function");
+	if(m_lazy_updates)
+	{
+		minimize_lazy(fun,variable_reference);
+		return m_fun->get_cost()+get_penalty(variable_reference);
+	}
+
+	// reused for all mini-batches
+	SGVector<float64_t> batch_gradient_new, batch_gradient_old;
+	if(m_batch_size>1)
+	{
+		batch_gradient_new=SGVector<float64_t>(variable_reference.vlen);
+		batch_gradient_old=SGVector<float64_t>(variable_reference.vlen);
+	}
+
 	for(;m_cur_passes<(m_num_passes-m_num_sgd_passes);m_cur_passes++)
 	{
 		if(m_cur_passes%m_svrg_interval==0)
@@ -101,24 +131,34 @@ float64_t SVRGMinimizer::minimize()
 				m_previous_variable=SGVector<float64_t>(variable_reference.vlen);
 
 			std::copy(variable_reference.vector, variable_reference.vector+variable_reference.vlen, m_previous_variable.vector);
-			m_average_gradient=fun->get_average_gradient();
+			// samples accessible by index are averaged in parallel
+			if(fun->get_num_samples()>0)
+				m_average_gradient=compute_average_gradient(fun,m_previous_variable);
+			else
+				m_average_gradient=fun->get_average_gradient();
 		}
-		fun->begin_sample();
-		while(fun->next_sample())
+		begin_pass(fun);
+		while(next_batch(fun))
 		{
 			m_iter_counter++;
 			float64_t learning_rate=1.0;
 			if(m_learning_rate)
 				learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
 
-			SGVector<float64_t> grad_new=m_fun->get_gradient();
-			SGVector<float64_t> var(variable_reference.vlen);
-			std::copy(variable_reference.vector, variable_reference.vector+variable_reference.vlen, var.vector);
+			SGVector<float64_t> grad_new=get_batch_gradient(fun,variable_reference,batch_gradient_new);
+			SGVector<float64_t> grad_old;
+			if(m_batch_size>1)
+				grad_old=get_batch_gradient(fun,m_previous_variable,batch_gradient_old);
+			else
+			{
+				SGVector<float64_t> var(variable_reference.vlen);
+				std::copy(variable_reference.vector, variable_reference.vector+variable_reference.vlen, var.vector);
 
-			std::copy(m_previous_variable.vector, m_previous_variable.vector+m_previous_variable.vlen, variable_reference.vector);
-			SGVector<float64_t> grad_old=m_fun->get_gradient();
+				std::copy(m_previous_variable.vector, m_previous_variable.vector+m_previous_variable.vlen, variable_reference.vector);
+				grad_old=m_fun->get_gradient();
 
-			std::copy(var.vector, var.vector+var.vlen, variable_reference.vector);
+				std::copy(var.vector, var.vector+var.vlen, variable_reference.vector);
+			}
 			for(index_t idx=0; idx<grad_new.vlen; idx++)
 				grad_new[idx]+=(m_average_gradient[idx]-grad_old[idx]);
 
@@ -131,3 +171,148 @@ float64_t SVRGMinimizer::minimize()
 	float64_t cost=m_fun->get_cost();
 	return cost+get_penalty(variable_reference);
 }
+
+SGVector<float64_t> SVRGMinimizer::compute_average_gradient(
+	const std::shared_ptr<FirstOrderSAGCostFunction>& fun, const SGVector<float64_t>& variable)
+{
+	index_t num_samples=fun->get_num_samples();
+	std::vector<index_t> indices(num_samples);
+	std::iota(indices.begin(), indices.end(), 0);
+
+	SGVector<float64_t> average(variable.vlen);
+	average.zero();
+
+	#pragma omp parallel
+	{
+#ifdef HAVE_OPENMP
+		index_t num_threads=omp_get_num_threads();
+		index_t thread=omp_get_thread_num();
+#else
+		index_t num_threads=1;
+		index_t thread=0;
+#endif
+		index_t begin=num_samples*thread/num_threads;
+		index_t end=num_samples*(thread+1)/num_threads;
+		if(begin<end)
+		{
+			SGVector<index_t> shard(indices.data()+begin, end-begin, false);
+			SGVector<float64_t> gradient(variable.vlen);
+			fun->get_batch_gradient(shard, variable, gradient);
+
+			#pragma omp critical
+			for(index_t idx=0; idx<average.vlen; idx++)
+				average[idx]+=gradient[idx]*(end-begin);
+		}
+	}
+
+	for(index_t idx=0; idx<average.vlen; idx++)
+		average[idx]/=num_samples;
+	return average;
+}
+
+void SVRGMinimizer::minimize_lazy(const std::shared_ptr<FirstOrderSAGCostFunction>& fun,
+	SGVector<float64_t> variable_reference)
+{
+	auto updater=std::dynamic_pointer_cast<GradientDescendUpdater>(m_gradient_updater);
+	require(updater && !updater->enables_descend_correction(),
+		"Lazy updates only support GradientDescendUpdater without descend correction");
+	float64_t penalty_weight=0.0;
+	if(m_penalty_type)
+	{
+		require(std::dynamic_pointer_cast<L2Penalty>(m_penalty_type),
+			"Lazy updates only support L2Penalty");
+		require(m_penalty_weight>0,"The weight of penalty must be set first");
+		penalty_weight=m_penalty_weight;
+	}
+	require(m_batch_size==1, "Lazy updates update the target variables per sample, "
+		"the batch size ({}) must be one", m_batch_size);
+
+	index_t num_samples=fun->get_num_samples();
+	require(num_samples>0,
+		"Lazy updates require a cost function with indexed samples, see "
+		"FirstOrderStochasticCostFunction::get_sample_gradient()");
+
+	std::vector<index_t> order(num_samples);
+	std::iota(order.begin(), order.end(), 0);
+
+	// A coordinate outside of the support of the samples of steps s+1,...,t
+	// is updated by the average gradient and the penalty only, which gives
+	// w_t=r*w_s+mu*(offset[t]-r*offset[s]) with r=scale[t]/scale[s]
+	std::vector<float64_t> scale(num_samples+1);
+	std::vector<float64_t> offset(num_samples+1);
+	std::vector<index_t> last_step(variable_reference.vlen);
+	auto catch_up=[&](index_t idx, index_t step)
+	{
+		float64_t ratio=scale[step]/scale[last_step[idx]];
+		variable_reference[idx]=ratio*variable_reference[idx]+
+			m_average_gradient[idx]*(offset[step]-ratio*offset[last_step[idx]]);
+		last_step[idx]=step;
+	};
+	auto catch_up_all=[&](index_t step)
+	{
+		#pragma omp parallel for
+		for(index_t idx=0; idx<variable_reference.vlen; idx++)
+			catch_up(idx, step);
+	};
+
+	// reused for all samples
+	std::vector<SGSparseVectorEntry<float64_t>> grad_new, grad_old;
+
+	for(;m_cur_passes<(m_num_passes-m_num_sgd_passes);m_cur_passes++)
+	{
+		if(m_cur_passes%m_svrg_interval==0)
+		{
+			if(m_previous_variable.vlen==0)
+				m_previous_variable=SGVector<float64_t>(variable_reference.vlen);
+
+			std::copy(variable_reference.vector, variable_reference.vector+variable_reference.vlen, m_previous_variable.vector);
+			m_average_gradient=compute_average_gradient(fun,m_previous_variable);
+		}
+
+		random::shuffle(order, m_prng);
+		scale[0]=1.0;
+		offset[0]=0.0;
+		std::fill(last_step.begin(), last_step.end(), 0);
+		for(index_t step=1; step<=num_samples; step++)
+		{
+			m_iter_counter++;
+			float64_t learning_rate=1.0;
+			if(m_learning_rate)
+				learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
+
+			// the support of the sample, brought up to date before the
+			// gradient at the current variables is computed
+			grad_old.clear();
+			fun->get_sample_gradient(order[step-1], m_previous_variable, grad_old);
+			for(const auto& entry : grad_old)
+				catch_up(entry.feat_index, step-1);
+
+			grad_new.clear();
+			fun->get_sample_gradient(order[step-1], variable_reference, grad_new);
+			require(grad_new.size()==grad_old.size(),
+				"The non-zero entries of the sample gradient must not depend on the variables");
+
+			for(size_t k=0; k<grad_new.size(); k++)
+			{
+				index_t idx=grad_new[k].feat_index;
+				require(idx==grad_old[k].feat_index,
+					"The non-zero entries of the sample gradient must not depend on the variables");
+				float64_t grad=grad_new[k].entry-grad_old[k].entry+m_average_gradient[idx];
+				variable_reference[idx]-=learning_rate*(grad+penalty_weight*variable_reference[idx]);
+				last_step[idx]=step;
+			}
+
+			float64_t decay=1.0-learning_rate*penalty_weight;
+			scale[step]=decay*scale[step-1];
+			offset[step]=decay*offset[step-1]-learning_rate;
+			if(std::abs(scale[step])<1e-100)
+			{
+				// renormalize before the ratios underflow
+				catch_up_all(step);
+				scale[step]=1.0;
+				offset[step]=0.0;
+			}
+		}
+		catch_up_all(num_samples);
+	}
+}
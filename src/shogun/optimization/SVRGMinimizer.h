@@ -33,6 +33,7 @@
 #define SVRGMINIMIZER_H
 #include <shogun/optimization/FirstOrderStochasticMinimizer.h>
 #include <shogun/optimization/FirstOrderSAGCostFunction.h>
+#include <shogun/mathematics/RandomMixin.h>
 namespace shogun
 {
 
@@ -44,7 +45,7 @@ namespace shogun
  * Advances in Neural Information Processing Systems. 2013.
  */
 
-class SVRGMinimizer: public FirstOrderStochasticMinimizer
+class SVRGMinimizer: public RandomMixin<FirstOrderStochasticMinimizer>
 {
 public:
 	/** Default constructor */
@@ -112,10 +113,56 @@ public:
 		m_svrg_interval=interval;
 	}
 
+	/** Set whether to update only the coordinates in the support of a sample
+	 *
+	 * Every update of SVRG adds the average gradient to all coordinates. With
+	 * lazy updates, the additions to the coordinates outside of the support
+	 * of the sample gradient are deferred until the coordinate is in the
+	 * support of a sample or the pass ends, where they are applied at once
+	 * in closed form. A step then costs time in the number of non-zero
+	 * entries of FirstOrderStochasticCostFunction::get_sample_gradient()
+	 * instead of the number of variables, and the average gradient is
+	 * computed in parallel from
+	 * FirstOrderStochasticCostFunction::get_batch_gradient(). The result is
+	 * the same as with dense updates of the shuffled samples.
+	 *
+	 * The indices of the non-zero entries of a sample gradient must not
+	 * depend on the target variables (eg, the non-zero features of a
+	 * sample). Only supported with a GradientDescendUpdater without
+	 * correction, a batch size of one and no penalty or L2Penalty.
+	 *
+	 * @param lazy_updates whether to update lazily
+	 */
+	void set_lazy_updates(bool lazy_updates) { m_lazy_updates=lazy_updates; }
+
+	/** Get whether to update only the coordinates in the support of a sample
+	 *
+	 * @return whether to update lazily
+	 */
+	bool get_lazy_updates() const { return m_lazy_updates; }
+
 protected:
 	/**  init the minimization process */
 	void init_minimization() override;
 
+	/** minimize with lazy updates, see set_lazy_updates()
+	 *
+	 * @param fun stochastic average gradient cost function
+	 * @param variable_reference target variables
+	 */
+	void minimize_lazy(const std::shared_ptr<FirstOrderSAGCostFunction>& fun,
+		SGVector<float64_t> variable_reference);
+
+	/** computes the average gradient with one shard of the samples per
+	 * thread
+	 *
+	 * @param fun stochastic average gradient cost function
+	 * @param variable target variables
+	 * @return average sample gradient at the target variables
+	 */
+	SGVector<float64_t> compute_average_gradient(const std::shared_ptr<FirstOrderSAGCostFunction>& fun,
+		const SGVector<float64_t>& variable);
+
 	/** the number to go through data  using SGD before SVRG update */
 	int32_t m_num_sgd_passes;
 
@@ -127,6 +174,9 @@ protected:
 
 	/**  used to store previous result */
 	SGVector<float64_t> m_previous_variable;
+
+	/** whether to update only the coordinates in the support of a sample */
+	bool m_lazy_updates;
 private:
 	/** Init */
 	void init();
@@ -8,6 +8,7 @@
 
 #include <shogun/regression/GaussianProcessRegression.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/machine/gp/ExactInferenceMethod.h>
 #include <shogun/machine/gp/FITCInferenceMethod.h>
 
 using namespace shogun;
@@ -30,6 +31,7 @@ GaussianProcessRegression::~GaussianProcessRegression()
 
 std::shared_ptr<RegressionLabels> GaussianProcessRegression::apply_regression(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	// check whether given combination of inference method and likelihood
 	// function supports regression
 	require(m_method, "Inference method should not be NULL");
@@ -103,6 +105,21 @@ bool GaussianProcessRegression::train_machine(std::shared_ptr<Features> data)
 	return true;
 }
 
+void GaussianProcessRegression::add_training_points(
+	const std::shared_ptr<Features>& data, const std::shared_ptr<Labels>& lab)
+{
+	require(m_method, "Inference method should not be NULL");
+	require(m_method->get_inference_type()==INF_EXACT,
+		"Adding training points requires exact inference, not {}",
+		m_method->get_name());
+
+	auto exact_method=m_method->as<ExactInferenceMethod>();
+	exact_method->add_training_points(data, lab);
+
+	// keep labels in sync for retraining
+	m_labels=m_method->get_labels();
+}
+
 SGVector<float64_t> GaussianProcessRegression::get_mean_vector(const std::shared_ptr<Features>& data)
 {
 	// check whether given combination of inference method and likelihood
@@ -48,6 +48,17 @@ public:
 	 */
 	std::shared_ptr<RegressionLabels> apply_regression(std::shared_ptr<Features> data=NULL) override;
 
+	/** add training points to a trained model with exact inference,
+	 * without refactorizing the kernel matrix of the previous points.
+	 * See ExactInferenceMethod::add_training_points().
+	 *
+	 * @param data features of the new points
+	 * @param lab regression labels of the new points
+	 */
+	void add_training_points(
+	    const std::shared_ptr<Features>& data,
+	    const std::shared_ptr<Labels>& lab);
+
 	/** get predicted mean vector
 	 *
 	 * @return predicted mean vector
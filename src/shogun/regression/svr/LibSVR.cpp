@@ -125,6 +125,8 @@ bool LibSVR::train_machine(std::shared_ptr<Features> data)
 	param.nu = nu;
 	param.kernel=kernel.get();
 	param.cache_size = kernel->get_cache_size();
+	param.cache_precision = kernel->get_cache_precision();
+	param.prefetch_size = 0;
 	param.max_train_time = m_max_train_time;
 	param.C = get_C1();
 	param.eps = epsilon;
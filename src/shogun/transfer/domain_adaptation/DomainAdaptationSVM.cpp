@@ -148,6 +148,7 @@ void DomainAdaptationSVM::set_train_factor(float64_t factor)
 
 std::shared_ptr<BinaryLabels> DomainAdaptationSVM::apply_binary(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	ASSERT(data)
 	ASSERT(presvm->get_bias()==0.0)
 
@@ -205,6 +205,7 @@ void DomainAdaptationSVMLinear::set_train_factor(float64_t factor)
 
 std::shared_ptr<BinaryLabels> DomainAdaptationSVMLinear::apply_binary(std::shared_ptr<Features> data)
 {
+	load_lazy_parameters();
 	ASSERT(presvm->get_bias()==0.0)
 
 	int32_t num_examples = data->get_num_vectors();
@@ -583,3 +583,24 @@ TEST(SGObject, auto_parameter)
     obj->put(MockObject::kAutoParameter, 1);
     EXPECT_EQ(obj->get<int32_t>(MockObject::kAutoParameter), 1);
 }
+
+TEST(SGObject, lazy_parameter_failed_load)
+{
+	auto obj = std::make_shared<MockObject>();
+	int32_t calls = 0;
+	obj->set_lazy_parameters(
+	    {std::string(MockObject::kInt)},
+	    [&calls](SGObject* o, std::string_view name) {
+		    if (calls++ == 0)
+			    throw std::runtime_error("stream is not available");
+		    // the loader accesses the parameter it loads
+		    o->put(std::string(name), o->get<int32_t>(name) + 42);
+	    });
+
+	EXPECT_THROW(obj->get<int32_t>(MockObject::kInt), std::runtime_error);
+	// the parameter is still pending after the failure
+	EXPECT_EQ(obj->get<int32_t>(MockObject::kInt), 42);
+	EXPECT_EQ(calls, 2);
+	EXPECT_EQ(obj->get<int32_t>(MockObject::kInt), 42);
+	EXPECT_EQ(calls, 2);
+}
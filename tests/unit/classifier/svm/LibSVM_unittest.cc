@@ -0,0 +1,95 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+#include <gtest/gtest.h>
+
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+#include <random>
+
+using namespace shogun;
+
+class LibSVMTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		const int32_t seed = 17;
+		const index_t num_vec = 200;
+		const index_t num_feat = 4;
+
+		SGMatrix<float64_t> matrix(num_feat, num_vec);
+		SGVector<float64_t> lab(num_vec);
+		std::mt19937_64 prng(seed);
+		NormalDistribution<float64_t> normal_dist;
+		for (index_t i = 0; i < num_vec; ++i)
+		{
+			lab[i] = i % 2 ? 1 : -1;
+			// overlapping classes, so that a good part of the alphas is
+			// bounded and the solver has to iterate for a while
+			for (index_t j = 0; j < num_feat; ++j)
+				matrix(j, i) = normal_dist(prng) + 0.5 * lab[i];
+		}
+
+		features = std::make_shared<DenseFeatures<float64_t>>(matrix);
+		labels = std::make_shared<BinaryLabels>(lab);
+	}
+
+	std::shared_ptr<LibSVM> train(
+	    int32_t prefetch_size, EKernelCachePrecision precision,
+	    int32_t cache_size = 10)
+	{
+		auto kernel = std::make_shared<GaussianKernel>(2.0);
+		kernel->set_cache_size(cache_size);
+		kernel->set_cache_precision(precision);
+		kernel->init(features, features);
+
+		auto svm = std::make_shared<LibSVM>(1.0, kernel, labels);
+		svm->set_prefetch_size(prefetch_size);
+		svm->train();
+		return svm;
+	}
+
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<BinaryLabels> labels;
+};
+
+TEST_F(LibSVMTest, prefetch_gives_same_solution)
+{
+	auto reference = train(0, KCP_FLOAT64);
+	auto prefetched = train(8, KCP_FLOAT64);
+
+	EXPECT_EQ(8, prefetched->get_prefetch_size());
+	EXPECT_NEAR(reference->get_bias(), prefetched->get_bias(), 1e-12);
+	EXPECT_EQ(
+	    reference->get_num_support_vectors(),
+	    prefetched->get_num_support_vectors());
+
+	auto alphas = reference->get_alphas();
+	auto prefetched_alphas = prefetched->get_alphas();
+	ASSERT_EQ(alphas.vlen, prefetched_alphas.vlen);
+	for (index_t i = 0; i < alphas.vlen; ++i)
+		EXPECT_NEAR(alphas[i], prefetched_alphas[i], 1e-12);
+}
+
+TEST_F(LibSVMTest, small_cache_float32)
+{
+	auto reference = train(0, KCP_FLOAT64);
+	// a cache that is too small for the kernel matrix forces evictions
+	auto small = train(4, KCP_FLOAT32, 0);
+
+	auto predicted = reference->apply_binary(features)->get_labels();
+	auto predicted_small = small->apply_binary(features)->get_labels();
+	index_t num_disagree = 0;
+	for (index_t i = 0; i < predicted.vlen; ++i)
+		num_disagree += predicted[i] != predicted_small[i];
+
+	EXPECT_LE(num_disagree, 2);
+	EXPECT_NEAR(reference->get_bias(), small->get_bias(), 1e-2);
+}
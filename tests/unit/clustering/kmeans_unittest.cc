@@ -9,6 +9,7 @@
 #include <shogun/clustering/KMeans.h>
 #include <shogun/clustering/KMeansMiniBatch.h>
 #include <shogun/distance/EuclideanDistance.h>
+#include <shogun/features/DataGenerator.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/lib/observers/ParameterObserver.h>
@@ -135,6 +136,57 @@ TEST(KMeans, KMeanspp_center_initialization_test)
 
 }
 
+TEST(KMeans, kmeans_parallel_center_initialization_test)
+{
+	/* four well separated groups of five points around (0,0) (0,100)
+	 * (100,0) (100,100) */
+	SGMatrix<float64_t> data(2, 20);
+	float64_t offsets[5][2]={{0,0}, {1,0}, {-1,0}, {0,1}, {0,-1}};
+	for (int32_t g=0; g<4; g++)
+	{
+		for (int32_t p=0; p<5; p++)
+		{
+			data(0, g*5+p)=100*(g/2)+offsets[p][0];
+			data(1, g*5+p)=100*(g%2)+offsets[p][1];
+		}
+	}
+
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+
+	for (int32_t loop=0; loop<10; loop++)
+	{
+		auto distance=std::make_shared<EuclideanDistance>(features, features);
+		auto clustering=std::make_shared<KMeans>(4, distance);
+		clustering->put("kmeans_parallel", true);
+		clustering->put("seed", loop);
+		clustering->train(features);
+
+		SGMatrix<float64_t> c=clustering->get_cluster_centers();
+		SGVector<int32_t> count=SGVector<int32_t>(4);
+		count.zero();
+		for (int32_t j=0; j<4; j++)
+		{
+			for (int32_t g=0; g<4; g++)
+			{
+				if (std::abs(c(0,j)-100*(g/2))<1e-10 &&
+				    std::abs(c(1,j)-100*(g%2))<1e-10)
+					count[g]++;
+			}
+		}
+
+		EXPECT_EQ(1, count[0]);
+		EXPECT_EQ(1, count[1]);
+		EXPECT_EQ(1, count[2]);
+		EXPECT_EQ(1, count[3]);
+	}
+
+	// the two initializations exclude each other
+	auto distance=std::make_shared<EuclideanDistance>(features, features);
+	auto clustering=std::make_shared<KMeans>(4, distance, true);
+	clustering->put("kmeans_parallel", true);
+	EXPECT_THROW(clustering->train(features), ShogunException);
+}
+
 TEST(KMeans, minibatch_training_test)
 {
 	/*create a rectangle with four points as (0,0) (0,1000) (2,0) (2,1000)*/
@@ -293,3 +345,33 @@ TEST(KMeans, random_centers_assign)
 
 }
 
+TEST(KMeans, hamerly_same_as_lloyd)
+{
+	/* Hamerly's bounds only skip distance computations, so both methods
+	 * have to converge to the same centers from the same initialization */
+	std::mt19937_64 prng(57);
+	const int32_t k=6;
+	SGMatrix<float64_t> data=
+	    DataGenerator::generate_gaussians(200, k, 3, prng);
+	auto features=std::make_shared<DenseFeatures<float64_t>>(data);
+
+	SGMatrix<float64_t> initial_centers(3, k);
+	for (int32_t j=0; j<k; j++)
+		initial_centers.set_column(j, data.get_column(j*37));
+
+	SGMatrix<float64_t> centers[2];
+	EKMeansMethod methods[]={KMM_LLOYD, KMM_HAMERLY};
+	for (int32_t m=0; m<2; m++)
+	{
+		auto distance=std::make_shared<EuclideanDistance>(features, features);
+		auto clustering=
+		    std::make_shared<KMeans>(k, distance, initial_centers.clone());
+		clustering->set_kmeans_method(methods[m]);
+		clustering->train(features);
+		centers[m]=clustering->get_cluster_centers();
+	}
+
+	for (int32_t j=0; j<k; j++)
+		for (int32_t i=0; i<3; i++)
+			EXPECT_NEAR(centers[0](i, j), centers[1](i, j), 1e-10);
+}
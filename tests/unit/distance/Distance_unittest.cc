@@ -6,9 +6,18 @@
 
 #include <gtest/gtest.h>
 
+#include <shogun/distance/ChebyshewMetric.h>
+#include <shogun/distance/ChiSquareDistance.h>
+#include <shogun/distance/CosineDistance.h>
 #include <shogun/distance/CustomMahalanobisDistance.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/distance/ManhattanMetric.h>
+#include <shogun/distance/MinkowskiMetric.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+#include <random>
 
 using namespace shogun;
 
@@ -37,3 +46,61 @@ TEST(Distance, custom_mahalanobis)
 
 
 }
+
+TEST(Distance, distance_block)
+{
+	const index_t dim=7;
+	// more vectors than in a single tile of get_distance_matrix
+	const index_t num_lhs=300;
+	const index_t num_rhs=270;
+
+	std::mt19937_64 prng(57);
+	NormalDistribution<float64_t> normal_dist;
+	SGMatrix<float64_t> data_lhs(dim, num_lhs);
+	SGMatrix<float64_t> data_rhs(dim, num_rhs);
+	for (index_t i=0; i<data_lhs.size(); ++i)
+		data_lhs[i]=normal_dist(prng);
+	for (index_t i=0; i<data_rhs.size(); ++i)
+		data_rhs[i]=normal_dist(prng);
+
+	auto feats_lhs=std::make_shared<DenseFeatures<float64_t>>(data_lhs);
+	auto feats_rhs=std::make_shared<DenseFeatures<float64_t>>(data_rhs);
+	// blocks of vectors in a subset are copied
+	SGVector<index_t> subset(num_rhs/2);
+	for (index_t i=0; i<subset.vlen; ++i)
+		subset[i]=num_rhs-1-2*i;
+	auto feats_subset=std::make_shared<DenseFeatures<float64_t>>(data_rhs);
+	feats_subset->add_subset(subset);
+
+	std::vector<std::shared_ptr<Distance>> distances = {
+		std::make_shared<EuclideanDistance>(),
+		std::make_shared<ManhattanMetric>(),
+		std::make_shared<ChebyshewMetric>(),
+		std::make_shared<CosineDistance>(),
+		std::make_shared<ChiSquareDistance>(),
+		std::make_shared<MinkowskiMetric>(3.0)};
+
+	for (const auto& distance : distances)
+	{
+		for (const auto& rhs : {feats_lhs, feats_rhs, feats_subset})
+		{
+			distance->init(feats_lhs, rhs);
+
+			SGMatrix<float64_t> block(20, 11);
+			distance->distance_block(13, 20, 5, 11, block);
+			for (index_t i=0; i<block.num_rows; ++i)
+				for (index_t j=0; j<block.num_cols; ++j)
+					EXPECT_NEAR(block(i, j), distance->distance(13+i, 5+j), 1E-10);
+
+			SGMatrix<float64_t> dm=distance->get_distance_matrix();
+			ASSERT_EQ(dm.num_rows, num_lhs);
+			ASSERT_EQ(dm.num_cols, rhs->get_num_vectors());
+			for (index_t i=0; i<dm.num_rows; ++i)
+				for (index_t j=0; j<dm.num_cols; ++j)
+					EXPECT_NEAR(dm(i, j), distance->distance(i, j), 1E-10);
+		}
+
+		SGMatrix<float64_t> wrong_size(2, 2);
+		EXPECT_THROW(distance->distance_block(0, 3, 0, 2, wrong_size), ShogunException);
+	}
+}
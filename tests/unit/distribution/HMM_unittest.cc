@@ -0,0 +1,169 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/distributions/HMM.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/mathematics/UniformIntDistribution.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace shogun;
+
+static std::shared_ptr<StringFeatures<uint16_t>> hmm_observations(
+    int32_t num_sequences, int32_t num_symbols)
+{
+	std::mt19937_64 prng(17);
+	UniformIntDistribution<int32_t> uniform_int_dist;
+
+	std::vector<SGVector<uint16_t>> sequences;
+	for (int32_t i = 0; i < num_sequences; ++i)
+	{
+		SGVector<uint16_t> sequence(uniform_int_dist(prng, {1, 30}));
+		// mostly runs of the same symbol, so that there is structure to learn
+		uint16_t symbol = 0;
+		for (auto& o : sequence)
+		{
+			if (uniform_int_dist(prng, {0, 4}) == 0)
+				symbol = uniform_int_dist(prng, {0, num_symbols - 1});
+			o = symbol;
+		}
+		sequences.push_back(sequence);
+	}
+	return std::make_shared<StringFeatures<uint16_t>>(sequences, RAWBYTE);
+}
+
+TEST(HMM, estimate_model_baum_welch)
+{
+	const int32_t N = 3;
+	const int32_t M = 4;
+	auto feats = hmm_observations(50, M);
+	auto hmm = std::make_shared<HMM>(feats, N, M, 1e-10);
+
+	auto estimate = std::make_shared<HMM>(hmm);
+	estimate->estimate_model_baum_welch(hmm);
+	auto prob = hmm->model_probability();
+
+	// same likelihood as the serial forward algorithm
+	hmm->invalidate_model();
+	EXPECT_NEAR(hmm->model_probability(), prob, 1e-8);
+
+	// the likelihood of the data does not decrease
+	EXPECT_GE(estimate->model_probability(), prob - 1e-8);
+
+#ifndef USE_HMMPARALLEL
+	auto reference = std::make_shared<HMM>(hmm);
+	reference->estimate_model_baum_welch_old(hmm);
+
+	for (int32_t i = 0; i < N; ++i)
+	{
+		EXPECT_NEAR(estimate->get_p(i), reference->get_p(i), 1e-8);
+		EXPECT_NEAR(estimate->get_q(i), reference->get_q(i), 1e-8);
+		for (int32_t j = 0; j < N; ++j)
+			EXPECT_NEAR(estimate->get_a(i, j), reference->get_a(i, j), 1e-8);
+		for (int32_t j = 0; j < M; ++j)
+			EXPECT_NEAR(estimate->get_b(i, j), reference->get_b(i, j), 1e-8);
+	}
+#endif
+}
+
+TEST(HMM, estimate_model_viterbi)
+{
+	const int32_t N = 3;
+	const int32_t M = 4;
+	auto feats = hmm_observations(50, M);
+	auto hmm = std::make_shared<HMM>(feats, N, M, 1e-10);
+
+	auto estimate = std::make_shared<HMM>(hmm);
+	estimate->estimate_model_viterbi(hmm);
+	auto pat_prob = hmm->best_path(-1);
+
+	hmm->invalidate_model();
+	EXPECT_NEAR(hmm->best_path(-1), pat_prob, 1e-8);
+
+	float64_t p_sum = 0;
+	for (int32_t i = 0; i < N; ++i)
+		p_sum += std::exp(estimate->get_p(i));
+	EXPECT_NEAR(p_sum, 1, 1e-8);
+}
+
+TEST(HMM, forward_backward_underflow)
+{
+	const int32_t N = 3;
+	const int32_t M = 2;
+	auto feats = hmm_observations(10, M);
+	auto hmm = std::make_shared<HMM>(feats, N, M, 1e-10);
+
+	// log probabilities far apart, so that the scaled sums underflow
+	const float64_t a[N][N] = {{-0.1, -800, -2}, {-1, -1, -900}, {-750, -0.5, -1}};
+	const float64_t b[N][M] = {{-0.2, -1000}, {-3, -0.1}, {-700, -0.7}};
+	for (int32_t i = 0; i < N; ++i)
+	{
+		hmm->set_p(i, -1 - i);
+		hmm->set_q(i, -2 + i * 0.5);
+		for (int32_t j = 0; j < N; ++j)
+			hmm->set_a(i, j, a[i][j]);
+		for (int32_t j = 0; j < M; ++j)
+			hmm->set_b(i, j, b[i][j]);
+	}
+	hmm->invalidate_model();
+
+	auto log_sum = [](float64_t x, float64_t y) {
+		auto max = std::max(x, y);
+		return max + std::log(std::exp(x - max) + std::exp(y - max));
+	};
+
+	for (int32_t dim = 0; dim < feats->get_num_vectors(); ++dim)
+	{
+		auto obs = feats->get_feature_vector(dim);
+		auto len = obs.vlen;
+
+		std::vector<float64_t> alpha(N), beta(N), next(N);
+		for (int32_t i = 0; i < N; ++i)
+		{
+			alpha[i] = hmm->get_p(i) + hmm->get_b(i, obs[0]);
+			beta[i] = hmm->get_q(i);
+		}
+		for (int32_t t = 1; t < len; ++t)
+		{
+			for (int32_t j = 0; j < N; ++j)
+			{
+				next[j] = alpha[0] + hmm->get_a(0, j);
+				for (int32_t i = 1; i < N; ++i)
+					next[j] = log_sum(next[j], alpha[i] + hmm->get_a(i, j));
+				next[j] += hmm->get_b(j, obs[t]);
+			}
+			std::swap(alpha, next);
+		}
+		for (int32_t t = len - 1; t > 0; --t)
+		{
+			for (int32_t i = 0; i < N; ++i)
+			{
+				next[i] = hmm->get_a(i, 0) + hmm->get_b(0, obs[t]) + beta[0];
+				for (int32_t j = 1; j < N; ++j)
+					next[i] = log_sum(
+					    next[i],
+					    hmm->get_a(i, j) + hmm->get_b(j, obs[t]) + beta[j]);
+			}
+			std::swap(beta, next);
+		}
+
+		float64_t prob = alpha[0] + hmm->get_q(0);
+		for (int32_t i = 1; i < N; ++i)
+			prob = log_sum(prob, alpha[i] + hmm->get_q(i));
+
+		EXPECT_NEAR(hmm->model_probability(dim), prob, 1e-8 * (1 + std::abs(prob)));
+		for (int32_t i = 0; i < N; ++i)
+		{
+			EXPECT_NEAR(
+			    hmm->model_derivative_p(i, dim) - hmm->get_b(i, obs[0]),
+			    beta[i], 1e-8 * (1 + std::abs(beta[i])));
+		}
+	}
+}
@@ -10,6 +10,7 @@
 #include <numeric>
 #include <shogun/util/zip_iterator.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/io/MemoryMappedFile.h>
 #include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/mathematics/UniformIntDistribution.h>
 #include <shogun/mathematics/NormalDistribution.h>
@@ -17,6 +18,9 @@
 #include <shogun/util/zip_iterator.h>
 
 #include <random>
+#include <stdio.h>
+
+#include "../utils/Utils.h"
 
 namespace shogun
 {
@@ -332,4 +336,62 @@ TEST(DenseFeaturesTest, const_iterator)
         for (const auto& [test, truth]: zip_iterator(iter, tmp))
             EXPECT_EQ(test, truth);
     }
-}
\ No newline at end of file
+}
+
+TEST(DenseFeaturesTest, memory_mapped)
+{
+	SGVector<float64_t> vals(20);
+	vals.range_fill();
+	auto mat = SGMatrix(vals, 5, 4);
+	auto orig = std::make_shared<DenseFeatures<float64_t>>(mat);
+
+	char fname[] = "DenseFeatures_mapped.XXXXXX";
+	generate_temp_filename(fname);
+	orig->save_mapped(fname);
+
+	{
+		auto feats = std::make_shared<DenseFeatures<float64_t>>(
+		    std::make_shared<MemoryMappedFile<char>>(fname));
+		EXPECT_EQ(feats->get_num_features(), mat.num_rows);
+		EXPECT_EQ(feats->get_num_vectors(), mat.num_cols);
+
+		auto mapped = feats->get_feature_matrix();
+		EXPECT_NE(mapped.matrix, mat.matrix);
+		EXPECT_TRUE(mapped.equals(mat));
+
+		auto copy = feats->duplicate()->as<DenseFeatures<float64_t>>();
+		feats.reset();
+		EXPECT_TRUE(copy->get_feature_matrix().equals(mat));
+
+		EXPECT_THROW(
+		    std::make_shared<DenseFeatures<int32_t>>(
+		        std::make_shared<MemoryMappedFile<char>>(fname)),
+		    ShogunException);
+	}
+
+	std::remove(fname);
+}
+
+TEST(DenseFeaturesTest, memory_mapped_subset)
+{
+	SGVector<float64_t> vals(20);
+	vals.range_fill();
+	auto mat = SGMatrix(vals, 5, 4);
+	auto orig = std::make_shared<DenseFeatures<float64_t>>(mat);
+	SGVector<index_t> subset {3, 1};
+	orig->add_subset(subset);
+
+	char fname[] = "DenseFeatures_mapped.XXXXXX";
+	generate_temp_filename(fname);
+	orig->save_mapped(fname);
+
+	{
+		auto feats = std::make_shared<DenseFeatures<float64_t>>(
+		    std::make_shared<MemoryMappedFile<char>>(fname));
+		EXPECT_EQ(feats->get_num_vectors(), subset.vlen);
+		EXPECT_TRUE(feats->get_feature_matrix().equals(
+		    orig->get_feature_matrix()));
+	}
+
+	std::remove(fname);
+}
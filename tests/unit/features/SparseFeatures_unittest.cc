@@ -5,6 +5,7 @@
  */
 #include <gtest/gtest.h>
 #include <shogun/base/ShogunEnv.h>
+#include <shogun/io/MemoryMappedFile.h>
 #include <shogun/io/fs/FileSystem.h>
 #include <shogun/io/serialization/JsonSerializer.h>
 #include <shogun/io/serialization/JsonDeserializer.h>
@@ -13,6 +14,9 @@
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/features/SparseFeatures.h>
 #include <string>
+#include <stdio.h>
+
+#include "../utils/Utils.h"
 
 using namespace shogun;
 
@@ -412,3 +416,40 @@ TEST(SparseFeaturesTest,subset_get_full_feature_vector_smaller)
 
 
 }
+
+TEST(SparseFeaturesTest, memory_mapped)
+{
+	SGMatrix<float64_t> data(3, 4);
+	data.zero();
+	data(0, 0)=1;
+	data(2, 0)=2;
+	data(1, 2)=3;
+	data(0, 3)=4;
+	data(1, 3)=5;
+	data(2, 3)=6;
+
+	auto orig=std::make_shared<SparseFeatures<float64_t>>(data);
+
+	char fname[] = "SparseFeatures_mapped.XXXXXX";
+	generate_temp_filename(fname);
+	orig->save_mapped(fname);
+
+	auto feats=std::make_shared<SparseFeatures<float64_t>>(
+		std::make_shared<MemoryMappedFile<char>>(fname));
+	EXPECT_EQ(feats->get_num_features(), data.num_rows);
+	EXPECT_EQ(feats->get_num_vectors(), data.num_cols);
+	EXPECT_EQ(feats->get_num_nonzero_entries(), 6);
+	EXPECT_EQ(feats->get_sparse_feature_vector(1).num_feat_entries, 0);
+
+	for (index_t i=0; i<feats->get_num_vectors(); ++i)
+	{
+		SGVector<float64_t> vec=feats->get_full_feature_vector(i);
+		for (index_t j=0; j<vec.vlen; ++j)
+			EXPECT_EQ(vec[j], data(j,i));
+	}
+
+	EXPECT_EQ(feats->dense_dot(1.0, 3, data.get_column_vector(3), data.num_rows, 0.0), 4*4+5*5+6*6);
+
+	feats.reset();
+	std::remove(fname);
+}
@@ -66,6 +66,119 @@ TEST(StreamingDenseFeaturesTest, example_reading_from_file)
 
 
 
+	std::remove(fname);
+}
+
+TEST(StreamingDenseFeaturesTest, example_reading_through_small_ring)
+{
+	int32_t seed = 17;
+	index_t n=1000;
+	index_t dim=3;
+	char fname[] = "StreamingDenseFeatures_small_ring.XXXXXX";
+	generate_temp_filename(fname);
+
+	std::mt19937_64 prng(seed);
+	NormalDistribution<float64_t> normal_dist;
+
+	SGMatrix<float64_t> data(dim,n);
+	for (index_t i=0; i<dim*n; ++i)
+		data.matrix[i] = normal_dist(prng);
+
+	auto orig_feats=std::make_shared<DenseFeatures<float64_t>>(data);
+	auto saved_features = std::make_shared<CSVFile>(fname, 'w');
+	orig_feats->save(saved_features);
+	saved_features->close();
+
+	// ring smaller than a batch, so that parser and reader
+	// have to hand over the slots many times
+	auto input = std::make_shared<StreamingAsciiFile>(fname);
+	input->set_delimiter(',');
+	auto feats
+		= std::make_shared<StreamingDenseFeatures<float64_t>>(input, false, 7);
+
+	index_t i = 0;
+	feats->start_parser();
+	while (feats->get_next_example())
+	{
+		SGVector<float64_t> example = feats->get_vector();
+		SGVector<float64_t> expected = orig_feats->get_feature_vector(i);
+
+		ASSERT_EQ(dim, example.vlen);
+
+		for (index_t j = 0; j < dim; j++)
+			EXPECT_NEAR(expected.vector[j], example.vector[j], 1E-5);
+
+		feats->release_example();
+		i++;
+	}
+	feats->end_parser();
+	EXPECT_EQ(n, i);
+
+	std::remove(fname);
+}
+
+TEST(StreamingDenseFeaturesTest, example_reading_on_several_threads)
+{
+	int32_t seed = 17;
+	index_t n=500;
+	index_t dim=3;
+	char fname[] = "StreamingDenseFeatures_parse_threads.XXXXXX";
+	generate_temp_filename(fname);
+
+	std::mt19937_64 prng(seed);
+	NormalDistribution<float64_t> normal_dist;
+
+	SGMatrix<float64_t> data(dim,n);
+	for (index_t i=0; i<dim*n; ++i)
+		data.matrix[i] = normal_dist(prng);
+
+	auto orig_feats=std::make_shared<DenseFeatures<float64_t>>(data);
+	auto saved_features = std::make_shared<CSVFile>(fname, 'w');
+	orig_feats->save(saved_features);
+	saved_features->close();
+
+	for (auto preserve_order : {true, false})
+	{
+		auto input = std::make_shared<StreamingAsciiFile>(fname);
+		input->set_delimiter(',');
+		input->set_parse_threads(3, preserve_order);
+		input->set_shard_size(256);
+		auto feats = std::make_shared<StreamingDenseFeatures<float64_t>>(
+			input, false, 16);
+
+		SGVector<bool> seen(n);
+		seen.zero();
+		index_t i = 0;
+		feats->start_parser();
+		while (feats->get_next_example())
+		{
+			SGVector<float64_t> example = feats->get_vector();
+			ASSERT_EQ(dim, example.vlen);
+
+			// without order, look the example up by its first entry
+			index_t index = i;
+			if (!preserve_order)
+			{
+				for (index = 0; index < n; index++)
+				{
+					if (std::abs(data(0, index) - example[0]) < 1E-5)
+						break;
+				}
+				ASSERT_LT(index, n);
+			}
+
+			for (index_t j = 0; j < dim; j++)
+				EXPECT_NEAR(data(j, index), example[j], 1E-5);
+			EXPECT_FALSE(seen[index]);
+			seen[index] = true;
+
+			feats->release_example();
+			i++;
+		}
+		feats->end_parser();
+		EXPECT_EQ(n, i);
+	}
+
 	std::remove(fname);
 }
 
@@ -77,6 +77,77 @@ TEST(StreamingSparseFeaturesTest, parse_file)
   stream_features->end_parser();
 
 
+  SG_FREE(data);
+  SG_FREE(labels);
+
+  std::remove(fname);
+}
+
+TEST(StreamingSparseFeaturesTest, parse_file_on_several_threads)
+{
+  char fname[] = "StreamingSparseFeatures_parse_threads.XXXXXX";
+  generate_temp_filename(fname);
+
+  int32_t seed = 100;
+  int32_t max_num_entries=20;
+  int32_t max_label_value=1;
+  float64_t max_entry_value=1;
+
+  int32_t num_vec=200;
+  int32_t num_feat=0;
+
+  std::mt19937_64 prng(seed);
+  UniformIntDistribution<int32_t> uniform_int_dist;
+  UniformRealDistribution<float64_t> uniform_real_dist;
+
+  SGSparseVector<float64_t>* data=SG_MALLOC(SGSparseVector<float64_t>, num_vec);
+  float64_t* labels=SG_MALLOC(float64_t, num_vec);
+  for (int32_t i=0; i<num_vec; i++)
+  {
+    data[i]=SGSparseVector<float64_t>(uniform_int_dist(prng, {0, max_num_entries}));
+    labels[i]=(float64_t) uniform_int_dist(prng, {-max_label_value, max_label_value});
+    for (int32_t j=0; j<data[i].num_feat_entries; j++)
+    {
+      int32_t feat_index=(j+1)*2;
+      if (feat_index>num_feat)
+        num_feat=feat_index;
+
+      data[i].features[j].feat_index=feat_index-1;
+      data[i].features[j].entry=uniform_real_dist(prng, {0.0, max_entry_value});
+    }
+  }
+  auto fout = std::make_shared<LibSVMFile>(fname, 'w');
+  fout->set_sparse_matrix(data, num_feat, num_vec, labels);
+  fout.reset();
+
+  // shards much smaller than the file, so that lines cross shard borders
+  auto file = std::make_shared<StreamingAsciiFile>(fname);
+  file->set_parse_threads(4);
+  file->set_shard_size(100);
+  auto stream_features =
+    std::make_shared<StreamingSparseFeatures<float64_t>>(file, true, 8);
+
+  stream_features->start_parser();
+  index_t i = 0;
+  while (stream_features->get_next_example())
+  {
+      ASSERT_LT(i, num_vec);
+      SGSparseVector<float64_t> v = stream_features->get_vector();
+      EXPECT_EQ(labels[i], stream_features->get_label());
+      EXPECT_EQ(data[i].num_feat_entries, v.num_feat_entries);
+
+      for (index_t j = 0; j < data[i].num_feat_entries; j++)
+      {
+        EXPECT_EQ(data[i].features[j].feat_index, v.features[j].feat_index);
+        EXPECT_DOUBLE_EQ(data[i].features[j].entry, v.features[j].entry);
+      }
+
+      stream_features->release_example();
+      i++;
+  }
+  stream_features->end_parser();
+  EXPECT_EQ(num_vec, i);
+
   SG_FREE(data);
   SG_FREE(labels);
 
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cmath>
 
 #include <shogun/io/ShogunErrc.h>
 #include <shogun/io/serialization/BitserySerializer.h>
@@ -11,6 +12,7 @@
 
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/kernel/GaussianKernel.h>
+#include <shogun/regression/LinearRidgeRegression.h>
 
 using namespace shogun;
 using namespace shogun::io;
@@ -119,6 +121,29 @@ private:
 	string::const_iterator m_current_pos;
 };
 
+class CountingInputStream : public DummyInputStream
+{
+public:
+	CountingInputStream(const string& buffer) : DummyInputStream(buffer)
+	{
+	}
+
+	error_condition read(string* buffer, int64_t size) override
+	{
+		auto ec = DummyInputStream::read(buffer, size);
+		m_bytes_read += buffer->size();
+		return ec;
+	}
+
+	size_t bytes_read() const
+	{
+		return m_bytes_read;
+	}
+
+private:
+	size_t m_bytes_read = 0;
+};
+
 template <typename T>
 class SerializationTest : public ::testing::Test {};
 
@@ -145,3 +170,88 @@ TYPED_TEST(SerializationTest, serialize)
 
 	ASSERT_TRUE(obj->equals(deser_obj));
 }
+
+TYPED_TEST(SerializationTest, serialize_dense_containers)
+{
+	SGMatrix<float64_t> data(7, 301);
+	for (index_t i = 0; i < data.num_rows * data.num_cols; ++i)
+		data[i] = std::sin(i) * 1e3;
+	SGMatrix<int32_t> int_data(3, 50);
+	for (index_t i = 0; i < int_data.num_rows * int_data.num_cols; ++i)
+		int_data[i] = i * 7919 - 100000;
+
+	auto float_features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto int_features = std::make_shared<DenseFeatures<int32_t>>(int_data);
+
+	for (const auto& obj :
+	     {std::static_pointer_cast<SGObject>(float_features),
+	      std::static_pointer_cast<SGObject>(int_features)})
+	{
+		auto serializer = std::make_shared<typename TypeParam::first_type>();
+		auto stream = std::make_shared<DummyOutputStream>();
+		serializer->attach(stream);
+		serializer->write(obj);
+
+		auto deserializer = std::make_shared<typename TypeParam::second_type>();
+		auto istream = std::make_shared<DummyInputStream>(stream->buffer());
+		deserializer->attach(istream);
+		auto deser_obj = deserializer->read_object();
+
+		ASSERT_TRUE(obj->equals(deser_obj));
+	}
+}
+
+TEST(BitseryDeserializer, read_object_lazy)
+{
+	SGVector<float64_t> w(10000);
+	for (index_t i = 0; i < w.vlen; ++i)
+		w[i] = std::sin(i);
+	auto obj = std::make_shared<LinearRidgeRegression>();
+	obj->put("w", w);
+	obj->put("bias", 0.5);
+
+	auto serializer = std::make_shared<BitserySerializer>();
+	serializer->set_table_of_contents(true);
+	auto stream = std::make_shared<DummyOutputStream>();
+	serializer->attach(stream);
+	serializer->write(obj);
+
+	// the indexed format can also be read at once
+	auto deserializer = std::make_shared<BitseryDeserializer>();
+	deserializer->attach(std::make_shared<DummyInputStream>(stream->buffer()));
+	ASSERT_TRUE(obj->equals(deserializer->read_object()));
+
+	auto istream = std::make_shared<CountingInputStream>(stream->buffer());
+	deserializer->attach(istream);
+	auto deser_obj = deserializer->read_object_lazy();
+	ASSERT_NE(deser_obj, nullptr);
+	auto header_bytes = istream->bytes_read();
+	EXPECT_LT(header_bytes, sizeof(float64_t) * w.vlen);
+
+	// parameters are read on first access, the others remain unread
+	EXPECT_EQ(deser_obj->get<float64_t>("bias"), 0.5);
+	EXPECT_LT(istream->bytes_read(), sizeof(float64_t) * w.vlen);
+
+	// the apply methods load the pending parameters
+	SGMatrix<float64_t> data(w.vlen, 2);
+	for (index_t i = 0; i < data.num_rows * data.num_cols; ++i)
+		data[i] = std::cos(i);
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto expected = obj->apply_regression(features)->get_labels();
+	auto result = deser_obj->as<LinearRidgeRegression>()
+	                  ->apply_regression(features)
+	                  ->get_labels();
+	EXPECT_GT(istream->bytes_read(), sizeof(float64_t) * w.vlen);
+	for (index_t i = 0; i < expected.vlen; ++i)
+		EXPECT_EQ(expected[i], result[i]);
+	ASSERT_TRUE(obj->equals(deser_obj));
+
+	// members of other objects are used directly, they are read at once
+	auto df = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto kernel = std::make_shared<GaussianKernel>(df, df, 2.0);
+	stream = std::make_shared<DummyOutputStream>();
+	serializer->attach(stream);
+	serializer->write(kernel);
+	deserializer->attach(std::make_shared<DummyInputStream>(stream->buffer()));
+	EXPECT_THROW(deserializer->read_object_lazy(), ShogunException);
+}
@@ -0,0 +1,190 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/kernel/KernelRowCache.h>
+
+#include <atomic>
+
+using namespace shogun;
+
+namespace
+{
+	// value of the "kernel" at (i, j)
+	float64_t value(int32_t i, int32_t j)
+	{
+		return i * 100.0 + j + 0.25;
+	}
+
+	KernelRowCache::RowComputer counting_computer(std::atomic<int32_t>& count)
+	{
+		return [&count](int32_t row, float64_t* out, int32_t start, int32_t end) {
+			for (int32_t j = start; j < end; ++j)
+			{
+				out[j] = value(row, j);
+				++count;
+			}
+		};
+	}
+}
+
+TEST(KernelRowCache, get_row)
+{
+	const int32_t num_rows = 10;
+	KernelRowCache cache(num_rows, 1 << 20, KCP_FLOAT64, 1);
+	std::atomic<int32_t> computed(0);
+	auto compute = counting_computer(computed);
+
+	auto row = cache.get_row(3, num_rows, compute);
+	ASSERT_TRUE(row.valid());
+	EXPECT_EQ(num_rows, row.size());
+	EXPECT_EQ(num_rows, computed);
+	for (int32_t j = 0; j < num_rows; ++j)
+		EXPECT_EQ(value(3, j), row[j]);
+	ASSERT_NE(nullptr, row.data<float64_t>());
+	EXPECT_EQ(nullptr, row.data<float32_t>());
+
+	// second request is served from the cache
+	auto again = cache.get_row(3, num_rows, compute);
+	EXPECT_EQ(num_rows, computed);
+	EXPECT_EQ(row.data<float64_t>(), again.data<float64_t>());
+
+	auto stats = cache.get_statistics();
+	EXPECT_EQ(1, stats.hits);
+	EXPECT_EQ(1, stats.misses);
+	EXPECT_EQ(0, stats.evictions);
+	EXPECT_EQ(int64_t(num_rows * sizeof(float64_t)), stats.bytes_used);
+}
+
+TEST(KernelRowCache, extend_prefix)
+{
+	const int32_t num_rows = 10;
+	KernelRowCache cache(num_rows, 1 << 20, KCP_FLOAT64, 1);
+	std::atomic<int32_t> computed(0);
+	auto compute = counting_computer(computed);
+
+	auto row = cache.get_row(1, 4, compute);
+	EXPECT_EQ(4, computed);
+	EXPECT_TRUE(cache.is_cached(1, 4));
+	EXPECT_FALSE(cache.is_cached(1, 5));
+
+	// only the missing part gets computed
+	row = cache.get_row(1, num_rows, compute);
+	EXPECT_EQ(num_rows, computed);
+	for (int32_t j = 0; j < num_rows; ++j)
+		EXPECT_EQ(value(1, j), row[j]);
+
+	// a shorter prefix is a hit
+	cache.get_row(1, 2, compute);
+	EXPECT_EQ(num_rows, computed);
+}
+
+TEST(KernelRowCache, eviction)
+{
+	const int32_t num_rows = 10;
+	// smallest possible cache holds two full rows
+	KernelRowCache cache(num_rows, 0, KCP_FLOAT64, 1);
+	std::atomic<int32_t> computed(0);
+	auto compute = counting_computer(computed);
+
+	auto evicted = cache.get_row(0, num_rows, compute);
+	cache.get_row(1, num_rows, compute);
+	cache.get_row(2, num_rows, compute);
+
+	EXPECT_FALSE(cache.is_cached(0, 1));
+	EXPECT_TRUE(cache.is_cached(1, num_rows));
+	EXPECT_TRUE(cache.is_cached(2, num_rows));
+	EXPECT_EQ(1, cache.get_statistics().evictions);
+
+	// handles stay valid after eviction
+	for (int32_t j = 0; j < num_rows; ++j)
+		EXPECT_EQ(value(0, j), evicted[j]);
+
+	// least recently used row goes first
+	cache.get_row(1, num_rows, compute);
+	cache.get_row(3, num_rows, compute);
+	EXPECT_TRUE(cache.is_cached(1, num_rows));
+	EXPECT_FALSE(cache.is_cached(2, 1));
+}
+
+TEST(KernelRowCache, float32_precision)
+{
+	const int32_t num_rows = 10;
+	KernelRowCache cache(num_rows, 1 << 20, KCP_FLOAT32);
+	std::atomic<int32_t> computed(0);
+
+	auto row = cache.get_row(5, num_rows, counting_computer(computed));
+	EXPECT_EQ(KCP_FLOAT32, cache.get_precision());
+	EXPECT_EQ(sizeof(float32_t), row.element_size());
+	ASSERT_NE(nullptr, row.data<float32_t>());
+	EXPECT_EQ(nullptr, row.data<float64_t>());
+
+	float64_t converted[num_rows];
+	row.copy_to(converted, 0, num_rows);
+	for (int32_t j = 0; j < num_rows; ++j)
+	{
+		EXPECT_FLOAT_EQ(value(5, j), row[j]);
+		EXPECT_FLOAT_EQ(value(5, j), converted[j]);
+	}
+	EXPECT_EQ(
+	    int64_t(num_rows * sizeof(float32_t)),
+	    cache.get_statistics().bytes_used);
+}
+
+TEST(KernelRowCache, swap_index)
+{
+	const int32_t num_rows = 6;
+	KernelRowCache cache(num_rows, 1 << 20, KCP_FLOAT64, 2);
+	std::atomic<int32_t> computed(0);
+	auto compute = counting_computer(computed);
+
+	cache.get_row(0, num_rows, compute);
+	cache.get_row(1, 3, compute);
+	cache.get_row(4, num_rows, compute);
+
+	cache.swap_index(1, 4);
+
+	// rows moved
+	EXPECT_TRUE(cache.is_cached(1, num_rows));
+	// full rows got their columns swapped
+	auto row = cache.get_row(0, num_rows, compute);
+	EXPECT_EQ(value(0, 4), row[1]);
+	EXPECT_EQ(value(0, 1), row[4]);
+	// rows covering only one of the columns are dropped, and so is
+	// their memory
+	EXPECT_FALSE(cache.is_cached(4, 1));
+	EXPECT_EQ(
+	    int64_t(2 * num_rows * sizeof(float64_t)),
+	    cache.get_statistics().bytes_used);
+}
+
+TEST(KernelRowCache, concurrent_access)
+{
+	const int32_t num_rows = 64;
+	KernelRowCache cache(
+	    num_rows, 8 * num_rows * sizeof(float64_t), KCP_FLOAT64, 4);
+	std::atomic<int32_t> computed(0);
+	auto compute = counting_computer(computed);
+	std::atomic<int32_t> mismatches(0);
+
+#pragma omp parallel for num_threads(4)
+	for (int32_t k = 0; k < 4 * num_rows; ++k)
+	{
+		int32_t i = (k * 7) % num_rows;
+		auto row = cache.get_row(i, num_rows, compute);
+		for (int32_t j = 0; j < num_rows; ++j)
+		{
+			if (row[j] != value(i, j))
+				++mismatches;
+		}
+	}
+
+	EXPECT_EQ(0, mismatches);
+	auto stats = cache.get_statistics();
+	EXPECT_EQ(4 * num_rows, stats.hits + stats.misses);
+	EXPECT_LE(stats.bytes_used, int64_t(8 * num_rows * sizeof(float64_t)));
+}
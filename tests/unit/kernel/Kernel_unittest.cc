@@ -34,6 +34,9 @@
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/LinearKernel.h>
+#include <shogun/kernel/PolyKernel.h>
+#include <shogun/kernel/SigmoidKernel.h>
 #include <shogun/mathematics/NormalDistribution.h>
 
 using namespace shogun;
@@ -370,3 +373,71 @@ TEST(Kernel, gaussian_get_kernel_matrix)
 
 
 }
+
+TEST(Kernel, blocked_get_kernel_matrix)
+{
+	const int32_t seed = 100;
+	// more vectors than in a single tile of the blocked computation
+	const index_t num_feats_p=300;
+	const index_t num_feats_q=270;
+	const index_t dim=5;
+
+	std::mt19937_64 prng(seed);
+	SGMatrix<float64_t> data_p = generate_std_norm_matrix(num_feats_p, dim, prng);
+	SGMatrix<float64_t> data_q = generate_std_norm_matrix(num_feats_q, dim, prng);
+	auto feats_p=std::make_shared<DenseFeatures<float64_t>>(data_p);
+	auto feats_q=std::make_shared<DenseFeatures<float64_t>>(data_q);
+	// a subset that is not contiguous in the feature matrix
+	auto feats_r=std::make_shared<DenseFeatures<float64_t>>(data_q);
+	SGVector<index_t> subset(num_feats_q/2);
+	for (index_t i=0; i<subset.vlen; ++i)
+		subset[i]=num_feats_q-1-2*i;
+	feats_r->add_subset(subset);
+
+	std::vector<std::shared_ptr<Kernel>> kernels = {
+		std::make_shared<LinearKernel>(),
+		std::make_shared<PolyKernel>(10, 3, 1.0, 0.5),
+		std::make_shared<SigmoidKernel>(10, 0.1, 0.5)};
+
+	for (const auto& kernel : kernels)
+	{
+		ASSERT_TRUE(kernel->has_property(KP_DOTBLOCK));
+		for (const auto& rhs : {feats_p, feats_q, feats_r})
+		{
+			kernel->init(feats_p, rhs);
+			SGMatrix<float64_t> km=kernel->get_kernel_matrix();
+			ASSERT_EQ(km.num_rows, num_feats_p);
+			ASSERT_EQ(km.num_cols, rhs->get_num_vectors());
+			for (index_t i=0; i<km.num_rows; i++)
+				for (index_t j=0; j<km.num_cols; ++j)
+					EXPECT_NEAR(kernel->kernel(i,j), km(i, j), 1E-10);
+		}
+	}
+}
+
+TEST(Kernel, kernel_block)
+{
+	const int32_t seed = 100;
+	const index_t num_feats_p=20;
+	const index_t num_feats_q=15;
+	const index_t dim=5;
+
+	std::mt19937_64 prng(seed);
+	SGMatrix<float64_t> data_p = generate_std_norm_matrix(num_feats_p, dim, prng);
+	SGMatrix<float64_t> data_q = generate_std_norm_matrix(num_feats_q, dim, prng);
+	auto feats_p=std::make_shared<DenseFeatures<float64_t>>(data_p);
+	auto feats_q=std::make_shared<DenseFeatures<float64_t>>(data_q);
+	SGVector<index_t> subset {12, 3, 7, 0, 9, 1, 14};
+	feats_q->add_subset(subset);
+
+	auto kernel=std::make_shared<PolyKernel>(10, 3, 1.0, 0.5);
+	kernel->init(feats_p, feats_q);
+
+	SGMatrix<float64_t> block(6, 4);
+	kernel->kernel_block(10, 6, 2, 4, block);
+	for (index_t i=0; i<block.num_rows; i++)
+		for (index_t j=0; j<block.num_cols; ++j)
+			EXPECT_NEAR(kernel->kernel(10+i, 2+j), block(i, j), 1E-12);
+
+	EXPECT_THROW(kernel->kernel_block(10, 6, 4, 4, block), ShogunException);
+}
@@ -34,8 +34,10 @@
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/labels/RegressionLabels.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/loss/HuberLoss.h>
 #include <shogun/loss/SquaredLoss.h>
 #include <shogun/machine/StochasticGBMachine.h>
+#include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/multiclass/tree/CARTree.h>
 
@@ -177,3 +179,152 @@ TEST_F(StochasticGBMachineTest, sinusoid_curve_fitting_subset_fraction)
 	EXPECT_NEAR(ret[8], -0.4408978052, epsilon);
 	EXPECT_NEAR(ret[9], 0.5380825978, epsilon);
 }
+
+TEST_F(StochasticGBMachineTest, histogram_split_matches_exact_split)
+{
+	const int32_t seed = 2855;
+	const float64_t fraction = 0.6;
+
+	SGVector<bool> ft(1);
+	ft[0] = false;
+	auto sq = std::make_shared<SquaredLoss>();
+
+	// less training vectors than bins, so the bins hold one value each
+	auto tree = std::make_shared<CARTree>(ft);
+	tree->set_max_depth(2);
+	auto sgbm = std::make_shared<StochasticGBMachine>(tree, sq, 100, 0.1, fraction);
+	sgbm->put("seed", seed);
+	sgbm->set_labels(train_labels);
+	sgbm->train(train_feats);
+	auto expected = sgbm->apply_regression(test_feats)->get_labels();
+
+	auto binned_tree = std::make_shared<CARTree>(ft);
+	binned_tree->set_max_depth(2);
+	binned_tree->set_histogram_split(true);
+	sgbm = std::make_shared<StochasticGBMachine>(binned_tree, sq, 100, 0.1, fraction);
+	sgbm->put("seed", seed);
+	sgbm->set_labels(train_labels);
+	sgbm->train(train_feats);
+	auto ret = sgbm->apply_regression(test_feats)->get_labels();
+
+	for (index_t i = 0; i < num_test_samples; ++i)
+		EXPECT_NEAR(expected[i], ret[i], 1e-6);
+}
+
+TEST_F(StochasticGBMachineTest, histogram_split_subset)
+{
+	const int32_t seed = 2855;
+	const float64_t fraction = 0.6;
+
+	SGVector<bool> ft(1);
+	ft[0] = false;
+	auto sq = std::make_shared<SquaredLoss>();
+
+	// the trees of the iterations are trained on subsets of the subset
+	SGVector<index_t> subset(num_train_samples / 2);
+	for (index_t i = 0; i < subset.vlen; ++i)
+		subset[i] = 2 * i + 1;
+	train_feats->add_subset(subset);
+	train_labels->add_subset(subset);
+	auto subset_feats = std::make_shared<DenseFeatures<float64_t>>(
+	    train_feats->get_feature_matrix());
+	auto subset_labels =
+	    std::make_shared<RegressionLabels>(train_labels->get_labels());
+
+	auto tree = std::make_shared<CARTree>(ft);
+	tree->set_max_depth(2);
+	auto sgbm = std::make_shared<StochasticGBMachine>(tree, sq, 100, 0.1, fraction);
+	sgbm->put("seed", seed);
+	sgbm->set_labels(subset_labels);
+	sgbm->train(subset_feats);
+	auto expected = sgbm->apply_regression(test_feats)->get_labels();
+
+	auto binned_tree = std::make_shared<CARTree>(ft);
+	binned_tree->set_max_depth(2);
+	binned_tree->set_histogram_split(true);
+	sgbm = std::make_shared<StochasticGBMachine>(binned_tree, sq, 100, 0.1, fraction);
+	sgbm->put("seed", seed);
+	sgbm->set_labels(train_labels);
+	sgbm->train(train_feats);
+	auto ret = sgbm->apply_regression(test_feats)->get_labels();
+
+	for (index_t i = 0; i < num_test_samples; ++i)
+		EXPECT_NEAR(expected[i], ret[i], 1e-6);
+}
+
+TEST_F(StochasticGBMachineTest, compile)
+{
+	const int32_t seed = 2855;
+
+	SGVector<bool> ft(1);
+	ft[0] = false;
+	auto tree = std::make_shared<CARTree>(ft);
+	tree->set_max_depth(2);
+	auto sq = std::make_shared<SquaredLoss>();
+	auto sgbm = std::make_shared<StochasticGBMachine>(tree, sq, 100, 0.1, 0.6);
+	sgbm->put("seed", seed);
+	sgbm->set_labels(train_labels);
+	sgbm->train(train_feats);
+
+	auto expected = sgbm->apply_regression(test_feats)->get_labels();
+	sgbm->compile();
+	auto ret = sgbm->apply_regression(test_feats)->get_labels();
+	for (index_t i = 0; i < num_test_samples; ++i)
+		EXPECT_NEAR(expected[i], ret[i], 1e-12);
+}
+
+TEST_F(StochasticGBMachineTest, newton_boosting)
+{
+	const int32_t seed = 2855;
+
+	SGVector<bool> ft(1);
+	ft[0] = false;
+	auto tree = std::make_shared<CARTree>(ft);
+	tree->set_max_depth(2);
+	auto sq = std::make_shared<SquaredLoss>();
+	auto sgbm = std::make_shared<StochasticGBMachine>(tree, sq, 100, 0.1, 1.0);
+	sgbm->put("seed", seed);
+	sgbm->set_labels(train_labels);
+	sgbm->train(train_feats);
+	auto expected = sgbm->apply_regression(test_feats)->get_labels();
+
+	// the Newton step of the squared loss is the exact linesearch step
+	sgbm->set_newton_boosting(true);
+	sgbm->set_l2_regularization(0);
+	sgbm->train(train_feats);
+	auto ret = sgbm->apply_regression(test_feats)->get_labels();
+	for (index_t i = 0; i < num_test_samples; ++i)
+		EXPECT_NEAR(expected[i], ret[i], 1e-3);
+
+	// hessians of the huber loss vanish for large residuals
+	auto huber = std::make_shared<HuberLoss>(0.5);
+	sgbm = std::make_shared<StochasticGBMachine>(tree, huber, 100, 0.1, 1.0);
+	sgbm->set_newton_boosting(true);
+	sgbm->set_labels(train_labels);
+	sgbm->train(train_feats);
+	auto train_labels_vec = train_labels->get_labels();
+	ret = sgbm->apply_regression(train_feats)->get_labels();
+	float64_t mse = 0;
+	float64_t var = 0;
+	for (index_t i = 0; i < num_train_samples; ++i)
+	{
+		mse += Math::sq(ret[i] - train_labels_vec[i]);
+		var += Math::sq(train_labels_vec[i]);
+	}
+	EXPECT_LT(mse, 0.5 * var);
+
+	// with nearly all residuals in the linear part and no regularization,
+	// the leaf values stay of the order of the gradients
+	float64_t max_label = 0;
+	for (index_t i = 0; i < num_train_samples; ++i)
+		max_label = std::max(max_label, std::abs(train_labels_vec[i]));
+	huber = std::make_shared<HuberLoss>(0.01);
+	sgbm = std::make_shared<StochasticGBMachine>(tree, huber, 10, 0.1, 1.0);
+	sgbm->set_newton_boosting(true);
+	sgbm->set_l2_regularization(0);
+	sgbm->set_labels(train_labels);
+	sgbm->train(train_feats);
+	ret = sgbm->apply_regression(train_feats)->get_labels();
+	for (index_t i = 0; i < num_train_samples; ++i)
+		EXPECT_LT(std::abs(ret[i]), max_label);
+}
@@ -472,3 +472,78 @@ TEST(ExactInferenceMethod,get_posterior_mean2)
 	abs_tolerance = Math::get_abs_tolerance(-0.9860387397670280495987072, rel_tolerance);
 	EXPECT_NEAR(mu[4],  -0.9860387397670280495987072,  abs_tolerance);
 }
+
+TEST(ExactInferenceMethod,add_training_points)
+{
+	/* 1d sine wave, the last points are added incrementally */
+	index_t n=8;
+	index_t k=3;
+
+	SGMatrix<float64_t> X(1, n);
+	SGVector<float64_t> Y(n);
+	for (index_t i=0; i<n; ++i)
+	{
+		X[i]=0.7*i-2;
+		Y[i]=std::sin(X[i]);
+	}
+
+	SGMatrix<float64_t> X_old(1, n-k);
+	SGVector<float64_t> Y_old(n-k);
+	SGMatrix<float64_t> X_new(1, k);
+	SGVector<float64_t> Y_new(k);
+	for (index_t i=0; i<n; ++i)
+	{
+		if (i<n-k)
+		{
+			X_old[i]=X[i];
+			Y_old[i]=Y[i];
+		}
+		else
+		{
+			X_new[i-n+k]=X[i];
+			Y_new[i-n+k]=Y[i];
+		}
+	}
+
+	auto mean=std::make_shared<ConstMean>(0.5);
+	auto lik=std::make_shared<GaussianLikelihood>();
+	lik->set_sigma(0.3);
+
+	auto inf=std::make_shared<ExactInferenceMethod>(
+			std::make_shared<GaussianKernel>(10, 2),
+			std::make_shared<DenseFeatures<float64_t>>(X),
+			mean, std::make_shared<RegressionLabels>(Y), lik);
+	inf->set_scale(1.5);
+
+	auto inc_inf=std::make_shared<ExactInferenceMethod>(
+			std::make_shared<GaussianKernel>(10, 2),
+			std::make_shared<DenseFeatures<float64_t>>(X_old),
+			mean, std::make_shared<RegressionLabels>(Y_old), lik);
+	inc_inf->set_scale(1.5);
+	inc_inf->update();
+
+	inc_inf->add_training_points(
+			std::make_shared<DenseFeatures<float64_t>>(X_new),
+			std::make_shared<RegressionLabels>(Y_new));
+
+	EXPECT_EQ(inc_inf->get_features()->get_num_vectors(), n);
+	EXPECT_EQ(inc_inf->get_labels()->get_num_labels(), n);
+
+	SGMatrix<float64_t> L=inf->get_cholesky();
+	SGMatrix<float64_t> inc_L=inc_inf->get_cholesky();
+	for (index_t i=0; i<n*n; ++i)
+		EXPECT_NEAR(inc_L[i], L[i], 1E-10);
+
+	SGVector<float64_t> alpha=inf->get_alpha();
+	SGVector<float64_t> inc_alpha=inc_inf->get_alpha();
+	for (index_t i=0; i<n; ++i)
+		EXPECT_NEAR(inc_alpha[i], alpha[i], 1E-10);
+
+	EXPECT_NEAR(inc_inf->get_negative_log_marginal_likelihood(),
+			inf->get_negative_log_marginal_likelihood(), 1E-10);
+
+	SGVector<float64_t> mu=inf->get_posterior_mean();
+	SGVector<float64_t> inc_mu=inc_inf->get_posterior_mean();
+	for (index_t i=0; i<n; ++i)
+		EXPECT_NEAR(inc_mu[i], mu[i], 1E-10);
+}
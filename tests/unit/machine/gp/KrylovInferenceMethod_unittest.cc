@@ -0,0 +1,179 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/lib/config.h>
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/machine/gp/ConstMean.h>
+#include <shogun/machine/gp/ExactInferenceMethod.h>
+#include <shogun/machine/gp/GaussianLikelihood.h>
+#include <shogun/machine/gp/KrylovInferenceMethod.h>
+#include <shogun/regression/GaussianProcessRegression.h>
+
+#include <cmath>
+
+using namespace shogun;
+
+class KrylovInferenceMethodTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		/* 1d sine wave */
+		index_t n=60;
+
+		SGMatrix<float64_t> X(1, n);
+		SGVector<float64_t> Y(n);
+		for (index_t i=0; i<n; ++i)
+		{
+			X[i]=0.13*i-3;
+			Y[i]=std::sin(2*X[i])+0.1*std::cos(17*X[i]);
+		}
+
+		features=std::make_shared<DenseFeatures<float64_t>>(X);
+		labels=std::make_shared<RegressionLabels>(Y);
+
+		exact=std::make_shared<ExactInferenceMethod>(
+				std::make_shared<GaussianKernel>(10, 0.5), features,
+				std::make_shared<ConstMean>(0.2), labels,
+				std::make_shared<GaussianLikelihood>(0.3));
+		exact->set_scale(1.5);
+
+		krylov=std::make_shared<KrylovInferenceMethod>(
+				std::make_shared<GaussianKernel>(10, 0.5), features,
+				std::make_shared<ConstMean>(0.2), labels,
+				std::make_shared<GaussianLikelihood>(0.3));
+		krylov->set_scale(1.5);
+		krylov->set_tolerance(1e-12);
+		krylov->set_num_probes(200);
+		krylov->put("seed", 7);
+	}
+
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<RegressionLabels> labels;
+	std::shared_ptr<ExactInferenceMethod> exact;
+	std::shared_ptr<KrylovInferenceMethod> krylov;
+};
+
+TEST_F(KrylovInferenceMethodTest, get_alpha)
+{
+	SGVector<float64_t> alpha=exact->get_alpha();
+	SGVector<float64_t> krylov_alpha=krylov->get_alpha();
+
+	ASSERT_EQ(krylov_alpha.vlen, alpha.vlen);
+	for (index_t i=0; i<alpha.vlen; ++i)
+		EXPECT_NEAR(krylov_alpha[i], alpha[i], 1E-8);
+
+	SGVector<float64_t> mu=exact->get_posterior_mean();
+	SGVector<float64_t> krylov_mu=krylov->get_posterior_mean();
+	for (index_t i=0; i<mu.vlen; ++i)
+		EXPECT_NEAR(krylov_mu[i], mu[i], 1E-8);
+}
+
+TEST_F(KrylovInferenceMethodTest, get_negative_log_marginal_likelihood)
+{
+	float64_t nlZ=exact->get_negative_log_marginal_likelihood();
+	float64_t krylov_nlZ=krylov->get_negative_log_marginal_likelihood();
+
+	// stochastic estimate of the log-determinant
+	EXPECT_NEAR(krylov_nlZ, nlZ, 0.05*std::abs(nlZ));
+}
+
+TEST_F(KrylovInferenceMethodTest, get_negative_log_marginal_likelihood_derivatives)
+{
+	std::map<SGObject::Parameters::value_type, std::shared_ptr<SGObject>> parameter_dictionary;
+	exact->build_gradient_parameter_dictionary(parameter_dictionary);
+	auto gradient=
+		exact->get_negative_log_marginal_likelihood_derivatives(parameter_dictionary);
+
+	std::map<SGObject::Parameters::value_type, std::shared_ptr<SGObject>> krylov_parameter_dictionary;
+	krylov->build_gradient_parameter_dictionary(krylov_parameter_dictionary);
+	auto krylov_gradient=
+		krylov->get_negative_log_marginal_likelihood_derivatives(krylov_parameter_dictionary);
+
+	// stochastic estimates of the traces
+	for (const auto& name : {"width", "log_scale", "log_sigma", "mean"})
+	{
+		float64_t dnlZ=gradient[name][0];
+		EXPECT_NEAR(krylov_gradient[name][0], dnlZ, 0.1*std::abs(dnlZ)+0.5)
+			<< name;
+	}
+
+	// exact without traces
+	EXPECT_NEAR(krylov_gradient["mean"][0], gradient["mean"][0], 1E-8);
+}
+
+TEST_F(KrylovInferenceMethodTest, apply_regression)
+{
+	SGMatrix<float64_t> X_test(1, 7);
+	for (index_t i=0; i<X_test.num_cols; ++i)
+		X_test[i]=0.9*i-2.9;
+	auto features_test=std::make_shared<DenseFeatures<float64_t>>(X_test);
+
+	auto gpr=std::make_shared<GaussianProcessRegression>(exact);
+	gpr->train();
+	SGVector<float64_t> mean=gpr->get_mean_vector(features_test);
+	SGVector<float64_t> variance=gpr->get_variance_vector(features_test);
+
+	auto krylov_gpr=std::make_shared<GaussianProcessRegression>(krylov);
+	krylov_gpr->train();
+	SGVector<float64_t> krylov_mean=krylov_gpr->get_mean_vector(features_test);
+	SGVector<float64_t> krylov_variance=krylov_gpr->get_variance_vector(features_test);
+
+	for (index_t i=0; i<X_test.num_cols; ++i)
+	{
+		EXPECT_NEAR(krylov_mean[i], mean[i], 1E-8);
+		EXPECT_NEAR(krylov_variance[i], variance[i], 1E-8);
+	}
+}
+
+TEST(KrylovInferenceMethod, kernel_derivative_in_tiles)
+{
+	/* more training points than in a single tile of kernel values */
+	index_t n=300;
+
+	SGMatrix<float64_t> X(1, n);
+	SGVector<float64_t> Y(n);
+	for (index_t i=0; i<n; ++i)
+	{
+		X[i]=0.02*i-3;
+		Y[i]=std::sin(2*X[i]);
+	}
+	auto features=std::make_shared<DenseFeatures<float64_t>>(X);
+	auto labels=std::make_shared<RegressionLabels>(Y);
+
+	auto exact=std::make_shared<ExactInferenceMethod>(
+			std::make_shared<GaussianKernel>(10, 0.5), features,
+			std::make_shared<ConstMean>(), labels,
+			std::make_shared<GaussianLikelihood>(0.3));
+	auto kernel=std::make_shared<GaussianKernel>(10, 0.5);
+	auto krylov=std::make_shared<KrylovInferenceMethod>(
+			kernel, features, std::make_shared<ConstMean>(), labels,
+			std::make_shared<GaussianLikelihood>(0.3));
+	krylov->set_tolerance(1e-12);
+	krylov->set_num_probes(200);
+	krylov->put("seed", 7);
+
+	std::map<SGObject::Parameters::value_type, std::shared_ptr<SGObject>> parameter_dictionary;
+	exact->build_gradient_parameter_dictionary(parameter_dictionary);
+	auto gradient=
+		exact->get_negative_log_marginal_likelihood_derivatives(parameter_dictionary);
+
+	std::map<SGObject::Parameters::value_type, std::shared_ptr<SGObject>> krylov_parameter_dictionary;
+	krylov->build_gradient_parameter_dictionary(krylov_parameter_dictionary);
+	auto krylov_gradient=
+		krylov->get_negative_log_marginal_likelihood_derivatives(krylov_parameter_dictionary);
+
+	float64_t dnlZ=gradient["width"][0];
+	EXPECT_NEAR(krylov_gradient["width"][0], dnlZ, 0.1*std::abs(dnlZ)+0.5);
+
+	// the kernel is back on the training points
+	EXPECT_EQ(kernel->get_num_vec_lhs(), n);
+	EXPECT_EQ(kernel->get_num_vec_rhs(), n);
+}
@@ -1518,6 +1518,153 @@ TYPED_TEST(
 		EXPECT_EQ(ref[i], cal[i]);
 }
 
+TYPED_TEST(LinalgBackendEigenRealTypesTest, SGSparseMatrix_SGVector_matrix_prod)
+{
+	const index_t rows = 4, cols = 3;
+	SGMatrix<TypeParam> D(rows, cols);
+	D.zero();
+	D(0, 0) = 1;
+	D(2, 0) = 2;
+	D(1, 1) = -3;
+	D(3, 2) = 4;
+	// columns of D are the sparse vectors, i.e. the sparse matrix is D^T
+	SGSparseMatrix<TypeParam> A(D);
+
+	SGVector<TypeParam> b(rows), c(cols);
+	for (index_t i = 0; i < rows; ++i)
+		b[i] = i + 1;
+	for (index_t i = 0; i < cols; ++i)
+		c[i] = i - 1;
+
+	auto result = linalg::matrix_prod(A, b);
+	auto ref = linalg::matrix_prod(D, b, true);
+	ASSERT_EQ(ref.vlen, result.vlen);
+	for (index_t i = 0; i < ref.vlen; ++i)
+		EXPECT_NEAR(ref[i], result[i], get_epsilon<TypeParam>());
+
+	result = linalg::matrix_prod(A, c, true);
+	ref = linalg::matrix_prod(D, c);
+	ASSERT_EQ(ref.vlen, result.vlen);
+	for (index_t i = 0; i < ref.vlen; ++i)
+		EXPECT_NEAR(ref[i], result[i], get_epsilon<TypeParam>());
+}
+
+TYPED_TEST(LinalgBackendEigenRealTypesTest, SGSparseMatrix_SGMatrix_matrix_prod)
+{
+	const index_t rows = 4, cols = 3, dim = 2;
+	SGMatrix<TypeParam> D(rows, cols);
+	D.zero();
+	D(0, 0) = 1;
+	D(2, 0) = 2;
+	D(1, 1) = -3;
+	D(3, 2) = 4;
+	SGSparseMatrix<TypeParam> A(D);
+
+	SGMatrix<TypeParam> B(rows, dim), C(cols, dim);
+	for (index_t i = 0; i < rows * dim; ++i)
+		B[i] = i;
+	for (index_t i = 0; i < cols * dim; ++i)
+		C[i] = i - 2;
+
+	// sparse x dense
+	auto result = linalg::matrix_prod(A, B);
+	auto ref = linalg::matrix_prod(D, B, true);
+	EXPECT_TRUE(ref.equals(result));
+
+	result = linalg::matrix_prod(A, C, true);
+	ref = linalg::matrix_prod(D, C);
+	EXPECT_TRUE(ref.equals(result));
+
+	result = linalg::matrix_prod(A, linalg::transpose_matrix(B), false, true);
+	ref = linalg::matrix_prod(D, B, true);
+	EXPECT_TRUE(ref.equals(result));
+
+	// dense x sparse
+	result = linalg::matrix_prod(C, A, true);
+	ref = linalg::matrix_prod(C, D, true, true);
+	EXPECT_TRUE(ref.equals(result));
+
+	result = linalg::matrix_prod(B, A, true, true);
+	ref = linalg::matrix_prod(B, D, true);
+	EXPECT_TRUE(ref.equals(result));
+}
+
+TYPED_TEST(LinalgBackendEigenRealTypesTest, SGSparseMatrix_SGSparseMatrix_matrix_prod)
+{
+	const index_t rows = 4, cols = 3;
+	SGMatrix<TypeParam> D(rows, cols);
+	D.zero();
+	D(0, 0) = 1;
+	D(2, 0) = 2;
+	D(1, 1) = -3;
+	D(3, 2) = 4;
+	D(3, 0) = 5;
+	SGSparseMatrix<TypeParam> A(D);
+
+	// D^T D
+	auto result = linalg::matrix_prod(A, A, false, true);
+	auto ref = linalg::matrix_prod(D, D, true);
+	ASSERT_EQ(cols, result.num_vectors);
+	ASSERT_EQ(cols, result.num_features);
+	for (index_t i = 0; i < cols; ++i)
+		for (index_t j = 0; j < cols; ++j)
+			EXPECT_NEAR(ref(i, j), result(j, i), get_epsilon<TypeParam>());
+
+	// D D^T
+	result = linalg::matrix_prod(A, A, true);
+	ref = linalg::matrix_prod(D, D, false, true);
+	ASSERT_EQ(rows, result.num_vectors);
+	ASSERT_EQ(rows, result.num_features);
+	for (index_t i = 0; i < rows; ++i)
+		for (index_t j = 0; j < rows; ++j)
+			EXPECT_NEAR(ref(i, j), result(j, i), get_epsilon<TypeParam>());
+}
+
+TYPED_TEST(LinalgBackendEigenRealTypesTest, SGSparseMatrix_scale)
+{
+	SGMatrix<TypeParam> D(3, 2);
+	D.zero();
+	D(0, 0) = 1;
+	D(2, 0) = 2;
+	D(1, 1) = -3;
+	SGSparseMatrix<TypeParam> A(D);
+	const TypeParam alpha = 0.5;
+
+	auto result = linalg::scale(A, alpha);
+	for (index_t i = 0; i < D.num_rows; ++i)
+		for (index_t j = 0; j < D.num_cols; ++j)
+			EXPECT_NEAR(alpha * D(i, j), result(i, j), get_epsilon<TypeParam>());
+
+	linalg::scale(A, A, alpha);
+	for (index_t i = 0; i < D.num_rows; ++i)
+		for (index_t j = 0; j < D.num_cols; ++j)
+			EXPECT_NEAR(alpha * D(i, j), A(i, j), get_epsilon<TypeParam>());
+}
+
+TYPED_TEST(LinalgBackendEigenRealTypesTest, SGSparseMatrix_colwise_rowwise_sum)
+{
+	const index_t rows = 3, cols = 3;
+	SGMatrix<TypeParam> D(rows, cols);
+	D.zero();
+	D(0, 0) = 1;
+	D(2, 0) = 2;
+	D(1, 1) = -3;
+	D(0, 2) = 4;
+	D(2, 2) = 5;
+	// the sparse matrix is D^T
+	SGSparseMatrix<TypeParam> A(D);
+
+	auto colwise = linalg::colwise_sum(A);
+	auto rowwise = linalg::rowwise_sum(A);
+	EXPECT_TRUE(linalg::rowwise_sum(D).equals(colwise));
+	EXPECT_TRUE(linalg::colwise_sum(D).equals(rowwise));
+
+	colwise = linalg::colwise_sum(A, true);
+	rowwise = linalg::rowwise_sum(A, true);
+	EXPECT_TRUE(linalg::rowwise_sum(D, true).equals(colwise));
+	EXPECT_TRUE(linalg::colwise_sum(D, true).equals(rowwise));
+}
+
 TYPED_TEST(LinalgBackendEigenAllTypesTest, SGVector_max)
 {
 	SGVector<TypeParam> A(9);
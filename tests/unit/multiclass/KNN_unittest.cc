@@ -4,11 +4,15 @@
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/features/SparseFeatures.h>
 #include <shogun/multiclass/KNN.h>
+#include <shogun/distance/CosineDistance.h>
 #include <shogun/distance/EuclideanDistance.h>
+#include <shogun/distance/ManhattanMetric.h>
 #include <shogun/labels/BinaryLabels.h>
 #include <shogun/features/DataGenerator.h>
 #include <shogun/mathematics/RandomNamespace.h>
 
+#include <algorithm>
+
 using namespace shogun;
 
 template <typename PRNG>
@@ -104,6 +108,31 @@ TEST_F(KNNTest, kdtree_solver)
 
 }
 
+TEST_F(KNNTest, cover_tree_solver)
+{
+	auto knn = std::make_shared<KNN>(k, distance, labels, KNN_COVER_TREE);
+	knn->train(features);
+	auto output = knn->apply(features_test)->as<MulticlassLabels>();
+
+	for ( index_t i = 0; i < labels_test->get_num_labels(); ++i )
+		EXPECT_EQ(output->get_label(i), labels_test->get_label(i));
+}
+
+TEST_F(KNNTest, cover_tree_solver_non_euclidean)
+{
+	auto metric = std::make_shared<ManhattanMetric>();
+	auto brute = std::make_shared<KNN>(k, metric, labels, KNN_BRUTE);
+	brute->train(features);
+	auto expected = brute->apply(features_test)->as<MulticlassLabels>();
+
+	auto knn = std::make_shared<KNN>(k, metric, labels, KNN_COVER_TREE);
+	knn->train(features);
+	auto output = knn->apply(features_test)->as<MulticlassLabels>();
+
+	for ( index_t i = 0; i < labels_test->get_num_labels(); ++i )
+		EXPECT_EQ(output->get_label(i), expected->get_label(i));
+}
+
 TEST_F(KNNTest, lsh_solver)
 {
 	auto knn = std::make_shared<KNN>(k, distance, labels, KNN_LSH);
@@ -226,3 +255,50 @@ TEST(KNN, classify_multiple_kdtree)
 
 
 }
+
+TEST(KNN, nearest_neighbors_blocked)
+{
+	std::mt19937_64 prng(23);
+
+	// more vectors than a single block of training and test vectors
+	const index_t num_train = 2500;
+	const index_t num_test = 300;
+	const index_t feats = 3;
+	const int32_t k = 5;
+
+	SGVector<float64_t> lab(num_train);
+	SGMatrix<float64_t> feat_train = DataGenerator::generate_gaussians(
+	    num_train / 5, 5, feats, prng);
+	SGMatrix<float64_t> feat_test = DataGenerator::generate_gaussians(
+	    num_test / 3, 3, feats, prng);
+	for (index_t i = 0; i < num_train; ++i)
+		lab[i] = i % 3;
+
+	auto labels = std::make_shared<MulticlassLabels>(lab);
+	auto features = std::make_shared<DenseFeatures<float64_t>>(feat_train);
+	auto features_test = std::make_shared<DenseFeatures<float64_t>>(feat_test);
+
+	std::vector<std::shared_ptr<Distance>> distances{
+	    std::make_shared<EuclideanDistance>(),
+	    std::make_shared<CosineDistance>()};
+	for (const auto& distance : distances)
+	{
+		auto knn = std::make_shared<KNN>(k, distance, labels, KNN_BRUTE);
+		knn->train(features);
+		distance->init(features, features_test);
+		SGMatrix<index_t> NN = knn->nearest_neighbors();
+		ASSERT_EQ(k, NN.num_rows);
+		ASSERT_EQ(num_test, NN.num_cols);
+
+		std::vector<float64_t> dists(num_train);
+		for (index_t i = 0; i < num_test; ++i)
+		{
+			for (index_t j = 0; j < num_train; ++j)
+				dists[j] = distance->distance(j, i);
+			std::partial_sort(dists.begin(), dists.begin() + k, dists.end());
+
+			for (int32_t j = 0; j < k; ++j)
+				EXPECT_NEAR(dists[j], distance->distance(NN(j, i), i), 1e-8);
+		}
+	}
+}
@@ -30,10 +30,13 @@
 
 #include <gtest/gtest.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/labels/RegressionLabels.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/multiclass/tree/CARTree.h>
 
+#include <algorithm>
 #include <random>
 
 using namespace shogun;
@@ -665,3 +668,176 @@ TEST(CARTree,cv_prune_simple)
 
 
 }
+
+TEST(CARTree, histogram_split_classify)
+{
+	int32_t seed = 17;
+	std::mt19937_64 prng(seed);
+	std::uniform_int_distribution<int32_t> dist(0, 49);
+
+	SGMatrix<float64_t> data(3, 200);
+	SGVector<float64_t> lab(200);
+	for (index_t i = 0; i < 200; ++i)
+	{
+		for (index_t j = 0; j < 3; ++j)
+			data(j, i) = dist(prng);
+		lab[i] = (data(0, i) > 20) + (data(1, i) > 30);
+	}
+
+	auto feats = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto labels = std::make_shared<MulticlassLabels>(lab);
+
+	auto c = std::make_shared<CARTree>();
+	c->set_labels(labels);
+	c->set_feature_types(SGVector<bool>{false, false, false});
+	c->set_histogram_split(true);
+	c->train(feats);
+
+	auto result = c->apply(feats)->as<MulticlassLabels>()->get_labels();
+	for (index_t i = 0; i < 200; ++i)
+		EXPECT_EQ(lab[i], result[i]);
+}
+
+TEST(CARTree, histogram_split_regression)
+{
+	int32_t seed = 23;
+	std::mt19937_64 prng(seed);
+	std::uniform_real_distribution<float64_t> dist(0.0, 10.0);
+
+	SGMatrix<float64_t> data(2, 1000);
+	for (index_t i = 0; i < 1000; ++i)
+	{
+		data(0, i) = dist(prng);
+		data(1, i) = dist(prng);
+	}
+	// the median is the upper edge of the 16th of 32 quantile bins
+	auto sorted = data.get_row_vector(0);
+	std::sort(sorted.begin(), sorted.end());
+	SGVector<float64_t> lab(1000);
+	for (index_t i = 0; i < 1000; ++i)
+		lab[i] = data(0, i) <= sorted[499] ? 1.0 : 3.0;
+
+	// nominal attribute whose categories are not ordered by their labels
+	SGMatrix<float64_t> nominal_data(1, 1000);
+	SGVector<float64_t> nominal_lab(1000);
+	for (index_t i = 0; i < 1000; ++i)
+	{
+		nominal_data(0, i) = i % 4;
+		nominal_lab[i] = (i % 4 == 0 || i % 4 == 3) ? 2.0 : -2.0;
+	}
+
+	auto c = std::make_shared<CARTree>(SGVector<bool>{false, false}, PT_REGRESSION);
+	c->set_labels(std::make_shared<RegressionLabels>(lab));
+	c->set_histogram_split(true);
+	c->set_num_bins(32);
+	c->set_max_depth(1);
+	auto feats = std::make_shared<DenseFeatures<float64_t>>(data);
+	c->train(feats);
+
+	EXPECT_EQ(0, c->get_root()->data.attribute_id);
+	auto result = c->apply_regression(feats)->get_labels();
+	for (index_t i = 0; i < 1000; ++i)
+		EXPECT_NEAR(lab[i], result[i], 1e-12);
+
+	c = std::make_shared<CARTree>(SGVector<bool>{true}, PT_REGRESSION);
+	c->set_labels(std::make_shared<RegressionLabels>(nominal_lab));
+	c->set_histogram_split(true);
+	auto nominal_feats = std::make_shared<DenseFeatures<float64_t>>(nominal_data);
+	c->train(nominal_feats);
+
+	EXPECT_EQ(2, c->get_root()->data.num_leaves);
+	result = c->apply_regression(nominal_feats)->get_labels();
+	for (index_t i = 0; i < 1000; ++i)
+		EXPECT_NEAR(nominal_lab[i], result[i], 1e-12);
+}
+
+TEST(CARTree, histogram_split_subset)
+{
+	int32_t seed = 19;
+	std::mt19937_64 prng(seed);
+	std::uniform_int_distribution<int32_t> dist(0, 49);
+
+	// the odd vectors are outside of the subset and would contradict the
+	// labels if they were read
+	SGMatrix<float64_t> data(3, 400);
+	SGVector<index_t> subset(200);
+	SGVector<float64_t> lab(200);
+	for (index_t i = 0; i < 200; ++i)
+	{
+		for (index_t j = 0; j < 3; ++j)
+		{
+			data(j, 2 * i) = dist(prng);
+			data(j, 2 * i + 1) = 49 - data(j, 2 * i);
+		}
+		subset[i] = 2 * i;
+		lab[i] = (data(0, 2 * i) > 20) + (data(1, 2 * i) > 30);
+	}
+
+	auto feats = std::make_shared<DenseFeatures<float64_t>>(data);
+	feats->add_subset(subset);
+	auto subset_feats =
+	    std::make_shared<DenseFeatures<float64_t>>(feats->get_feature_matrix());
+
+	auto c = std::make_shared<CARTree>();
+	c->set_labels(std::make_shared<MulticlassLabels>(lab));
+	c->set_feature_types(SGVector<bool>{false, false, false});
+	c->set_histogram_split(true);
+	c->train(feats);
+
+	auto result = c->apply(subset_feats)->as<MulticlassLabels>()->get_labels();
+	for (index_t i = 0; i < 200; ++i)
+		EXPECT_EQ(lab[i], result[i]);
+}
+
+TEST(CARTree, compile)
+{
+	int32_t seed = 31;
+	std::mt19937_64 prng(seed);
+	std::uniform_int_distribution<int32_t> category(0, 3);
+	std::uniform_real_distribution<float64_t> dist(0.0, 1.0);
+
+	// attribute 0 is nominal, some values of attribute 1 are missing
+	SGMatrix<float64_t> data(3, 300);
+	SGVector<float64_t> lab(300);
+	for (index_t i = 0; i < 300; ++i)
+	{
+		data(0, i) = category(prng);
+		data(1, i) = dist(prng) < 0.1 ? CARTree::MISSING : dist(prng);
+		data(2, i) = dist(prng);
+		lab[i] = (data(0, i) == 2) + (data(2, i) > 0.5);
+	}
+	auto feats = std::make_shared<DenseFeatures<float64_t>>(data);
+
+	auto c = std::make_shared<CARTree>(SGVector<bool>{true, false, false});
+	c->set_labels(std::make_shared<MulticlassLabels>(lab));
+	c->set_max_depth(4);
+	c->train(feats);
+
+	auto expected = c->apply_multiclass(feats)->get_labels();
+	c->compile();
+	auto result = c->apply_multiclass(feats)->get_labels();
+	for (index_t i = 0; i < 300; ++i)
+		EXPECT_EQ(expected[i], result[i]);
+
+	// retraining drops the compiled tree
+	c->set_max_depth(1);
+	c->train(feats);
+	result = c->apply_multiclass(feats)->get_labels();
+	auto root = c->get_root()->as<CARTree::bnode_t>();
+	ASSERT_EQ(2, root->data.num_leaves);
+	for (index_t i = 0; i < 300; ++i)
+	{
+		EXPECT_TRUE(
+		    result[i] == root->left()->data.node_label ||
+		    result[i] == root->right()->data.node_label);
+	}
+
+	// setting the root, here an edited one, drops the compiled tree
+	c->compile();
+	root->left()->data.node_label = 7;
+	root->right()->data.node_label = 7;
+	c->set_root(root);
+	result = c->apply_multiclass(feats)->get_labels();
+	for (index_t i = 0; i < 300; ++i)
+		EXPECT_EQ(7, result[i]);
+}
@@ -0,0 +1,124 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ * Authors: agent
+ */
+
+#include <gtest/gtest.h>
+
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/multiclass/tree/MetricCoverTree.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+using namespace shogun;
+
+namespace
+{
+	SGMatrix<float64_t> random_points(index_t dim, index_t num, int32_t seed)
+	{
+		SGMatrix<float64_t> points(dim, num);
+		std::mt19937_64 prng(seed);
+		NormalDistribution<float64_t> normal_dist;
+		for (index_t i = 0; i < dim * num; ++i)
+			points[i] = normal_dist(prng);
+		return points;
+	}
+
+	// L1 distance, a metric that is not supported by KDTree
+	float64_t manhattan(
+	    const SGMatrix<float64_t>& a, index_t i, const SGMatrix<float64_t>& b,
+	    index_t j)
+	{
+		float64_t result = 0;
+		for (index_t d = 0; d < a.num_rows; ++d)
+			result += std::abs(a(d, i) - b(d, j));
+		return result;
+	}
+
+	void check_against_brute_force(
+	    const SGMatrix<float64_t>& data, const SGMatrix<float64_t>& queries,
+	    int32_t k)
+	{
+		MetricCoverTree tree;
+		tree.build_tree(data.num_cols, [&data](index_t a, index_t b) {
+			return manhattan(data, a, data, b);
+		});
+		EXPECT_EQ(data.num_cols, tree.get_num_points());
+
+		tree.query_knn(
+		    queries.num_cols, k, [&data, &queries](index_t a, index_t b) {
+			    return manhattan(data, a, queries, b);
+		    });
+		auto indices = tree.get_knn_indices();
+		auto dists = tree.get_knn_dists();
+		ASSERT_EQ(k, indices.num_rows);
+		ASSERT_EQ(queries.num_cols, indices.num_cols);
+
+		std::vector<float64_t> brute(data.num_cols);
+		for (index_t q = 0; q < queries.num_cols; ++q)
+		{
+			for (index_t i = 0; i < data.num_cols; ++i)
+				brute[i] = manhattan(data, i, queries, q);
+			std::vector<float64_t> sorted(brute);
+			std::sort(sorted.begin(), sorted.end());
+
+			for (int32_t j = 0; j < k; ++j)
+			{
+				// neighbours may differ in case of ties, distances may not
+				EXPECT_NEAR(sorted[j], dists(j, q), 1e-12);
+				EXPECT_NEAR(brute[indices(j, q)], dists(j, q), 1e-12);
+			}
+		}
+	}
+}
+
+TEST(MetricCoverTree, knn_matches_brute_force)
+{
+	auto data = random_points(5, 300, 3);
+	auto queries = random_points(5, 50, 4);
+	check_against_brute_force(data, queries, 7);
+}
+
+TEST(MetricCoverTree, query_training_points)
+{
+	auto data = random_points(3, 200, 5);
+	check_against_brute_force(data, data, 1);
+
+	MetricCoverTree tree;
+	tree.build_tree(data.num_cols, [&data](index_t a, index_t b) {
+		return manhattan(data, a, data, b);
+	});
+	tree.query_knn(data.num_cols, 1, [&data](index_t a, index_t b) {
+		return manhattan(data, a, data, b);
+	});
+	auto indices = tree.get_knn_indices();
+	for (index_t i = 0; i < data.num_cols; ++i)
+		EXPECT_EQ(i, indices(0, i));
+}
+
+TEST(MetricCoverTree, duplicates)
+{
+	// every point appears three times
+	auto unique = random_points(2, 40, 6);
+	SGMatrix<float64_t> data(2, 120);
+	for (index_t i = 0; i < data.num_cols; ++i)
+	{
+		data(0, i) = unique(0, i % unique.num_cols);
+		data(1, i) = unique(1, i % unique.num_cols);
+	}
+
+	auto queries = random_points(2, 20, 7);
+	check_against_brute_force(data, queries, 5);
+	check_against_brute_force(data, unique, 3);
+}
+
+TEST(MetricCoverTree, all_points)
+{
+	auto data = random_points(4, 30, 8);
+	auto queries = random_points(4, 10, 9);
+	check_against_brute_force(data, queries, data.num_cols);
+}
@@ -262,3 +262,107 @@ TEST_F(RandomForestTest, score_consistent_with_binary_trivial_data)
 	EXPECT_NEAR(1.0, values_vector[8], 1e-1);
 	EXPECT_NEAR(1.0, values_vector[9], 1e-1);
 }
+
+TEST_F(RandomForestTest, histogram_split)
+{
+	int32_t seed = 2343;
+	std::mt19937_64 prng(seed);
+	std::uniform_real_distribution<float64_t> dist(0.0, 1.0);
+
+	SGMatrix<float64_t> data(5, 500);
+	SGVector<float64_t> lab(500);
+	for (index_t i = 0; i < 500; ++i)
+	{
+		for (index_t j = 0; j < 5; ++j)
+			data(j, i) = dist(prng);
+		lab[i] = data(0, i) + data(1, i) > 1.0;
+	}
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto labels = std::make_shared<MulticlassLabels>(lab);
+
+	auto c = std::make_shared<RandomForest>(features, labels, 20, 5);
+	c->set_feature_types(SGVector<bool>{false, false, false, false, false});
+	c->set_combination_rule(std::make_shared<MajorityVote>());
+	c->set_histogram_split(true);
+	c->put("seed", seed);
+	c->train(features);
+
+	auto result = c->apply(features)->as<MulticlassLabels>();
+	auto accuracy = std::make_shared<MulticlassAccuracy>();
+	EXPECT_GT(accuracy->evaluate(result, labels), 0.95);
+}
+
+TEST_F(RandomForestTest, histogram_split_subset)
+{
+	int32_t seed = 2343;
+	std::mt19937_64 prng(seed);
+	std::uniform_real_distribution<float64_t> dist(0.0, 1.0);
+
+	// bags are drawn from the subset, the vectors outside of it have
+	// the opposite labels
+	SGMatrix<float64_t> data(5, 1000);
+	SGVector<index_t> subset(500);
+	SGVector<float64_t> lab(500);
+	for (index_t i = 0; i < 500; ++i)
+	{
+		for (index_t j = 0; j < 5; ++j)
+		{
+			data(j, 2 * i) = dist(prng);
+			data(j, 2 * i + 1) = 1.0 - data(j, 2 * i);
+		}
+		subset[i] = 2 * i;
+		lab[i] = data(0, 2 * i) + data(1, 2 * i) > 1.0;
+	}
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	features->add_subset(subset);
+	auto labels = std::make_shared<MulticlassLabels>(lab);
+
+	auto c = std::make_shared<RandomForest>(features, labels, 20, 5);
+	c->set_feature_types(SGVector<bool>{false, false, false, false, false});
+	c->set_combination_rule(std::make_shared<MajorityVote>());
+	c->set_histogram_split(true);
+	c->put("seed", seed);
+	c->train(features);
+
+	auto result = c->apply(features)->as<MulticlassLabels>();
+	auto accuracy = std::make_shared<MulticlassAccuracy>();
+	EXPECT_GT(accuracy->evaluate(result, labels), 0.95);
+}
+
+TEST_F(RandomForestTest, compile)
+{
+	int32_t seed = 2343;
+	std::mt19937_64 prng(seed);
+	std::uniform_real_distribution<float64_t> dist(0.0, 1.0);
+
+	SGMatrix<float64_t> data(4, 300);
+	SGVector<float64_t> lab(300);
+	for (index_t i = 0; i < 300; ++i)
+	{
+		for (index_t j = 0; j < 4; ++j)
+			data(j, i) = dist(prng);
+		lab[i] = data(0, i) > data(1, i);
+	}
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto labels = std::make_shared<MulticlassLabels>(lab);
+
+	auto c = std::make_shared<RandomForest>(features, labels, 10, 2);
+	c->set_feature_types(SGVector<bool>{false, false, false, false});
+	c->set_combination_rule(std::make_shared<MajorityVote>());
+	c->put("seed", seed);
+	c->train(features);
+
+	auto expected = c->apply(features)->as<MulticlassLabels>();
+	c->compile();
+	auto result = c->apply(features)->as<MulticlassLabels>();
+	for (index_t i = 0; i < 300; ++i)
+	{
+		EXPECT_EQ(expected->get_label(i), result->get_label(i));
+		for (index_t k = 0; k < 2; ++k)
+		{
+			EXPECT_EQ(
+			    expected->get_multiclass_confidences(i)[k],
+			    result->get_multiclass_confidences(i)[k]);
+		}
+	}
+}
@@ -29,6 +29,8 @@
  *
  */
 #include <gtest/gtest.h>
+#include <numeric>
+#include <random>
 
 #include "StochasticMinimizers_unittest.h"
 
@@ -37,6 +39,7 @@
 #include <shogun/optimization/GradientDescendUpdater.h>
 #include <shogun/optimization/ConstLearningRate.h>
 #include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/optimization/SVRGMinimizer.h>
 #include <shogun/optimization/StandardMomentumCorrection.h>
 #include <shogun/optimization/AdaDeltaUpdater.h>
@@ -288,6 +291,45 @@ SGVector<float64_t> ClassificationForTestCostFunction::get_average_gradient()
 	return result;
 }
 
+index_t ClassificationForTestCostFunction::get_num_samples() const
+{
+	return m_labels.vlen;
+}
+
+void ClassificationForTestCostFunction::get_sample_gradient(index_t idx,
+	const SGVector<float64_t>& variable, std::vector<SGSparseVectorEntry<float64_t>>& gradient) const
+{
+	Map<const VectorXd> e_w(variable.vector,variable.vlen);
+	Map<const MatrixXd> e_x(m_features.matrix, m_features.num_rows, m_features.num_cols);
+	float64_t tmp=e_w.dot(e_x.col(idx));
+	tmp=exp(tmp*m_labels[idx]);
+	float64_t w=m_labels[idx]*tmp / (1.0+tmp);
+	for(index_t i=0; i<m_features.num_rows; i++)
+	{
+		if(e_x(i,idx)!=0.0)
+			gradient.push_back({i, w*e_x(i,idx)});
+	}
+}
+
+void ClassificationForTestCostFunction::get_batch_gradient(const SGVector<index_t>& batch,
+	const SGVector<float64_t>& variable, SGVector<float64_t> gradient) const
+{
+	Map<const VectorXd> e_w(variable.vector,variable.vlen);
+	Map<const MatrixXd> e_x(m_features.matrix, m_features.num_rows, m_features.num_cols);
+	MatrixXd e_batch(m_features.num_rows, batch.vlen);
+	VectorXd e_y(batch.vlen);
+	for(index_t i=0; i<batch.vlen; i++)
+	{
+		e_batch.col(i)=e_x.col(batch[i]);
+		e_y[i]=m_labels[batch[i]];
+	}
+
+	ArrayXd tmp=(e_y.array()*(e_batch.transpose()*e_w).array()).exp();
+	VectorXd w=e_y.array()*tmp/(1.0+tmp);
+	Map<VectorXd> e_r(gradient.vector,gradient.vlen);
+	e_r=e_batch*w/batch.vlen;
+}
+
 SGVector<float64_t> ClassificationForTestCostFunction::obtain_variable_reference()
 {
 	return m_weight;
@@ -643,6 +685,125 @@ TEST(SGDMinimizer,test5)
 	EXPECT_NEAR(cost,8.54011254349676, 1e-10);
 }
 
+TEST(SGDMinimizer,hogwild)
+{
+	ClassificationFixture data;
+	float64_t penalty_weight=1.0/data.y.vlen;
+	int32_t num_passes=100;
+
+	auto serial_fun=std::make_shared<ClassificationForTestCostFunction2>();
+	serial_fun->set_data(data.x, data.y);
+	auto serial=std::make_shared<SGDMinimizer>(serial_fun);
+	serial->set_penalty_weight(penalty_weight);
+	serial->set_penalty_type(std::make_shared<L2Penalty>());
+	auto rate=std::make_shared<ConstLearningRate>();
+	rate->set_const_learning_rate(0.1);
+	serial->set_learning_rate(rate);
+	serial->set_gradient_updater(std::make_shared<GradientDescendUpdater>());
+	serial->set_number_passes(num_passes);
+	serial->minimize();
+
+	auto fun=std::make_shared<ClassificationForTestCostFunction>();
+	fun->set_data(data.x, data.y);
+	auto opt=std::make_shared<SGDMinimizer>(fun);
+	opt->put("seed", 17);
+	opt->set_hogwild(true);
+	opt->set_penalty_weight(penalty_weight);
+	opt->set_penalty_type(std::make_shared<L2Penalty>());
+	opt->set_learning_rate(rate);
+	opt->set_gradient_updater(std::make_shared<GradientDescendUpdater>());
+	opt->set_number_passes(num_passes);
+	opt->minimize();
+	EXPECT_EQ(opt->get_iteration_counter(), num_passes*data.y.vlen);
+
+	// samples are visited in a different order, so the iterates only agree
+	// up to the noise of the constant learning rate
+	float64_t serial_cost=serial_fun->get_cost()/data.y.vlen;
+	float64_t cost=fun->get_cost()/data.y.vlen;
+	EXPECT_NEAR(cost, serial_cost, 2e-3);
+
+	SGVector<float64_t> serial_w=serial_fun->obtain_variable_reference();
+	SGVector<float64_t> w=fun->obtain_variable_reference();
+	EXPECT_NEAR(w[0], serial_w[0], 0.05);
+	EXPECT_NEAR(w[1], serial_w[1], 0.05);
+}
+
+TEST(SGDMinimizer,batch_gradient)
+{
+	ClassificationFixture data;
+	auto fun=std::make_shared<ClassificationForTestCostFunction>();
+	fun->set_data(data.x, data.y);
+
+	SGVector<index_t> batch(7);
+	for(index_t i=0; i<batch.vlen; i++)
+		batch[i]=(5*i+3)%data.y.vlen;
+	SGVector<float64_t> w(2);
+	w[0]=0.3;
+	w[1]=-1.2;
+
+	SGVector<float64_t> gradient(2);
+	fun->get_batch_gradient(batch, w, gradient);
+	SGVector<float64_t> reference(2);
+	fun->FirstOrderStochasticCostFunction::get_batch_gradient(batch, w, reference);
+
+	EXPECT_NEAR(gradient[0], reference[0], 1e-12);
+	EXPECT_NEAR(gradient[1], reference[1], 1e-12);
+}
+
+TEST(SGDMinimizer,full_batch)
+{
+	ClassificationFixture data;
+	float64_t penalty_weight=1.0/data.y.vlen;
+	float64_t learning_rate=0.5;
+	int32_t num_passes=30;
+
+	auto fun=std::make_shared<ClassificationForTestCostFunction>();
+	fun->set_data(data.x, data.y);
+	auto opt=std::make_shared<SGDMinimizer>(fun);
+	opt->set_penalty_weight(penalty_weight);
+	opt->set_penalty_type(std::make_shared<L2Penalty>());
+	auto rate=std::make_shared<ConstLearningRate>();
+	rate->set_const_learning_rate(learning_rate);
+	opt->set_learning_rate(rate);
+	opt->set_gradient_updater(std::make_shared<GradientDescendUpdater>());
+	opt->set_number_passes(num_passes);
+	opt->set_batch_size(data.y.vlen);
+	opt->minimize();
+	EXPECT_EQ(opt->get_iteration_counter(), num_passes);
+
+	// a mini-batch of all samples is a step of gradient descent
+	auto gd_fun=std::make_shared<ClassificationForTestCostFunction>();
+	gd_fun->set_data(data.x, data.y);
+	SGVector<float64_t> gd_w=gd_fun->obtain_variable_reference();
+	for(int32_t pass=0; pass<num_passes; pass++)
+	{
+		SGVector<float64_t> gradient=gd_fun->get_average_gradient();
+		for(index_t i=0; i<gd_w.vlen; i++)
+			gd_w[i]-=learning_rate*(gradient[i]+penalty_weight*gd_w[i]);
+	}
+
+	SGVector<float64_t> w=fun->obtain_variable_reference();
+	EXPECT_NEAR(w[0], gd_w[0], 1e-10);
+	EXPECT_NEAR(w[1], gd_w[1], 1e-10);
+}
+
+TEST(SGDMinimizer,hogwild_requires_indexed_samples)
+{
+	RegressionFixture data;
+	auto aa=std::make_shared<CRegressionExample>();
+	aa->set_x(data.x);
+	aa->set_y(data.y);
+	aa->set_init_w(SGVector<float64_t>(3));
+	auto fun=std::make_shared<RegressionForTestCostFunction>();
+	fun->set_target(aa);
+
+	auto opt=std::make_shared<SGDMinimizer>(fun);
+	opt->set_hogwild(true);
+	opt->set_gradient_updater(std::make_shared<GradientDescendUpdater>());
+	opt->set_number_passes(1);
+	EXPECT_THROW(opt->minimize(), ShogunException);
+}
+
 TEST(SVRGMinimizer,test1)
 {
 	SGVector<float64_t> w(3);
@@ -693,6 +854,172 @@ TEST(SVRGMinimizer,test1)
 	EXPECT_NEAR(w[2],1.6913053544,1e-8);
 }
 
+TEST(SVRGMinimizer,full_batch)
+{
+	ClassificationFixture data;
+	float64_t learning_rate=0.5;
+	int32_t num_passes=30;
+
+	auto fun=std::make_shared<ClassificationForTestCostFunction>();
+	fun->set_data(data.x, data.y);
+	auto opt=std::make_shared<SVRGMinimizer>(fun);
+	auto rate=std::make_shared<ConstLearningRate>();
+	rate->set_const_learning_rate(learning_rate);
+	opt->set_learning_rate(rate);
+	opt->set_gradient_updater(std::make_shared<GradientDescendUpdater>());
+	opt->set_number_passes(num_passes);
+	opt->set_sgd_number_passes(0);
+	opt->set_average_update_interval(1);
+	opt->set_batch_size(data.y.vlen);
+	opt->minimize();
+
+	// the variance reduction of a mini-batch of all samples cancels out
+	auto gd_fun=std::make_shared<ClassificationForTestCostFunction>();
+	gd_fun->set_data(data.x, data.y);
+	SGVector<float64_t> gd_w=gd_fun->obtain_variable_reference();
+	for(int32_t pass=0; pass<num_passes; pass++)
+	{
+		SGVector<float64_t> gradient=gd_fun->get_average_gradient();
+		for(index_t i=0; i<gd_w.vlen; i++)
+			gd_w[i]-=learning_rate*gradient[i];
+	}
+
+	SGVector<float64_t> w=fun->obtain_variable_reference();
+	EXPECT_NEAR(w[0], gd_w[0], 1e-10);
+	EXPECT_NEAR(w[1], gd_w[1], 1e-10);
+}
+
+TEST(SVRGMinimizer,lazy_updates)
+{
+	//every sample has two of the six features
+	index_t num_samples=30;
+	index_t num_features=6;
+	SGMatrix<float64_t> x(num_features, num_samples);
+	x.zero();
+	SGVector<float64_t> y(num_samples);
+	for(index_t i=0; i<num_samples; i++)
+	{
+		index_t first=i%num_features;
+		index_t second=(3*i+1)%num_features;
+		if(second==first)
+			second=(first+1)%num_features;
+		x(first,i)=std::sin(i+1.0);
+		x(second,i)=std::cos(2.0*i);
+		y[i]=std::sin(3.0*i)>0 ? 1.0 : -1.0;
+	}
+	float64_t penalty_weight=1.0/num_samples;
+
+	auto fun=std::make_shared<ClassificationForTestCostFunction>();
+	fun->set_data(x, y);
+	auto opt=std::make_shared<SVRGMinimizer>(fun);
+	opt->put("seed", 3);
+	opt->set_lazy_updates(true);
+	opt->set_penalty_weight(penalty_weight);
+	opt->set_penalty_type(std::make_shared<L2Penalty>());
+	auto rate=std::make_shared<ConstLearningRate>();
+	rate->set_const_learning_rate(0.5);
+	opt->set_learning_rate(rate);
+	opt->set_gradient_updater(std::make_shared<GradientDescendUpdater>());
+	opt->set_number_passes(50);
+	opt->set_sgd_number_passes(0);
+	opt->set_average_update_interval(1);
+	opt->minimize();
+
+	//SVRG converges to the minimum, obtained here by gradient descent
+	auto gd_fun=std::make_shared<ClassificationForTestCostFunction>();
+	gd_fun->set_data(x, y);
+	SGVector<float64_t> gd_w=gd_fun->obtain_variable_reference();
+	for(int32_t iter=0; iter<5000; iter++)
+	{
+		SGVector<float64_t> gradient=gd_fun->get_average_gradient();
+		for(index_t i=0; i<gd_w.vlen; i++)
+			gd_w[i]-=gradient[i]+penalty_weight*gd_w[i];
+	}
+
+	SGVector<float64_t> w=fun->obtain_variable_reference();
+	for(index_t i=0; i<num_features; i++)
+		EXPECT_NEAR(w[i], gd_w[i], 1e-8);
+}
+
+TEST(SVRGMinimizer,lazy_updates_one_pass)
+{
+	index_t num_samples=30;
+	index_t num_features=6;
+	SGMatrix<float64_t> x(num_features, num_samples);
+	x.zero();
+	SGVector<float64_t> y(num_samples);
+	for(index_t i=0; i<num_samples; i++)
+	{
+		index_t first=i%num_features;
+		index_t second=(3*i+1)%num_features;
+		if(second==first)
+			second=(first+1)%num_features;
+		x(first,i)=std::sin(i+1.0);
+		x(second,i)=std::cos(2.0*i);
+		y[i]=std::sin(3.0*i)>0 ? 1.0 : -1.0;
+	}
+	float64_t penalty_weight=1.0/num_samples;
+	float64_t learning_rate=0.5;
+	int32_t seed=3;
+
+	auto fun=std::make_shared<ClassificationForTestCostFunction>();
+	fun->set_data(x, y);
+	auto opt=std::make_shared<SVRGMinimizer>(fun);
+	opt->put("seed", seed);
+	opt->set_lazy_updates(true);
+	opt->set_penalty_weight(penalty_weight);
+	opt->set_penalty_type(std::make_shared<L2Penalty>());
+	auto rate=std::make_shared<ConstLearningRate>();
+	rate->set_const_learning_rate(learning_rate);
+	opt->set_learning_rate(rate);
+	opt->set_gradient_updater(std::make_shared<GradientDescendUpdater>());
+	opt->set_number_passes(1);
+	opt->set_sgd_number_passes(0);
+	opt->set_average_update_interval(1);
+	opt->minimize();
+
+	//the same pass of SVRG, updating every coordinate in every step
+	auto dense_fun=std::make_shared<ClassificationForTestCostFunction>();
+	dense_fun->set_data(x, y);
+	SGVector<float64_t> dense_w=dense_fun->obtain_variable_reference();
+	SGVector<float64_t> snapshot=dense_w.clone();
+	std::vector<index_t> order(num_samples);
+	std::iota(order.begin(), order.end(), 0);
+	std::mt19937_64 prng(seed);
+	random::shuffle(order, prng);
+
+	std::vector<SGSparseVectorEntry<float64_t>> gradient;
+	SGVector<float64_t> average(num_features);
+	average.zero();
+	for(index_t i=0; i<num_samples; i++)
+	{
+		gradient.clear();
+		dense_fun->get_sample_gradient(i, snapshot, gradient);
+		for(const auto& entry : gradient)
+			average[entry.feat_index]+=entry.entry/num_samples;
+	}
+
+	for(index_t i : order)
+	{
+		SGVector<float64_t> grad(num_features);
+		grad.zero();
+		gradient.clear();
+		dense_fun->get_sample_gradient(i, dense_w, gradient);
+		for(const auto& entry : gradient)
+			grad[entry.feat_index]+=entry.entry;
+		gradient.clear();
+		dense_fun->get_sample_gradient(i, snapshot, gradient);
+		for(const auto& entry : gradient)
+			grad[entry.feat_index]-=entry.entry;
+		for(index_t j=0; j<num_features; j++)
+			dense_w[j]-=learning_rate*(grad[j]+average[j]+penalty_weight*dense_w[j]);
+	}
+
+	SGVector<float64_t> w=fun->obtain_variable_reference();
+	for(index_t i=0; i<num_features; i++)
+		EXPECT_NEAR(w[i], dense_w[i], 1e-12);
+}
+
 TEST(SVRGMinimizer,test2)
 {
 	//We fix the sample sequences
@@ -74,6 +74,11 @@ public:
 	virtual bool next_sample();
 	virtual int32_t get_sample_size();
 	virtual SGVector<float64_t> get_average_gradient();
+	virtual index_t get_num_samples() const;
+	virtual void get_sample_gradient(index_t idx, const SGVector<float64_t>& variable,
+		std::vector<SGSparseVectorEntry<float64_t>>& gradient) const;
+	virtual void get_batch_gradient(const SGVector<index_t>& batch,
+		const SGVector<float64_t>& variable, SGVector<float64_t> gradient) const;
 	virtual const char* get_name() const { return "ClassificationForTestCostFunction"; }
 protected:
 	index_t m_sample_idx;
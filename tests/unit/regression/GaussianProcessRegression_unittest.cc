@@ -723,3 +723,65 @@ TEST(GaussianProcessRegression,fitc_regression)
 
 
 }
+
+TEST(GaussianProcessRegression, add_training_points)
+{
+	index_t ntr=5;
+
+	SGMatrix<float64_t> feat_train(1, ntr);
+	SGVector<float64_t> lab_train(ntr);
+
+	feat_train[0]=1.25107;
+	feat_train[1]=2.16097;
+	feat_train[2]=0.00034;
+	feat_train[3]=0.90699;
+	feat_train[4]=0.44026;
+
+	lab_train[0]=0.39635;
+	lab_train[1]=0.00358;
+	lab_train[2]=-1.18139;
+	lab_train[3]=1.35533;
+	lab_train[4]=-0.08232;
+
+	// first two points at training, the others one at a time
+	SGMatrix<float64_t> feat_first(1, 2);
+	SGVector<float64_t> lab_first(2);
+	for (index_t i=0; i<2; ++i)
+	{
+		feat_first[i]=feat_train[i];
+		lab_first[i]=lab_train[i];
+	}
+
+	auto kernel=std::make_shared<GaussianKernel>(10, 0.02);
+	auto mean=std::make_shared<ZeroMean>();
+	auto liklihood=std::make_shared<GaussianLikelihood>(0.25);
+	auto inf=std::make_shared<ExactInferenceMethod>(kernel,
+			std::make_shared<DenseFeatures<float64_t>>(feat_first),
+			mean, std::make_shared<RegressionLabels>(lab_first), liklihood);
+
+	auto gpr=std::make_shared<GaussianProcessRegression>(inf);
+	gpr->train();
+
+	for (index_t i=2; i<ntr; ++i)
+	{
+		SGMatrix<float64_t> feat(1, 1);
+		SGVector<float64_t> lab(1);
+		feat[0]=feat_train[i];
+		lab[0]=lab_train[i];
+		gpr->add_training_points(
+				std::make_shared<DenseFeatures<float64_t>>(feat),
+				std::make_shared<RegressionLabels>(lab));
+	}
+	EXPECT_EQ(gpr->get_labels()->get_num_labels(), ntr);
+
+	// same predictions as apply_regression_on_training_features
+	auto predictions=gpr->apply_regression(
+			std::make_shared<DenseFeatures<float64_t>>(feat_train));
+	SGVector<float64_t> prediction_vector=predictions->get_labels();
+
+	EXPECT_NEAR(prediction_vector[0], 0.3732367, 1E-7);
+	EXPECT_NEAR(prediction_vector[1], 0.0033694, 1E-7);
+	EXPECT_NEAR(prediction_vector[2], -1.1118968, 1E-7);
+	EXPECT_NEAR(prediction_vector[3], 1.2756631, 1E-7);
+	EXPECT_NEAR(prediction_vector[4], -0.0774804, 1E-7);
+}